@@ -12,6 +12,7 @@
 #include <gauxc/basisset.hpp>
 #include <gauxc/basisset_map.hpp>
 #include <gauxc/shell_pair.hpp>
+#include <gauxc/shell_spatial_index.hpp>
 #include <gauxc/xc_task.hpp>
 #include <gauxc/util/timer.hpp>
 #include <gauxc/runtime_environment.hpp>
@@ -44,6 +45,7 @@ public:
   using basis_type      = BasisSet<double>;
   using basis_map_type  = BasisSetMap;
   using shell_pair_type = ShellPairCollection<double>;
+  using shell_index_type = ShellSpatialIndex;
 
   /// Construct default LoadBalancer instance with null internal state
   LoadBalancer();
@@ -73,6 +75,17 @@ public:
 
   /// Rebalance quadrature batches according to exx cost 
   void rebalance_exx();
+
+  /**
+   *  @brief Remove negligible quadrature points from local tasks
+   *
+   *  Points whose (partitioned) weight is negligible are removed, the basis
+   *  screening of each task is redone on the bounding box of the remaining
+   *  points and tasks which have become equivalent are merged.
+   *
+   *  @param[in] weight_tol Points with |weight| <= weight_tol are removed
+   */
+  void compact_tasks( double weight_tol );
   
   /// Return internal timing tracker
   const util::Timer& get_timings() const;
@@ -102,6 +115,9 @@ public:
   const shell_pair_type& shell_pairs() const;
   const shell_pair_type& shell_pairs();
 
+  /// Return the spatial index over the shells of the basis
+  const shell_index_type& shell_index() const;
+
   /// Return the runtime handle used to construct this LoadBalancer
   const RuntimeEnvironment& runtime() const;
   
@@ -20,6 +20,9 @@ namespace detail {
 struct MolecularWeightsSettings { 
     XCWeightAlg weight_alg = XCWeightAlg::SSF; ///< Weight partitioning scheme
     bool becke_size_adjustment = false; ///< Whether to use Becke size adjustments
+    bool atom_screening = false; ///< Whether to restrict cell functions to contributing atoms (Host only)
+    bool compact_tasks = false; ///< Whether to remove negligible points from tasks after partitioning
+    double compact_weight_tol = 1e-15; ///< Points with |weight| <= compact_weight_tol are removed
 };
 
 
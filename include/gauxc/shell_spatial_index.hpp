@@ -0,0 +1,262 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/basisset.hpp>
+#include <gauxc/util/geometry.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace GauXC {
+
+/**
+ *  @brief A hierarchy of uniform cell grids over the cutoff spheres of the
+ *  shells of a BasisSet
+ *
+ *  Answers queries for the shells whose cutoff sphere intersects an axis
+ *  aligned box in time proportional to the number of shells near the box
+ *  rather than the size of the basis.
+ *
+ *  The edge length of the cells doubles from one level to the next. Each
+ *  shell is binned, on the finest level on which the bounding box of its
+ *  cutoff sphere spans few cells, into every cell overlapped by that box.
+ *  Diffuse shells are hence kept on coarse levels rather than being tested
+ *  for every query.
+ */
+class ShellSpatialIndex {
+
+  using point_type = std::array<double,3>;
+
+  /// Cell grid of one level of the hierarchy
+  struct cell_grid {
+    double                cell_size;   ///< Cell edge length
+    std::array<int64_t,3> ncells;      ///< Number of cells per dimension
+    std::vector<int32_t>  cell_ptr;    ///< CSR row pointer over cells
+    std::vector<int32_t>  cell_shells; ///< CSR shell indices
+
+    inline int64_t cell_coord( const point_type& origin, double x, 
+      int dim ) const {
+      const int64_t c = std::floor( (x - origin[dim]) / cell_size );
+      return std::clamp<int64_t>( c, 0, ncells[dim]-1 );
+    }
+
+    inline int64_t cell_index( int64_t i, int64_t j, int64_t k ) const {
+      return i + ncells[0] * (j + ncells[1] * k);
+    }
+
+    /// Cell range [lo,up] (inclusive) covered by a box
+    inline auto cell_range( const point_type& origin, const point_type& lo, 
+      const point_type& up ) const {
+      std::array<int64_t,3> c_lo, c_up;
+      for( int d = 0; d < 3; ++d ) {
+        c_lo[d] = cell_coord( origin, lo[d], d );
+        c_up[d] = cell_coord( origin, up[d], d );
+      }
+      return std::pair( c_lo, c_up );
+    }
+  };
+
+  std::vector<point_type> centers_;  ///< Shell centers
+  std::vector<double>     radii_;    ///< Shell cutoff radii
+
+  point_type             origin_; ///< Lower corner of the cell grids
+  std::vector<cell_grid> levels_; ///< Cell grids, finest first
+
+  /// Maximum number of cells a shell may span on its level (all shells
+  /// fit on the coarsest level, which consists of a single cell)
+  static constexpr int64_t max_cells_per_shell = 64;
+
+  /// Bounding box of the cutoff sphere of a shell, padded against roundoff
+  inline auto shell_box( int32_t ish ) const {
+    const auto& c = centers_[ish];
+    const auto  r = radii_[ish];
+    point_type lo, up;
+    for( int d = 0; d < 3; ++d ) {
+      const double pad = 1e-10 * (1. + std::abs(c[d]) + r);
+      lo[d] = c[d] - r - pad;
+      up[d] = c[d] + r + pad;
+    }
+    return std::pair( lo, up );
+  }
+
+public:
+
+  ShellSpatialIndex() = default;
+
+  /**
+   *  @brief Construct a ShellSpatialIndex object from a BasisSet
+   *
+   *  @param[in] basis BasisSet for which to generate the index
+   */
+  template <typename F>
+  ShellSpatialIndex( const BasisSet<F>& basis ) {
+
+    const int32_t nshells = basis.nshells();
+    if( not nshells ) return;
+
+    centers_.resize( nshells );
+    radii_.resize( nshells );
+    for( int32_t i = 0; i < nshells; ++i ) {
+      const auto& O = basis.at(i).O();
+      centers_[i] = { O[0], O[1], O[2] };
+      radii_[i]   = basis.at(i).cutoff_radius();
+    }
+
+    // Extent of all cutoff spheres
+    point_type up;
+    origin_.fill( std::numeric_limits<double>::infinity() );
+    up.fill( -std::numeric_limits<double>::infinity() );
+    for( int32_t i = 0; i < nshells; ++i ) {
+      auto [s_lo, s_up] = shell_box(i);
+      for( int d = 0; d < 3; ++d ) {
+        origin_[d] = std::min( origin_[d], s_lo[d] );
+        up[d]      = std::max( up[d],      s_up[d] );
+      }
+    }
+
+    // Finest cell size on the order of a typical cutoff radius, bounded 
+    // such that the number of cells remains proportional to the number 
+    // of shells
+    std::vector<double> r_sorted( radii_ );
+    std::nth_element( r_sorted.begin(), r_sorted.begin() + nshells/2,
+      r_sorted.end() );
+    double cell_size = std::max( r_sorted[nshells/2], 1e-3 );
+
+    const double max_cells = 8. * nshells;
+    auto total_cells = [&]() {
+      double n = 1.;
+      for( int d = 0; d < 3; ++d )
+        n *= std::max( 1., std::ceil( (up[d] - origin_[d]) / cell_size ) );
+      return n;
+    };
+    while( total_cells() > max_cells ) cell_size *= 1.25;
+
+    // Levels of doubling cell size, up to a single cell
+    for( ;; cell_size *= 2. ) {
+      cell_grid g;
+      g.cell_size = cell_size;
+      for( int d = 0; d < 3; ++d )
+        g.ncells[d] = std::max<int64_t>( 1,
+          std::ceil( (up[d] - origin_[d]) / cell_size ) );
+      const bool top = g.ncells[0] * g.ncells[1] * g.ncells[2] == 1;
+      levels_.emplace_back( std::move(g) );
+      if( top ) break;
+    }
+
+    // Level of each shell
+    std::vector<int32_t> shell_level( nshells );
+    for( int32_t ish = 0; ish < nshells; ++ish ) {
+      auto [s_lo, s_up] = shell_box(ish);
+      size_t il = 0;
+      for( ; il < levels_.size() - 1; ++il ) {
+        auto [c_lo, c_up] = levels_[il].cell_range( origin_, s_lo, s_up );
+        int64_t nspan = 1;
+        for( int d = 0; d < 3; ++d ) nspan *= c_up[d] - c_lo[d] + 1;
+        if( nspan <= max_cells_per_shell ) break;
+      }
+      shell_level[ish] = il;
+    }
+
+    // Bin shells into the cells of their level (CSR, two passes)
+    for( size_t il = 0; il < levels_.size(); ++il ) {
+      auto& g = levels_[il];
+      const int64_t ncells_total = g.ncells[0] * g.ncells[1] * g.ncells[2];
+      g.cell_ptr.assign( ncells_total + 1, 0 );
+
+      for( int pass = 0; pass < 2; ++pass ) {
+        std::vector<int32_t> cell_fill;
+        if( pass ) {
+          for( int64_t c = 0; c < ncells_total; ++c )
+            g.cell_ptr[c+1] += g.cell_ptr[c];
+          g.cell_shells.resize( g.cell_ptr.back() );
+          cell_fill.assign( g.cell_ptr.begin(), g.cell_ptr.end() - 1 );
+        }
+
+        for( int32_t ish = 0; ish < nshells; ++ish ) {
+          if( shell_level[ish] != int32_t(il) ) continue;
+          auto [s_lo, s_up] = shell_box(ish);
+          auto [c_lo, c_up] = g.cell_range( origin_, s_lo, s_up );
+
+          for( int64_t k = c_lo[2]; k <= c_up[2]; ++k )
+          for( int64_t j = c_lo[1]; j <= c_up[1]; ++j )
+          for( int64_t i = c_lo[0]; i <= c_up[0]; ++i ) {
+            const auto c = g.cell_index(i,j,k);
+            if( pass ) g.cell_shells[ cell_fill[c]++ ] = ish;
+            else       g.cell_ptr[c+1]++;
+          }
+        }
+      }
+    }
+
+  }
+
+  /// Number of indexed shells
+  inline size_t nshells() const { return radii_.size(); }
+
+  /**
+   *  @brief Generate candidate shells which may intersect a box
+   *
+   *  Candidates are a superset of the intersecting shells and may
+   *  contain duplicates.
+   *
+   *  @param[in]  lo         Lower corner of the box
+   *  @param[in]  up         Upper corner of the box
+   *  @param[out] candidates Candidate shell indices (appended)
+   */
+  void candidate_shells( const point_type& lo, const point_type& up,
+    std::vector<int32_t>& candidates ) const {
+
+    for( const auto& g : levels_ ) {
+      if( g.cell_shells.empty() ) continue;
+      auto [c_lo, c_up] = g.cell_range( origin_, lo, up );
+      for( int64_t k = c_lo[2]; k <= c_up[2]; ++k )
+      for( int64_t j = c_lo[1]; j <= c_up[1]; ++j )
+      for( int64_t i = c_lo[0]; i <= c_up[0]; ++i ) {
+        const auto c = g.cell_index(i,j,k);
+        candidates.insert( candidates.end(),
+          g.cell_shells.begin() + g.cell_ptr[c],
+          g.cell_shells.begin() + g.cell_ptr[c+1] );
+      }
+    }
+
+  }
+
+  /**
+   *  @brief Determine the shells whose cutoff sphere intersects a box
+   *
+   *  Equivalent to testing geometry::cube_sphere_intersect for every
+   *  shell of the basis.
+   *
+   *  @param[in] lo Lower corner of the box
+   *  @param[in] up Upper corner of the box
+   *  @returns   Indices of the intersecting shells in ascending order
+   */
+  std::vector<int32_t> intersecting_shells( const point_type& lo,
+    const point_type& up ) const {
+
+    std::vector<int32_t> shell_list;
+    candidate_shells( lo, up, shell_list );
+    std::sort( shell_list.begin(), shell_list.end() );
+    shell_list.erase( std::unique( shell_list.begin(), shell_list.end() ),
+      shell_list.end() );
+
+    shell_list.erase( std::remove_if( shell_list.begin(), shell_list.end(),
+      [&]( int32_t ish ) {
+        return not geometry::cube_sphere_intersect( lo, up, centers_[ish],
+          radii_[ish] );
+      }), shell_list.end() );
+
+    return shell_list;
+
+  }
+
+};
+
+}
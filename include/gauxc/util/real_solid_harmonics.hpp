@@ -135,7 +135,7 @@ public:
   }
 
   inline void tform_bra_rm( int bra_l, int nket, const double* cart,
-    int ldc, double* sph, int lds ) {
+    int ldc, double* sph, int lds ) const {
 
     const int bra_cart_sz = (bra_l+1) * (bra_l+2)/2;
     const int bra_sph_sz  = 2*bra_l + 1;
@@ -151,7 +151,7 @@ public:
   }
 
   inline void tform_bra_cm( int bra_l, int nket, const double* cart,
-    int ldc, double* sph, int lds ) {
+    int ldc, double* sph, int lds ) const {
 
     const int bra_cart_sz = (bra_l+1) * (bra_l+2)/2;
     const int bra_sph_sz  = 2*bra_l + 1;
@@ -167,7 +167,7 @@ public:
   }
 
   inline void itform_bra_rm( int bra_l, int nket, const double* sph,
-    int lds, double* cart, int ldc ) {
+    int lds, double* cart, int ldc ) const {
 
     const int bra_cart_sz = (bra_l+1) * (bra_l+2)/2;
     const int bra_sph_sz  = 2*bra_l + 1;
@@ -183,7 +183,7 @@ public:
   }
 
   inline void itform_bra_cm( int bra_l, int nket, const double* sph,
-    int lds, double* cart, int ldc ) {
+    int lds, double* cart, int ldc ) const {
 
     const int bra_cart_sz = (bra_l+1) * (bra_l+2)/2;
     const int bra_sph_sz  = 2*bra_l + 1;
@@ -199,7 +199,7 @@ public:
   }
 
   inline void tform_ket_rm( int nbra, int ket_l, const double* cart,
-    int ldc, double* sph, int lds ) {
+    int ldc, double* sph, int lds ) const {
 
     const int ket_cart_sz = (ket_l+1) * (ket_l+2)/2;
     const int ket_sph_sz  = 2*ket_l + 1;
@@ -215,7 +215,7 @@ public:
   }
 
   inline void tform_both_rm( int bra_l, int ket_l, const double* cart,
-    int ldc, double* sph, int lds ) {
+    int ldc, double* sph, int lds ) const {
 
     //const int bra_cart_sz = (bra_l+1) * (bra_l+2)/2;
     const int ket_cart_sz = (ket_l+1) * (ket_l+2)/2;
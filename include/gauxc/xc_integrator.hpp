@@ -34,7 +34,11 @@ public:
   using exc_vxc_type_rks  = std::tuple< value_type, matrix_type >;
   using exc_vxc_type_uks  = std::tuple< value_type, matrix_type, matrix_type >;  
   using exc_vxc_type_gks  = std::tuple< value_type, matrix_type, matrix_type, matrix_type, matrix_type >;
+  using exc_vxc_batch_type = std::vector< exc_vxc_type_rks >;
+  using exc_multi_type     = std::vector< value_type >;
+  using exc_vxc_multi_type = std::vector< exc_vxc_type_rks >;
   using exc_grad_type = std::vector< value_type >;
+  using fxc_contraction_type = std::vector< matrix_type >;
   using exx_type      = matrix_type;
 
 private:
@@ -66,8 +70,19 @@ public:
   exc_vxc_type_gks  eval_exc_vxc ( const MatrixType&, const MatrixType&, const MatrixType&, const MatrixType&,
                                    const IntegratorSettingsXC& = IntegratorSettingsXC{});
 
+  exc_vxc_batch_type eval_exc_vxc_batch( const std::vector<MatrixType>&,
+                                         const IntegratorSettingsXC& = IntegratorSettingsXC{} );
+
+  exc_multi_type     eval_exc_multi( const MatrixType&, const std::vector<functional_type>&,
+                                     const IntegratorSettingsXC& = IntegratorSettingsXC{} );
+  exc_vxc_multi_type eval_exc_vxc_multi( const MatrixType&, const std::vector<functional_type>&,
+                                         const IntegratorSettingsXC& = IntegratorSettingsXC{} );
+
   exc_grad_type eval_exc_grad( const MatrixType& );
 
+  fxc_contraction_type eval_fxc_contraction( const MatrixType&, const std::vector<MatrixType>&,
+                                             const IntegratorSettingsXC& = IntegratorSettingsXC{} );
+
   exx_type      eval_exx     ( const MatrixType&, 
                                const IntegratorSettingsEXX& = IntegratorSettingsEXX{} );
 
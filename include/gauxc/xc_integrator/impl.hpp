@@ -74,6 +74,32 @@ typename XCIntegrator<MatrixType>::exc_vxc_type_gks
         return pimpl_->eval_exc_vxc(Ps, Pz, Py, Px, ks_settings);
   };
 
+template <typename MatrixType>
+typename XCIntegrator<MatrixType>::exc_vxc_batch_type
+  XCIntegrator<MatrixType>::eval_exc_vxc_batch( const std::vector<MatrixType>& Ps, 
+                                                const IntegratorSettingsXC& ks_settings ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->eval_exc_vxc_batch(Ps, ks_settings);
+};
+
+template <typename MatrixType>
+typename XCIntegrator<MatrixType>::exc_multi_type
+  XCIntegrator<MatrixType>::eval_exc_multi( const MatrixType& P, 
+                                            const std::vector<functional_type>& funcs,
+                                            const IntegratorSettingsXC& ks_settings ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->eval_exc_multi(P, funcs, ks_settings);
+};
+
+template <typename MatrixType>
+typename XCIntegrator<MatrixType>::exc_vxc_multi_type
+  XCIntegrator<MatrixType>::eval_exc_vxc_multi( const MatrixType& P, 
+                                                const std::vector<functional_type>& funcs,
+                                                const IntegratorSettingsXC& ks_settings ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->eval_exc_vxc_multi(P, funcs, ks_settings);
+};
+
 template <typename MatrixType>
 typename XCIntegrator<MatrixType>::exc_grad_type
   XCIntegrator<MatrixType>::eval_exc_grad( const MatrixType& P ) {
@@ -81,6 +107,15 @@ typename XCIntegrator<MatrixType>::exc_grad_type
   return pimpl_->eval_exc_grad(P);
 };
 
+template <typename MatrixType>
+typename XCIntegrator<MatrixType>::fxc_contraction_type
+  XCIntegrator<MatrixType>::eval_fxc_contraction( const MatrixType& P, 
+                                                  const std::vector<MatrixType>& tPs,
+                                                  const IntegratorSettingsXC& ks_settings ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->eval_fxc_contraction(P, tPs, ks_settings);
+};
+
 template <typename MatrixType>
 typename XCIntegrator<MatrixType>::exx_type
   XCIntegrator<MatrixType>::eval_exx( const MatrixType&     P,
@@ -157,6 +157,90 @@ typename ReplicatedXCIntegrator<MatrixType>::exc_vxc_type_gks
 
 }
 
+template <typename MatrixType>
+typename ReplicatedXCIntegrator<MatrixType>::exc_vxc_batch_type
+  ReplicatedXCIntegrator<MatrixType>::eval_exc_vxc_batch_( const std::vector<MatrixType>& Ps,
+                                                           const IntegratorSettingsXC& ks_settings ) {
+
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  const size_t ndm = Ps.size();
+  if( not ndm ) return exc_vxc_batch_type{};
+
+  const int64_t m = Ps[0].rows();
+  const int64_t n = Ps[0].cols();
+  for( const auto& P : Ps ) 
+  if( P.rows() != m or P.cols() != n )
+    GAUXC_GENERIC_EXCEPTION("Batched Density Matrices Must Have the Same Dimension");
+
+  std::vector<matrix_type> VXC( ndm, matrix_type( m, n ) );
+  std::vector<value_type>  EXC( ndm );
+
+  std::vector<const value_type*> P_ptrs( ndm );
+  std::vector<value_type*>       VXC_ptrs( ndm );
+  for( size_t i = 0; i < ndm; ++i ) {
+    P_ptrs[i]   = Ps[i].data();
+    VXC_ptrs[i] = VXC[i].data();
+  }
+
+  pimpl_->eval_exc_vxc_batch( m, n, ndm, P_ptrs.data(), m, VXC_ptrs.data(), m,
+                              EXC.data(), ks_settings );
+
+  exc_vxc_batch_type EXC_VXC; EXC_VXC.reserve( ndm );
+  for( size_t i = 0; i < ndm; ++i )
+    EXC_VXC.emplace_back( EXC[i], std::move(VXC[i]) );
+
+  return EXC_VXC;
+
+}
+
+template <typename MatrixType>
+typename ReplicatedXCIntegrator<MatrixType>::exc_multi_type
+  ReplicatedXCIntegrator<MatrixType>::eval_exc_multi_( const MatrixType& P,
+                                                       const std::vector<functional_type>& funcs,
+                                                       const IntegratorSettingsXC& ks_settings ) {
+
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  const size_t nfunc = funcs.size();
+
+  // No VXC requested
+  exc_multi_type EXC( nfunc );
+  if( nfunc )
+    pimpl_->eval_exc_vxc_multi( P.rows(), P.cols(), P.data(), P.rows(), nfunc,
+                                funcs.data(), nullptr, P.rows(), EXC.data(), 
+                                ks_settings );
+
+  return EXC;
+
+}
+
+template <typename MatrixType>
+typename ReplicatedXCIntegrator<MatrixType>::exc_vxc_multi_type
+  ReplicatedXCIntegrator<MatrixType>::eval_exc_vxc_multi_( const MatrixType& P,
+                                                           const std::vector<functional_type>& funcs,
+                                                           const IntegratorSettingsXC& ks_settings ) {
+
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  const size_t nfunc = funcs.size();
+  if( not nfunc ) return exc_vxc_multi_type{};
+
+  std::vector<matrix_type> VXC( nfunc, matrix_type( P.rows(), P.cols() ) );
+  std::vector<value_type>  EXC( nfunc );
+
+  std::vector<value_type*> VXC_ptrs( nfunc );
+  for( size_t i = 0; i < nfunc; ++i ) VXC_ptrs[i] = VXC[i].data();
+
+  pimpl_->eval_exc_vxc_multi( P.rows(), P.cols(), P.data(), P.rows(), nfunc,
+                              funcs.data(), VXC_ptrs.data(), P.rows(), 
+                              EXC.data(), ks_settings );
+
+  exc_vxc_multi_type EXC_VXC; EXC_VXC.reserve( nfunc );
+  for( size_t i = 0; i < nfunc; ++i )
+    EXC_VXC.emplace_back( EXC[i], std::move(VXC[i]) );
+
+  return EXC_VXC;
+
+}
+
 template <typename MatrixType>
 typename ReplicatedXCIntegrator<MatrixType>::exc_grad_type 
   ReplicatedXCIntegrator<MatrixType>::eval_exc_grad_( const MatrixType& P ) {
@@ -171,6 +255,37 @@ typename ReplicatedXCIntegrator<MatrixType>::exc_grad_type
 
 }
 
+template <typename MatrixType>
+typename ReplicatedXCIntegrator<MatrixType>::fxc_contraction_type
+  ReplicatedXCIntegrator<MatrixType>::eval_fxc_contraction_( const MatrixType& P, 
+                                                             const std::vector<MatrixType>& tPs,
+                                                             const IntegratorSettingsXC& ks_settings ) {
+
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  const size_t ntrial = tPs.size();
+  if( not ntrial ) return fxc_contraction_type{};
+
+  for( const auto& tP : tPs ) 
+  if( tP.rows() != P.rows() or tP.cols() != P.cols() )
+    GAUXC_GENERIC_EXCEPTION("Trial Densities Must Have the Same Dimension as P");
+
+  fxc_contraction_type FXC( ntrial, matrix_type( P.rows(), P.cols() ) );
+
+  std::vector<const value_type*> tP_ptrs( ntrial );
+  std::vector<value_type*>       FXC_ptrs( ntrial );
+  for( size_t i = 0; i < ntrial; ++i ) {
+    tP_ptrs[i]  = tPs[i].data();
+    FXC_ptrs[i] = FXC[i].data();
+  }
+
+  pimpl_->eval_fxc_contraction( P.rows(), P.cols(), P.data(), P.rows(), ntrial,
+                                tP_ptrs.data(), P.rows(), FXC_ptrs.data(), 
+                                P.rows(), ks_settings );
+
+  return FXC;
+
+}
+
 template <typename MatrixType>
 typename ReplicatedXCIntegrator<MatrixType>::exx_type 
   ReplicatedXCIntegrator<MatrixType>::eval_exx_( const MatrixType& P, const IntegratorSettingsEXX& settings ) {
@@ -74,8 +74,27 @@ protected:
                               value_type* VXCx, int64_t ldvxcx,
                               value_type* EXC, const IntegratorSettingsXC& ks_settings ) = 0;
 
+  /// Batched RKS EXC/VXC, defaults to consecutive eval_exc_vxc_ calls
+  virtual void eval_exc_vxc_batch_( int64_t m, int64_t n, int64_t ndm, 
+                                    const value_type* const* P, int64_t ldp, 
+                                    value_type* const* VXC, int64_t ldvxc,
+                                    value_type* EXC, const IntegratorSettingsXC& ks_settings );
+
+  /// RKS EXC(/VXC) for several functionals, throws unless provided by the implementation
+  virtual void eval_exc_vxc_multi_( int64_t m, int64_t n, const value_type* P,
+                                    int64_t ldp, int64_t nfunc,
+                                    const functional_type* funcs,
+                                    value_type* const* VXC, int64_t ldvxc,
+                                    value_type* EXC, const IntegratorSettingsXC& ks_settings );
+
   virtual void eval_exc_grad_( int64_t m, int64_t n, const value_type* P,
                                int64_t ldp, value_type* EXC_GRAD ) = 0;
+  /// RKS fxc contraction, throws unless provided by the implementation
+  virtual void eval_fxc_contraction_( int64_t m, int64_t n, const value_type* P,
+                                      int64_t ldp, int64_t ntrial,
+                                      const value_type* const* tP, int64_t ldtp,
+                                      value_type* const* FXC, int64_t ldfxc,
+                                      const IntegratorSettingsXC& ks_settings );
   virtual void eval_exx_( int64_t m, int64_t n, const value_type* P,
                           int64_t ldp, value_type* K, int64_t ldk,
                           const IntegratorSettingsEXX& settings ) = 0;
@@ -130,9 +149,26 @@ public:
                      value_type* EXC, const IntegratorSettingsXC& ks_settings );
 
 
+  void eval_exc_vxc_batch( int64_t m, int64_t n, int64_t ndm, 
+                           const value_type* const* P, int64_t ldp, 
+                           value_type* const* VXC, int64_t ldvxc,
+                           value_type* EXC, const IntegratorSettingsXC& ks_settings );
+
+  void eval_exc_vxc_multi( int64_t m, int64_t n, const value_type* P,
+                           int64_t ldp, int64_t nfunc,
+                           const functional_type* funcs,
+                           value_type* const* VXC, int64_t ldvxc,
+                           value_type* EXC, const IntegratorSettingsXC& ks_settings );
+
   void eval_exc_grad( int64_t m, int64_t n, const value_type* P,
                       int64_t ldp, value_type* EXC_GRAD );
 
+  void eval_fxc_contraction( int64_t m, int64_t n, const value_type* P,
+                             int64_t ldp, int64_t ntrial,
+                             const value_type* const* tP, int64_t ldtp,
+                             value_type* const* FXC, int64_t ldfxc,
+                             const IntegratorSettingsXC& ks_settings );
+
   void eval_exx( int64_t m, int64_t n, const value_type* P,
                  int64_t ldp, value_type* K, int64_t ldk,
                  const IntegratorSettingsEXX& settings );
@@ -31,8 +31,12 @@ public:
   using exc_vxc_type_rks   = typename XCIntegratorImpl<MatrixType>::exc_vxc_type_rks;
   using exc_vxc_type_uks   = typename XCIntegratorImpl<MatrixType>::exc_vxc_type_uks;
   using exc_vxc_type_gks   = typename XCIntegratorImpl<MatrixType>::exc_vxc_type_gks;
+  using exc_vxc_batch_type = typename XCIntegratorImpl<MatrixType>::exc_vxc_batch_type;
+  using exc_multi_type     = typename XCIntegratorImpl<MatrixType>::exc_multi_type;
+  using exc_vxc_multi_type = typename XCIntegratorImpl<MatrixType>::exc_vxc_multi_type;
   using exc_grad_type  = typename XCIntegratorImpl<MatrixType>::exc_grad_type;
   using exx_type       = typename XCIntegratorImpl<MatrixType>::exx_type;
+  using fxc_contraction_type = typename XCIntegratorImpl<MatrixType>::fxc_contraction_type;
 
 private:
 
@@ -46,7 +50,14 @@ private:
   exc_vxc_type_rks  eval_exc_vxc_ ( const MatrixType&, const IntegratorSettingsXC& ) override;
   exc_vxc_type_uks  eval_exc_vxc_ ( const MatrixType&, const MatrixType&, const IntegratorSettingsXC&) override;
   exc_vxc_type_gks  eval_exc_vxc_ ( const MatrixType&, const MatrixType&, const MatrixType&, const MatrixType&, const IntegratorSettingsXC& ) override;
+  exc_vxc_batch_type eval_exc_vxc_batch_( const std::vector<MatrixType>&, const IntegratorSettingsXC& ) override;
+  exc_multi_type     eval_exc_multi_( const MatrixType&, const std::vector<functional_type>&, 
+                                      const IntegratorSettingsXC& ) override;
+  exc_vxc_multi_type eval_exc_vxc_multi_( const MatrixType&, const std::vector<functional_type>&, 
+                                          const IntegratorSettingsXC& ) override;
   exc_grad_type eval_exc_grad_( const MatrixType& ) override;
+  fxc_contraction_type eval_fxc_contraction_( const MatrixType&, const std::vector<MatrixType>&, 
+                                              const IntegratorSettingsXC& ) override;
   exx_type      eval_exx_     ( const MatrixType&, const IntegratorSettingsEXX& ) override;
   const util::Timer& get_timings_() const override;
   const LoadBalancer& get_load_balancer_() const override;
@@ -23,8 +23,12 @@ public:
   using exc_vxc_type_rks   = typename XCIntegrator<MatrixType>::exc_vxc_type_rks;
   using exc_vxc_type_uks   = typename XCIntegrator<MatrixType>::exc_vxc_type_uks;
   using exc_vxc_type_gks   = typename XCIntegrator<MatrixType>::exc_vxc_type_gks;
+  using exc_vxc_batch_type = typename XCIntegrator<MatrixType>::exc_vxc_batch_type;
+  using exc_multi_type     = typename XCIntegrator<MatrixType>::exc_multi_type;
+  using exc_vxc_multi_type = typename XCIntegrator<MatrixType>::exc_vxc_multi_type;
   using exc_grad_type  = typename XCIntegrator<MatrixType>::exc_grad_type;
   using exx_type       = typename XCIntegrator<MatrixType>::exx_type;
+  using fxc_contraction_type = typename XCIntegrator<MatrixType>::fxc_contraction_type;
 
 protected:
 
@@ -38,7 +42,18 @@ protected:
   virtual exc_vxc_type_uks  eval_exc_vxc_ ( const MatrixType& Ps, const MatrixType& Pz, const IntegratorSettingsXC& ks_settings ) = 0;
   virtual exc_vxc_type_gks  eval_exc_vxc_ ( const MatrixType& Ps, const MatrixType& Pz, const MatrixType& Py, const MatrixType& Px, 
                                             const IntegratorSettingsXC& ks_settings ) = 0;
+  virtual exc_vxc_batch_type eval_exc_vxc_batch_( const std::vector<MatrixType>& Ps, 
+                                                  const IntegratorSettingsXC& ks_settings ) = 0;
+  virtual exc_multi_type eval_exc_multi_( const MatrixType& P, 
+                                          const std::vector<functional_type>& funcs,
+                                          const IntegratorSettingsXC& ks_settings ) = 0;
+  virtual exc_vxc_multi_type eval_exc_vxc_multi_( const MatrixType& P, 
+                                                  const std::vector<functional_type>& funcs,
+                                                  const IntegratorSettingsXC& ks_settings ) = 0;
   virtual exc_grad_type eval_exc_grad_( const MatrixType& P ) = 0;
+  virtual fxc_contraction_type eval_fxc_contraction_( const MatrixType& P, 
+                                                      const std::vector<MatrixType>& tPs,
+                                                      const IntegratorSettingsXC& ks_settings ) = 0;
   virtual exx_type      eval_exx_     ( const MatrixType&     P, 
                                         const IntegratorSettingsEXX& settings ) = 0;
   virtual const util::Timer& get_timings_() const = 0;
@@ -107,6 +122,37 @@ public:
     return eval_exc_vxc_(Ps, Pz, Py, Px, ks_settings);
   }
 
+  /** Integrate EXC / VXC for a set of RKS densities on the same grid
+   *
+   *  @param[in] Ps The density matrices
+   *  @returns EXC / VXC of each density matrix
+   */
+  exc_vxc_batch_type eval_exc_vxc_batch( const std::vector<MatrixType>& Ps, const IntegratorSettingsXC& ks_settings ) {
+    return eval_exc_vxc_batch_(Ps, ks_settings);
+  }
+
+  /** Integrate EXC for several functionals on the same RKS density
+   *
+   *  @param[in] P     The alpha density matrix
+   *  @param[in] funcs The XC functionals
+   *  @returns EXC of each functional
+   */
+  exc_multi_type eval_exc_multi( const MatrixType& P, const std::vector<functional_type>& funcs,
+                                 const IntegratorSettingsXC& ks_settings ) {
+    return eval_exc_multi_(P, funcs, ks_settings);
+  }
+
+  /** Integrate EXC / VXC for several functionals on the same RKS density
+   *
+   *  @param[in] P     The alpha density matrix
+   *  @param[in] funcs The XC functionals
+   *  @returns EXC / VXC of each functional
+   */
+  exc_vxc_multi_type eval_exc_vxc_multi( const MatrixType& P, const std::vector<functional_type>& funcs,
+                                         const IntegratorSettingsXC& ks_settings ) {
+    return eval_exc_vxc_multi_(P, funcs, ks_settings);
+  }
+
   /** Integrate EXC gradient for RKS
    * 
    *   TODO: add API for UKS/GKS
@@ -118,6 +164,17 @@ public:
     return eval_exc_grad_(P);
   }
 
+  /** Contract the XC kernel (fxc) of an RKS density with trial densities
+   *
+   *  @param[in] P   The ground state density matrix
+   *  @param[in] tPs The trial density matrices
+   *  @returns The XC kernel contracted with each trial density
+   */
+  fxc_contraction_type eval_fxc_contraction( const MatrixType& P, const std::vector<MatrixType>& tPs,
+                                             const IntegratorSettingsXC& ks_settings ) {
+    return eval_fxc_contraction_(P, tPs, ks_settings);
+  }
+
   /** Integrate Exact Exchange for RHF
    *
    *  @param[in] P The alpha density matrix
@@ -6,6 +6,8 @@
  * See LICENSE.txt for details
  */
 #pragma once
+#include <cstddef>
+#include <string>
 
 namespace GauXC {
 
@@ -14,11 +16,51 @@ struct IntegratorSettingsSNLinK : public IntegratorSettingsEXX {
   bool screen_ek = true;
   double energy_tol = 1e-10;
   double k_tol      = 1e-10;
+  /// Skip shell pairs on blocks of points where their bounded contribution
+  /// to G falls below this tolerance (0 disables)
+  double pt_tol     = 0.;
+  /// Drop shell blocks of |P| below this tolerance from the approximate F
+  /// bounds of the EK screening (0 disables). The bounds are inflated by the
+  /// dropped contribution, but the retained shell pairs are no longer those
+  /// of the exact bound
+  double approx_f_p_tol = 0.;
+
+  /// Build K(P) = K(P_prev) + K(P - P_prev) relative to the previous call
+  bool incremental = false;
+  /// Discard the incremental state and perform a full build
+  bool incremental_reset = false;
+  /// Perform a full build once the accumulated bound of the delta build
+  /// contributions, max|P - P_prev| times the max V bound of the shell
+  /// pairs, since the last full build exceeds this
+  double incremental_rebuild_tol = 1e-4;
 };
 
 struct IntegratorSettingsXC { virtual ~IntegratorSettingsXC() noexcept = default; };
 struct IntegratorSettingsKS : public IntegratorSettingsXC {
   double gks_dtol = 1e-12;
+
+  /// Memory budget (bytes) of the cross-call collocation cache (0 disables)
+  size_t collocation_cache_bytes = 0;
+  /// Optional file to spill evicted collocation cache entries to (mmap)
+  std::string collocation_cache_spill_file;
+  /// Size (bytes) of the collocation cache spill file
+  size_t collocation_cache_spill_bytes = 0;
+
+  /// Shell block screening threshold of the density matrix in the 
+  /// X matrix GEMMs (0 disables)
+  double xmat_screen_tol = 0.;
+
+  /// Screening threshold of the Gaussian primitives over the bounding box 
+  /// of each task in the collocation kernels (0 disables)
+  double prim_screen_tol = 0.;
+
+  /// Minimum number of points (accumulated over consecutive tasks) per 
+  /// evaluation of the functional (0 evaluates the functional per task)
+  size_t func_batch_npts = 0;
+
+  /// Points whose (total) density does not exceed this threshold are 
+  /// removed from each task after the density evaluation (0 disables)
+  double den_screen_tol = 0.;
 };
 
 }
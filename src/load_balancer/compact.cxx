@@ -0,0 +1,112 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "load_balancer_impl.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <numeric>
+
+namespace GauXC::detail {
+
+void LoadBalancerImpl::compact_tasks( double weight_tol ) {
+
+  auto& tasks = get_tasks();
+  const size_t ntasks = tasks.size();
+
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    auto& task = tasks[iT];
+    auto& points  = task.points;
+    auto& weights = task.weights;
+    const size_t npts_old = points.size();
+
+    // Remove negligible points
+    size_t npts = 0;
+    for( size_t i = 0; i < npts_old; ++i )
+    if( std::abs(weights[i]) > weight_tol ) {
+      points[npts]  = points[i];
+      weights[npts] = weights[i];
+      ++npts;
+    }
+
+    if( npts == npts_old ) continue;
+
+    points.resize( npts );  points.shrink_to_fit();
+    weights.resize( npts ); weights.shrink_to_fit();
+    task.npts = npts;
+
+    auto& shell_list = task.bfn_screening.shell_list;
+    if( not npts ) {
+      shell_list.clear();
+      task.bfn_screening.nbe = 0;
+      continue;
+    }
+
+    // Re-screen on the bounding box of the remaining points. As the
+    // remaining points are a subset of those of the original batches,
+    // shells may only be removed from the original list.
+    std::array<double,3> box_lo, box_up;
+    box_lo.fill( std::numeric_limits<double>::infinity() );
+    box_up.fill( -std::numeric_limits<double>::infinity() );
+    for( const auto& pt : points )
+    for( int d = 0; d < 3; ++d ) {
+      box_lo[d] = std::min( box_lo[d], pt[d] );
+      box_up[d] = std::max( box_up[d], pt[d] );
+    }
+
+    auto box_shells = shell_index_->intersecting_shells( box_lo, box_up );
+    std::vector<int32_t> new_shell_list;
+    std::set_intersection( shell_list.begin(), shell_list.end(),
+      box_shells.begin(), box_shells.end(),
+      std::back_inserter(new_shell_list) );
+
+    // Preserve contiguous (filled in) shell lists
+    const bool is_contiguous = shell_list.size() and
+      (size_t)(shell_list.back() - shell_list.front() + 1) == shell_list.size();
+    if( is_contiguous and new_shell_list.size() ) {
+      const auto sh_st = new_shell_list.front();
+      const auto sh_en = new_shell_list.back();
+      new_shell_list.resize( sh_en - sh_st + 1 );
+      std::iota( new_shell_list.begin(), new_shell_list.end(), sh_st );
+    }
+
+    shell_list = std::move(new_shell_list);
+    task.bfn_screening.nbe = std::accumulate( shell_list.begin(),
+      shell_list.end(), 0ul,
+      [&](const auto& a, const auto& b) { return a + basis_->at(b).size(); } );
+
+  }
+
+  // Remove empty tasks
+  tasks.erase( std::remove_if( tasks.begin(), tasks.end(),
+    []( const auto& t ) {
+      return t.points.empty() or t.bfn_screening.shell_list.empty();
+    } ), tasks.end() );
+
+  // Re-merge tasks which have become equivalent
+  std::stable_sort( tasks.begin(), tasks.end(),
+    []( const auto& a, const auto& b ) {
+      if( a.iParent != b.iParent ) return a.iParent < b.iParent;
+      return a.bfn_screening.shell_list < b.bfn_screening.shell_list;
+    } );
+
+  std::vector< XCTask > merged_tasks;
+  merged_tasks.reserve( tasks.size() );
+  for( auto& task : tasks ) {
+    if( merged_tasks.size() and merged_tasks.back().equiv_with(task) )
+      merged_tasks.back().merge_with( task );
+    else merged_tasks.emplace_back( std::move(task) );
+  }
+
+  tasks = std::move( merged_tasks );
+
+}
+
+}
@@ -31,21 +31,13 @@ std::pair<std::vector<int32_t>,size_t> FillInHostReplicatedLoadBalancer::micro_b
 ) const {
 
 
-  int32_t first_shell = -1;
-  int32_t last_shell  = -1;
-  for(auto iSh = 0ul; iSh < bs.size(); ++iSh) {
-
-    const auto& center = bs[iSh].O();
-    const auto  crad   = bs[iSh].cutoff_radius();
-    const bool intersect = 
-      geometry::cube_sphere_intersect( box_lo, box_up, center, crad );
-    
-    if( intersect ) {
-      if( first_shell < 0 ) first_shell = iSh;
-      last_shell = iSh;
-    }
-
-  }
+  // Shells whose cutoff sphere intersects the batch box (spatial index is
+  // built over the basis of this LoadBalancer)
+  const auto intersect_list = shell_index_->intersecting_shells( box_lo, box_up );
+  const int32_t first_shell = 
+    intersect_list.size() ? intersect_list.front() : -1;
+  const int32_t last_shell = 
+    intersect_list.size() ? intersect_list.back()  : -1;
 
   if( first_shell < 0 ) {
     return std::pair( std::vector<int32_t>{}, 0ul );
@@ -31,27 +31,9 @@ std::pair<std::vector<int32_t>,size_t> PetiteHostReplicatedLoadBalancer::micro_b
 ) const {
 
 
-  std::vector<int32_t> shell_list; shell_list.reserve(bs.nshells());
-  for(auto iSh = 0ul; iSh < bs.size(); ++iSh) {
-
-    const auto& center = bs[iSh].O();
-    const auto  crad   = bs[iSh].cutoff_radius();
-    const bool intersect = 
-      geometry::cube_sphere_intersect( box_lo, box_up, center, crad );
-    
-
-    //std::cout << "  MBS: " << iSh << ", " << 
-    //          center[0] << ", " << center[1] << ", " << center[2] << ", " <<
-    //          box_up[0] << ", " << box_up[1] << ", " << box_up[2] << ", " <<
-    //          box_lo[0] << ", " << box_lo[1] << ", " << box_lo[2] << ", " <<
-    //          crad << std::boolalpha << ", " << intersect << std::endl;
-              
-
-    // Add shell to list if need be
-    if( intersect )
-      shell_list.emplace_back( iSh );
-
-  }
+  // Shells whose cutoff sphere intersects the batch box (spatial index is
+  // built over the basis of this LoadBalancer)
+  auto shell_list = shell_index_->intersecting_shells( box_lo, box_up );
 
   size_t nbe = std::accumulate( shell_list.begin(), shell_list.end(), 0ul,
     [&](const auto& a, const auto& b) { return a + bs[b].size(); } );
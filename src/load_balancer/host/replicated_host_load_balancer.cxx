@@ -6,6 +6,7 @@
  * See LICENSE.txt for details
  */
 #include "replicated_host_load_balancer.hpp"
+#include <gauxc/util/mpi.hpp>
 
 namespace GauXC {
 namespace detail {
@@ -22,106 +23,143 @@ std::vector< XCTask > HostReplicatedLoadBalancer::create_local_tasks_() const  {
   int32_t world_rank = runtime_.comm_rank();
   int32_t world_size = runtime_.comm_size();
 
-  std::vector< XCTask > local_work;
-  std::vector<size_t> global_workload( world_size, 0 );   
-
   const auto natoms = this->mol_->natoms();
-  int32_t iCurrent  = 0;
-  int32_t atBatchSz = 1;
 
-  const size_t max_nbatches = mg_->max_nbatches();
-  std::vector< std::pair<size_t, XCTask> > temp_tasks;
-  temp_tasks.reserve( max_nbatches );
+  // Global batch index offsets for each atom
+  std::vector<size_t> batch_idx_offset( natoms + 1, 0 );
+  for( size_t iAt = 0; iAt < natoms; ++iAt ) {
+    const auto& atom = this->mol_->at(iAt);
+    batch_idx_offset[iAt+1] = batch_idx_offset[iAt] + 
+      mg_->get_grid(atom.Z).batcher().nbatches();
+  }
+  const size_t nbatches_total = batch_idx_offset.back();
 
-  // For batching of multiple atom screening
-  size_t batch_idx_offset = 0;
+  // Generate and screen a batch, returns false if the batch is negligible
+  auto generate_task = [&]( const auto& batcher, size_t ibatch, int32_t iAt,
+    XCTask& task ) {
 
-  // Loop over Atoms
-  for( const auto& atom : *this->mol_ ) {
+    // Generate the batch (non-negligible cost)
+    auto [lo, up, points, weights] = batcher.at(ibatch);
 
-    const std::array<double,3> center = { atom.x, atom.y, atom.z };
+    if( points.size() == 0 ) return false;
 
-    auto& batcher = mg_->get_grid(atom.Z).batcher();
-    batcher.quadrature().recenter( center );
-    const size_t nbatches = batcher.nbatches();
+    // Microbatch Screening
+    auto [shell_list, nbe] = micro_batch_screen( (*this->basis_), lo, up );
 
-    #pragma omp parallel for
-    for( size_t ibatch = 0; ibatch < nbatches; ++ibatch ) {
-    
-      size_t batch_idx = ibatch + batch_idx_offset;
+    // Course grain screening
+    if( not shell_list.size() ) return false; 
 
-      // Generate the batch (non-negligible cost)
-      auto [lo, up, points, weights] = batcher.at(ibatch);
+    // Copy task data
+    task.iParent    = iAt;
+    // This enables lazy assignment of points vector (see CUDA impl)
+    task.npts       = points.size(); 
+    task.points     = std::move( points );
+    task.weights    = std::move( weights );
+    task.bfn_screening.shell_list = std::move(shell_list);
+    task.bfn_screening.nbe        = nbe;
+    task.dist_nearest = molmeta_->dist_nearest()[iAt];
+    return true;
 
-      if( points.size() == 0 ) continue;
+  };
 
-      // Microbatch Screening
-      auto [shell_list, nbe] = micro_batch_screen( (*this->basis_), lo, up );
+  // Loop over batches of each atom, calling func(batcher, ibatch, batch_idx)
+  // for each batch selected by the predicate (OpenMP parallel over batches)
+  auto for_each_batch = [&]( auto&& pred, auto&& func ) {
+    for( size_t iAt = 0; iAt < natoms; ++iAt ) {
+      const auto& atom = this->mol_->at(iAt);
+      const std::array<double,3> center = { atom.x, atom.y, atom.z };
+
+      auto& batcher = mg_->get_grid(atom.Z).batcher();
+      batcher.quadrature().recenter( center );
+      const size_t nbatches = batcher.nbatches();
+
+      #pragma omp parallel for
+      for( size_t ibatch = 0; ibatch < nbatches; ++ibatch ) {
+        const size_t batch_idx = ibatch + batch_idx_offset[iAt];
+        if( pred(batch_idx) ) func( batcher, ibatch, iAt, batch_idx );
+      }
+    }
+  };
 
-      // Course grain screening
-      if( not shell_list.size() ) continue; 
+  // Each rank generates a strided subset of the batches to obtain their
+  // exact cost, which is then shared among all ranks. Batches which are
+  // negligible have zero cost.
+  std::vector<size_t> batch_cost( nbatches_total, 0 );
+  std::vector< std::pair<size_t, XCTask> > temp_tasks;
 
-      // Copy task data
+  for_each_batch( 
+    [&]( size_t batch_idx ) { 
+      return (int32_t)(batch_idx % world_size) == world_rank; 
+    },
+    [&]( const auto& batcher, size_t ibatch, int32_t iAt, size_t batch_idx ) {
       XCTask task;
-      task.iParent    = iCurrent;
-      // This enables lazy assignment of points vector (see CUDA impl)
-      task.npts       = points.size(); 
-      task.points     = std::move( points );
-      task.weights    = std::move( weights );
-      task.bfn_screening.shell_list = std::move(shell_list);
-      task.bfn_screening.nbe        = nbe;
-      task.dist_nearest = molmeta_->dist_nearest()[iCurrent];
+      if( not generate_task( batcher, ibatch, iAt, task ) ) return;
+      batch_cost[batch_idx] = task.cost( n_deriv, natoms );
 
       #pragma omp critical
       temp_tasks.push_back( 
         std::pair(batch_idx,std::move( task )) 
       );
+    }
+  );
 
-    } // omp parallel for over batches
-
-
-
-
-
-    // Assign Tasks to MPI ranks
-    if( (iCurrent+1) % atBatchSz == 0 or iCurrent == ((int32_t)natoms-1) ) {
-
-      // Sort based on task index for deterministic assignment
-      std::sort( temp_tasks.begin(), temp_tasks.end(), 
-        []( const auto& a, const auto& b ) {
-          return a.first < b.first;
-        } );
-
-      // Assign batches to MPI ranks
-      for( size_t ibatch = 0; ibatch < temp_tasks.size(); ++ibatch ) {
-
-        XCTask task = std::move(temp_tasks.at(ibatch).second);
-        //auto& points = task.points;
-        //auto  nbe    = task.nbe;
-
-        // Get rank with minimum work
-        auto min_rank_it = 
-          std::min_element( global_workload.begin(), global_workload.end() );
-        int64_t min_rank = std::distance( global_workload.begin(), min_rank_it );
+  #ifdef GAUXC_HAS_MPI
+  if( world_size > 1 ) {
+    MPI_Allreduce( MPI_IN_PLACE, batch_cost.data(), nbatches_total, 
+      mpi_data_type<size_t>(), MPI_SUM, runtime_.comm() );
+  }
+  #endif
 
-        // Compute cost heuristic and increment total work
-        global_workload[ min_rank ] += task.cost( n_deriv, natoms );
+  // Assign batches to MPI ranks in order of batch index. This is a
+  // deterministic function of batch_cost and is replicated on all ranks.
+  std::vector< int32_t > batch_owner( nbatches_total, -1 );
+  std::vector<size_t> global_workload( world_size, 0 );   
+  for( size_t batch_idx = 0; batch_idx < nbatches_total; ++batch_idx ) {
+    if( not batch_cost[batch_idx] ) continue;
 
-        if( world_rank == min_rank ) 
-          local_work.push_back( std::move(task) );
+    // Get rank with minimum work
+    auto min_rank_it = 
+      std::min_element( global_workload.begin(), global_workload.end() );
+    int64_t min_rank = std::distance( global_workload.begin(), min_rank_it );
 
-      }
+    // Increment total work
+    global_workload[ min_rank ] += batch_cost[batch_idx];
+    batch_owner[ batch_idx ] = min_rank;
+  }
 
-      temp_tasks.clear();
+  // Keep the owned batches from the cost pass
+  temp_tasks.erase( std::remove_if( temp_tasks.begin(), temp_tasks.end(),
+    [&]( const auto& t ){ return batch_owner[t.first] != world_rank; } ),
+    temp_tasks.end() );
+
+  // Generate the remaining owned batches
+  for_each_batch( 
+    [&]( size_t batch_idx ) {
+      return batch_owner[batch_idx] == world_rank and
+        (int32_t)(batch_idx % world_size) != world_rank;
+    },
+    [&]( const auto& batcher, size_t ibatch, int32_t iAt, size_t batch_idx ) {
+      XCTask task;
+      generate_task( batcher, ibatch, iAt, task );
 
+      #pragma omp critical
+      temp_tasks.push_back( 
+        std::pair(batch_idx,std::move( task )) 
+      );
     }
+  );
 
+  // Sort based on task index for deterministic ordering
+  std::sort( temp_tasks.begin(), temp_tasks.end(), 
+    []( const auto& a, const auto& b ) {
+      return a.first < b.first;
+    } );
 
-    // Update counters and offsets
-    iCurrent++;
-    batch_idx_offset += nbatches;
-
-  } // Loop over Atoms
+  std::vector< XCTask > local_work;
+  local_work.reserve( temp_tasks.size() );
+  for( auto& [batch_idx, task] : temp_tasks ) 
+    local_work.emplace_back( std::move(task) );
+  temp_tasks.clear();
 
 //return local_work;
 
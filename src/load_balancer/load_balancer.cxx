@@ -46,6 +46,11 @@ void LoadBalancer::rebalance_exx() {
   pimpl_->rebalance_exx();
 }
 
+void LoadBalancer::compact_tasks( double weight_tol ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  pimpl_->compact_tasks( weight_tol );
+}
+
 const util::Timer& LoadBalancer::get_timings() const {
   if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
   return pimpl_->get_timings();
@@ -87,6 +92,10 @@ const LoadBalancer::shell_pair_type& LoadBalancer::shell_pairs() const {
   if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
   return pimpl_->shell_pairs();
 }
+const LoadBalancer::shell_index_type& LoadBalancer::shell_index() const {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->shell_index();
+}
 
 const LoadBalancer::shell_pair_type& LoadBalancer::shell_pairs() {
   if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
@@ -18,6 +18,7 @@ LoadBalancerImpl::LoadBalancerImpl( const RuntimeEnvironment& rt, const Molecule
   molmeta_( molmeta ) { 
 
   basis_map_   = std::make_shared<basis_map_type>(*basis_, mol);
+  shell_index_ = std::make_shared<shell_index_type>(*basis_);
 
 }
 
@@ -36,15 +37,18 @@ LoadBalancerImpl::LoadBalancerImpl( LoadBalancerImpl&& ) noexcept = default;
 LoadBalancerImpl::~LoadBalancerImpl() noexcept = default;
 
 const std::vector<XCTask>& LoadBalancerImpl::get_tasks() const {
-  if( not local_tasks_.size() ) GAUXC_GENERIC_EXCEPTION("No Tasks Created");
+  if( not tasks_created_ ) GAUXC_GENERIC_EXCEPTION("No Tasks Created");
   return local_tasks_;
 }
 
 std::vector<XCTask>& LoadBalancerImpl::get_tasks() {
 
-  if( not local_tasks_.size() ) {
+  // Tasks may legitimately be empty on this rank (e.g. after compaction),
+  // only create them once
+  if( not tasks_created_ ) {
     auto create_tasks_st = std::chrono::high_resolution_clock::now();
     local_tasks_ = create_local_tasks_();
+    tasks_created_ = true;
     auto create_tasks_en = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> create_tasks_dr = create_tasks_en - create_tasks_st; 
     timer_.add_timing("LoadBalancer.CreateTasks", create_tasks_dr);
@@ -120,6 +124,10 @@ const LoadBalancerImpl::shell_pair_type& LoadBalancerImpl::shell_pairs() {
   return *shell_pairs_;
 }
 
+const LoadBalancerImpl::shell_index_type& LoadBalancerImpl::shell_index() const {
+  return *shell_index_;
+}
+
 const RuntimeEnvironment& LoadBalancerImpl::runtime() const {
   return runtime_;
 }
@@ -19,6 +19,7 @@ public:
   using basis_type      = BasisSet<double>;
   using basis_map_type  = BasisSetMap;
   using shell_pair_type = ShellPairCollection<double>;
+  using shell_index_type = ShellSpatialIndex;
 
 protected:
 
@@ -29,8 +30,10 @@ protected:
   std::shared_ptr<MolMeta>    molmeta_;
   std::shared_ptr<basis_map_type> basis_map_;
   std::shared_ptr<shell_pair_type> shell_pairs_;
+  std::shared_ptr<shell_index_type> shell_index_;
 
   std::vector< XCTask >     local_tasks_;
+  bool                      tasks_created_ = false; ///< local_tasks_ may be empty
 
   LoadBalancerState         state_;
 
@@ -61,6 +64,8 @@ public:
   void rebalance_exc_vxc();
   void rebalance_exx();
 
+  void compact_tasks( double weight_tol );
+
   const util::Timer& get_timings() const;
 
   size_t max_npts()       const;
@@ -74,6 +79,7 @@ public:
   const basis_map_type& basis_map() const;
   const shell_pair_type& shell_pairs() const;
   const shell_pair_type& shell_pairs();
+  const shell_index_type& shell_index() const;
 
   LoadBalancerState& state();
 
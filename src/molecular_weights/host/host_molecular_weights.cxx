@@ -30,8 +30,12 @@ void HostMolecularWeights::modify_weights( LoadBalancer& lb ) const {
   // Modify the weights
   const auto& mol  = lb.molecule();
   const auto& meta = lb.molmeta();
-  lwd->partition_weights( this->settings_.weight_alg, mol, meta, 
-    tasks.begin(), tasks.end() );
+  if( this->settings_.atom_screening )
+    lwd->partition_weights_screened( this->settings_.weight_alg, mol, meta, 
+      tasks.begin(), tasks.end() );
+  else
+    lwd->partition_weights( this->settings_.weight_alg, mol, meta, 
+      tasks.begin(), tasks.end() );
 
   lb.state().modified_weights_are_stored = true;
 }
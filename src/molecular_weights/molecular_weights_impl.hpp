@@ -39,6 +39,10 @@ public:
   inline util::Timer& get_timer() {
     return timer_;
   };
+
+  inline const MolecularWeightsSettings& settings() const {
+    return settings_;
+  }
 };
 
 }
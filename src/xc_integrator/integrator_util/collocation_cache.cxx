@@ -0,0 +1,311 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "collocation_cache.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <map>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define GAUXC_COLLOCATION_CACHE_HAS_MMAP
+#endif
+
+namespace GauXC {
+
+// FNV-1a
+static uint64_t fnv1a( const void* ptr, size_t n, 
+  uint64_t h = 14695981039346656037ull ) {
+  auto* c = static_cast<const unsigned char*>(ptr);
+  for( size_t i = 0; i < n; ++i ) {
+    h ^= c[i];
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+struct CollocationCache::signature {
+  int32_t iParent;
+  int32_t npts;
+  uint64_t pts_hash; ///< Hash of all points of the task
+  std::vector<int32_t> shell_list;
+
+  bool operator==( const signature& other ) const {
+    return iParent == other.iParent and npts == other.npts and
+      pts_hash == other.pts_hash and shell_list == other.shell_list;
+  }
+
+  uint64_t hash() const {
+    uint64_t h = fnv1a( &iParent, sizeof(iParent) );
+    h = fnv1a( &npts,     sizeof(npts),     h );
+    h = fnv1a( &pts_hash, sizeof(pts_hash), h );
+    return fnv1a( shell_list.data(), shell_list.size() * sizeof(int32_t), h );
+  }
+};
+
+struct CollocationCache::spill_region {
+  void*  base     = nullptr;
+  size_t capacity = 0;
+  std::map<size_t,size_t> free_ranges; ///< Offset -> bytes of free space
+  mutable std::mutex mtx;
+
+  spill_region( const std::string& fname, size_t sz ) : capacity(sz) {
+#ifdef GAUXC_COLLOCATION_CACHE_HAS_MMAP
+    int fd = open( fname.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600 );
+    if( fd < 0 ) GAUXC_GENERIC_EXCEPTION("Could Not Open Collocation Spill File");
+
+    // The mapping keeps the storage alive, the file need not be visible
+    unlink( fname.c_str() );
+    if( ftruncate( fd, sz ) ) {
+      close(fd);
+      GAUXC_GENERIC_EXCEPTION("Could Not Resize Collocation Spill File");
+    }
+
+    base = mmap( nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close(fd);
+    if( base == MAP_FAILED ) {
+      base = nullptr;
+      GAUXC_GENERIC_EXCEPTION("Could Not Map Collocation Spill File");
+    }
+#else
+    (void)(fname);
+    GAUXC_GENERIC_EXCEPTION("Collocation Spill Requires mmap");
+#endif
+    free_ranges[0] = capacity;
+  }
+
+  ~spill_region() noexcept {
+#ifdef GAUXC_COLLOCATION_CACHE_HAS_MMAP
+    if( base ) munmap( base, capacity );
+#endif
+  }
+
+  /// Copy data into the region (first fit), nullptr if out of space
+  const double* store( const double* data, size_t len ) {
+    const size_t nbytes = len * sizeof(double);
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = std::find_if( free_ranges.begin(), free_ranges.end(),
+      [&]( const auto& r ){ return r.second >= nbytes; } );
+    if( it == free_ranges.end() ) return nullptr;
+
+    const auto [offset, avail] = *it;
+    free_ranges.erase(it);
+    if( avail > nbytes ) free_ranges[offset + nbytes] = avail - nbytes;
+
+    auto* ptr = reinterpret_cast<double*>( static_cast<char*>(base) + offset );
+    std::memcpy( ptr, data, nbytes );
+    return ptr;
+  }
+
+  /// Return the space of stored data to the region
+  void release( const double* ptr, size_t len ) {
+    size_t offset = reinterpret_cast<const char*>(ptr) - 
+      static_cast<const char*>(base);
+    size_t nbytes = len * sizeof(double);
+    std::lock_guard<std::mutex> lock(mtx);
+
+    // Coalesce with the adjacent free ranges
+    auto next = free_ranges.lower_bound(offset);
+    if( next != free_ranges.end() and offset + nbytes == next->first ) {
+      nbytes += next->second;
+      next = free_ranges.erase(next);
+    }
+    if( next != free_ranges.begin() ) {
+      auto prev = std::prev(next);
+      if( prev->first + prev->second == offset ) {
+        offset  = prev->first;
+        nbytes += prev->second;
+        free_ranges.erase(prev);
+      }
+    }
+    free_ranges[offset] = nbytes;
+  }
+
+  bool fits( size_t len ) const {
+    const size_t nbytes = len * sizeof(double);
+    std::lock_guard<std::mutex> lock(mtx);
+    return std::any_of( free_ranges.begin(), free_ranges.end(),
+      [&]( const auto& r ){ return r.second >= nbytes; } );
+  }
+};
+
+// Spilled data is returned to the spill region once the entry and all
+// outstanding handles to it are gone
+struct CollocationCache::entry {
+  signature sig;
+  int nderiv;
+  size_t len;
+  double score;
+  std::shared_ptr<spill_region> spill; ///< Region holding data, if spilled
+  std::unique_ptr<double[]> owned;
+  const double* data = nullptr;
+
+  ~entry() noexcept { if( spill and data ) spill->release( data, len ); }
+
+  bool spilled() const { return bool(spill); }
+  size_t bytes() const { return len * sizeof(double); }
+};
+
+
+CollocationCache::CollocationCache( size_t max_bytes, std::string spill_file,
+  size_t max_spill_bytes ) :
+  max_bytes_(max_bytes), spill_file_(spill_file),
+  max_spill_bytes_(max_spill_bytes) {
+
+  if( spill_file_.size() and max_spill_bytes_ )
+    spill_ = std::make_shared<spill_region>( spill_file_, max_spill_bytes_ );
+
+}
+
+CollocationCache::~CollocationCache() noexcept = default;
+
+bool CollocationCache::has_config( size_t max_bytes,
+  const std::string& spill_file, size_t max_spill_bytes ) const {
+  return max_bytes == max_bytes_ and spill_file == spill_file_ and
+    max_spill_bytes == max_spill_bytes_;
+}
+
+CollocationCache::signature CollocationCache::make_signature(
+  const XCTask& task ) {
+
+  signature sig;
+  sig.iParent    = task.iParent;
+  sig.npts       = task.points.size();
+  sig.pts_hash   = fnv1a( task.points.data(), 
+    task.points.size() * sizeof(task.points[0]) );
+  sig.shell_list = task.bfn_screening.shell_list;
+  return sig;
+
+}
+
+CollocationCache::data_ptr CollocationCache::lookup( const XCTask& task,
+  int nderiv ) {
+
+  const auto sig = make_signature( task );
+  const auto key = sig.hash();
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto it = entries_.find(key);
+  if( it == entries_.end() ) return nullptr;
+
+  const auto& e = it->second;
+  if( not (e->sig == sig) or e->nderiv < nderiv ) return nullptr;
+
+  // Alias the data with the lifetime of the entry
+  return data_ptr( e, e->data );
+
+}
+
+bool CollocationCache::admits( size_t len, double benefit ) const {
+
+  const size_t nbytes = len * sizeof(double);
+  const double score  = benefit / nbytes;
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  if( spill_ and spill_->fits(len) ) return true;
+  if( nbytes > max_bytes_ ) return false;
+
+  // Bytes which may be reclaimed from entries of lower score
+  size_t avail = max_bytes_ - cur_bytes_;
+  for( auto it = in_core_.begin();
+       it != in_core_.end() and avail < nbytes and it->first < score; ++it ) {
+    avail += entries_.at(it->second)->bytes();
+  }
+  return avail >= nbytes;
+
+}
+
+void CollocationCache::evict_( entry_ptr e ) {
+
+  const auto key = e->sig.hash();
+  if( not e->spilled() ) {
+    in_core_.erase( score_key(e->score, key) );
+    cur_bytes_ -= e->bytes();
+  }
+
+  // Outstanding handles keep the evicted data alive, spilled data
+  // is placed in a new entry
+  const double* spill_ptr = nullptr;
+  if( spill_ and not e->spilled() ) spill_ptr = spill_->store( e->data, e->len );
+
+  if( spill_ptr ) {
+    auto s = std::make_shared<entry>();
+    s->sig     = e->sig;
+    s->nderiv  = e->nderiv;
+    s->len     = e->len;
+    s->score   = e->score;
+    s->spill   = spill_;
+    s->data    = spill_ptr;
+    entries_[key] = s;
+  } else {
+    entries_.erase(key);
+  }
+
+}
+
+void CollocationCache::insert( const XCTask& task, int nderiv, size_t len,
+  const double* data, double benefit ) {
+
+  auto e = std::make_shared<entry>();
+  e->sig    = make_signature( task );
+  e->nderiv = nderiv;
+  e->len    = len;
+  e->score  = benefit / e->bytes();
+
+  const auto key = e->sig.hash();
+  const auto nbytes = e->bytes();
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  // Replace existing entries unless they already serve this request
+  auto it = entries_.find(key);
+  if( it != entries_.end() ) {
+    auto& old = it->second;
+    if( old->sig == e->sig and old->nderiv >= nderiv ) return;
+    if( not old->spilled() ) {
+      in_core_.erase( score_key(old->score, key) );
+      cur_bytes_ -= old->bytes();
+    }
+    entries_.erase(it);
+  }
+
+  // Evict lower value entries until the new entry fits
+  while( cur_bytes_ + nbytes > max_bytes_ and in_core_.size() and
+         in_core_.begin()->first < e->score ) {
+    evict_( entries_.at(in_core_.begin()->second) );
+  }
+
+  if( cur_bytes_ + nbytes <= max_bytes_ ) {
+    e->owned = std::unique_ptr<double[]>( new double[len] );
+    std::memcpy( e->owned.get(), data, nbytes );
+    e->data = e->owned.get();
+    cur_bytes_ += nbytes;
+    in_core_.insert( score_key(e->score, key) );
+    entries_[key] = e;
+  } else if( spill_ and (e->data = spill_->store(data, len)) ) {
+    e->spill = spill_;
+    entries_[key] = e;
+  }
+
+}
+
+void CollocationCache::clear() {
+  std::lock_guard<std::mutex> lock(mtx_);
+  entries_.clear();
+  in_core_.clear();
+  cur_bytes_ = 0;
+}
+
+size_t CollocationCache::bytes() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return cur_bytes_;
+}
+
+}
@@ -0,0 +1,125 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/xc_task.hpp>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace GauXC {
+
+/**
+ *  Cache of task collocation matrices which persists across integrator calls
+ *
+ *  The grid, basis and task partitioning stay fixed across SCF iterations,
+ *  so the collocation (and derivatives) of a task may be reused. Entries are
+ *  keyed on a signature of the task (a hash of all of its points + basis 
+ *  screening), stale entries (e.g. after task reorganization) are simply 
+ *  never hit again.
+ *
+ *  Cached data is layout agnostic, but callers must store derivative
+ *  blocks in increasing derivative order such that the collocation of a
+ *  lower derivative order is a prefix of that of a higher one.
+ *
+ *  When the memory budget is exceeded, entries with the smallest estimated
+ *  benefit (work saved) per byte are evicted. Evicted entries are optionally
+ *  spilled to a memory mapped file rather than discarded, the file space of
+ *  spilled entries is reused once they are replaced or cleared (and no 
+ *  longer referenced).
+ *
+ *  All member functions are thread safe.
+ */
+class CollocationCache {
+
+public:
+
+  using data_ptr = std::shared_ptr<const double>;
+
+  /**
+   *  Construct a CollocationCache
+   *
+   *  @param[in] max_bytes       Memory budget of in-core entries
+   *  @param[in] spill_file      Path of the spill file (empty disables spill)
+   *  @param[in] max_spill_bytes Size of the spill file
+   */
+  CollocationCache( size_t max_bytes, std::string spill_file = "",
+    size_t max_spill_bytes = 0 );
+
+  ~CollocationCache() noexcept;
+
+  CollocationCache( const CollocationCache& ) = delete;
+  CollocationCache( CollocationCache&& )      = delete;
+
+  /// Whether this instance was constructed with the passed configuration
+  bool has_config( size_t max_bytes, const std::string& spill_file,
+    size_t max_spill_bytes ) const;
+
+  /**
+   *  Lookup the collocation of a task
+   *
+   *  @param[in] task   Task to lookup
+   *  @param[in] nderiv Required derivative order
+   *  @returns   Pointer to cached data (valid while the handle is held),
+   *             nullptr if not present with at least nderiv derivatives
+   */
+  data_ptr lookup( const XCTask& task, int nderiv );
+
+  /**
+   *  Whether an entry would currently be admitted into the cache
+   *
+   *  Allows callers to skip preparing data for insertion.
+   */
+  bool admits( size_t len, double benefit ) const;
+
+  /**
+   *  Offer the collocation of a task for insertion
+   *
+   *  @param[in] task    Task which generated the collocation
+   *  @param[in] nderiv  Derivative order of data
+   *  @param[in] len     Length of data
+   *  @param[in] data    Collocation data (copied)
+   *  @param[in] benefit Estimated cost of regenerating data
+   */
+  void insert( const XCTask& task, int nderiv, size_t len, const double* data,
+    double benefit );
+
+  /// Drop all entries
+  void clear();
+
+  /// Number of bytes held in core
+  size_t bytes() const;
+
+private:
+
+  struct signature;
+  struct entry;
+  struct spill_region;
+
+  using entry_ptr = std::shared_ptr<entry>;
+  using score_key = std::pair<double, uint64_t>;
+
+  static signature make_signature( const XCTask& task );
+  void evict_( entry_ptr e );
+
+  size_t max_bytes_;
+  size_t cur_bytes_ = 0;
+  std::string spill_file_;
+  size_t max_spill_bytes_;
+
+  std::unordered_map<uint64_t, entry_ptr> entries_;
+  std::set<score_key> in_core_; ///< In-core entries ordered by score
+  std::shared_ptr<spill_region> spill_; ///< Shared with spilled entries
+
+  mutable std::mutex mtx_;
+
+};
+
+}
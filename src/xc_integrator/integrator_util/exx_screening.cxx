@@ -6,7 +6,7 @@
  * See LICENSE.txt for details
  */
 #include "exx_screening.hpp"
-#include "host/blas.hpp"
+#include "integral_bounds.hpp"
 #include <gauxc/util/div_ceil.hpp>
 #include <chrono>
 //#include <mpi.h>
@@ -25,11 +25,32 @@ ostream& operator<<( ostream& out, const vector<T>& v ) {
 
 namespace GauXC {
 
+std::vector<double> exx_shell_pair_v_max( const BasisSet<double>& basis,
+  const ShellPairCollection<double>& shpairs ) {
+
+  const size_t nshells = basis.nshells();
+  std::vector<double> V_max( shpairs.npairs() );
+
+  const auto sp_row_ptr = shpairs.row_ptr();
+  const auto sp_col_ind = shpairs.col_ind();
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t i = 0; i < nshells; ++i ) {
+    const auto j_st = sp_row_ptr[i];
+    const auto j_en = sp_row_ptr[i+1];
+    for( auto _j = j_st; _j < j_en; ++_j ) {
+      const auto j = sp_col_ind[_j];
+      V_max[_j] = util::max_coulomb( basis.at(i), basis.at(j) );
+    }
+  }
+
+  return V_max;
+}
+
 void exx_ek_screening( 
   const BasisSet<double>& basis, const BasisSetMap& basis_map,
   const ShellPairCollection<double>& shpairs,
-  const double* P_abs, size_t ldp, const double* V_shell_max, size_t ldv,
-  double eps_E, double eps_K, LocalHostWorkDriver* lwd, 
+  const double* P, size_t ldp, const double* V_shell_max,
+  double eps_E, double eps_K, double P_tol, LocalHostWorkDriver* lwd, 
   exx_detail::host_task_iterator task_begin,
   exx_detail::host_task_iterator task_end ) {
 
@@ -38,8 +59,19 @@ void exx_ek_screening(
   const size_t nshells = basis.nshells();
   const size_t ntasks  = std::distance(task_begin, task_end);
 
+  // Max bfn values are only stored for the basis functions which survive
+  // the collocation screening of each task (CSR over tasks, ordered as
+  // bfn_screening.shell_list)
+  std::vector<size_t> task_max_bfn_ptr(ntasks+1);
+  task_max_bfn_ptr[0] = 0;
+  for(size_t i_task = 0; i_task < ntasks; ++i_task) {
+    const auto& shell_list_bfn = (task_begin + i_task)->bfn_screening.shell_list;
+    task_max_bfn_ptr[i_task+1] = task_max_bfn_ptr[i_task] +
+      basis.nbf_subset( shell_list_bfn.begin(), shell_list_bfn.end() );
+  }
+
   std::vector<double> task_max_bf_sum(ntasks);
-  std::vector<double> task_max_bfn(nbf * ntasks);
+  std::vector<double> task_max_bfn(task_max_bfn_ptr.back());
 
   //using hrt_t = std::chrono::high_resolution_clock;
   //using dur_t = std::chrono::duration<double>;
@@ -48,7 +80,6 @@ void exx_ek_screening(
   #pragma omp parallel
   { // Scope temp mem
   std::vector<double> basis_eval;
-  std::vector<double> bfn_max_grid(nbf);
 
   #pragma omp for schedule(dynamic)
   for(size_t i_task = 0; i_task < ntasks; ++i_task) {
@@ -61,11 +92,11 @@ void exx_ek_screening(
     const auto* weights     = task.weights.data();
 
     // Basis function shell list
-    auto shell_list_bfn_ = task.bfn_screening.shell_list;
-    int32_t* shell_list_bfn = shell_list_bfn_.data();
+    const auto& shell_list_bfn_ = task.bfn_screening.shell_list;
+    const int32_t* shell_list_bfn = shell_list_bfn_.data();
     size_t nshells_bfn = shell_list_bfn_.size();
     size_t nbe_bfn     = 
-      basis.nbf_subset( shell_list_bfn_.begin(), shell_list_bfn_.end() );
+      task_max_bfn_ptr[i_task+1] - task_max_bfn_ptr[i_task];
 
     // Resize scratch
     basis_eval.resize( nbe_bfn * npts );
@@ -88,7 +119,7 @@ void exx_ek_screening(
     task_max_bf_sum[i_task] = max_bfn_sum;
 
     // Compute max value for each bfn over grid
-    bfn_max_grid.resize(nbe_bfn);
+    auto* bfn_max_grid = task_max_bfn.data() + task_max_bfn_ptr[i_task];
     for( auto ibf = 0ul; ibf < nbe_bfn; ++ibf ) {
       double tmp = 0.;
       for( auto ipt = 0ul; ipt < npts; ++ipt ) {
@@ -100,53 +131,92 @@ void exx_ek_screening(
       bfn_max_grid[ibf] = tmp;
     }
 
-    // Place max bfn into larger array
-    auto task_max_bfn_it = task_max_bfn.data() + i_task*nbf;
-    size_t ibf = 0ul;
-    for( auto i = 0ul; i < nshells_bfn; ++i ) {
-      const auto ish = shell_list_bfn[i];
-      const auto sh_sz = basis_map.shell_size(ish);
-      const auto sh_off = basis_map.shell_to_first_ao(ish);
-
-      for( auto j = 0; j < sh_sz; ++j ) {
-        task_max_bfn_it[j + sh_off] = bfn_max_grid[j + ibf];
-      }
-
-      ibf += sh_sz;
-    }
-
   } // Loop over tasks
   } // Memory Scope
   //auto coll_en = hrt_t::now();
   //std::cout << "... done " << dur_t(coll_en-coll_st).count() << std::endl;
 
-  // Compute approx F_i^(k) = |P_ij| * B_j^(k) 
-  //auto gemm_st = hrt_t::now();
-  std::vector<double> task_approx_f( nbf * ntasks );
-  blas::gemm( 'N', 'N', nbf, ntasks, nbf, 1., P_abs, ldp,
-    task_max_bfn.data(), nbf, 0., task_approx_f.data(), nbf );
-  //auto gemm_en = hrt_t::now();
-  //std::cout << "... done " << dur_t(gemm_en-gemm_st).count() << std::endl;
 
+  // Approximate F bounds (opt-in, P_tol > 0): for each (column) shell, 
+  // the AO row ranges of the shells where max |P| over the block exceeds
+  // P_tol, with adjacent shells merged. The dropped blocks contribute at
+  // most P_tol * sum_j B_j^(k) to any F_i^(k), which is added back below 
+  // such that max_F remains an upper bound of the full sum (the retained 
+  // shell pairs may differ from the exact bound)
+  const bool use_P_rows = P_tol > 0.;
+  std::vector< std::vector<std::pair<size_t,size_t>> > P_rows;
+  if( use_P_rows ) P_rows.resize( nshells );
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t jsh = 0; jsh < P_rows.size(); ++jsh ) {
+    const auto j_sz  = basis_map.shell_size(jsh);
+    const auto j_off = basis_map.shell_to_first_ao(jsh);
+    auto& rows = P_rows[jsh];
+    for( size_t ish = 0; ish < nshells; ++ish ) {
+      const auto i_sz  = basis_map.shell_size(ish);
+      const auto i_off = basis_map.shell_to_first_ao(ish);
+      double P_max = 0.;
+      for( auto j = 0; j < j_sz; ++j ) 
+      for( auto i = 0; i < i_sz; ++i ) {
+        P_max = std::max( P_max, std::abs(P[i_off + i + (j_off + j)*ldp]) );
+      }
+      if( P_max <= P_tol ) continue;
+      if( rows.size() and rows.back().second == size_t(i_off) ) 
+        rows.back().second += i_sz;
+      else rows.emplace_back( i_off, i_off + i_sz );
+    }
+  }
 
   //std::ofstream fmax_file("cpu_fmax." + std::to_string(world_rank) + ".txt");
   //std::cout << "CPU FMAX SHELLS = ";
   //auto list_st = hrt_t::now();
-  #pragma omp parallel for schedule(dynamic)
+  #pragma omp parallel
+  { // Scope temp mem
+  std::vector<uint32_t> task_ek_shells(util::div_ceil(nshells,32));
+  std::vector<double> max_F_shells(nshells);
+  std::vector<double> max_F_approx_bfn(nbf);
+
+  #pragma omp for schedule(dynamic)
   for(size_t i_task = 0; i_task < ntasks; ++i_task) {
     //std::cout << "ITASK = " << i_task << std::endl;
-    std::vector<uint32_t> task_ek_shells(util::div_ceil(nshells,32),0);
-    std::vector<double> max_F_shells(nshells);
+    std::fill( task_ek_shells.begin(), task_ek_shells.end(), 0u );
+
+    // Compute approx F_i^(k) = |P_ij| * B_j^(k), only visiting the
+    // columns j which carry a nonzero B_j^(k) (and the significant
+    // shell blocks of those columns if requested)
+    std::fill( max_F_approx_bfn.begin(), max_F_approx_bfn.end(), 0. );
+    const auto& shell_list_bfn = (task_begin + i_task)->bfn_screening.shell_list;
+    const double* task_max_bfn_it = 
+      task_max_bfn.data() + task_max_bfn_ptr[i_task];
+    double B_sum = 0.;
+    size_t ibf = 0ul;
+    for( auto ish : shell_list_bfn ) {
+      const auto sh_sz  = basis_map.shell_size(ish);
+      const auto sh_off = basis_map.shell_to_first_ao(ish);
+      for( auto j = 0; j < sh_sz; ++j ) {
+        const auto B_j = task_max_bfn_it[ibf + j];
+        if( B_j == 0. ) continue;
+        B_sum += B_j;
+        const double* P_j = P + (sh_off + j)*ldp;
+        if( use_P_rows ) {
+          for( auto [i_st, i_en] : P_rows[ish] )
+          for( auto i = i_st; i < i_en; ++i ) 
+            max_F_approx_bfn[i] += std::abs(P_j[i]) * B_j;
+        } else {
+          for( auto i = 0ul; i < nbf; ++i ) 
+            max_F_approx_bfn[i] += std::abs(P_j[i]) * B_j;
+        }
+      }
+      ibf += sh_sz;
+    }
 
     // Collapse max_F over shells
-    const double* max_F_approx_bfn = task_approx_f.data() + i_task*nbf;
     for( auto ish = 0ul, ibf = 0ul; ish < nshells; ++ish) {
       const auto sh_sz = basis[ish].size();
       double tmp = 0.;
       for( auto i = 0; i < sh_sz; ++i ) {
         tmp = std::max( tmp, std::abs(max_F_approx_bfn[ibf + i]) );
       }
-      max_F_shells[ish] = tmp;
+      max_F_shells[ish] = tmp + P_tol * B_sum;
       ibf += sh_sz;
     }
     //for(auto x : max_F_shells) std::cout << x << " ";
@@ -170,7 +240,7 @@ void exx_ek_screening(
       for(auto _j = row_st; _j < row_en; ++_j)
     {
       const auto j = shpairs.col_ind()[_j];
-      const auto V_ij = V_shell_max[i + j*ldv];
+      const auto V_ij = V_shell_max[_j];
       const auto F_i  = max_F_shells[i];
       const auto F_j  = max_F_shells[j];
 
@@ -209,6 +279,7 @@ void exx_ek_screening(
       basis.nbf_subset( ek_shells.begin(), ek_shells.end() );
 
   } // Loop over tasks
+  } // Memory Scope
   //auto list_en = hrt_t::now();
   //std::cout << "... done " << dur_t(list_en-list_st).count() << std::endl;
 
@@ -239,7 +310,7 @@ void exx_ek_screening(
 void exx_ek_screening( 
   const BasisSet<double>& basis, const BasisSetMap& basis_map,
   const ShellPairCollection<double>& shpairs,
-  const double* P_abs, size_t ldp, const double* V_shell_max, size_t ldv,
+  const double* P_abs, size_t ldp, const double* V_shell_max,
   double eps_E, double eps_K, XCDeviceData& device_data, 
   LocalDeviceWorkDriver* lwd, 
   exx_detail::host_task_iterator task_begin,
@@ -256,7 +327,7 @@ void exx_ek_screening(
   device_data.allocate_static_data_exx_ek_screening( ntasks, nbf, nshells, 
     shpairs.npairs(), basis_map.max_l() );
   device_data.send_static_data_density_basis( P_abs, ldp, nullptr, 0, nullptr, 0, nullptr, 0,  basis );
-  device_data.send_static_data_exx_ek_screening( V_shell_max, ldv, basis_map,
+  device_data.send_static_data_exx_ek_screening( V_shell_max, basis_map,
     shpairs );
 
   integrator_term_tracker enabled_terms;
@@ -18,11 +18,28 @@ namespace exx_detail {
   using host_task_iterator  = typename host_task_container::iterator;
 }
 
+/**
+ *  Upper bounds of the point Coulomb integrals (util::max_coulomb) for the
+ *  shell pairs in shpairs, stored on its CSR pattern: V[_j] bounds the pair
+ *  (i, col_ind[_j]) for row_ptr[i] <= _j < row_ptr[i+1]
+ */
+std::vector<double> exx_shell_pair_v_max( const BasisSet<double>& basis,
+  const ShellPairCollection<double>& shpairs );
+
+/**
+ *  sn-LinK EK screening on the host
+ *
+ *  V_shell_max is stored on the CSR pattern of shpairs (see
+ *  exx_shell_pair_v_max). Only the columns of P spanned by the basis
+ *  functions of each task are referenced. If P_tol > 0, shell blocks of P
+ *  below P_tol are dropped from the F bounds, which are inflated by the
+ *  dropped bound (see IntegratorSettingsSNLinK::approx_f_p_tol).
+ */
 void exx_ek_screening( 
   const BasisSet<double>& basis, const BasisSetMap& basis_map,
   const ShellPairCollection<double>& shpairs,
-  const double* P_abs, size_t ldp, const double* V_shell_max, size_t ldv,
-  double eps_E, double eps_K, LocalHostWorkDriver* lwd, 
+  const double* P, size_t ldp, const double* V_shell_max,
+  double eps_E, double eps_K, double P_tol, LocalHostWorkDriver* lwd, 
   exx_detail::host_task_iterator task_begin,
   exx_detail::host_task_iterator task_end );
 
@@ -30,7 +47,7 @@ void exx_ek_screening(
 void exx_ek_screening( 
   const BasisSet<double>& basis, const BasisSetMap& basis_map,
   const ShellPairCollection<double>& shpairs,
-  const double* P_abs, size_t ldp, const double* V_shell_max, size_t ldv,
+  const double* P_abs, size_t ldp, const double* V_shell_max,
   double eps_E, double eps_K, XCDeviceData& device_data, 
   LocalDeviceWorkDriver* lwd, 
   exx_detail::host_task_iterator task_begin,
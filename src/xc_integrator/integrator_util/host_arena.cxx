@@ -0,0 +1,120 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "host_arena.hpp"
+#include <gauxc/exceptions.hpp>
+#include <cstdlib>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#define GAUXC_HOST_ARENA_HAS_MMAP
+#endif
+
+namespace GauXC {
+
+namespace {
+  constexpr size_t huge_page_size = 2ul << 20;
+}
+
+void HostArena::heap_deleter::operator()( void* p ) const noexcept {
+  std::free(p);
+}
+
+HostArena::HostArena( size_t bytes ) {
+  reserve( bytes );
+}
+
+HostArena::~HostArena() noexcept {
+  unmap_();
+}
+
+void HostArena::unmap_() noexcept {
+  if( not base_ ) return;
+#ifdef GAUXC_HOST_ARENA_HAS_MMAP
+  if( mapped_ ) munmap( base_, capacity_ );
+  else
+#endif
+  std::free( base_ );
+  base_     = nullptr;
+  capacity_ = 0;
+  mapped_   = false;
+}
+
+void HostArena::reserve( size_t bytes ) {
+
+  if( bytes <= capacity_ ) return;
+  if( offset_ or overflow_.size() )
+    GAUXC_GENERIC_EXCEPTION("Cannot Grow HostArena With Outstanding Allocations");
+
+  unmap_();
+
+  // Large arenas are rounded to (and advised to be backed by) huge pages.
+  // Pages are not touched here, they are faulted in by the first thread
+  // to write them
+  bytes = aligned_size<char>( bytes );
+#ifdef GAUXC_HOST_ARENA_HAS_MMAP
+  if( bytes >= huge_page_size ) {
+    bytes = ((bytes + huge_page_size - 1) / huge_page_size) * huge_page_size;
+    void* ptr = mmap( nullptr, bytes, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if( ptr != MAP_FAILED ) {
+#ifdef MADV_HUGEPAGE
+      madvise( ptr, bytes, MADV_HUGEPAGE );
+#endif
+      base_     = ptr;
+      capacity_ = bytes;
+      mapped_   = true;
+      return;
+    }
+  }
+#endif
+
+  base_ = std::aligned_alloc( alignment, bytes );
+  if( not base_ ) GAUXC_GENERIC_EXCEPTION("HostArena Allocation Failed");
+  capacity_ = bytes;
+
+}
+
+void* HostArena::allocate_bytes_( size_t bytes ) {
+
+  if( not bytes ) return nullptr;
+  bytes = aligned_size<char>( bytes );
+
+  if( offset_ + bytes <= capacity_ ) {
+    void* ptr = static_cast<char*>(base_) + offset_;
+    offset_ += bytes;
+    return ptr;
+  }
+
+  void* ptr = std::aligned_alloc( alignment, bytes );
+  if( not ptr ) GAUXC_GENERIC_EXCEPTION("HostArena Allocation Failed");
+  overflow_.emplace_back( ptr );
+  noverflow_++;
+  return ptr;
+
+}
+
+void HostArena::release( marker m ) {
+  offset_ = m.offset;
+  overflow_.resize( m.noverflow );
+}
+
+void HostArena::shrink( size_t bytes ) {
+
+  if( offset_ or overflow_.size() )
+    GAUXC_GENERIC_EXCEPTION("Cannot Shrink HostArena With Outstanding Allocations");
+
+  if( capacity_ > bytes ) unmap_();
+
+}
+
+HostArena& HostArena::thread_arena() {
+  static thread_local HostArena arena;
+  return arena;
+}
+
+}
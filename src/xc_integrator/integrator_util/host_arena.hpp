@@ -0,0 +1,125 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace GauXC {
+
+/**
+ *  Bump allocator for host scratch memory
+ *
+ *  Host analogue of buffer_adaptor: a single (optionally huge page backed)
+ *  mapping from which aligned, uninitialized scratch is carved by advancing
+ *  an offset. Allocations are released in LIFO order by rewinding to a
+ *  previously recorded mark, typically through HostArena::scope.
+ *
+ *  Each thread is expected to own its arena (see thread_arena), pages are
+ *  first touched by the owning thread and are thus NUMA local to it.
+ *
+ *  Requests which do not fit in the reserved mapping are served from the
+ *  heap and released with the enclosing mark, such that kernels need not
+ *  know whether their caller sized the arena. The number of such requests
+ *  is tracked to allow callers to verify their sizing.
+ */
+class HostArena {
+
+  void*  base_     = nullptr; ///< Base of the mapping
+  size_t capacity_ = 0;       ///< Size of the mapping
+  size_t offset_   = 0;       ///< Current top of the arena
+  bool   mapped_   = false;   ///< Whether base_ was obtained from mmap
+
+  struct heap_deleter { void operator()( void* p ) const noexcept; };
+
+  /// Heap allocations which did not fit in the mapping
+  std::vector< std::unique_ptr<void, heap_deleter> > overflow_;
+  size_t noverflow_ = 0; ///< Total number of overflow allocations
+
+  void* allocate_bytes_( size_t bytes );
+  void  unmap_() noexcept;
+
+public:
+
+  /// Alignment of all allocations (cache line)
+  static constexpr size_t alignment = 64;
+
+  /// Size in bytes of a single allocation of n objects of type T
+  template <typename T>
+  static constexpr size_t aligned_size( size_t n ) {
+    return ((n * sizeof(T) + alignment - 1) / alignment) * alignment;
+  }
+
+  /// Construct an arena of a given capacity (bytes)
+  explicit HostArena( size_t bytes = 0 );
+
+  ~HostArena() noexcept;
+
+  HostArena( const HostArena& ) = delete;
+  HostArena( HostArena&& )      = delete;
+
+  /**
+   *  Ensure the capacity of the arena is at least bytes
+   *
+   *  Grows the mapping (contents are not preserved), may only be called
+   *  when no allocations are outstanding.
+   */
+  void reserve( size_t bytes );
+
+  /// Allocate uninitialized, aligned storage for n objects of type T
+  template <typename T>
+  T* allocate( size_t n ) {
+    return static_cast<T*>( allocate_bytes_( n * sizeof(T) ) );
+  }
+
+  /// State of the arena to which allocations may be rewound
+  struct marker {
+    size_t offset;
+    size_t noverflow;
+  };
+
+  /// Current top of the arena
+  inline marker mark() const { return marker{ offset_, overflow_.size() }; }
+
+  /// Release all allocations made since a mark was recorded
+  void release( marker m );
+
+  /// Release all allocations
+  inline void release_all() { release( marker{ 0, 0 } ); }
+
+  /**
+   *  Drop the mapping if its capacity exceeds bytes
+   *
+   *  Returns the scratch of a (large) task loop to the system once it is
+   *  done, may only be called when no allocations are outstanding.
+   */
+  void shrink( size_t bytes = 0 );
+
+  inline size_t capacity() const { return capacity_; }
+  inline size_t used()     const { return offset_;   }
+
+  /// Number of requests that were served from the heap
+  inline size_t overflow_count() const { return noverflow_; }
+
+  /// RAII mark / release
+  class scope {
+    HostArena& arena_;
+    marker     mark_;
+  public:
+    inline scope( HostArena& arena ) : arena_(arena), mark_(arena.mark()) { }
+    inline ~scope() noexcept { arena_.release(mark_); }
+    scope( const scope& ) = delete;
+  };
+
+  /// Arena owned by the calling thread
+  static HostArena& thread_arena();
+
+};
+
+}
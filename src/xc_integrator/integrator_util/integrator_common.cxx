@@ -141,4 +141,28 @@ std::tuple< std::vector< std::array<int32_t, 3> > , std::vector< int32_t > >
 
 
 
+void gen_compressed_submat_map( const BasisSetMap&            basis_map,
+                                const std::vector< int32_t >& shell_list,
+                                std::vector< std::array<int32_t, 3> >& submat_map ) {
+
+  submat_map.clear();
+
+  // One cut per run of consecutive shells
+  int32_t small_index = 0;
+  for( auto sh_it = shell_list.begin(); sh_it != shell_list.end(); ) {
+
+    auto run_end = sh_it + 1;
+    while( run_end != shell_list.end() and *run_end - *(run_end-1) == 1 ) 
+      ++run_end;
+
+    const int32_t cut_start = basis_map.shell_to_ao_range( *sh_it ).first;
+    const int32_t cut_end   = basis_map.shell_to_ao_range( *(run_end-1) ).second;
+    submat_map.push_back({cut_start, cut_end - cut_start, small_index});
+    small_index += cut_end - cut_start;
+
+    sh_it = run_end;
+  }
+
+}
+
 }
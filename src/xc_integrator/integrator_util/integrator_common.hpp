@@ -16,5 +16,12 @@ std::tuple< std::vector< std::array<int32_t, 3> >, std::vector< int32_t > >
                              const std::vector< int32_t >& shell_mask,
 		             const int32_t LDA, const int32_t block_size ); 
 
+/// Compressed submatrix map of a shell list without block splitting 
+/// (block_size = LDA above), written to a caller owned map whose storage 
+/// is reused
+void gen_compressed_submat_map( const BasisSetMap&            basis_map,
+                                const std::vector< int32_t >& shell_list,
+                                std::vector< std::array<int32_t, 3> >& submat_map );
+
 
 }
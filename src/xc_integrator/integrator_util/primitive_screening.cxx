@@ -0,0 +1,93 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "primitive_screening.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace GauXC {
+
+PrimitiveScreening::PrimitiveScreening( const BasisSet<double>& basis, 
+  const std::vector<int32_t>& shell_list, size_t npts, const double* points,
+  double tol, int deriv ) : tol_(tol) {
+
+  // Bounding box of the task
+  std::array<double,3> lo, up;
+  lo.fill(  std::numeric_limits<double>::infinity() );
+  up.fill( -std::numeric_limits<double>::infinity() );
+  for( size_t ipt = 0; ipt < npts; ++ipt )
+  for( int k = 0; k < 3; ++k ) {
+    lo[k] = std::min( lo[k], points[3*ipt + k] );
+    up[k] = std::max( up[k], points[3*ipt + k] );
+  }
+
+  shell_list_.reserve( shell_list.size() );
+  prim_ptr_.reserve( shell_list.size() + 1 );
+  prim_ptr_.emplace_back( 0 );
+
+  std::vector<double> poly, dpoly;
+
+  for( auto ish : shell_list ) {
+
+    const auto& sh = basis.at(ish);
+    const auto* O  = sh.O_data();
+    const int   l  = sh.l();
+
+    // Squared distance from the shell center to the box
+    double d2 = 0.;
+    for( int k = 0; k < 3; ++k ) {
+      const double dk = std::max( { lo[k] - O[k], 0., O[k] - up[k] } );
+      d2 += dk * dk;
+    }
+
+    // Each derivative maps a term r^p exp(-a r^2) of the bound to (at most)
+    // p r^(p-1) + 2a r^(p+1) times exp(-a r^2), the Laplacian is bounded
+    // by three times the bound of the second derivatives. r^p exp(-a r^2)
+    // decreases for r^2 > p / (2a), the maximum of each term over the box 
+    // is attained at the closest point beyond that radius
+    const size_t nprim_old = alpha_.size();
+    for( int32_t p = 0; p < sh.nprim(); ++p ) {
+      const double a  = sh.alpha_data()[p];
+      const double c  = sh.coeff_data()[p];
+
+      // Coefficients of r^0 ... r^(l+deriv)
+      poly.assign( l + deriv + 1, 0. ); poly[l] = 1.;
+      for( int n = 0; n < deriv; ++n ) {
+        dpoly.assign( l + deriv + 1, 0. );
+        for( int k = 0; k <= l + n; ++k ) if( poly[k] != 0. ) {
+          if( k ) dpoly[k-1] += k * poly[k];
+          dpoly[k+1] += 2. * a * poly[k];
+        }
+        poly.swap( dpoly );
+      }
+      if( deriv > 1 ) for( auto& b : poly ) b *= 3.;
+
+      double bound = 0.;
+      for( int k = 0; k <= l + deriv; ++k ) if( poly[k] != 0. ) {
+        const double r2 = std::max( d2, 0.5 * k / a );
+        bound += poly[k] * std::pow(r2, 0.5*k) * std::exp(-a*r2);
+      }
+      bound *= std::abs(c);
+
+      if( bound > tol ) {
+        alpha_.emplace_back( a );
+        coeff_.emplace_back( c );
+      }
+    }
+
+    if( alpha_.size() == nprim_old ) continue;
+    shell_list_.emplace_back( ish );
+    prim_ptr_.emplace_back( alpha_.size() );
+    nbe_ += sh.size();
+
+  }
+
+}
+
+}
@@ -0,0 +1,95 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/basisset.hpp>
+#include <vector>
+
+namespace GauXC {
+
+/**
+ *  Primitive screening of the shells of a task
+ *
+ *  Retains, for each shell of a task, the primitives for which a bound of
+ *  the primitive, |c| r^l exp(-a r^2), or of its derivatives up to a given
+ *  order over the bounding box of the task points exceeds a tolerance. 
+ *  Shells without any significant primitive are removed from
+ *  the shell list (and hence from the packed basis functions of the task).
+ *
+ *  Retained primitives are stored contiguously (CSR) and are indexed by the
+ *  position of the shell in shell_list().
+ */
+class PrimitiveScreening {
+
+  double               tol_;        ///< Screening tolerance
+  std::vector<int32_t> shell_list_; ///< Shells with significant primitives
+  size_t               nbe_ = 0;    ///< Number of basis functions in shell_list_
+  std::vector<int32_t> prim_ptr_;   ///< CSR pointer into alpha_ / coeff_
+  std::vector<double>  alpha_;      ///< Retained exponents
+  std::vector<double>  coeff_;      ///< Retained (normalized) coefficients
+
+public:
+
+  /**
+   *  Screen the primitives of a task
+   *
+   *  @param[in] basis      Basis set
+   *  @param[in] shell_list Shells of the task (e.g. bfn_screening.shell_list)
+   *  @param[in] npts       Number of points of the task
+   *  @param[in] points     Points of the task (AoS, 3*npts)
+   *  @param[in] tol        Primitive screening tolerance
+   *  @param[in] deriv      Derivative order of the collocation (2 also 
+   *                        covers the Laplacian)
+   */
+  PrimitiveScreening( const BasisSet<double>& basis, 
+    const std::vector<int32_t>& shell_list, size_t npts, const double* points,
+    double tol, int deriv = 0 );
+
+  inline double tol() const { return tol_; }
+
+  inline const std::vector<int32_t>& shell_list() const { return shell_list_; }
+  inline size_t nshells() const { return shell_list_.size(); }
+  inline size_t nbe()     const { return nbe_;               }
+
+  /// Total number of retained primitives
+  inline size_t nprim_total() const { return alpha_.size(); }
+
+  inline int32_t nprim( size_t i ) const { 
+    return prim_ptr_[i+1] - prim_ptr_[i]; 
+  }
+  inline const double* alpha_data( size_t i ) const { 
+    return alpha_.data() + prim_ptr_[i]; 
+  }
+  inline const double* coeff_data( size_t i ) const { 
+    return coeff_.data() + prim_ptr_[i]; 
+  }
+
+};
+
+/// Primitives of a shell to be evaluated by a collocation kernel
+struct PrimitiveView {
+  int32_t       nprim;
+  const double* alpha;
+  const double* coeff;
+};
+
+/**
+ *  Primitives of the i-th shell of a task
+ *
+ *  @param[in] sh    Shell
+ *  @param[in] prims Primitive screening of the task, all primitives of sh
+ *                   are returned if null
+ *  @param[in] i     Position of sh in the shell list of the task
+ */
+inline PrimitiveView task_primitives( const Shell<double>& sh, 
+  const PrimitiveScreening* prims, size_t i ) {
+  if( prims ) return { prims->nprim(i), prims->alpha_data(i), prims->coeff_data(i) };
+  return { sh.nprim(), sh.alpha_data(), sh.coeff_data() };
+}
+
+}
@@ -0,0 +1,156 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "shell_block_screening.hpp"
+#include <cmath>
+
+namespace GauXC {
+
+ShellBlockScreening::ShellBlockScreening( const BasisSetMap& basis_map, 
+  const double* A, size_t lda, double tol ) : 
+  ShellBlockScreening( basis_map, 1, &A, &lda, tol ) { }
+
+ShellBlockScreening::ShellBlockScreening( const BasisSetMap& basis_map, 
+  size_t nmat, const double* const* A, const size_t* lda, double tol ) :
+  tol_(tol) {
+
+  const int32_t nshells = basis_map.shell_sizes().size();
+  std::vector< std::vector<int32_t> > row_cols( nshells );
+
+  #pragma omp parallel for schedule(dynamic)
+  for( int32_t i = 0; i < nshells; ++i ) {
+    const auto i_st = basis_map.shell_to_first_ao(i);
+    const auto i_sz = basis_map.shell_size(i);
+    for( int32_t j = 0; j < nshells; ++j ) {
+      const auto j_st = basis_map.shell_to_first_ao(j);
+      const auto j_sz = basis_map.shell_size(j);
+
+      double max_abs = 0.;
+      for( size_t k = 0; k < nmat; ++k )
+      for( int32_t jj = 0; jj < j_sz; ++jj )
+      for( int32_t ii = 0; ii < i_sz; ++ii ) {
+        max_abs = std::max( max_abs, 
+          std::abs( A[k][ (i_st+ii) + (j_st+jj)*lda[k] ] ) );
+      }
+
+      if( max_abs > tol ) row_cols[i].emplace_back(j);
+    }
+  }
+
+  row_ptr_.resize( nshells + 1 );
+  row_ptr_[0] = 0;
+  for( int32_t i = 0; i < nshells; ++i )
+    row_ptr_[i+1] = row_ptr_[i] + row_cols[i].size();
+
+  col_ind_.reserve( row_ptr_.back() );
+  for( auto& cols : row_cols )
+    col_ind_.insert( col_ind_.end(), cols.begin(), cols.end() );
+
+}
+
+
+
+ShellBlockPattern::range ShellBlockPattern::make_range_( int32_t blk_st,
+  int32_t blk_en ) const {
+
+  const auto& first = blocks_[blk_st];
+  const auto& last  = blocks_[blk_en];
+  const int32_t nbf = last.ao_cmp + last.nbf - first.ao_cmp;
+  return range{ blk_st, blk_en, first.ao_st, first.ao_cmp, nbf,
+    last.ao_st + last.nbf - first.ao_st == nbf };
+
+}
+
+void ShellBlockPattern::build( const BasisSetMap& basis_map, size_t nshells,
+  const int32_t* shell_list, const ShellBlockScreening& screen ) {
+
+  blocks_.clear();
+  runs_.clear();
+  groups_.clear();
+  max_panel_ = 0;
+
+  // Runs of shells which are contiguous in the full basis and share a
+  // center, capped in size such that screening remains effective
+  int32_t ao_cmp = 0;
+  for( size_t i = 0; i < nshells; ++i ) {
+    const auto ish = shell_list[i];
+    const auto sz  = basis_map.shell_size(ish);
+    auto* last = blocks_.size() ? &blocks_.back() : nullptr;
+    if( last and last->sh_en + 1 == ish and 
+        basis_map.shell_to_center(ish) == basis_map.shell_to_center(last->sh_en) and
+        last->nbf + sz <= max_block_nbf ) {
+      last->sh_en = ish;
+      last->nbf  += sz;
+    } else {
+      blocks_.push_back( 
+        block{ ish, ish, basis_map.shell_to_first_ao(ish), ao_cmp, sz } );
+    }
+    ao_cmp += sz;
+  }
+
+  shell_block_.resize( screen.nshells(), -1 );
+  const int32_t nblocks = blocks_.size();
+  for( int32_t b = 0; b < nblocks; ++b )
+  for( auto ish = blocks_[b].sh_st; ish <= blocks_[b].sh_en; ++ish )
+    shell_block_[ish] = b;
+
+  const auto* row_ptr = screen.row_ptr();
+  const auto* col_ind = screen.col_ind();
+  for( int32_t iI = 0; iI < nblocks; ++iI ) {
+
+    // Significant column blocks of the row block
+    col_blocks_.clear();
+    for( auto ish = blocks_[iI].sh_st; ish <= blocks_[iI].sh_en; ++ish )
+    for( auto _j = row_ptr[ish]; _j < row_ptr[ish+1]; ++_j ) {
+      const auto iJ = shell_block_[col_ind[_j]];
+      if( iJ >= 0 ) col_blocks_.emplace_back( iJ );
+    }
+    std::sort( col_blocks_.begin(), col_blocks_.end() );
+    col_blocks_.erase( std::unique( col_blocks_.begin(), col_blocks_.end() ),
+      col_blocks_.end() );
+
+    // Merge consecutive blocks into runs
+    const int32_t run_st = runs_.size();
+    for( size_t k = 0; k < col_blocks_.size(); ) {
+      size_t l = k;
+      while( l + 1 < col_blocks_.size() and col_blocks_[l+1] == col_blocks_[l] + 1 ) ++l;
+      runs_.emplace_back( make_range_( col_blocks_[k], col_blocks_[l] ) );
+      k = l + 1;
+    }
+    const int32_t run_en = runs_.size();
+
+    // Extend the previous row group if its runs are the same
+    if( groups_.size() ) {
+      auto& g = groups_.back();
+      const bool same_runs = g.run_en - g.run_st == run_en - run_st and
+        std::equal( runs_.begin() + g.run_st, runs_.begin() + g.run_en,
+          runs_.begin() + run_st, []( const range& a, const range& b ) {
+            return a.blk_st == b.blk_st and a.blk_en == b.blk_en;
+          } );
+      if( g.rows.blk_en + 1 == iI and same_runs ) {
+        g.rows = make_range_( g.rows.blk_st, iI );
+        runs_.resize( run_st );
+        continue;
+      }
+    }
+
+    groups_.push_back( row_group{ make_range_( iI, iI ), run_st, run_en } );
+
+  }
+
+  for( const auto& g : groups_ )
+  for( auto ir = g.run_st; ir < g.run_en; ++ir )
+    max_panel_ = std::max( max_panel_, size_t(g.rows.nbf) * runs_[ir].nbf );
+
+  // Reset the block map for the next task
+  for( const auto& b : blocks_ )
+  for( auto ish = b.sh_st; ish <= b.sh_en; ++ish )
+    shell_block_[ish] = -1;
+
+}
+
+}
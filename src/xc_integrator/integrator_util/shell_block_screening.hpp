@@ -0,0 +1,144 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/basisset_map.hpp>
+#include <algorithm>
+
+namespace GauXC {
+
+/**
+ *  Shell block sparsity pattern of (nbf,nbf) matrices
+ *
+ *  Stores, in CSR format, the shell pairs (i,j) for which max|A| over the
+ *  corresponding block of any of the matrices exceeds a tolerance. Column
+ *  indices are sorted within each row.
+ */
+class ShellBlockScreening {
+
+  double               tol_;     ///< Screening tolerance
+  std::vector<int32_t> row_ptr_; ///< CSR row pointer (nshells+1)
+  std::vector<int32_t> col_ind_; ///< CSR column indices
+
+public:
+
+  /**
+   *  Construct the sparsity pattern of a matrix
+   *
+   *  @param[in] basis_map Map of the basis of the matrix
+   *  @param[in] A         Matrix (col major)
+   *  @param[in] lda       Leading dimension of A
+   *  @param[in] tol       Blocks with max|A| <= tol are considered negligible
+   */
+  ShellBlockScreening( const BasisSetMap& basis_map, const double* A, 
+    size_t lda, double tol );
+
+  /**
+   *  Construct the union of the sparsity patterns of several matrices
+   *
+   *  @param[in] basis_map Map of the basis of the matrices
+   *  @param[in] nmat      Number of matrices
+   *  @param[in] A         Matrices (col major)
+   *  @param[in] lda       Leading dimensions of A
+   *  @param[in] tol       Blocks with max|A| <= tol are considered negligible
+   */
+  ShellBlockScreening( const BasisSetMap& basis_map, size_t nmat,
+    const double* const* A, const size_t* lda, double tol );
+
+  inline double tol()     const { return tol_; }
+  inline size_t nshells() const { return row_ptr_.size() - 1; }
+  inline size_t nnz()     const { return col_ind_.size(); }
+
+  inline const int32_t* row_ptr() const { return row_ptr_.data(); }
+  inline const int32_t* col_ind() const { return col_ind_.data(); }
+
+  /// Whether any block (i,j), j in [j_st, j_en], is significant
+  inline bool any_significant( int32_t i, int32_t j_st, int32_t j_en ) const {
+    const auto* c_st = col_ind_.data() + row_ptr_[i];
+    const auto* c_en = col_ind_.data() + row_ptr_[i+1];
+    const auto* it = std::lower_bound( c_st, c_en, j_st );
+    return it != c_en and *it <= j_en;
+  }
+
+};
+
+/**
+ *  Shell block pattern of a task for the screened X matrix GEMMs
+ *
+ *  Shells of the task which are contiguous in the full basis and share a
+ *  center are grouped into blocks (of at most max_block_nbf functions).
+ *  For each row block, the significant column blocks are merged into runs
+ *  of consecutive blocks, consecutive row blocks with the same runs are
+ *  merged into row groups. Each (row group, run) pair then maps onto a
+ *  single GEMM with the collocation.
+ *
+ *  The pattern is built from the CSR rows of the task's shells, its cost
+ *  is linear in the number of significant shell pairs. Instances may be
+ *  rebuilt for each task, reusing their storage.
+ */
+class ShellBlockPattern {
+
+public:
+
+  static constexpr int32_t max_block_nbf = 64;
+
+  /// Shells [sh_st, sh_en] starting at ao_st (full) / ao_cmp (compressed)
+  struct block {
+    int32_t sh_st, sh_en;
+    int32_t ao_st, ao_cmp;
+    int32_t nbf;
+  };
+
+  /// Consecutive blocks [blk_st, blk_en], contiguous in the compressed
+  /// basis. If contiguous in the full basis, P is referenced in place
+  struct range {
+    int32_t blk_st, blk_en;
+    int32_t ao_st, ao_cmp;
+    int32_t nbf;
+    bool    contiguous;
+  };
+
+  /// Rows of the group and its column runs runs()[run_st, run_en)
+  struct row_group {
+    range   rows;
+    int32_t run_st, run_en;
+  };
+
+  /**
+   *  Build the pattern of a task
+   *
+   *  @param[in] basis_map  Map of the full basis
+   *  @param[in] nshells    The number of shells of the task
+   *  @param[in] shell_list The list of shells of the task
+   *  @param[in] screen     Shell block sparsity pattern of P
+   */
+  void build( const BasisSetMap& basis_map, size_t nshells, 
+    const int32_t* shell_list, const ShellBlockScreening& screen );
+
+  inline const std::vector<block>&     blocks() const { return blocks_; }
+  inline const std::vector<range>&     runs()   const { return runs_;   }
+  inline const std::vector<row_group>& groups() const { return groups_; }
+
+  /// Largest (row group, run) panel of P
+  inline size_t max_panel() const { return max_panel_; }
+
+private:
+
+  std::vector<block>     blocks_;
+  std::vector<range>     runs_;
+  std::vector<row_group> groups_;
+  size_t max_panel_ = 0;
+
+  std::vector<int32_t> shell_block_; ///< Block of each shell (-1 if absent)
+  std::vector<int32_t> col_blocks_;  ///< Significant blocks of a row block
+
+  range make_range_( int32_t blk_st, int32_t blk_en ) const;
+
+};
+
+}
@@ -0,0 +1,207 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "host/fused_local_host_work_driver.hpp"
+#include "host/util.hpp"
+#include "host/blas.hpp"
+#include "integrator_util/host_arena.hpp"
+#include <gauxc/exceptions.hpp>
+#include <algorithm>
+
+namespace GauXC {
+
+FusedLocalHostWorkDriver::FusedLocalHostWorkDriver( size_t cache_bytes ) :
+  ReferenceLocalHostWorkDriver(), cache_bytes_(cache_bytes) { }
+
+FusedLocalHostWorkDriver::~FusedLocalHostWorkDriver() noexcept = default;
+
+bool FusedLocalHostWorkDriver::supports_fused_exc_vxc() const { return true; }
+
+size_t FusedLocalHostWorkDriver::point_block_size( size_t npts, size_t nbe,
+  size_t nmat ) const {
+
+  // Keep blocks a multiple of the SIMD width
+  constexpr size_t block_align = 8;
+  size_t nb = cache_bytes_ / (sizeof(double) * std::max<size_t>(nbe,1) * nmat);
+  nb = std::max( block_align, nb - nb % block_align );
+  return std::min( nb, npts );
+
+}
+
+void FusedLocalHostWorkDriver::eval_exc_vxc_fused( const functional_type& func,
+  size_t npts, size_t nbf, size_t nbe, size_t nshells, const double* points, 
+  const double* weights, const BasisSet<double>& basis, 
+  const int32_t* shell_list, const submat_map_t& submat_map, 
+  const double* Ps, size_t ldps, const double* Pz, size_t ldpz, 
+  double* VXCs, double* VXCz, double* EXC, double* N_EL ) {
+
+  if( func.is_mgga() )
+    GAUXC_GENERIC_EXCEPTION("Fused EXC/VXC Not Implemented For MGGA");
+
+  const bool is_uks      = Pz != nullptr;
+  const bool is_gga      = func.is_gga();
+  const bool is_exc_only = VXCs == nullptr;
+  if( is_uks and not is_exc_only and not VXCz )
+    GAUXC_GENERIC_EXCEPTION("Fused EXC/VXC Requires VXCz For UKS");
+
+  const size_t nspin  = is_uks ? 2 : 1;
+  const size_t nbasis = is_gga ? 4 : 1; // basis + gradient
+  const size_t ngamma = is_uks ? 3 : 1;
+
+  *EXC  = 0.;
+  *N_EL = 0.;
+  if( not npts ) {
+    if( VXCs ) std::fill_n( VXCs, nbe*nbe, 0. );
+    if( VXCz and is_uks ) std::fill_n( VXCz, nbe*nbe, 0. );
+    return;
+  }
+
+  auto& arena = HostArena::thread_arena();
+  HostArena::scope task_scope( arena );
+
+  // Compressed density matrices, formed once per task
+  auto* P_scr = submat_map.size() > 1 ? 
+    arena.allocate<double>( nspin*nbe*nbe ) : nullptr;
+  auto compress_P = [&]( const double* P, size_t ldp, double* scr ) {
+    if( submat_map.size() > 1 ) {
+      detail::submat_set( nbf, nbf, nbe, nbe, P, ldp, scr, nbe, submat_map );
+      return std::make_pair( (const double*)scr, nbe );
+    } else if( nbe != nbf ) {
+      return std::make_pair( P + submat_map[0][0]*(ldp+1), ldp );
+    }
+    return std::make_pair( P, ldp );
+  };
+
+  const auto [Ps_use, ldps_use] = compress_P( Ps, ldps, P_scr );
+  const double* Pz_use = nullptr; size_t ldpz_use = 0;
+  if( is_uks ) std::tie(Pz_use, ldpz_use) = 
+    compress_P( Pz, ldpz, P_scr ? P_scr + nbe*nbe : nullptr );
+
+  // Block working set: collocation + X/Z per spin
+  const size_t nb_max = point_block_size( npts, nbe, nbasis + nspin );
+  auto* basis_scr  = arena.allocate<double>( nbasis * nbe * nb_max );
+  auto* xmat_scr   = arena.allocate<double>( nspin  * nbe * nb_max );
+  auto* den_scr    = arena.allocate<double>( nspin  * nbasis * nb_max );
+  auto* gamma_scr  = arena.allocate<double>( is_gga ? ngamma * nb_max : 0 );
+  auto* vgamma_scr = arena.allocate<double>( is_gga ? ngamma * nb_max : 0 );
+  auto* eps_scr    = arena.allocate<double>( nb_max );
+  auto* vrho_scr   = arena.allocate<double>( nspin * nb_max );
+
+  const double xmat_fac = is_uks ? 1.0 : 2.0;
+
+  double EXC_local = 0.;
+  double NEL_local = 0.;
+  for( size_t ip = 0; ip < npts; ip += nb_max ) {
+
+    const size_t nb = std::min( nb_max, npts - ip );
+    const auto* pts_blk = points  + 3*ip;
+    const auto* wgt_blk = weights + ip;
+
+    auto* basis_eval    = basis_scr;
+    auto* dbasis_x_eval = basis_eval    + nbe * nb;
+    auto* dbasis_y_eval = dbasis_x_eval + nbe * nb;
+    auto* dbasis_z_eval = dbasis_y_eval + nbe * nb;
+
+    auto* den_eval    = den_scr;
+    auto* dden_x_eval = den_eval    + nspin * nb;
+    auto* dden_y_eval = dden_x_eval + nspin * nb;
+    auto* dden_z_eval = dden_y_eval + nspin * nb;
+
+    auto* gamma  = gamma_scr;
+    auto* vgamma = vgamma_scr;
+    auto* eps    = eps_scr;
+    auto* vrho   = vrho_scr;
+
+    // X is overwritten by Z once the density has been formed
+    auto* Xs = xmat_scr;
+    auto* Xz = is_uks ? Xs + nbe * nb : nullptr;
+
+    // Collocation
+    if( is_gga )
+      eval_collocation_gradient( nb, nshells, nbe, pts_blk, basis, shell_list,
+        basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+    else
+      eval_collocation( nb, nshells, nbe, pts_blk, basis, shell_list, 
+        basis_eval );
+
+    // X = fac * P * B
+    blas::gemm( 'N', 'N', nbe, nb, nbe, xmat_fac, Ps_use, ldps_use, basis_eval,
+      nbe, 0., Xs, nbe );
+    if( is_uks )
+      blas::gemm( 'N', 'N', nbe, nb, nbe, 1., Pz_use, ldpz_use, basis_eval,
+        nbe, 0., Xz, nbe );
+
+    // U and V variables
+    if( is_gga ) {
+      if( is_uks )
+        eval_uvvar_gga_uks( nb, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
+          dbasis_z_eval, Xs, nbe, Xz, nbe, den_eval, dden_x_eval, dden_y_eval,
+          dden_z_eval, gamma );
+      else
+        eval_uvvar_gga_rks( nb, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
+          dbasis_z_eval, Xs, nbe, den_eval, dden_x_eval, dden_y_eval, 
+          dden_z_eval, gamma );
+    } else {
+      if( is_uks )
+        eval_uvvar_lda_uks( nb, nbe, basis_eval, Xs, nbe, Xz, nbe, den_eval );
+      else
+        eval_uvvar_lda_rks( nb, nbe, basis_eval, Xs, nbe, den_eval );
+    }
+
+    // XC functional
+    if( is_gga ) func.eval_exc_vxc( nb, den_eval, gamma, eps, vrho, vgamma );
+    else         func.eval_exc_vxc( nb, den_eval, eps, vrho );
+
+    // Factor weights into XC results + scalar integrations
+    for( size_t i = 0; i < nb; ++i ) {
+      const auto w   = wgt_blk[i];
+      const auto den = is_uks ? (den_eval[2*i] + den_eval[2*i+1]) : den_eval[i];
+      eps[i] *= w;
+      NEL_local += w      * den;
+      EXC_local += eps[i] * den;
+      for( size_t s = 0; s < nspin;  ++s ) vrho[nspin*i + s] *= w;
+      if( is_gga )
+      for( size_t s = 0; s < ngamma; ++s ) vgamma[ngamma*i + s] *= w;
+    }
+
+    if( is_exc_only ) continue;
+
+    // Z matrices
+    auto* Zs = Xs;
+    auto* Zz = Xz;
+    if( is_gga ) {
+      if( is_uks )
+        eval_zmat_gga_vxc_uks( nb, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
+          dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval, dden_z_eval,
+          Zs, nbe, Zz, nbe );
+      else
+        eval_zmat_gga_vxc_rks( nb, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
+          dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval, dden_z_eval,
+          Zs, nbe );
+    } else {
+      if( is_uks )
+        eval_zmat_lda_vxc_uks( nb, nbe, vrho, basis_eval, Zs, nbe, Zz, nbe );
+      else
+        eval_zmat_lda_vxc_rks( nb, nbe, vrho, basis_eval, Zs, nbe );
+    }
+
+    // Rank-2k update of the compressed VXC
+    const double beta = ip ? 1. : 0.;
+    blas::syr2k( 'L', 'N', nbe, nb, 1., basis_eval, nbe, Zs, nbe, beta, 
+      VXCs, nbe );
+    if( is_uks )
+      blas::syr2k( 'L', 'N', nbe, nb, 1., basis_eval, nbe, Zz, nbe, beta, 
+        VXCz, nbe );
+
+  } // Loop over point blocks
+
+  *EXC  = EXC_local;
+  *N_EL = NEL_local;
+
+}
+
+}
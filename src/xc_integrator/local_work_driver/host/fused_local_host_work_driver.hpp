@@ -0,0 +1,49 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include "reference_local_host_work_driver.hpp"
+
+namespace GauXC {
+
+/**
+ *  Host LWD which evaluates EXC/VXC in fused passes over cache sized blocks
+ *  of the points of a task. All other kernels are those of the reference LWD.
+ */
+struct FusedLocalHostWorkDriver : public ReferenceLocalHostWorkDriver {
+
+  /// Default size of the per-block working set (typical L2)
+  static constexpr size_t default_cache_bytes = 1ul << 20;
+
+  FusedLocalHostWorkDriver( size_t cache_bytes = default_cache_bytes );
+
+  virtual ~FusedLocalHostWorkDriver() noexcept;
+
+  FusedLocalHostWorkDriver( const FusedLocalHostWorkDriver& )     = delete;
+  FusedLocalHostWorkDriver( FusedLocalHostWorkDriver&& ) noexcept = delete;
+
+  /// Number of points per block such that nmat (nbe,npts_block) matrices
+  /// fit in the working set
+  size_t point_block_size( size_t npts, size_t nbe, size_t nmat ) const;
+
+  // Public APIs
+
+  bool supports_fused_exc_vxc() const override;
+  void eval_exc_vxc_fused( const functional_type& func, size_t npts, 
+    size_t nbf, size_t nbe, size_t nshells, const double* points, 
+    const double* weights, const BasisSet<double>& basis, 
+    const int32_t* shell_list, const submat_map_t& submat_map, 
+    const double* Ps, size_t ldps, const double* Pz, size_t ldpz, 
+    double* VXCs, double* VXCz, double* EXC, double* N_EL ) override;
+
+private:
+
+  size_t cache_bytes_; ///< Size of the per-block working set
+
+};
+
+}
@@ -37,6 +37,16 @@ void LocalHostWorkDriver::partition_weights( XCWeightAlg weight_alg,
 
 }
 
+void LocalHostWorkDriver::partition_weights_screened( XCWeightAlg weight_alg, 
+  const Molecule& mol, const MolMeta& meta, task_iterator task_begin, 
+  task_iterator task_end ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->partition_weights_screened(weight_alg, mol, meta, task_begin, 
+    task_end);
+
+}
+
 
 // Collocation
 void LocalHostWorkDriver::eval_collocation( size_t npts, size_t nshells, size_t nbe, 
@@ -62,6 +72,29 @@ void LocalHostWorkDriver::eval_collocation_gradient( size_t npts, size_t nshells
 }
 
 
+// Collocation on atomic quadratures
+void LocalHostWorkDriver::eval_collocation_atomic( size_t npts, size_t nshells, 
+  size_t nbe, const double* pts, const BasisSet<double>& basis, 
+  const int32_t* shell_list, const double* center, double* basis_eval ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_collocation_atomic(npts, nshells, nbe, pts, basis, shell_list, 
+    center, basis_eval);
+
+}
+
+void LocalHostWorkDriver::eval_collocation_gradient_atomic( size_t npts, 
+  size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+  const int32_t* shell_list, const double* center, double* basis_eval, 
+  double* dbasis_x_eval, double* dbasis_y_eval, double* dbasis_z_eval) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_collocation_gradient_atomic(npts, nshells, nbe, pts, basis, 
+    shell_list, center, basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval);
+
+}
+
+
 // Collocation Hessian
 void LocalHostWorkDriver::eval_collocation_hessian( size_t npts, size_t nshells, 
     size_t nbe, const double* pts, const BasisSet<double>& basis, 
@@ -77,6 +110,50 @@ void LocalHostWorkDriver::eval_collocation_hessian( size_t npts, size_t nshells,
 
 }
 
+// Collocation Laplacian
+void LocalHostWorkDriver::eval_collocation_laplacian( size_t npts, size_t nshells, 
+    size_t nbe, const double* pts, const BasisSet<double>& basis, 
+    const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
+    double* dbasis_y_eval, double* dbasis_z_eval, double* lbasis_eval ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_collocation_laplacian(npts, nshells, nbe, pts, basis, shell_list, 
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval);
+
+}
+
+// Collocation with primitive screening
+void LocalHostWorkDriver::eval_collocation_screened( size_t npts, 
+  const double* pts, const BasisSet<double>& basis, 
+  const PrimitiveScreening& prims, double* basis_eval ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_collocation_screened(npts, pts, basis, prims, basis_eval);
+
+}
+
+void LocalHostWorkDriver::eval_collocation_gradient_screened( size_t npts, 
+  const double* pts, const BasisSet<double>& basis, 
+  const PrimitiveScreening& prims, double* basis_eval, double* dbasis_x_eval, 
+  double* dbasis_y_eval, double* dbasis_z_eval ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_collocation_gradient_screened(npts, pts, basis, prims, 
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval);
+
+}
+
+void LocalHostWorkDriver::eval_collocation_laplacian_screened( size_t npts, 
+  const double* pts, const BasisSet<double>& basis, 
+  const PrimitiveScreening& prims, double* basis_eval, double* dbasis_x_eval, 
+  double* dbasis_y_eval, double* dbasis_z_eval, double* lbasis_eval ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_collocation_laplacian_screened(npts, pts, basis, prims, 
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval);
+
+}
+
 // Collocation 3rd
 void LocalHostWorkDriver::eval_collocation_der3( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
@@ -110,6 +187,27 @@ void LocalHostWorkDriver::eval_xmat( size_t npts, size_t nbf, size_t nbe,
 
 }
 
+void LocalHostWorkDriver::eval_xmat_stacked( size_t npts, size_t nbf, 
+  size_t nbe, const submat_map_t& submat_map, double fac, size_t ndm, 
+  const double* const* P, size_t ldp, const double* basis_eval, size_t ldb, 
+  double* X, size_t ldx, double* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_xmat_stacked(npts, nbf, nbe, submat_map, fac, ndm, P, ldp, 
+    basis_eval, ldb, X, ldx, scr);
+
+}
+
+void LocalHostWorkDriver::eval_xmat_screened( size_t npts, 
+  const ShellBlockPattern& pattern, double fac, const double* P, size_t ldp, 
+  const double* basis_eval, size_t ldb, double* X, size_t ldx, double* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_xmat_screened(npts, pattern, fac, P, ldp, basis_eval, ldb, 
+    X, ldx, scr);
+
+}
+
 void LocalHostWorkDriver::eval_exx_fmat( size_t npts, size_t nbf, size_t nbe_bra,
   size_t nbe_ket, const submat_map_t& submat_map_bra,
   const submat_map_t& submat_map_ket, const double* P, size_t ldp,
@@ -147,6 +245,68 @@ void LocalHostWorkDriver::inc_exx_k( size_t npts, size_t nbf, size_t nbe_bra,
     submat_map_ket, G, ldg, K, ldk, scr );
 }
 
+void LocalHostWorkDriver::inc_exx_k_packed( size_t npts, size_t nbf, 
+  size_t nbe_bra, size_t nbe_ket, const double* basis_eval, 
+  const submat_map_t& submat_map_bra, const submat_map_t& submat_map_ket, 
+  const double* G, size_t ldg, double* K_packed, double* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->inc_exx_k_packed(npts, nbf, nbe_bra, nbe_ket, basis_eval, 
+    submat_map_bra, submat_map_ket, G, ldg, K_packed, scr );
+}
+
+void LocalHostWorkDriver::eval_exx_fmat_cart( size_t npts, size_t nbf, 
+  size_t nbe_bra, size_t nbe_ket, size_t nshells_bra, 
+  const int32_t* shell_list_bra, const BasisSet<double>& basis, 
+  const submat_map_t& submat_map_bra, const submat_map_t& submat_map_ket, 
+  const double* P, size_t ldp, const double* basis_eval, size_t ldb, 
+  double* F, size_t ldf ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_exx_fmat_cart(npts, nbf, nbe_bra, nbe_ket, nshells_bra, 
+    shell_list_bra, basis, submat_map_bra, submat_map_ket, P, ldp, basis_eval,
+    ldb, F, ldf );
+
+}
+
+void LocalHostWorkDriver::eval_exx_gmat_cart( size_t npts, size_t nshells, 
+  size_t nshell_pairs, const double* points, const double* weights, 
+  const BasisSet<double>& basis, const ShellPairCollection<double>& shpairs, 
+  const int32_t* shell_list, const std::pair<int32_t,int32_t>* shell_pair_list, 
+  const double* F, size_t ldf, double* G, size_t ldg, double eps_pt ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_exx_gmat_cart(npts, nshells, nshell_pairs, points, weights, 
+    basis, shpairs, shell_list, shell_pair_list, F, ldf, G, ldg, eps_pt );
+
+}
+
+void LocalHostWorkDriver::inc_exx_k_cart( size_t npts, size_t nbf, 
+  size_t nbe_bra, size_t nbe_ket, size_t nshells_ket, 
+  const int32_t* shell_list_ket, const BasisSet<double>& basis, 
+  const double* basis_eval, const submat_map_t& submat_map_bra, 
+  const submat_map_t& submat_map_ket, const double* G, size_t ldg, double* K, 
+  size_t ldk ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->inc_exx_k_cart(npts, nbf, nbe_bra, nbe_ket, nshells_ket, 
+    shell_list_ket, basis, basis_eval, submat_map_bra, submat_map_ket, G, ldg,
+    K, ldk );
+}
+
+void LocalHostWorkDriver::inc_exx_k_cart_packed( size_t npts, size_t nbf, 
+  size_t nbe_bra, size_t nbe_ket, size_t nshells_ket, 
+  const int32_t* shell_list_ket, const BasisSet<double>& basis, 
+  const double* basis_eval, const submat_map_t& submat_map_bra, 
+  const submat_map_t& submat_map_ket, const double* G, size_t ldg, 
+  double* K_packed ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->inc_exx_k_cart_packed(npts, nbf, nbe_bra, nbe_ket, nshells_ket, 
+    shell_list_ket, basis, basis_eval, submat_map_bra, submat_map_ket, G, ldg,
+    K_packed );
+}
+
 
 
 // U/VVar LDA (density)
@@ -399,6 +559,38 @@ void LocalHostWorkDriver::inc_vxc( size_t npts, size_t nbf, size_t nbe,
 
 }
 
+// Increment packed VXC by Z
+void LocalHostWorkDriver::inc_vxc_packed( size_t npts, size_t nbf, size_t nbe, 
+  const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
+  size_t ldz, double* VXC_packed, double* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->inc_vxc_packed(npts, nbf, nbe, basis_eval, submat_map, Z, ldz, 
+    VXC_packed, scr);
+
+}
+
+
+bool LocalHostWorkDriver::supports_fused_exc_vxc() {
+
+  throw_if_invalid_pimpl(pimpl_);
+  return pimpl_->supports_fused_exc_vxc();
+
+}
+
+void LocalHostWorkDriver::eval_exc_vxc_fused( const functional_type& func, 
+  size_t npts, size_t nbf, size_t nbe, size_t nshells, const double* points, 
+  const double* weights, const BasisSet<double>& basis, 
+  const int32_t* shell_list, const submat_map_t& submat_map, 
+  const double* Ps, size_t ldps, const double* Pz, size_t ldpz, 
+  double* VXCs, double* VXCz, double* EXC, double* N_EL ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_exc_vxc_fused(func, npts, nbf, nbe, nshells, points, weights,
+    basis, shell_list, submat_map, Ps, ldps, Pz, ldpz, VXCs, VXCz, EXC, N_EL);
+
+}
+
 
 
 }
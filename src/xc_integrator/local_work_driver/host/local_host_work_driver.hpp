@@ -14,6 +14,7 @@
 #include <gauxc/shell_pair.hpp>
 #include <gauxc/basisset_map.hpp>
 #include <gauxc/xc_task.hpp>
+#include <gauxc/types.hpp>
 
 
 namespace GauXC {
@@ -23,6 +24,9 @@ struct LocalHostWorkDriverPIMPL;
 
 }
 
+class ShellBlockPattern;
+class PrimitiveScreening;
+
 /// Base class for local work drivers in Host execution spaces 
 class LocalHostWorkDriver : public LocalWorkDriver {
 
@@ -71,6 +75,23 @@ public:
   void partition_weights( XCWeightAlg weight_alg, const Molecule& mol, 
     const MolMeta& meta, task_iterator task_begin, task_iterator task_end );
 
+  /** Evaluate the molecular partition weights using atom screening
+   *
+   *  Same as partition_weights, but the cell functions of each point are
+   *  only evaluated over the atoms which may contribute to its weight.
+   *  Candidate atoms are obtained per task from a spatial cell list.
+   *  Schemes without screening fall back to partition_weights.
+   *
+   *  @param[in] weight_alg Molecular partitioning scheme
+   *  @param[in] mol        Molecule being partitioned
+   *  @param[in] molmeta    Metadata associated with mol
+   *
+   *  @param[in/out] task_begin Start iterator for task container to be modified
+   *  @param[in/out] task_end   End iterator for task container to be modified
+   */
+  void partition_weights_screened( XCWeightAlg weight_alg, const Molecule& mol, 
+    const MolMeta& meta, task_iterator task_begin, task_iterator task_end );
+
 
   /** Evaluation the collocation matrix
    *
@@ -109,6 +130,47 @@ public:
     double* dbasis_z_eval);
 
 
+  /** Evaluation the collocation matrix on points of an atomic quadrature
+   *
+   *  Radial factors of shells centered on `center` are evaluated once per
+   *  distinct radius (radial node) rather than once per point.
+   *
+   *  @param[in] npts     Same as `eval_collocation`
+   *  @param[in] nshells  Same as `eval_collocation`
+   *  @param[in] nbe      Same as `eval_collocation`
+   *  @param[in] pts      Same as `eval_collocation`
+   *  @param[in] basis    Same as `eval_collocation`
+   *  @param[in] shell_list Same as `eval_collocation`
+   *  @param[in] center   Center of the atomic quadrature (3)
+   *
+   *  @param[out] basis_eval Same as `eval_collocation`
+   */
+  void eval_collocation_atomic( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    const double* center, double* basis_eval );
+
+  /** Evaluation the collocation matrix + gradient on points of an atomic 
+   *  quadrature
+   *
+   *  @param[in] npts     Same as `eval_collocation`
+   *  @param[in] nshells  Same as `eval_collocation`
+   *  @param[in] nbe      Same as `eval_collocation`
+   *  @param[in] pts      Same as `eval_collocation`
+   *  @param[in] basis    Same as `eval_collocation`
+   *  @param[in] shell_list Same as `eval_collocation`
+   *  @param[in] center   Same as `eval_collocation_atomic`
+   *
+   *  @param[out] basis_eval    Same as `eval_collocation`
+   *  @param[out] dbasis_x_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_y_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_z_eval Same as `eval_collocation_gradient`
+   */
+  void eval_collocation_gradient_atomic( size_t npts, size_t nshells, 
+    size_t nbe, const double* pts, const BasisSet<double>& basis, 
+    const int32_t* shell_list, const double* center, double* basis_eval, 
+    double* dbasis_x_eval, double* dbasis_y_eval, double* dbasis_z_eval);
+
+
   /** Evaluation the collocation matrix + gradient + hessian
    *
    *  @param[in] npts     Same as `eval_collocation`
@@ -136,6 +198,79 @@ public:
     double* d2basis_xz_eval, double* d2basis_yy_eval, double* d2basis_yz_eval,
     double* d2basis_zz_eval );
 
+  /** Evaluation the collocation matrix + gradient + laplacian
+   *
+   *  @param[in] npts     Same as `eval_collocation`
+   *  @param[in] nshells  Same as `eval_collocation`
+   *  @param[in] nbe      Same as `eval_collocation`
+   *  @param[in] pts      Same as `eval_collocation`
+   *  @param[in] basis    Same as `eval_collocation`
+   *  @param[in] shell_list Same as `eval_collocation`
+   *
+   *  @param[out] basis_eval    Same as `eval_collocation`
+   *  @param[out] dbasis_x_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_y_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_z_eval Same as `eval_collocation_gradient`
+   *  @param[out] lbasis_eval   Laplacian of `basis_eval` (same dimensions)
+   */
+  void eval_collocation_laplacian( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* lbasis_eval );
+
+
+  /** Evaluation the collocation matrix with primitive screening
+   *
+   *  Only the shells and primitives retained by `prims` are evaluated,
+   *  the outputs are packed over the basis functions of `prims.shell_list()`.
+   *
+   *  @param[in] npts     Same as `eval_collocation`
+   *  @param[in] pts      Same as `eval_collocation`
+   *  @param[in] basis    Same as `eval_collocation`
+   *  @param[in] prims    Primitive screening of the task
+   *
+   *  @param[out] basis_eval Same as `eval_collocation` (prims.nbe() x npts)
+   */
+  void eval_collocation_screened( size_t npts, const double* pts, 
+    const BasisSet<double>& basis, const PrimitiveScreening& prims, 
+    double* basis_eval );
+
+  /** Evaluation the collocation matrix + gradient with primitive screening
+   *
+   *  @param[in] npts     Same as `eval_collocation`
+   *  @param[in] pts      Same as `eval_collocation`
+   *  @param[in] basis    Same as `eval_collocation`
+   *  @param[in] prims    Same as `eval_collocation_screened`
+   *
+   *  @param[out] basis_eval    Same as `eval_collocation_screened`
+   *  @param[out] dbasis_x_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_y_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_z_eval Same as `eval_collocation_gradient`
+   */
+  void eval_collocation_gradient_screened( size_t npts, const double* pts, 
+    const BasisSet<double>& basis, const PrimitiveScreening& prims, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval );
+
+  /** Evaluation the collocation matrix + gradient + laplacian with primitive
+   *  screening
+   *
+   *  @param[in] npts     Same as `eval_collocation`
+   *  @param[in] pts      Same as `eval_collocation`
+   *  @param[in] basis    Same as `eval_collocation`
+   *  @param[in] prims    Same as `eval_collocation_screened`
+   *
+   *  @param[out] basis_eval    Same as `eval_collocation_screened`
+   *  @param[out] dbasis_x_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_y_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_z_eval Same as `eval_collocation_gradient`
+   *  @param[out] lbasis_eval   Same as `eval_collocation_laplacian`
+   */
+  void eval_collocation_laplacian_screened( size_t npts, const double* pts, 
+    const BasisSet<double>& basis, const PrimitiveScreening& prims, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* lbasis_eval );
+
   /** Evaluation the collocation matrix + gradient + hessian + 3rd derivatives
    *
    *  @param[in] npts     Same as `eval_collocation`
@@ -196,6 +331,53 @@ public:
     const double* basis_eval, size_t ldb, double* X, size_t ldx, 
     double* scr );
 
+  /** Evaluate the compressed "X" matrices = fac * P_i * B of a set of
+   *  density matrices with a single GEMM
+   *
+   *  The compressed P_i are stacked vertically, such that rows 
+   *  [i*nbe, (i+1)*nbe) of X hold the X matrix of P_i.
+   *
+   *  @param[in]  npts        The number of points in the collocation matrix 
+   *  @param[in]  nbf         The total number of bfns
+   *  @param[in]  nbe         The number of non-negligible bfns
+   *  @param[in]  submat_map  Map from the full matrix to non-negligible submatrices
+   *  @param[in]  fac         Scaling factor in front of matrix multiplication
+   *  @param[in]  ndm         The number of density matrices
+   *  @param[in]  P           The density matrices ( ndm x (nbf,nbf) col major)
+   *  @param[in]  ldp         The leading dimension of each P_i
+   *  @param[in]  basis_eval  The collocation matrix ( (nbe,npts) col major)
+   *  @param[in]  ldb         The leading dimension of basis_eval
+   *  @param[out] X           The stacked X matrices ( (ndm*nbe,npts) col major)
+   *  @param[in]  ldx         The leading dimension of X
+   *  @param[in/out] scr      Scratch space of at least ndm*nbe*nbe
+   */
+  void eval_xmat_stacked( size_t npts, size_t nbf, size_t nbe, 
+    const submat_map_t& submat_map, double fac, size_t ndm, 
+    const double* const* P, size_t ldp, const double* basis_eval, size_t ldb, 
+    double* X, size_t ldx, double* scr );
+
+  /** Evaluate the compressed "X" matrix = fac * P * B, skipping negligible
+   *  shell blocks of P
+   *
+   *  Each (row group, run) pair of the task pattern (see ShellBlockPattern)
+   *  is contracted with the collocation in a single GEMM. Blocks of P which
+   *  are not contiguous in the full basis are packed into scr.
+   *
+   *  @param[in]  npts        The number of points in the collocation matrix 
+   *  @param[in]  pattern     Shell block pattern of P over the task
+   *  @param[in]  fac         Scaling factor in front of matrix multiplication
+   *  @param[in]  P           The alpha density matrix ( (nbf,nbf) col major)
+   *  @param[in]  ldp         The leading dimension of P
+   *  @param[in]  basis_eval  The collocation matrix ( (nbe,npts) col major)
+   *  @param[in]  ldb         The leading dimension of basis_eval
+   *  @param[out] X           The X matrix ( (nbe,npts) col major)
+   *  @param[in]  ldx         The leading dimension of X
+   *  @param[in]  scr         Scratch of at least pattern.max_panel()
+   */
+  void eval_xmat_screened( size_t npts, const ShellBlockPattern& pattern, 
+    double fac, const double* P, size_t ldp, const double* basis_eval, 
+    size_t ldb, double* X, size_t ldx, double* scr );
+
   void eval_exx_fmat( size_t npts, size_t nbf, size_t nbe_bra,
     size_t nbe_ket, const submat_map_t& submat_map_bra,
     const submat_map_t& submat_map_ket, const double* P, size_t ldp,
@@ -213,6 +395,127 @@ public:
     const double* basis_eval, const submat_map_t& submat_map_bra, 
     const submat_map_t& submat_map_ket, const double* G, size_t ldg, double* K, 
     size_t ldk, double* scr );
+
+  /** Increment packed K integrand given G / Collocation
+   *
+   *  K += B * G**T, with the strict upper triangle folded onto the lower
+   *  triangle, i.e. the packed result accumulates K + K**T off the diagonal.
+   *
+   *  No synchronization is performed on K, each thread is expected to
+   *  provide its own copy.
+   *
+   *  @param[in] npts           Number of grid points
+   *  @param[in] nbf            Number of bfns in full basis
+   *  @param[in] nbe_bra        Number of non-negligible bra bfns
+   *  @param[in] nbe_ket        Number of non-negligible ket bfns
+   *  @param[in] basis_eval     Compressed collocation matrix ((nbe_bra,npts), col major)
+   *  @param[in] submat_map_bra Map between non-negligible bra bfns to full basis
+   *  @param[in] submat_map_ket Map between non-negligible ket bfns to full basis
+   *  @param[in] G              Compressed G Matrix ((nbe_ket,npts), col major)
+   *  @param[in] ldg            Leading dimension of G
+   *  @param[in/out] K_packed   Packed lower triangle of K (nbf*(nbf+1)/2)
+   *  @param[out] scr           Scratch space at least nbe_bra*nbe_ket
+   */
+  void inc_exx_k_packed( size_t npts, size_t nbf, size_t nbe_bra, 
+    size_t nbe_ket, const double* basis_eval, 
+    const submat_map_t& submat_map_bra, const submat_map_t& submat_map_ket, 
+    const double* G, size_t ldg, double* K_packed, double* scr );
+
+  /** Evaluate the EXX F matrix, F = P * B, in the Cartesian basis of the
+   *  bra shells, stored in the (row major) layout consumed by
+   *  eval_exx_gmat_cart.
+   *
+   *  @param[in]  npts           Number of grid points
+   *  @param[in]  nbf            Number of bfns in full basis
+   *  @param[in]  nbe_bra        Number of non-negligible bra bfns
+   *  @param[in]  nbe_ket        Number of non-negligible ket bfns
+   *  @param[in]  nshells_bra    Number of non-negligible bra shells
+   *  @param[in]  shell_list_bra List of non-negligible bra shells
+   *  @param[in]  basis          Full basis set
+   *  @param[in]  submat_map_bra Map between non-negligible bra bfns to full basis
+   *  @param[in]  submat_map_ket Map between non-negligible ket bfns to full basis
+   *  @param[in]  P              The density matrix ((nbf,nbf) col major)
+   *  @param[in]  ldp            Leading dimension of P
+   *  @param[in]  basis_eval     Compressed ket collocation ((nbe_ket,npts) col major)
+   *  @param[in]  ldb            Leading dimension of basis_eval
+   *  @param[out] F              Cartesian F matrix ((nbe_bra_cart,npts) row major)
+   *  @param[in]  ldf            Leading dimension of F (>= npts)
+   */
+  void eval_exx_fmat_cart( size_t npts, size_t nbf, size_t nbe_bra,
+    size_t nbe_ket, size_t nshells_bra, const int32_t* shell_list_bra,
+    const BasisSet<double>& basis, const submat_map_t& submat_map_bra,
+    const submat_map_t& submat_map_ket, const double* P, size_t ldp,
+    const double* basis_eval, size_t ldb, double* F, size_t ldf );
+
+  /** Evaluate the EXX G matrix, G(mu,i) = w(i) * A(mu,nu,i) * F(nu,i), in
+   *  the Cartesian basis
+   *
+   *  F and G are stored row major, i.e. each Cartesian bfn of the shell
+   *  list occupies a contiguous row of npts values. No transformations or
+   *  transpositions are performed.
+   *
+   *  @param[in]  npts            Number of grid points
+   *  @param[in]  nshells         Number of non-negligible shells
+   *  @param[in]  nshell_pairs    Number of significant shell pairs
+   *  @param[in]  points          Grid points ((3,npts) col major)
+   *  @param[in]  weights         Grid weights (npts)
+   *  @param[in]  basis           Full basis set
+   *  @param[in]  shpairs         Shell pairs of the full basis set
+   *  @param[in]  shell_list      List of non-negligible shells
+   *  @param[in]  shell_pair_list List of significant shell pairs
+   *  @param[in]  F               Cartesian F matrix ((nbe_cart,npts) row major)
+   *  @param[in]  ldf             Leading dimension of F
+   *  @param[out] G               Cartesian G matrix ((nbe_cart,npts) row major)
+   *  @param[in]  ldg             Leading dimension of G
+   *  @param[in]  eps_pt          Tolerance of the point level screening. A
+   *                              shell pair is skipped on blocks of points
+   *                              where the bound of its contribution to G
+   *                              falls below eps_pt (0 disables)
+   */
+  void eval_exx_gmat_cart( size_t npts, size_t nshells, size_t nshell_pairs,
+    const double* points, const double* weights, 
+    const BasisSet<double>& basis, const ShellPairCollection<double>& shpairs, 
+    const int32_t* shell_list, const std::pair<int32_t,int32_t>* shell_pair_list, 
+    const double* F, size_t ldf, double* G, size_t ldg, double eps_pt );
+
+  /** Increment K integrand given a Cartesian G / Collocation
+   *
+   *  K += B * (T * G)**T, where T transforms the Cartesian ket bfns to the
+   *  basis of the ket shells. T is applied to the (nbe_bra,nbe_ket_cart)
+   *  product B * G**T rather than to G.
+   *
+   *  @param[in] npts           Number of grid points
+   *  @param[in] nbf            Number of bfns in full basis
+   *  @param[in] nbe_bra        Number of non-negligible bra bfns
+   *  @param[in] nbe_ket        Number of non-negligible ket bfns
+   *  @param[in] nshells_ket    Number of non-negligible ket shells
+   *  @param[in] shell_list_ket List of non-negligible ket shells
+   *  @param[in] basis          Full basis set
+   *  @param[in] basis_eval     Compressed collocation matrix ((nbe_bra,npts), col major)
+   *  @param[in] submat_map_bra Map between non-negligible bra bfns to full basis
+   *  @param[in] submat_map_ket Map between non-negligible ket bfns to full basis
+   *  @param[in] G              Cartesian G matrix ((nbe_ket_cart,npts) row major)
+   *  @param[in] ldg            Leading dimension of G
+   *  @param[in/out] K          K matrix ((nbf,nbf) col major)
+   *  @param[in] ldk            Leading dimension of K
+   */
+  void inc_exx_k_cart( size_t npts, size_t nbf, size_t nbe_bra, 
+    size_t nbe_ket, size_t nshells_ket, const int32_t* shell_list_ket,
+    const BasisSet<double>& basis, const double* basis_eval, 
+    const submat_map_t& submat_map_bra, const submat_map_t& submat_map_ket, 
+    const double* G, size_t ldg, double* K, size_t ldk );
+
+  /** Increment packed K integrand given a Cartesian G / Collocation
+   *
+   *  Same as inc_exx_k_cart, with K accumulated as in inc_exx_k_packed
+   *
+   *  @param[in/out] K_packed   Packed lower triangle of K (nbf*(nbf+1)/2)
+   */
+  void inc_exx_k_cart_packed( size_t npts, size_t nbf, size_t nbe_bra, 
+    size_t nbe_ket, size_t nshells_ket, const int32_t* shell_list_ket,
+    const BasisSet<double>& basis, const double* basis_eval, 
+    const submat_map_t& submat_map_bra, const submat_map_t& submat_map_ket, 
+    const double* G, size_t ldg, double* K_packed );
     
   /** Evaluate the U and V variavles for RKS LDA
    *
@@ -222,9 +525,12 @@ public:
    *  @param[in] nbe        The number of basis functions in collocation matrix
    *  @param[in] basis_eval The collocation matrix ( (nbe,npts), col major, lb=nbe)
    *  @param[in] X          The X matrix (P*B, (nbe,npts) col major)
-   *  @param[in] ldx        The leading dimension of X
+   *  @param[in] ldx        The leading dimension of X (>= nbe, X may be a
+   *                        block of vertically stacked X matrices)
    *  @param[out] den_eval  The total density evaluated on the grid (npts)
    *
+   *  The collocation matrices (and its derivatives) of all U/V variable
+   *  kernels have leading dimension nbe, only X (and M) are strided.
    */
   void eval_uvvar_lda_rks( size_t npts, size_t nbe, const double* basis_eval,
     const double* X, size_t ldx, double* den_eval);
@@ -238,8 +544,9 @@ public:
    *  @param[in] nbe        The number of basis functions in collocation matrix
    *  @param[in] basis_eval The collocation matrix ( (nbe,npts), col major, lb=nbe)
    *  @param[in] Xs         The Xs matrix (Ps*B, (nbe,npts) col major)
+   *  @param[in] ldxs       The leading dimension of Xs
    *  @param[in] Xz         The Xz matrix (Pz*B, (nbe,npts) col major)
-   *  @param[in] ldx        The leading dimension of X
+   *  @param[in] ldxz       The leading dimension of Xz
    *  @param[out] den_eval  The total density evaluated on the grid (npts)
    *
    */
@@ -469,6 +776,67 @@ public:
     const submat_map_t& submat_map, const double* Z, size_t ldz, 
     double* VXC, size_t ldvxc, double* scr );
 
+  /** Increment packed VXC integrand given Z / Collocation
+   *
+   *  Same as inc_vxc, but VXC is stored as a packed lower triangle and
+   *  no synchronization is performed on VXC, each thread is expected to
+   *  provide its own copy.
+   *
+   *  @param[in] npts        Number of grid points
+   *  @param[in] nbf         Number of bfns in full basis
+   *  @param[in] nbe         Number of non-negligible bfns
+   *  @paran[in] basis_eval  Compressed collocation matrix ((nbe,npts), col major, ld=nbe)
+   *  @param[in] submat_map  Map between non-negilgible bfns to full basis
+   *  @param[in] Z           Compressed Z Matrix ((nbe,npts), col major)
+   *  @param[in] ldz         Leading dimension of Z
+   *  @param[in/out] VXC_packed Packed lower triangle of VXC (nbf*(nbf+1)/2)
+   *  @param[out] scr        Scratch space at least nbe*nbe
+   *
+   */
+  void inc_vxc_packed( size_t npts, size_t nbf, size_t nbe, 
+    const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
+    size_t ldz, double* VXC_packed, double* scr );
+
+
+  /// Whether this LWD implements eval_exc_vxc_fused
+  bool supports_fused_exc_vxc();
+
+  /** Evaluate the EXC/VXC contributions of a task in a single fused pass
+   *
+   *  The points of the task are processed in blocks small enough that the
+   *  collocation, X and Z matrices of a block remain in cache while the
+   *  density, functional and Z evaluations are performed on them. The
+   *  contribution of each block is accumulated into the compressed VXC
+   *  through a rank-2k update. Only RKS/UKS LDA/GGA functionals are supported.
+   *
+   *  @param[in] func        XC functional
+   *  @param[in] npts        Number of grid points
+   *  @param[in] nbf         Number of bfns in full basis
+   *  @param[in] nbe         Number of non-negligible bfns
+   *  @param[in] nshells     Number of non-negligible shells
+   *  @param[in] points      Grid points (AoS)
+   *  @param[in] weights     Quadrature weights
+   *  @param[in] basis       Basis set
+   *  @param[in] shell_list  List of non-negligible shells
+   *  @param[in] submat_map  Map between non-negilgible bfns to full basis
+   *  @param[in] Ps          Scalar density matrix (nbf,nbf)
+   *  @param[in] ldps        Leading dimension of Ps
+   *  @param[in] Pz          Z density matrix (nbf,nbf), nullptr for RKS
+   *  @param[in] ldpz        Leading dimension of Pz
+   *  @param[out] VXCs       Lower triangle of the compressed scalar VXC 
+   *                         ((nbe,nbe), ld=nbe), nullptr for EXC only
+   *  @param[out] VXCz       Lower triangle of the compressed Z VXC 
+   *                         ((nbe,nbe), ld=nbe), nullptr for RKS / EXC only
+   *  @param[out] EXC        Weighted EXC contribution of the task
+   *  @param[out] N_EL       Weighted electron count of the task
+   */
+  void eval_exc_vxc_fused( const functional_type& func, size_t npts, 
+    size_t nbf, size_t nbe, size_t nshells, const double* points, 
+    const double* weights, const BasisSet<double>& basis, 
+    const int32_t* shell_list, const submat_map_t& submat_map, 
+    const double* Ps, size_t ldps, const double* Pz, size_t ldpz, 
+    double* VXCs, double* VXCz, double* EXC, double* N_EL );
+
 private: 
 
   pimpl_type pimpl_; ///< Implementation
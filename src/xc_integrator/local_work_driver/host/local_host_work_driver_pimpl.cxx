@@ -6,10 +6,21 @@
  * See LICENSE.txt for details
  */
 #include "local_host_work_driver_pimpl.hpp"
+#include <gauxc/exceptions.hpp>
 
 namespace GauXC::detail {
 
 LocalHostWorkDriverPIMPL::LocalHostWorkDriverPIMPL() = default; 
 LocalHostWorkDriverPIMPL::~LocalHostWorkDriverPIMPL() noexcept = default;
 
+bool LocalHostWorkDriverPIMPL::supports_fused_exc_vxc() const { return false; }
+
+void LocalHostWorkDriverPIMPL::eval_exc_vxc_fused( const functional_type&, 
+  size_t, size_t, size_t, size_t, const double*, const double*, 
+  const BasisSet<double>&, const int32_t*, const submat_map_t&, 
+  const double*, size_t, const double*, size_t, double*, double*, double*, 
+  double* ) {
+  GAUXC_GENERIC_EXCEPTION("Fused EXC/VXC Not Implemented For This LWD");
+}
+
 }
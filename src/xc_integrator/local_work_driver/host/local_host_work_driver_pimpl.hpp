@@ -29,6 +29,9 @@ struct LocalHostWorkDriverPIMPL {
 
   virtual void partition_weights( XCWeightAlg weight_alg, const Molecule& mol, 
     const MolMeta& meta, task_iterator task_begin, task_iterator task_end ) = 0;
+  virtual void partition_weights_screened( XCWeightAlg weight_alg, 
+    const Molecule& mol, const MolMeta& meta, task_iterator task_begin, 
+    task_iterator task_end ) = 0;
 
   virtual void eval_collocation( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
@@ -37,12 +40,34 @@ struct LocalHostWorkDriverPIMPL {
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
     double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
     double* dbasis_z_eval) = 0;
+  virtual void eval_collocation_atomic( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    const double* center, double* basis_eval ) = 0;
+  virtual void eval_collocation_gradient_atomic( size_t npts, size_t nshells, 
+    size_t nbe, const double* pts, const BasisSet<double>& basis, 
+    const int32_t* shell_list, const double* center, double* basis_eval, 
+    double* dbasis_x_eval, double* dbasis_y_eval, double* dbasis_z_eval) = 0;
   virtual void eval_collocation_hessian( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
     double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
     double* dbasis_z_eval, double* d2basis_xx_eval, double* d2basis_xy_eval,
     double* d2basis_xz_eval, double* d2basis_yy_eval, double* d2basis_yz_eval,
     double* d2basis_zz_eval ) = 0;
+  virtual void eval_collocation_laplacian( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* lbasis_eval ) = 0;
+  virtual void eval_collocation_screened( size_t npts, const double* pts, 
+    const BasisSet<double>& basis, const PrimitiveScreening& prims, 
+    double* basis_eval ) = 0;
+  virtual void eval_collocation_gradient_screened( size_t npts, 
+    const double* pts, const BasisSet<double>& basis, 
+    const PrimitiveScreening& prims, double* basis_eval, double* dbasis_x_eval,
+    double* dbasis_y_eval, double* dbasis_z_eval ) = 0;
+  virtual void eval_collocation_laplacian_screened( size_t npts, 
+    const double* pts, const BasisSet<double>& basis, 
+    const PrimitiveScreening& prims, double* basis_eval, double* dbasis_x_eval,
+    double* dbasis_y_eval, double* dbasis_z_eval, double* lbasis_eval ) = 0;
   virtual void eval_collocation_der3( size_t npts, size_t nshells, size_t nbe,
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
     double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
@@ -56,6 +81,14 @@ struct LocalHostWorkDriverPIMPL {
   virtual void eval_xmat( size_t npts, size_t nbf, size_t nbe, 
     const submat_map_t& submat_map, double fac, const double* P, size_t ldp, 
     const double* basis_eval, size_t ldb, double* X, size_t ldx, double* scr ) = 0;
+  virtual void eval_xmat_stacked( size_t npts, size_t nbf, size_t nbe, 
+    const submat_map_t& submat_map, double fac, size_t ndm, 
+    const double* const* P, size_t ldp, const double* basis_eval, size_t ldb, 
+    double* X, size_t ldx, double* scr ) = 0;
+  virtual void eval_xmat_screened( size_t npts, 
+    const ShellBlockPattern& pattern, double fac, const double* P, 
+    size_t ldp, const double* basis_eval, size_t ldb, double* X, 
+    size_t ldx, double* scr ) = 0;
 
   virtual void eval_exx_fmat( size_t npts, size_t nbf, size_t nbe_bra,
     size_t nbe_ket, const submat_map_t& submat_map_bra,
@@ -74,6 +107,33 @@ struct LocalHostWorkDriverPIMPL {
     const double* basis_eval, const submat_map_t& submat_map_bra, 
     const submat_map_t& submat_map_ket, const double* G, size_t ldg, double* K, 
     size_t ldk, double* scr ) = 0;
+  virtual void inc_exx_k_packed( size_t npts, size_t nbf, size_t nbe_bra, 
+    size_t nbe_ket, const double* basis_eval, 
+    const submat_map_t& submat_map_bra, const submat_map_t& submat_map_ket, 
+    const double* G, size_t ldg, double* K_packed, double* scr ) = 0;
+
+  virtual void eval_exx_fmat_cart( size_t npts, size_t nbf, size_t nbe_bra,
+    size_t nbe_ket, size_t nshells_bra, const int32_t* shell_list_bra,
+    const BasisSet<double>& basis, const submat_map_t& submat_map_bra,
+    const submat_map_t& submat_map_ket, const double* P, size_t ldp,
+    const double* basis_eval, size_t ldb, double* F, size_t ldf ) = 0;
+
+  virtual void eval_exx_gmat_cart( size_t npts, size_t nshells, size_t nshell_pairs,
+    const double* points, const double* weights, 
+    const BasisSet<double>& basis, const ShellPairCollection<double>& shpairs, 
+    const int32_t* shell_list, const std::pair<int32_t,int32_t>* shell_pair_list, 
+    const double* F, size_t ldf, double* G, size_t ldg, double eps_pt ) = 0;
+
+  virtual void inc_exx_k_cart( size_t npts, size_t nbf, size_t nbe_bra, 
+    size_t nbe_ket, size_t nshells_ket, const int32_t* shell_list_ket,
+    const BasisSet<double>& basis, const double* basis_eval, 
+    const submat_map_t& submat_map_bra, const submat_map_t& submat_map_ket, 
+    const double* G, size_t ldg, double* K, size_t ldk ) = 0;
+  virtual void inc_exx_k_cart_packed( size_t npts, size_t nbf, size_t nbe_bra, 
+    size_t nbe_ket, size_t nshells_ket, const int32_t* shell_list_ket,
+    const BasisSet<double>& basis, const double* basis_eval, 
+    const submat_map_t& submat_map_bra, const submat_map_t& submat_map_ket, 
+    const double* G, size_t ldg, double* K_packed ) = 0;
     
   virtual void eval_uvvar_lda_rks( size_t npts, size_t nbe, const double* basis_eval,
     const double* X, size_t ldx, double* den_eval) = 0;
@@ -169,6 +229,18 @@ struct LocalHostWorkDriverPIMPL {
   virtual void inc_vxc( size_t npts, size_t nbf, size_t nbe, 
     const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
     size_t ldz, double* VXC, size_t ldvxc, double* scr ) = 0;
+  virtual void inc_vxc_packed( size_t npts, size_t nbf, size_t nbe, 
+    const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
+    size_t ldz, double* VXC_packed, double* scr ) = 0;
+
+  // Fused task kernels, optional
+  virtual bool supports_fused_exc_vxc() const;
+  virtual void eval_exc_vxc_fused( const functional_type& func, size_t npts, 
+    size_t nbf, size_t nbe, size_t nshells, const double* points, 
+    const double* weights, const BasisSet<double>& basis, 
+    const int32_t* shell_list, const submat_map_t& submat_map, 
+    const double* Ps, size_t ldps, const double* Pz, size_t ldpz, 
+    double* VXCs, double* VXCz, double* EXC, double* N_EL );
 
 };
 
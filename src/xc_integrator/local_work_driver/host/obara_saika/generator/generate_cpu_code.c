@@ -582,7 +582,7 @@ void generate_diagonal_files(FILE *f, int lA, int size, struct node *root_node,
   fprintf(f, "  __typeof__ (b) _b = (b);		\\\n");
   fprintf(f, "  _a < _b ? _a : _b; })\n");
   fprintf(f, "\n");
-  fprintf(f, "namespace XCPU {\n");
+  fprintf(f, "namespace XCPU::XCPU_OS_ISA {\n");
   fprintf(f, "void integral_%d(size_t npts,\n", lA);
   fprintf(f, "               double *_points,\n");
   fprintf(f, "               point rA,\n");
@@ -796,7 +796,7 @@ void generate_off_diagonal_files(FILE *f, int lA, int lB, int size, struct node
   fprintf(f, "  __typeof__ (b) _b = (b);		\\\n");
   fprintf(f, "  _a < _b ? _a : _b; })\n");
   fprintf(f, "\n");
-  fprintf(f, "namespace XCPU {\n");
+  fprintf(f, "namespace XCPU::XCPU_OS_ISA {\n");
   fprintf(f, "void integral_%d_%d(size_t npts,\n", lA, lB);
   fprintf(f, "                  double *_points,\n");
   fprintf(f, "                  point rA,\n");
@@ -1018,7 +1018,8 @@ void generate_diagonal_header_files(int lA) {
   fprintf(f, "#define __MY_INTEGRAL_%d\n", lA);
   fprintf(f, "\n");
   fprintf(f, "#include \"../include/integral_data_types.hpp\"\n");
-  fprintf(f, "namespace XCPU {\n");
+  fprintf(f, "#include \"obara_saika_isa.hpp\"\n");
+  fprintf(f, "namespace XCPU::XCPU_OS_ISA {\n");
   fprintf(f, "void integral_%d(size_t npts,\n", lA);
   fprintf(f, "               double *points,\n");
   fprintf(f, "               point rA,\n");
@@ -1049,7 +1050,8 @@ void generate_off_diagonal_header_files(int lA, int lB) {
   fprintf(f, "#define __MY_INTEGRAL_%d_%d\n", lA, lB);
   fprintf(f, "\n");
   fprintf(f, "#include \"../include/integral_data_types.hpp\"\n");
-  fprintf(f, "namespace XCPU {\n");
+  fprintf(f, "#include \"obara_saika_isa.hpp\"\n");
+  fprintf(f, "namespace XCPU::XCPU_OS_ISA {\n");
   fprintf(f, "void integral_%d_%d(size_t npts,\n", lA, lB);
   fprintf(f, "                  double *points,\n");
   fprintf(f, "                  point rA,\n");
@@ -1071,51 +1073,22 @@ void generate_off_diagonal_header_files(int lA, int lB) {
   fclose(f);
 }
 
+/*
+ * Per ISA (lA,lB) dispatch of the shell pair kernels. The public
+ * XCPU::compute_integral_shell_pair (obara_saika_integrals.cxx) selects
+ * the ISA build at runtime and is maintained by hand.
+ */
 void generate_main_files(int lA) {
   char filename[512];
 
   FILE *f;
   
-  sprintf(filename, "obara_saika_integrals.hpp");
+  sprintf(filename, "integral_shell_pair.cxx");
       
   f = fopen(filename, "w");
 
-  fprintf(f, "#ifndef __MY_INTEGRAL_OBARA_SAIKA\n");
-  fprintf(f, "#define __MY_INTEGRAL_OBARA_SAIKA\n");
-  fprintf(f, "\n");
-  fprintf(f, "namespace XCPU {\n");
-  fprintf(f, "void generate_shell_pair( const shells& A, const shells& B, prim_pair *prim_pairs);\n");
-  fprintf(f, "void compute_integral_shell_pair(int is_diag,\n");
-  fprintf(f, "                  size_t npts,\n");
-  fprintf(f, "                  double *points,\n");
-  fprintf(f, "                  int lA,\n");
-  fprintf(f, "                  int lB,\n");
-  fprintf(f, "                  point rA,\n");
-  fprintf(f, "                  point rB,\n");
-  fprintf(f, "                  int nprim_pairs,\n");
-  fprintf(f, "                  prim_pair *prim_pairs,\n");  
-  fprintf(f, "                  double *Xi,\n");
-  fprintf(f, "                  double *Xj,\n");
-  fprintf(f, "                  int ldX,\n");	 
-  fprintf(f, "                  double *Gi,\n");
-  fprintf(f, "                  double *Gj,\n");
-  fprintf(f, "                  int ldG, \n");
-  fprintf(f, "                  double *weights, \n");
-  fprintf(f, "                  double *boys_table);\n");
-  fprintf(f, "}\n");
-  fprintf(f, "\n");
-  fprintf(f, "#endif\n");
-  
-  fclose(f);  
-
-  sprintf(filename, "obara_saika_integrals.cxx");
-      
-  f = fopen(filename, "w");
-
-  fprintf(f, "#include <stdio.h>\n");
-  fprintf(f, "#include <stdlib.h>\n");
-  fprintf(f, "#include \"../include/integral_data_types.hpp\"\n");
-  fprintf(f, "#include \"../include/obara_saika_integrals.hpp\"\n");
+  fprintf(f, "#include \"../include/cpu/integral_data_types.hpp\"\n");
+  fprintf(f, "#include \"integral_shell_pair.hpp\"\n");
   for(int i = 0; i <= lA; ++i) {
     fprintf(f, "#include \"integral_%d.hpp\"\n", i);
   }
@@ -1125,53 +1098,9 @@ void generate_main_files(int lA) {
       fprintf(f, "#include \"integral_%d_%d.hpp\"\n", i, j);
     }
   }
+  fprintf(f, "#include <stdio.h>\n");
 
-  fprintf(f, "namespace XCPU {\n");
-  fprintf(f, "void generate_shell_pair( const shells& A, const shells& B, prim_pair *prim_pairs) {\n");
-  fprintf(f, "   // L Values\n");
-  fprintf(f, "   const auto xA = A.origin.x;\n");
-  fprintf(f, "   const auto yA = A.origin.y;\n");
-  fprintf(f, "   const auto zA = A.origin.z;\n\n");
-
-  fprintf(f, "   const auto xB = B.origin.x;\n");
-  fprintf(f, "   const auto yB = B.origin.y;\n");
-  fprintf(f, "   const auto zB = B.origin.z;\n\n");
-
-  fprintf(f, "   double rABx = xA - xB;\n");
-  fprintf(f, "   double rABy = yA - yB;\n");
-  fprintf(f, "   double rABz = zA - zB;\n\n");
-
-  fprintf(f, "   const double dAB = rABx*rABx + rABy*rABy + rABz*rABz;\n\n");
-
-  fprintf(f, "   const int nprim_A = A.m;\n");
-  fprintf(f, "   const int nprim_B = B.m;\n");
-
-  fprintf(f, "   for(int i = 0, ij = 0; i < nprim_A; ++i       )\n");
-  fprintf(f, "   for(int j = 0        ; j < nprim_B; ++j, ++ij ) {\n");
-  fprintf(f, "      auto& pair = prim_pairs[ij];\n");
-
-  fprintf(f, "      const auto alpha_A = A.coeff[i].alpha;\n");
-  fprintf(f, "      const auto alpha_B = B.coeff[j].alpha;\n\n");
-
-  fprintf(f, "      pair.gamma = alpha_A + alpha_B;\n");
-  fprintf(f, "      pair.gamma_inv = 1. / pair.gamma;\n\n");
-
-  fprintf(f, "      pair.P.x = (alpha_A * xA + alpha_B * xB) * pair.gamma_inv;\n");
-  fprintf(f, "      pair.P.y = (alpha_A * yA + alpha_B * yB) * pair.gamma_inv;\n");
-  fprintf(f, "      pair.P.z = (alpha_A * zA + alpha_B * zB) * pair.gamma_inv;\n\n");
-
-  fprintf(f, "      pair.PA.x = pair.P.x - xA;\n");
-  fprintf(f, "      pair.PA.y = pair.P.y - yA;\n");
-  fprintf(f, "      pair.PA.z = pair.P.z - zA;\n\n");
-
-  fprintf(f, "      pair.PB.x = pair.P.x - xB;\n");
-  fprintf(f, "      pair.PB.y = pair.P.y - yB;\n");
-  fprintf(f, "      pair.PB.z = pair.P.z - zB;\n\n");
-  fprintf(f, "      pair.K_coeff_prod = 2 * M_PI * pair.gamma_inv * std::exp( - alpha_A * alpha_B * dAB * pair.gamma_inv ) * A.coeff[i].coeff * B.coeff[j].coeff;\n");
-  fprintf(f, "   }\n");
-  fprintf(f, "}\n");
-  
-  fprintf(f, "\n");
+  fprintf(f, "namespace XCPU::XCPU_OS_ISA {\n");
   fprintf(f, "void compute_integral_shell_pair(int is_diag,\n");
   fprintf(f, "                  size_t npts,\n");
   fprintf(f, "                  double *points,\n");
@@ -7,7 +7,12 @@
  */
 #pragma once
 
-#include <gauxc/util/constexpr_math.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <gauxc/gauxc_config.hpp>
+#include "obara_saika_isa.hpp"
 
 #define NPTS_LOCAL 64
 
@@ -18,9 +23,38 @@
 #define DEFAULT_NSEGMENT ((DEFAULT_MAX_T * DEFAULT_NCHEB) / 2)
 #define DEFAULT_LD_TABLE (DEFAULT_NCHEB + 1)
 
-namespace XCPU {
+namespace XCPU::XCPU_OS_ISA {
 
   constexpr double shpair_screen_tol = 1e-12;
+  constexpr double sqrt_pi_ov_2      = 0.88622692545275801364;
+
+  // Internal linkage copies of std::min, std::abs and GauXC::rsqrt: these
+  // kernels are compiled with different ISA flags, and any out-of-line copy
+  // of a shared inline function emitted here could otherwise be picked by
+  // the linker for every other TU (see obara_saika_isa.hpp)
+  namespace {
+
+  inline size_t os_min( size_t a, size_t b ) { return a < b ? a : b; }
+  inline double os_abs( double x ) { return fabs(x); }
+
+  inline double os_rsqrt( double x ) {
+#ifdef GAUXC_USE_FAST_RSQRT
+    double y = x;
+    double x2 = y * 0.5;
+    int64_t i;
+    memcpy( &i, &y, sizeof(i) );
+    i = 0x5fe6eb50c7b537a9 - (i >> 1);
+    memcpy( &y, &i, sizeof(y) );
+    y = y * (1.5 - (x2 * y * y));
+    y = y * (1.5 - (x2 * y * y));
+    return y;
+#else
+    x = 1.0 / x;
+    return sqrt(x);
+#endif
+  }
+
+  }
 
   template <int M>
   inline void boys_element(double *T, double *T_inv_e, double *eval, double *boys_table) {
@@ -29,7 +63,7 @@ namespace XCPU {
 	const double sqrt_t = std::sqrt((*T));
 	const double inv_sqrt_t = 1./sqrt_t;
 	*(T_inv_e) = 0.0;
-	*(eval) = GauXC::constants::sqrt_pi_ov_2<> * std::erf(sqrt_t) * inv_sqrt_t;
+	*(eval) = sqrt_pi_ov_2 * std::erf(sqrt_t) * inv_sqrt_t;
       } else {
 	const double* boys_m = (boys_table + M * DEFAULT_LD_TABLE * DEFAULT_NSEGMENT);
 	constexpr double deltaT = double(DEFAULT_MAX_T) / DEFAULT_NSEGMENT;
@@ -56,8 +90,8 @@ namespace XCPU {
       }
     } else {
       const double t_inv = 1./(*T);
-      //double _val = GauXC::constants::sqrt_pi_ov_2<> * std::sqrt(t_inv);
-      double _val = GauXC::constants::sqrt_pi_ov_2<> * GauXC::rsqrt(*T);
+      //double _val = sqrt_pi_ov_2 * std::sqrt(t_inv);
+      double _val = sqrt_pi_ov_2 * os_rsqrt(*T);
     
       for(int i = 1; i < M + 1; ++i) {
 	_val *= ((i - 0.5) * t_inv);
@@ -77,7 +111,7 @@ namespace XCPU {
 	  const double inv_sqrt_t = 1./sqrt_t;
 	  
 	  T_inv_e[i] = 0.0;
-	  eval[i] = GauXC::constants::sqrt_pi_ov_2<> * std::erf(sqrt_t) * inv_sqrt_t;
+	  eval[i] = sqrt_pi_ov_2 * std::erf(sqrt_t) * inv_sqrt_t;
 	} else {
 	  const double* boys_m = (boys_table + M * DEFAULT_LD_TABLE * DEFAULT_NSEGMENT);
 	  constexpr double deltaT = double(DEFAULT_MAX_T) / DEFAULT_NSEGMENT;
@@ -102,8 +136,8 @@ namespace XCPU {
 	}
       } else {
 	const double t_inv = 1./T[i];
-	//double _val = GauXC::constants::sqrt_pi_ov_2<> * std::sqrt(t_inv);
-    double _val = GauXC::constants::sqrt_pi_ov_2<> * GauXC::rsqrt(T[i]);
+	//double _val = sqrt_pi_ov_2 * std::sqrt(t_inv);
+    double _val = sqrt_pi_ov_2 * os_rsqrt(T[i]);
       
 	for(int j = 1; j < M + 1; ++j) {
 	  _val *= ((j - 0.5) * t_inv);
@@ -118,7 +152,7 @@ namespace XCPU {
 
   inline double boys_element_0( double T ) {
     if( T > 26.0 ) {
-      return 0.88622692545275801364 * GauXC::rsqrt(T);
+      return 0.88622692545275801364 * os_rsqrt(T);
     } else if( T < 13.0 ) {
       const auto exp_t = exp( - T * 0.33333333333333333333 );
 
@@ -197,9 +231,9 @@ namespace XCPU {
 #define SCALAR_DUPLICATE(x) (*(x))
 
 // AVX-512 SIMD Types
-#if __AVX512F__ && __has_include(<zmmintrin.h>)
+#if __AVX512F__
 
-  #include <zmmintrin.h>
+  #include <immintrin.h>
   
   #define SIMD_TYPE __m512d
   
@@ -13,7 +13,7 @@
 
 #define PI 3.14159265358979323846
 
-namespace XCPU {
+namespace XCPU::XCPU_OS_ISA {
 void integral_1_0(size_t npts,
                   double *_points,
                   point /*rA*/,
@@ -53,7 +53,7 @@ void integral_1_0(size_t npts,
          double zP = prim_pairs[ij].P.z;
 
          double eval = prim_pairs[ij].K_coeff_prod;
-         if(std::abs(eval) < shpair_screen_tol) continue;
+         if(os_abs(eval) < shpair_screen_tol) continue;
 
          // Evaluate T Values
          for(size_t p_inner = 0; p_inner < NPTS_LOCAL; p_inner += SIMD_LENGTH) {
@@ -164,7 +164,7 @@ void integral_1_0(size_t npts,
    }
 
    for(; p_outer < npts; p_outer += NPTS_LOCAL) {
-     size_t npts_inner = std::min((size_t) NPTS_LOCAL, npts - p_outer);
+     size_t npts_inner = os_min((size_t) NPTS_LOCAL, npts - p_outer);
       double *_point_outer = (_points + p_outer);
 
       for(int i = 0; i < 3 * NPTS_LOCAL; i += SIMD_LENGTH) SIMD_ALIGNED_STORE((temp + i), SIMD_ZERO());
@@ -180,7 +180,7 @@ void integral_1_0(size_t npts,
          double zP = prim_pairs[ij].P.z;
 
          double eval = prim_pairs[ij].K_coeff_prod;
-         if(std::abs(eval) < shpair_screen_tol) continue;
+         if(os_abs(eval) < shpair_screen_tol) continue;
 
          // Evaluate T Values
          size_t npts_inner_upper = SIMD_LENGTH * (npts_inner / SIMD_LENGTH);
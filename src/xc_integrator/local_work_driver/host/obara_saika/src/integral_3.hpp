@@ -9,7 +9,8 @@
 #define __MY_INTEGRAL_3
 
 #include "../include/cpu/integral_data_types.hpp"
-namespace XCPU {
+#include "obara_saika_isa.hpp"
+namespace XCPU::XCPU_OS_ISA {
 void integral_3(size_t npts,
                double *points,
                point rA,
@@ -13,7 +13,7 @@
 
 #define PI 3.14159265358979323846
 
-namespace XCPU {
+namespace XCPU::XCPU_OS_ISA {
 void integral_4_1(size_t npts,
                   double *_points,
                   point rA,
@@ -1661,7 +1661,7 @@ void integral_4_1(size_t npts,
    }
 
    for(; p_outer < npts; p_outer += NPTS_LOCAL) {
-      size_t npts_inner = std::min((size_t) NPTS_LOCAL, npts - p_outer);
+      size_t npts_inner = os_min((size_t) NPTS_LOCAL, npts - p_outer);
       double *_point_outer = (_points + p_outer);
 
       double X_AB = rA.x - rB.x;
@@ -0,0 +1,499 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "../include/cpu/integral_data_types.hpp"
+#include "integral_shell_pair.hpp"
+#include "integral_0.hpp"
+#include "integral_1.hpp"
+#include "integral_2.hpp"
+#include "integral_3.hpp"
+#include "integral_4.hpp"
+#include "integral_0_0.hpp"
+#include "integral_1_0.hpp"
+#include "integral_1_1.hpp"
+#include "integral_2_0.hpp"
+#include "integral_2_1.hpp"
+#include "integral_2_2.hpp"
+#include "integral_3_0.hpp"
+#include "integral_3_1.hpp"
+#include "integral_3_2.hpp"
+#include "integral_3_3.hpp"
+#include "integral_4_0.hpp"
+#include "integral_4_1.hpp"
+#include "integral_4_2.hpp"
+#include "integral_4_3.hpp"
+#include "integral_4_4.hpp"
+#include <stdio.h>
+namespace XCPU::XCPU_OS_ISA {
+void compute_integral_shell_pair(int is_diag,
+                  size_t npts,
+                  double *points,
+                  int lA,
+                  int lB,
+                  point rA,
+                  point rB,
+                  int nprim_pairs,
+                  prim_pair *prim_pairs,
+                  double *Xi,
+                  double *Xj,
+                  int ldX,
+                  double *Gi,
+                  double *Gj,
+                  int ldG, 
+                  double *weights, 
+                  double *boys_table) {
+   if (is_diag) {
+      if(lA == 0) {
+         integral_0(npts,
+                    points,
+                    rA,
+                    rB,
+                    nprim_pairs,
+                    prim_pairs,
+                    Xi,
+                    ldX,
+                    Gi,
+                    ldG, 
+                    weights, 
+                    boys_table);
+      } else if(lA == 1) {
+        integral_1(npts,
+                    points,
+                   rA,
+                   rB,
+                   nprim_pairs,
+                   prim_pairs,
+                   Xi,
+                   ldX,
+                   Gi,
+                   ldG, 
+                   weights, 
+                   boys_table);
+      } else if(lA == 2) {
+        integral_2(npts,
+                    points,
+                   rA,
+                   rB,
+                   nprim_pairs,
+                   prim_pairs,
+                   Xi,
+                   ldX,
+                   Gi,
+                   ldG, 
+                   weights, 
+                   boys_table);
+      } else if(lA == 3) {
+        integral_3(npts,
+                    points,
+                   rA,
+                   rB,
+                   nprim_pairs,
+                   prim_pairs,
+                   Xi,
+                   ldX,
+                   Gi,
+                   ldG, 
+                   weights, 
+                   boys_table);
+      } else if(lA == 4) {
+        integral_4(npts,
+                    points,
+                   rA,
+                   rB,
+                   nprim_pairs,
+                   prim_pairs,
+                   Xi,
+                   ldX,
+                   Gi,
+                   ldG, 
+                   weights, 
+                   boys_table);
+      } else {
+         printf("Type not defined!\n");
+      }
+   } else {
+      if((lA == 0) && (lB == 0)) {
+         integral_0_0(npts,
+                      points,
+                      rA,
+                      rB,
+                      nprim_pairs,
+                      prim_pairs,
+                      Xi,
+                      Xj,
+                      ldX,
+                      Gi,
+                      Gj,
+                      ldG, 
+                      weights, 
+                      boys_table);
+      } else if((lA == 1) && (lB == 0)) {
+            integral_1_0(npts,
+                         points,
+                         rA,
+                         rB,
+                         nprim_pairs,
+                         prim_pairs,
+                         Xi,
+                         Xj,
+                         ldX,
+                         Gi,
+                         Gj,
+                         ldG, 
+                         weights, 
+                         boys_table);
+      } else if((lA == 0) && (lB == 1)) {
+         integral_1_0(npts,
+                      points,
+                      rB,
+                      rA,
+                      nprim_pairs,
+                      prim_pairs,
+                      Xj,
+                      Xi,
+                      ldX,
+                      Gj,
+                      Gi,
+                      ldG, 
+                      weights, 
+                      boys_table);
+      } else if((lA == 1) && (lB == 1)) {
+        integral_1_1(npts,
+                     points,
+                     rA,
+                     rB,
+                     nprim_pairs,
+                     prim_pairs,
+                     Xi,
+                     Xj,
+                     ldX,
+                     Gi,
+                     Gj,
+                     ldG, 
+                     weights, 
+                     boys_table);
+      } else if((lA == 2) && (lB == 0)) {
+            integral_2_0(npts,
+                         points,
+                         rA,
+                         rB,
+                         nprim_pairs,
+                         prim_pairs,
+                         Xi,
+                         Xj,
+                         ldX,
+                         Gi,
+                         Gj,
+                         ldG, 
+                         weights, 
+                         boys_table);
+      } else if((lA == 0) && (lB == 2)) {
+         integral_2_0(npts,
+                      points,
+                      rB,
+                      rA,
+                      nprim_pairs,
+                      prim_pairs,
+                      Xj,
+                      Xi,
+                      ldX,
+                      Gj,
+                      Gi,
+                      ldG, 
+                      weights, 
+                      boys_table);
+      } else if((lA == 2) && (lB == 1)) {
+            integral_2_1(npts,
+                         points,
+                         rA,
+                         rB,
+                         nprim_pairs,
+                         prim_pairs,
+                         Xi,
+                         Xj,
+                         ldX,
+                         Gi,
+                         Gj,
+                         ldG, 
+                         weights, 
+                         boys_table);
+      } else if((lA == 1) && (lB == 2)) {
+         integral_2_1(npts,
+                      points,
+                      rB,
+                      rA,
+                      nprim_pairs,
+                      prim_pairs,
+                      Xj,
+                      Xi,
+                      ldX,
+                      Gj,
+                      Gi,
+                      ldG, 
+                      weights, 
+                      boys_table);
+      } else if((lA == 2) && (lB == 2)) {
+        integral_2_2(npts,
+                     points,
+                     rA,
+                     rB,
+                     nprim_pairs,
+                     prim_pairs,
+                     Xi,
+                     Xj,
+                     ldX,
+                     Gi,
+                     Gj,
+                     ldG, 
+                     weights, 
+                     boys_table);
+      } else if((lA == 3) && (lB == 0)) {
+            integral_3_0(npts,
+                         points,
+                         rA,
+                         rB,
+                         nprim_pairs,
+                         prim_pairs,
+                         Xi,
+                         Xj,
+                         ldX,
+                         Gi,
+                         Gj,
+                         ldG, 
+                         weights, 
+                         boys_table);
+      } else if((lA == 0) && (lB == 3)) {
+         integral_3_0(npts,
+                      points,
+                      rB,
+                      rA,
+                      nprim_pairs,
+                      prim_pairs,
+                      Xj,
+                      Xi,
+                      ldX,
+                      Gj,
+                      Gi,
+                      ldG, 
+                      weights, 
+                      boys_table);
+      } else if((lA == 3) && (lB == 1)) {
+            integral_3_1(npts,
+                         points,
+                         rA,
+                         rB,
+                         nprim_pairs,
+                         prim_pairs,
+                         Xi,
+                         Xj,
+                         ldX,
+                         Gi,
+                         Gj,
+                         ldG, 
+                         weights, 
+                         boys_table);
+      } else if((lA == 1) && (lB == 3)) {
+         integral_3_1(npts,
+                      points,
+                      rB,
+                      rA,
+                      nprim_pairs,
+                      prim_pairs,
+                      Xj,
+                      Xi,
+                      ldX,
+                      Gj,
+                      Gi,
+                      ldG, 
+                      weights, 
+                      boys_table);
+      } else if((lA == 3) && (lB == 2)) {
+            integral_3_2(npts,
+                         points,
+                         rA,
+                         rB,
+                         nprim_pairs,
+                         prim_pairs,
+                         Xi,
+                         Xj,
+                         ldX,
+                         Gi,
+                         Gj,
+                         ldG, 
+                         weights, 
+                         boys_table);
+      } else if((lA == 2) && (lB == 3)) {
+         integral_3_2(npts,
+                      points,
+                      rB,
+                      rA,
+                      nprim_pairs,
+                      prim_pairs,
+                      Xj,
+                      Xi,
+                      ldX,
+                      Gj,
+                      Gi,
+                      ldG, 
+                      weights, 
+                      boys_table);
+      } else if((lA == 3) && (lB == 3)) {
+        integral_3_3(npts,
+                     points,
+                     rA,
+                     rB,
+                     nprim_pairs,
+                     prim_pairs,
+                     Xi,
+                     Xj,
+                     ldX,
+                     Gi,
+                     Gj,
+                     ldG, 
+                     weights, 
+                     boys_table);
+      } else if((lA == 4) && (lB == 0)) {
+            integral_4_0(npts,
+                         points,
+                         rA,
+                         rB,
+                         nprim_pairs,
+                         prim_pairs,
+                         Xi,
+                         Xj,
+                         ldX,
+                         Gi,
+                         Gj,
+                         ldG, 
+                         weights, 
+                         boys_table);
+      } else if((lA == 0) && (lB == 4)) {
+         integral_4_0(npts,
+                      points,
+                      rB,
+                      rA,
+                      nprim_pairs,
+                      prim_pairs,
+                      Xj,
+                      Xi,
+                      ldX,
+                      Gj,
+                      Gi,
+                      ldG, 
+                      weights, 
+                      boys_table);
+      } else if((lA == 4) && (lB == 1)) {
+            integral_4_1(npts,
+                         points,
+                         rA,
+                         rB,
+                         nprim_pairs,
+                         prim_pairs,
+                         Xi,
+                         Xj,
+                         ldX,
+                         Gi,
+                         Gj,
+                         ldG, 
+                         weights, 
+                         boys_table);
+      } else if((lA == 1) && (lB == 4)) {
+         integral_4_1(npts,
+                      points,
+                      rB,
+                      rA,
+                      nprim_pairs,
+                      prim_pairs,
+                      Xj,
+                      Xi,
+                      ldX,
+                      Gj,
+                      Gi,
+                      ldG, 
+                      weights, 
+                      boys_table);
+      } else if((lA == 4) && (lB == 2)) {
+            integral_4_2(npts,
+                         points,
+                         rA,
+                         rB,
+                         nprim_pairs,
+                         prim_pairs,
+                         Xi,
+                         Xj,
+                         ldX,
+                         Gi,
+                         Gj,
+                         ldG, 
+                         weights, 
+                         boys_table);
+      } else if((lA == 2) && (lB == 4)) {
+         integral_4_2(npts,
+                      points,
+                      rB,
+                      rA,
+                      nprim_pairs,
+                      prim_pairs,
+                      Xj,
+                      Xi,
+                      ldX,
+                      Gj,
+                      Gi,
+                      ldG, 
+                      weights, 
+                      boys_table);
+      } else if((lA == 4) && (lB == 3)) {
+            integral_4_3(npts,
+                         points,
+                         rA,
+                         rB,
+                         nprim_pairs,
+                         prim_pairs,
+                         Xi,
+                         Xj,
+                         ldX,
+                         Gi,
+                         Gj,
+                         ldG, 
+                         weights, 
+                         boys_table);
+      } else if((lA == 3) && (lB == 4)) {
+         integral_4_3(npts,
+                      points,
+                      rB,
+                      rA,
+                      nprim_pairs,
+                      prim_pairs,
+                      Xj,
+                      Xi,
+                      ldX,
+                      Gj,
+                      Gi,
+                      ldG, 
+                      weights, 
+                      boys_table);
+      } else if((lA == 4) && (lB == 4)) {
+        integral_4_4(npts,
+                     points,
+                     rA,
+                     rB,
+                     nprim_pairs,
+                     prim_pairs,
+                     Xi,
+                     Xj,
+                     ldX,
+                     Gi,
+                     Gj,
+                     ldG, 
+                     weights, 
+                     boys_table);
+      } else {
+         printf("Type not defined!\n");
+      }
+   }
+}
+}
@@ -0,0 +1,48 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include "../include/cpu/integral_data_types.hpp"
+
+namespace XCPU {
+
+/// Shell pair kernel, dispatches on (lA,lB) within a single ISA build
+using integral_shell_pair_type = void( int is_diag,
+                                       size_t npts,
+                                       double *points,
+                                       int lA,
+                                       int lB,
+                                       point rA,
+                                       point rB,
+                                       int nprim_pairs,
+                                       prim_pair *prim_pairs,
+                                       double *Xi,
+                                       double *Xj,
+                                       int ldX,
+                                       double *Gi,
+                                       double *Gj,
+                                       int ldG,
+                                       double *weights,
+                                       double *boys_table );
+
+// ISA builds of the kernels (see obara_saika_isa.hpp)
+namespace reference { integral_shell_pair_type compute_integral_shell_pair; }
+namespace avx2      { integral_shell_pair_type compute_integral_shell_pair; }
+namespace avx512    { integral_shell_pair_type compute_integral_shell_pair; }
+
+/**
+ *  Select the ISA build of the shell pair kernels
+ *
+ *  The widest build supported by both the library and the executing CPU
+ *  is chosen. The selection may be capped by setting GAUXC_OS_ISA to one
+ *  of "reference", "avx2" or "avx512" in the environment.
+ *  XCPU::compute_integral_shell_pair makes this selection once per process.
+ */
+integral_shell_pair_type* select_integral_shell_pair();
+
+}
@@ -7,28 +7,10 @@
  */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string>
 #include "../include/cpu/integral_data_types.hpp"
 #include "../include/cpu/obara_saika_integrals.hpp"
-#include "integral_0.hpp"
-#include "integral_1.hpp"
-#include "integral_2.hpp"
-#include "integral_3.hpp"
-#include "integral_4.hpp"
-#include "integral_0_0.hpp"
-#include "integral_1_0.hpp"
-#include "integral_1_1.hpp"
-#include "integral_2_0.hpp"
-#include "integral_2_1.hpp"
-#include "integral_2_2.hpp"
-#include "integral_3_0.hpp"
-#include "integral_3_1.hpp"
-#include "integral_3_2.hpp"
-#include "integral_3_3.hpp"
-#include "integral_4_0.hpp"
-#include "integral_4_1.hpp"
-#include "integral_4_2.hpp"
-#include "integral_4_3.hpp"
-#include "integral_4_4.hpp"
+#include "integral_shell_pair.hpp"
 namespace XCPU {
 void generate_shell_pair( const shells& A, const shells& B, prim_pair *prim_pairs) {
    // L Values
@@ -73,6 +55,27 @@ void generate_shell_pair( const shells& A, const shells& B, prim_pair *prim_pair
    }
 }
 
+integral_shell_pair_type* select_integral_shell_pair() {
+
+  const std::string isa = getenv("GAUXC_OS_ISA") ? getenv("GAUXC_OS_ISA") : "";
+  if( isa == "reference" ) return reference::compute_integral_shell_pair;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+  #ifdef GAUXC_OBARA_SAIKA_HAS_AVX512
+  if( (isa.empty() or isa == "avx512") and __builtin_cpu_supports("avx512f") )
+    return avx512::compute_integral_shell_pair;
+  #endif
+  #ifdef GAUXC_OBARA_SAIKA_HAS_AVX2
+  if( __builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma") )
+    return avx2::compute_integral_shell_pair;
+  #endif
+#endif
+
+  return reference::compute_integral_shell_pair;
+
+}
+
 void compute_integral_shell_pair(int is_diag,
                   size_t npts,
                   double *points,
@@ -90,454 +93,9 @@ void compute_integral_shell_pair(int is_diag,
                   int ldG, 
                   double *weights, 
                   double *boys_table) {
-   if (is_diag) {
-      if(lA == 0) {
-         integral_0(npts,
-                    points,
-                    rA,
-                    rB,
-                    nprim_pairs,
-                    prim_pairs,
-                    Xi,
-                    ldX,
-                    Gi,
-                    ldG, 
-                    weights, 
-                    boys_table);
-      } else if(lA == 1) {
-        integral_1(npts,
-                    points,
-                   rA,
-                   rB,
-                   nprim_pairs,
-                   prim_pairs,
-                   Xi,
-                   ldX,
-                   Gi,
-                   ldG, 
-                   weights, 
-                   boys_table);
-      } else if(lA == 2) {
-        integral_2(npts,
-                    points,
-                   rA,
-                   rB,
-                   nprim_pairs,
-                   prim_pairs,
-                   Xi,
-                   ldX,
-                   Gi,
-                   ldG, 
-                   weights, 
-                   boys_table);
-      } else if(lA == 3) {
-        integral_3(npts,
-                    points,
-                   rA,
-                   rB,
-                   nprim_pairs,
-                   prim_pairs,
-                   Xi,
-                   ldX,
-                   Gi,
-                   ldG, 
-                   weights, 
-                   boys_table);
-      } else if(lA == 4) {
-        integral_4(npts,
-                    points,
-                   rA,
-                   rB,
-                   nprim_pairs,
-                   prim_pairs,
-                   Xi,
-                   ldX,
-                   Gi,
-                   ldG, 
-                   weights, 
-                   boys_table);
-      } else {
-         printf("Type not defined!\n");
-      }
-   } else {
-      if((lA == 0) && (lB == 0)) {
-         integral_0_0(npts,
-                      points,
-                      rA,
-                      rB,
-                      nprim_pairs,
-                      prim_pairs,
-                      Xi,
-                      Xj,
-                      ldX,
-                      Gi,
-                      Gj,
-                      ldG, 
-                      weights, 
-                      boys_table);
-      } else if((lA == 1) && (lB == 0)) {
-            integral_1_0(npts,
-                         points,
-                         rA,
-                         rB,
-                         nprim_pairs,
-                         prim_pairs,
-                         Xi,
-                         Xj,
-                         ldX,
-                         Gi,
-                         Gj,
-                         ldG, 
-                         weights, 
-                         boys_table);
-      } else if((lA == 0) && (lB == 1)) {
-         integral_1_0(npts,
-                      points,
-                      rB,
-                      rA,
-                      nprim_pairs,
-                      prim_pairs,
-                      Xj,
-                      Xi,
-                      ldX,
-                      Gj,
-                      Gi,
-                      ldG, 
-                      weights, 
-                      boys_table);
-      } else if((lA == 1) && (lB == 1)) {
-        integral_1_1(npts,
-                     points,
-                     rA,
-                     rB,
-                     nprim_pairs,
-                     prim_pairs,
-                     Xi,
-                     Xj,
-                     ldX,
-                     Gi,
-                     Gj,
-                     ldG, 
-                     weights, 
-                     boys_table);
-      } else if((lA == 2) && (lB == 0)) {
-            integral_2_0(npts,
-                         points,
-                         rA,
-                         rB,
-                         nprim_pairs,
-                         prim_pairs,
-                         Xi,
-                         Xj,
-                         ldX,
-                         Gi,
-                         Gj,
-                         ldG, 
-                         weights, 
-                         boys_table);
-      } else if((lA == 0) && (lB == 2)) {
-         integral_2_0(npts,
-                      points,
-                      rB,
-                      rA,
-                      nprim_pairs,
-                      prim_pairs,
-                      Xj,
-                      Xi,
-                      ldX,
-                      Gj,
-                      Gi,
-                      ldG, 
-                      weights, 
-                      boys_table);
-      } else if((lA == 2) && (lB == 1)) {
-            integral_2_1(npts,
-                         points,
-                         rA,
-                         rB,
-                         nprim_pairs,
-                         prim_pairs,
-                         Xi,
-                         Xj,
-                         ldX,
-                         Gi,
-                         Gj,
-                         ldG, 
-                         weights, 
-                         boys_table);
-      } else if((lA == 1) && (lB == 2)) {
-         integral_2_1(npts,
-                      points,
-                      rB,
-                      rA,
-                      nprim_pairs,
-                      prim_pairs,
-                      Xj,
-                      Xi,
-                      ldX,
-                      Gj,
-                      Gi,
-                      ldG, 
-                      weights, 
-                      boys_table);
-      } else if((lA == 2) && (lB == 2)) {
-        integral_2_2(npts,
-                     points,
-                     rA,
-                     rB,
-                     nprim_pairs,
-                     prim_pairs,
-                     Xi,
-                     Xj,
-                     ldX,
-                     Gi,
-                     Gj,
-                     ldG, 
-                     weights, 
-                     boys_table);
-      } else if((lA == 3) && (lB == 0)) {
-            integral_3_0(npts,
-                         points,
-                         rA,
-                         rB,
-                         nprim_pairs,
-                         prim_pairs,
-                         Xi,
-                         Xj,
-                         ldX,
-                         Gi,
-                         Gj,
-                         ldG, 
-                         weights, 
-                         boys_table);
-      } else if((lA == 0) && (lB == 3)) {
-         integral_3_0(npts,
-                      points,
-                      rB,
-                      rA,
-                      nprim_pairs,
-                      prim_pairs,
-                      Xj,
-                      Xi,
-                      ldX,
-                      Gj,
-                      Gi,
-                      ldG, 
-                      weights, 
-                      boys_table);
-      } else if((lA == 3) && (lB == 1)) {
-            integral_3_1(npts,
-                         points,
-                         rA,
-                         rB,
-                         nprim_pairs,
-                         prim_pairs,
-                         Xi,
-                         Xj,
-                         ldX,
-                         Gi,
-                         Gj,
-                         ldG, 
-                         weights, 
-                         boys_table);
-      } else if((lA == 1) && (lB == 3)) {
-         integral_3_1(npts,
-                      points,
-                      rB,
-                      rA,
-                      nprim_pairs,
-                      prim_pairs,
-                      Xj,
-                      Xi,
-                      ldX,
-                      Gj,
-                      Gi,
-                      ldG, 
-                      weights, 
-                      boys_table);
-      } else if((lA == 3) && (lB == 2)) {
-            integral_3_2(npts,
-                         points,
-                         rA,
-                         rB,
-                         nprim_pairs,
-                         prim_pairs,
-                         Xi,
-                         Xj,
-                         ldX,
-                         Gi,
-                         Gj,
-                         ldG, 
-                         weights, 
-                         boys_table);
-      } else if((lA == 2) && (lB == 3)) {
-         integral_3_2(npts,
-                      points,
-                      rB,
-                      rA,
-                      nprim_pairs,
-                      prim_pairs,
-                      Xj,
-                      Xi,
-                      ldX,
-                      Gj,
-                      Gi,
-                      ldG, 
-                      weights, 
-                      boys_table);
-      } else if((lA == 3) && (lB == 3)) {
-        integral_3_3(npts,
-                     points,
-                     rA,
-                     rB,
-                     nprim_pairs,
-                     prim_pairs,
-                     Xi,
-                     Xj,
-                     ldX,
-                     Gi,
-                     Gj,
-                     ldG, 
-                     weights, 
-                     boys_table);
-      } else if((lA == 4) && (lB == 0)) {
-            integral_4_0(npts,
-                         points,
-                         rA,
-                         rB,
-                         nprim_pairs,
-                         prim_pairs,
-                         Xi,
-                         Xj,
-                         ldX,
-                         Gi,
-                         Gj,
-                         ldG, 
-                         weights, 
-                         boys_table);
-      } else if((lA == 0) && (lB == 4)) {
-         integral_4_0(npts,
-                      points,
-                      rB,
-                      rA,
-                      nprim_pairs,
-                      prim_pairs,
-                      Xj,
-                      Xi,
-                      ldX,
-                      Gj,
-                      Gi,
-                      ldG, 
-                      weights, 
-                      boys_table);
-      } else if((lA == 4) && (lB == 1)) {
-            integral_4_1(npts,
-                         points,
-                         rA,
-                         rB,
-                         nprim_pairs,
-                         prim_pairs,
-                         Xi,
-                         Xj,
-                         ldX,
-                         Gi,
-                         Gj,
-                         ldG, 
-                         weights, 
-                         boys_table);
-      } else if((lA == 1) && (lB == 4)) {
-         integral_4_1(npts,
-                      points,
-                      rB,
-                      rA,
-                      nprim_pairs,
-                      prim_pairs,
-                      Xj,
-                      Xi,
-                      ldX,
-                      Gj,
-                      Gi,
-                      ldG, 
-                      weights, 
-                      boys_table);
-      } else if((lA == 4) && (lB == 2)) {
-            integral_4_2(npts,
-                         points,
-                         rA,
-                         rB,
-                         nprim_pairs,
-                         prim_pairs,
-                         Xi,
-                         Xj,
-                         ldX,
-                         Gi,
-                         Gj,
-                         ldG, 
-                         weights, 
-                         boys_table);
-      } else if((lA == 2) && (lB == 4)) {
-         integral_4_2(npts,
-                      points,
-                      rB,
-                      rA,
-                      nprim_pairs,
-                      prim_pairs,
-                      Xj,
-                      Xi,
-                      ldX,
-                      Gj,
-                      Gi,
-                      ldG, 
-                      weights, 
-                      boys_table);
-      } else if((lA == 4) && (lB == 3)) {
-            integral_4_3(npts,
-                         points,
-                         rA,
-                         rB,
-                         nprim_pairs,
-                         prim_pairs,
-                         Xi,
-                         Xj,
-                         ldX,
-                         Gi,
-                         Gj,
-                         ldG, 
-                         weights, 
-                         boys_table);
-      } else if((lA == 3) && (lB == 4)) {
-         integral_4_3(npts,
-                      points,
-                      rB,
-                      rA,
-                      nprim_pairs,
-                      prim_pairs,
-                      Xj,
-                      Xi,
-                      ldX,
-                      Gj,
-                      Gi,
-                      ldG, 
-                      weights, 
-                      boys_table);
-      } else if((lA == 4) && (lB == 4)) {
-        integral_4_4(npts,
-                     points,
-                     rA,
-                     rB,
-                     nprim_pairs,
-                     prim_pairs,
-                     Xi,
-                     Xj,
-                     ldX,
-                     Gi,
-                     Gj,
-                     ldG, 
-                     weights, 
-                     boys_table);
-      } else {
-         printf("Type not defined!\n");
-      }
-   }
+
+   static integral_shell_pair_type* kernel = select_integral_shell_pair();
+   kernel( is_diag, npts, points, lA, lB, rA, rB, nprim_pairs, prim_pairs,
+           Xi, Xj, ldX, Gi, Gj, ldG, weights, boys_table );
 }
 }
@@ -0,0 +1,24 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+/**
+ *  The Obara-Saika kernels (integral_*.cxx, integral_shell_pair.cxx) are
+ *  compiled once with the flags of the library ("reference") and once per
+ *  additional target ISA (see CMakeLists.txt). Each build is placed in its
+ *  own namespace, XCPU::XCPU_OS_ISA, such that the inline helpers compiled
+ *  for different ISAs never alias. The kernels must not call inline
+ *  functions shared with the rest of the library (std::min, GauXC::rsqrt,
+ *  ...): the linker keeps a single out-of-line copy of those, which could
+ *  then be the one compiled for a wider ISA. Use the internal linkage
+ *  helpers of config_obara_saika.hpp instead.
+ *  XCPU::compute_integral_shell_pair selects the build at runtime.
+ */
+#ifndef XCPU_OS_ISA
+  #define XCPU_OS_ISA reference
+#endif
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <gauxc/basisset.hpp>
+#include "integrator_util/primitive_screening.hpp"
 
 namespace GauXC {
 
@@ -17,7 +18,8 @@ void gau2grid_collocation( size_t                  npts,
                            const double*           points, 
                            const BasisSet<double>& basis,
                            const int32_t*          shell_mask,
-                           double*                 basis_eval );
+                           double*                 basis_eval,
+                           const PrimitiveScreening* prims = nullptr );
 
 void gau2grid_collocation_gradient( size_t                  npts, 
                                     size_t                  nshells,
@@ -28,7 +30,32 @@ void gau2grid_collocation_gradient( size_t                  npts,
                                     double*                 basis_eval, 
                                     double*                 dbasis_x_eval, 
                                     double*                 dbasis_y_eval,
-                                    double*                 dbasis_z_eval );
+                                    double*                 dbasis_z_eval,
+                                    const PrimitiveScreening* prims = nullptr );
+
+/// Same as gau2grid_collocation for points of an atomic quadrature about 
+/// center, radial factors of on-center shells are shared between points 
+/// on the same radial node
+void gau2grid_collocation_atomic( size_t                  npts, 
+                                  size_t                  nshells,
+                                  size_t                  nbe,
+                                  const double*           points, 
+                                  const BasisSet<double>& basis,
+                                  const int32_t*          shell_mask,
+                                  const double*           center,
+                                  double*                 basis_eval );
+
+void gau2grid_collocation_gradient_atomic( size_t                  npts, 
+                                           size_t                  nshells,
+                                           size_t                  nbe,
+                                           const double*           points, 
+                                           const BasisSet<double>& basis,
+                                           const int32_t*          shell_mask,
+                                           const double*           center,
+                                           double*                 basis_eval, 
+                                           double*                 dbasis_x_eval, 
+                                           double*                 dbasis_y_eval,
+                                           double*                 dbasis_z_eval );
 
 
 void gau2grid_collocation_hessian( size_t                  npts, 
@@ -48,6 +75,19 @@ void gau2grid_collocation_hessian( size_t                  npts,
                                    double*                 d2basis_yz_eval,
                                    double*                 d2basis_zz_eval);
 
+void gau2grid_collocation_laplacian( size_t                  npts, 
+                                     size_t                  nshells,
+                                     size_t                  nbe,
+                                     const double*           points, 
+                                     const BasisSet<double>& basis,
+                                     const int32_t*          shell_mask,
+                                     double*                 basis_eval, 
+                                     double*                 dbasis_x_eval, 
+                                     double*                 dbasis_y_eval,
+                                     double*                 dbasis_z_eval, 
+                                     double*                 lbasis_eval,
+                                     const PrimitiveScreening* prims = nullptr );
+
 void gau2grid_collocation_der3(    size_t                  npts,
                                    size_t                  nshells,
                                    size_t                  nbe,
@@ -6,6 +6,9 @@
  * See LICENSE.txt for details
  */
 #include "collocation.hpp"
+#include "integrator_util/host_arena.hpp"
+#include <algorithm>
+#include <cmath>
 
 
 #ifdef GAUXC_HAS_GAU2GRID
@@ -24,27 +27,29 @@ void gau2grid_collocation( size_t                  npts,
                            const double*           points, 
                            const BasisSet<double>& basis,
                            const int32_t*          shell_mask,
-                           double*                 basis_eval ) {
+                           double*                 basis_eval,
+                           const PrimitiveScreening* prims ) {
 
 #ifdef GAUXC_HAS_GAU2GRID
 
-  std::allocator<double> a;
-  auto* rv = a.allocate( npts * nbe );
+  auto& arena = HostArena::thread_arena();
+  HostArena::scope scratch_scope( arena );
+  auto* rv = arena.allocate<double>( npts * nbe );
 
   size_t ncomp = 0;
   for( size_t i = 0; i < nshells; ++i ) {
 
     const auto& sh = basis.at(shell_mask[i]);
+    const auto prim = task_primitives( sh, prims, i );
     int order = sh.pure() ? GG_SPHERICAL_CCA : GG_CARTESIAN_CCA; 
-    gg_collocation( sh.l(), npts, points, 3, sh.nprim(), sh.coeff_data(),
-      sh.alpha_data(), sh.O_data(), order, rv + ncomp*npts );
+    gg_collocation( sh.l(), npts, points, 3, prim.nprim, prim.coeff,
+      prim.alpha, sh.O_data(), order, rv + ncomp*npts );
 
     ncomp += sh.size();
 
   }
 
   gg_fast_transpose( ncomp, npts, rv, basis_eval );
-  a.deallocate( rv, npts*nbe );
 
 #else
   
@@ -81,12 +86,14 @@ void gau2grid_collocation_gradient( size_t                  npts,
                                     double*                 basis_eval, 
                                     double*                 dbasis_x_eval, 
                                     double*                 dbasis_y_eval,
-                                    double*                 dbasis_z_eval ) {
+                                    double*                 dbasis_z_eval,
+                                    const PrimitiveScreening* prims ) {
 
 #ifdef GAUXC_HAS_GAU2GRID
 
-  std::allocator<double> a;
-  auto* rv = a.allocate( 4 * npts * nbe );
+  auto& arena = HostArena::thread_arena();
+  HostArena::scope scratch_scope( arena );
+  auto* rv = arena.allocate<double>( 4 * npts * nbe );
   auto* rv_x = rv   + npts * nbe;
   auto* rv_y = rv_x + npts * nbe;
   auto* rv_z = rv_y + npts * nbe;
@@ -95,9 +102,10 @@ void gau2grid_collocation_gradient( size_t                  npts,
   for( size_t i = 0; i < nshells; ++i ) {
 
     const auto& sh = basis.at(shell_mask[i]);
+    const auto prim = task_primitives( sh, prims, i );
     int order = sh.pure() ? GG_SPHERICAL_CCA : GG_CARTESIAN_CCA; 
-    gg_collocation_deriv1( sh.l(), npts, points, 3, sh.nprim(), sh.coeff_data(),
-      sh.alpha_data(), sh.O_data(), order, rv + ncomp*npts, 
+    gg_collocation_deriv1( sh.l(), npts, points, 3, prim.nprim, prim.coeff,
+      prim.alpha, sh.O_data(), order, rv + ncomp*npts, 
       rv_x + ncomp*npts, rv_y + ncomp*npts, rv_z + ncomp*npts );
 
     ncomp += sh.size();
@@ -109,8 +117,6 @@ void gau2grid_collocation_gradient( size_t                  npts,
   gg_fast_transpose( ncomp, npts, rv_y, dbasis_y_eval );
   gg_fast_transpose( ncomp, npts, rv_z, dbasis_z_eval );
 
-  a.deallocate( rv, 4*npts*nbe );
-
 #else 
 
   for( size_t ipt = 0; ipt < npts;  ++ipt )
@@ -159,8 +165,9 @@ void gau2grid_collocation_hessian( size_t                  npts,
                                    double*                 d2basis_yz_eval,
                                    double*                 d2basis_zz_eval) {
 
-  std::allocator<double> a;
-  auto* rv = a.allocate( 10 * npts * nbe );
+  auto& arena = HostArena::thread_arena();
+  HostArena::scope scratch_scope( arena );
+  auto* rv = arena.allocate<double>( 10 * npts * nbe );
   auto* rv_x = rv   + npts * nbe;
   auto* rv_y = rv_x + npts * nbe;
   auto* rv_z = rv_y + npts * nbe;
@@ -198,7 +205,66 @@ void gau2grid_collocation_hessian( size_t                  npts,
   gg_fast_transpose( ncomp, npts, rv_yz, d2basis_yz_eval );
   gg_fast_transpose( ncomp, npts, rv_zz, d2basis_zz_eval );
 
-  a.deallocate( rv, 10*npts*nbe );
+}
+
+void gau2grid_collocation_laplacian( size_t                  npts, 
+                                     size_t                  nshells,
+                                     size_t                  nbe,
+                                     const double*           points, 
+                                     const BasisSet<double>& basis,
+                                     const int32_t*          shell_mask,
+                                     double*                 basis_eval, 
+                                     double*                 dbasis_x_eval, 
+                                     double*                 dbasis_y_eval,
+                                     double*                 dbasis_z_eval, 
+                                     double*                 lbasis_eval,
+                                     const PrimitiveScreening* prims ) {
+
+  auto& arena = HostArena::thread_arena();
+  HostArena::scope scratch_scope( arena );
+  auto* rv = arena.allocate<double>( 5 * npts * nbe );
+  auto* rv_x = rv   + npts * nbe;
+  auto* rv_y = rv_x + npts * nbe;
+  auto* rv_z = rv_y + npts * nbe;
+  auto* rv_l = rv_z + npts * nbe;
+
+  // gau2grid only provides the full hessian, which is only kept for a 
+  // single shell at a time
+  size_t max_shell_sz = 0;
+  for( size_t i = 0; i < nshells; ++i )
+    max_shell_sz = std::max<size_t>( max_shell_sz, basis.at(shell_mask[i]).size() );
+  auto* sh_hess = arena.allocate<double>( 6 * npts * max_shell_sz );
+  const size_t sh_len = npts * max_shell_sz;
+
+  size_t ncomp = 0;
+  for( size_t i = 0; i < nshells; ++i ) {
+
+    const auto& sh = basis.at(shell_mask[i]);
+    int order = sh.pure() ? GG_SPHERICAL_CCA : GG_CARTESIAN_CCA; 
+
+    const auto ioff = ncomp*npts;
+    auto* sh_xx = sh_hess;
+    auto* sh_yy = sh_xx + 3*sh_len;
+    auto* sh_zz = sh_xx + 5*sh_len;
+    const auto prim = task_primitives( sh, prims, i );
+    gg_collocation_deriv2( sh.l(), npts, points, 3, prim.nprim, prim.coeff,
+      prim.alpha, sh.O_data(), order, rv + ioff, rv_x + ioff, rv_y + ioff, 
+      rv_z + ioff, sh_xx, sh_xx + sh_len, sh_xx + 2*sh_len, sh_yy, 
+      sh_xx + 4*sh_len, sh_zz );
+
+    const size_t len = sh.size() * npts;
+    for( size_t j = 0; j < len; ++j )
+      rv_l[ioff + j] = sh_xx[j] + sh_yy[j] + sh_zz[j];
+
+    ncomp += sh.size();
+
+  }
+
+  gg_fast_transpose( ncomp, npts, rv,   basis_eval );
+  gg_fast_transpose( ncomp, npts, rv_x, dbasis_x_eval );
+  gg_fast_transpose( ncomp, npts, rv_y, dbasis_y_eval );
+  gg_fast_transpose( ncomp, npts, rv_z, dbasis_z_eval );
+  gg_fast_transpose( ncomp, npts, rv_l, lbasis_eval );
 
 }
 
@@ -230,8 +296,9 @@ void gau2grid_collocation_der3(    size_t                  npts,
                                    double*                 d3basis_yzz_eval,
                                    double*                 d3basis_zzz_eval) {
 
-  std::allocator<double> a;
-  auto* rv = a.allocate( 20 * npts * nbe );
+  auto& arena = HostArena::thread_arena();
+  HostArena::scope scratch_scope( arena );
+  auto* rv = arena.allocate<double>( 20 * npts * nbe );
   auto* rv_x = rv   + npts * nbe;
   auto* rv_y = rv_x + npts * nbe;
   auto* rv_z = rv_y + npts * nbe;
@@ -292,7 +359,334 @@ void gau2grid_collocation_der3(    size_t                  npts,
   gg_fast_transpose( ncomp, npts, rv_yzz, d3basis_yzz_eval );
   gg_fast_transpose( ncomp, npts, rv_zzz, d3basis_zzz_eval );
 
-  a.deallocate( rv, 20*npts*nbe );
+}
+
+
+#ifdef GAUXC_HAS_GAU2GRID
+namespace {
+
+/**
+ *  Radial nodes of a set of points with respect to a center
+ *
+ *  Points are grouped on (relative) coincidence of their squared distance
+ *  to the center, which identifies the radial nodes of points drawn from
+ *  an atomic quadrature centered there.
+ */
+struct radial_nodes {
+  size_t   nrad;  ///< Number of distinct radii
+  double*  r2;    ///< Squared radii (nrad)
+  int32_t* node;  ///< Radial node of each point (npts)
+  double*  xyz;   ///< Points relative to the center (SoA, 3 x npts)
+};
+
+radial_nodes gen_radial_nodes( HostArena& arena, size_t npts, 
+  const double* points, const double* center ) {
+
+  constexpr double r2_tol = 1e-12;
+
+  radial_nodes rn;
+  rn.r2   = arena.allocate<double>( npts );
+  rn.node = arena.allocate<int32_t>( npts );
+  rn.xyz  = arena.allocate<double>( 3 * npts );
+
+  auto* pt_r2 = arena.allocate<double>( npts );
+  auto* idx   = arena.allocate<int32_t>( npts );
+  for( size_t i = 0; i < npts; ++i ) {
+    const auto x = points[3*i + 0] - center[0];
+    const auto y = points[3*i + 1] - center[1];
+    const auto z = points[3*i + 2] - center[2];
+    rn.xyz[i] = x; rn.xyz[i + npts] = y; rn.xyz[i + 2*npts] = z;
+    pt_r2[i] = x*x + y*y + z*z;
+    idx[i] = i;
+  }
+
+  std::sort( idx, idx + npts, 
+    [&]( auto i, auto j ){ return pt_r2[i] < pt_r2[j]; } );
+
+  rn.nrad = 0;
+  for( size_t i = 0; i < npts; ++i ) {
+    const auto r2 = pt_r2[idx[i]];
+    if( not rn.nrad or r2 - rn.r2[rn.nrad-1] > r2_tol * r2 ) 
+      rn.r2[rn.nrad++] = r2;
+    rn.node[idx[i]] = rn.nrad - 1;
+  }
+
+  return rn;
+}
+
+/**
+ *  Evaluate the radial factors (and optionally their derivatives wrt r^2 
+ *  times 2) of an on-center shell at each radial node
+ */
+void eval_radial( const Shell<double>& sh, const radial_nodes& rn, double* R, 
+  double* dR ) {
+
+  const auto nprim = sh.nprim();
+  const auto* alpha = sh.alpha_data();
+  const auto* coeff = sh.coeff_data();
+  for( size_t k = 0; k < rn.nrad; ++k ) {
+    double r = 0., dr = 0.;
+    for( int32_t p = 0; p < nprim; ++p ) {
+      const auto e = coeff[p] * std::exp( -alpha[p] * rn.r2[k] );
+      r  += e;
+      dr -= 2. * alpha[p] * e;
+    }
+    R[k] = r;
+    if( dR ) dR[k] = dr;
+  }
+
+}
+
+/**
+ *  Shells whose origin lies within this distance of the center are taken as
+ *  centered on it, origins and atomic centers may differ in their last bits
+ *  (e.g. after unit conversion)
+ */
+inline bool is_on_center( const Shell<double>& sh, const double* center ) {
+  constexpr double center_tol = 1e-12;
+  const auto& O = sh.O();
+  const auto dx = O[0] - center[0];
+  const auto dy = O[1] - center[1];
+  const auto dz = O[2] - center[2];
+  return dx*dx + dy*dy + dz*dz <= center_tol * center_tol;
+}
+
+/**
+ *  Angular (polynomial) factors of the on-center shells of a task at each
+ *  point relative to the center. Generated by evaluating a unit, zero 
+ *  exponent shell for each (l, pure) pair present before the shells are
+ *  evaluated, and shared by all on-center shells of that pair.
+ */
+class angular_tables {
+
+  const double** tables_; ///< (l, pure) -> table, indexed 2*l + pure
+
+public:
+
+  /// Angular factors (+ gradient if deriv) in (comp,pts) blocks of the 
+  /// shells flagged in on_center
+  angular_tables( HostArena& arena, size_t npts, const double* points, 
+    const double* center, bool deriv, const BasisSet<double>& basis,
+    size_t nshells, const int32_t* shell_mask, const bool* on_center ) { 
+
+    const size_t ntables = 2 * (gg_max_L() + 1);
+    tables_ = arena.allocate<const double*>( ntables );
+    std::fill_n( tables_, ntables, nullptr );
+
+    const double one = 1., zero = 0.;
+    for( size_t i = 0; i < nshells; ++i ) {
+      if( not on_center[i] ) continue;
+      const auto& sh = basis.at(shell_mask[i]);
+      auto& tab = tables_[ 2*sh.l() + sh.pure() ];
+      if( tab ) continue;
+
+      const size_t len = sh.size() * npts;
+      auto* t = arena.allocate<double>( (deriv ? 4 : 1) * len );
+
+      const int order = sh.pure() ? GG_SPHERICAL_CCA : GG_CARTESIAN_CCA; 
+      if( deriv ) 
+        gg_collocation_deriv1( sh.l(), npts, points, 3, 1, &one, &zero, 
+          center, order, t, t + len, t + 2*len, t + 3*len );
+      else
+        gg_collocation( sh.l(), npts, points, 3, 1, &one, &zero, center, 
+          order, t );
+      tab = t;
+    }
+  }
+
+  inline const double* get( const Shell<double>& sh ) const {
+    return tables_[ 2*sh.l() + sh.pure() ];
+  }
+
+};
+
+/// Whether radial reuse pays off for a set of radial nodes
+inline bool use_radial_reuse( const radial_nodes& rn, size_t npts ) {
+  return 2 * rn.nrad <= npts;
+}
+
+/// Flag the on-center shells of a task
+bool* flag_on_center( HostArena& arena, const BasisSet<double>& basis,
+  size_t nshells, const int32_t* shell_mask, const double* center ) {
+  auto* on_center = arena.allocate<bool>( nshells );
+  for( size_t i = 0; i < nshells; ++i )
+    on_center[i] = is_on_center( basis.at(shell_mask[i]), center );
+  return on_center;
+}
+
+}
+#endif
+
+void gau2grid_collocation_atomic( size_t                  npts, 
+                                  size_t                  nshells,
+                                  size_t                  nbe,
+                                  const double*           points, 
+                                  const BasisSet<double>& basis,
+                                  const int32_t*          shell_mask,
+                                  const double*           center,
+                                  double*                 basis_eval ) {
+
+#ifdef GAUXC_HAS_GAU2GRID
+
+  auto& arena = HostArena::thread_arena();
+  HostArena::scope scratch_scope( arena );
+
+  auto rn = gen_radial_nodes( arena, npts, points, center );
+  if( not use_radial_reuse( rn, npts ) ) {
+    gau2grid_collocation( npts, nshells, nbe, points, basis, shell_mask, 
+      basis_eval );
+    return;
+  }
+
+  auto* rv = arena.allocate<double>( npts * nbe );
+  auto* R  = arena.allocate<double>( rn.nrad );
+  auto* Rp = arena.allocate<double>( npts );
+
+  const auto* on_center = flag_on_center( arena, basis, nshells, shell_mask,
+    center );
+  const angular_tables ang( arena, npts, points, center, false, basis, 
+    nshells, shell_mask, on_center );
+
+  size_t ncomp = 0;
+  for( size_t i = 0; i < nshells; ++i ) {
+
+    const auto& sh = basis.at(shell_mask[i]);
+    auto* sh_eval = rv + ncomp*npts;
+
+    if( on_center[i] ) {
+
+      // Radial factors at each point, shared by all components
+      eval_radial( sh, rn, R, nullptr );
+      for( size_t ipt = 0; ipt < npts; ++ipt ) Rp[ipt] = R[rn.node[ipt]];
+
+      const auto* S = ang.get( sh );
+      for( int32_t c = 0; c < sh.size(); ++c )
+      for( size_t ipt = 0; ipt < npts; ++ipt )
+        sh_eval[c*npts + ipt] = Rp[ipt] * S[c*npts + ipt];
+
+    } else {
+
+      int order = sh.pure() ? GG_SPHERICAL_CCA : GG_CARTESIAN_CCA; 
+      gg_collocation( sh.l(), npts, points, 3, sh.nprim(), sh.coeff_data(),
+        sh.alpha_data(), sh.O_data(), order, sh_eval );
+
+    }
+
+    ncomp += sh.size();
+
+  }
+
+  gg_fast_transpose( ncomp, npts, rv, basis_eval );
+
+#else
+
+  (void)center;
+  gau2grid_collocation( npts, nshells, nbe, points, basis, shell_mask, 
+    basis_eval );
+
+#endif
+
+}
+
+void gau2grid_collocation_gradient_atomic( size_t                  npts, 
+                                           size_t                  nshells,
+                                           size_t                  nbe,
+                                           const double*           points, 
+                                           const BasisSet<double>& basis,
+                                           const int32_t*          shell_mask,
+                                           const double*           center,
+                                           double*                 basis_eval, 
+                                           double*                 dbasis_x_eval, 
+                                           double*                 dbasis_y_eval,
+                                           double*                 dbasis_z_eval ) {
+
+#ifdef GAUXC_HAS_GAU2GRID
+
+  auto& arena = HostArena::thread_arena();
+  HostArena::scope scratch_scope( arena );
+
+  auto rn = gen_radial_nodes( arena, npts, points, center );
+  if( not use_radial_reuse( rn, npts ) ) {
+    gau2grid_collocation_gradient( npts, nshells, nbe, points, basis, 
+      shell_mask, basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+    return;
+  }
+
+  auto* rv = arena.allocate<double>( 4 * npts * nbe );
+  auto* rv_x = rv   + npts * nbe;
+  auto* rv_y = rv_x + npts * nbe;
+  auto* rv_z = rv_y + npts * nbe;
+
+  auto* R   = arena.allocate<double>( rn.nrad );
+  auto* dR  = arena.allocate<double>( rn.nrad );
+  auto* Rp  = arena.allocate<double>( npts );
+  auto* dRp = arena.allocate<double>( npts );
+
+  const auto* on_center = flag_on_center( arena, basis, nshells, shell_mask,
+    center );
+  const angular_tables ang( arena, npts, points, center, true, basis, 
+    nshells, shell_mask, on_center );
+
+  const auto* x = rn.xyz;
+  const auto* y = x + npts;
+  const auto* z = y + npts;
+
+  size_t ncomp = 0;
+  for( size_t i = 0; i < nshells; ++i ) {
+
+    const auto& sh = basis.at(shell_mask[i]);
+    const size_t off = ncomp*npts;
+
+    if( on_center[i] ) {
+
+      // phi = R(r) S(x,y,z) -> d/dx phi = R dS/dx + x S (1/r dR/dr)
+      eval_radial( sh, rn, R, dR );
+      for( size_t ipt = 0; ipt < npts; ++ipt ) {
+        Rp[ipt]  = R [rn.node[ipt]];
+        dRp[ipt] = dR[rn.node[ipt]];
+      }
+
+      const size_t len = sh.size() * npts;
+      const auto* S   = ang.get( sh );
+      const auto* S_x = S   + len;
+      const auto* S_y = S_x + len;
+      const auto* S_z = S_y + len;
+      for( int32_t c = 0; c < sh.size(); ++c )
+      for( size_t ipt = 0; ipt < npts; ++ipt ) {
+        const auto j   = c*npts + ipt;
+        const auto r   = Rp[ipt];
+        const auto drS = dRp[ipt] * S[j];
+        rv  [off + j] = r * S[j];
+        rv_x[off + j] = r * S_x[j] + x[ipt] * drS;
+        rv_y[off + j] = r * S_y[j] + y[ipt] * drS;
+        rv_z[off + j] = r * S_z[j] + z[ipt] * drS;
+      }
+
+    } else {
+
+      int order = sh.pure() ? GG_SPHERICAL_CCA : GG_CARTESIAN_CCA; 
+      gg_collocation_deriv1( sh.l(), npts, points, 3, sh.nprim(), sh.coeff_data(),
+        sh.alpha_data(), sh.O_data(), order, rv + off, rv_x + off, rv_y + off,
+        rv_z + off );
+
+    }
+
+    ncomp += sh.size();
+
+  }
+
+  gg_fast_transpose( ncomp, npts, rv,   basis_eval );
+  gg_fast_transpose( ncomp, npts, rv_x, dbasis_x_eval );
+  gg_fast_transpose( ncomp, npts, rv_y, dbasis_y_eval );
+  gg_fast_transpose( ncomp, npts, rv_z, dbasis_z_eval );
+
+#else
+
+  (void)center;
+  gau2grid_collocation_gradient( npts, nshells, nbe, points, basis, 
+    shell_mask, basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+
+#endif
 
 }
 
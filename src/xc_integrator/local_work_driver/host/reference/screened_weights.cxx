@@ -0,0 +1,568 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "host/reference/weights.hpp"
+#include "common/integrator_constants.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace GauXC {
+
+namespace {
+
+using point_type = std::array<double,3>;
+
+/**
+ *  Uniform cell list over the atomic centers of a Molecule
+ */
+class AtomCellList {
+
+  const Molecule*       mol_;
+  point_type            origin_;
+  double                cell_size_ = 2.;
+  std::array<int64_t,3> ncells_    = {1,1,1};
+
+  std::vector<int32_t> cell_ptr_;   ///< CSR row pointer over cells
+  std::vector<int32_t> cell_atoms_; ///< CSR atom indices
+
+  inline int64_t cell_coord( double x, int dim ) const {
+    const int64_t c = std::floor( (x - origin_[dim]) / cell_size_ );
+    return std::clamp<int64_t>( c, 0, ncells_[dim]-1 );
+  }
+
+  inline int64_t cell_index( int64_t i, int64_t j, int64_t k ) const {
+    return i + ncells_[0] * (j + ncells_[1] * k);
+  }
+
+public:
+
+  AtomCellList( const Molecule& mol ) : mol_(&mol) {
+
+    const int64_t natoms = mol.natoms();
+
+    point_type up;
+    origin_.fill( std::numeric_limits<double>::infinity() );
+    up.fill( -std::numeric_limits<double>::infinity() );
+    for( const auto& atom : mol ) {
+      const point_type r = { atom.x, atom.y, atom.z };
+      for( int d = 0; d < 3; ++d ) {
+        origin_[d] = std::min( origin_[d], r[d] );
+        up[d]      = std::max( up[d],      r[d] );
+      }
+    }
+
+    // Keep the number of cells proportional to the number of atoms
+    auto ncells_dim = [&]( int d ) {
+      return std::max<int64_t>( 1,
+        std::floor( (up[d] - origin_[d]) / cell_size_ ) + 1 );
+    };
+    while( ncells_dim(0) * ncells_dim(1) * ncells_dim(2) > 2 * natoms )
+      cell_size_ *= 1.25;
+    for( int d = 0; d < 3; ++d ) ncells_[d] = ncells_dim(d);
+
+    const int64_t ncells_total = ncells_[0] * ncells_[1] * ncells_[2];
+    std::vector<int64_t> atom_cell( natoms );
+    cell_ptr_.assign( ncells_total + 1, 0 );
+    for( int64_t iA = 0; iA < natoms; ++iA ) {
+      const auto& atom = mol[iA];
+      atom_cell[iA] = cell_index( cell_coord(atom.x,0), cell_coord(atom.y,1),
+        cell_coord(atom.z,2) );
+      cell_ptr_[atom_cell[iA]+1]++;
+    }
+    for( int64_t c = 0; c < ncells_total; ++c ) cell_ptr_[c+1] += cell_ptr_[c];
+
+    cell_atoms_.resize( natoms );
+    std::vector<int32_t> cell_fill( cell_ptr_.begin(), cell_ptr_.end()-1 );
+    for( int64_t iA = 0; iA < natoms; ++iA )
+      cell_atoms_[ cell_fill[atom_cell[iA]]++ ] = iA;
+
+  }
+
+  /**
+   *  Determine the atoms within a distance r of a box
+   *
+   *  @param[in]  lo    Lower corner of the box
+   *  @param[in]  up    Upper corner of the box
+   *  @param[in]  r     Search radius
+   *  @param[out] atoms Atom indices (ascending order)
+   */
+  void query( const point_type& lo, const point_type& up, double r,
+    std::vector<int32_t>& atoms ) const {
+
+    atoms.clear();
+    std::array<int64_t,3> c_lo, c_up;
+    for( int d = 0; d < 3; ++d ) {
+      c_lo[d] = cell_coord( lo[d] - r, d );
+      c_up[d] = cell_coord( up[d] + r, d );
+    }
+
+    const double r2 = r*r;
+    for( int64_t k = c_lo[2]; k <= c_up[2]; ++k )
+    for( int64_t j = c_lo[1]; j <= c_up[1]; ++j )
+    for( int64_t i = c_lo[0]; i <= c_up[0]; ++i ) {
+      const auto c = cell_index(i,j,k);
+      for( auto iA = cell_ptr_[c]; iA < cell_ptr_[c+1]; ++iA ) {
+        const auto& atom = (*mol_)[cell_atoms_[iA]];
+        const double dx = std::max( {lo[0] - atom.x, 0., atom.x - up[0]} );
+        const double dy = std::max( {lo[1] - atom.y, 0., atom.y - up[1]} );
+        const double dz = std::max( {lo[2] - atom.z, 0., atom.z - up[2]} );
+        if( dx*dx + dy*dy + dz*dz <= r2 ) atoms.emplace_back( cell_atoms_[iA] );
+      }
+    }
+
+    std::sort( atoms.begin(), atoms.end() );
+
+  }
+
+  /// Distance from a point to the nearest atom
+  double nearest_distance( const point_type& pt ) const {
+
+    std::vector<int32_t> atoms;
+    for( double r = cell_size_; ; r *= 2. ) {
+      query( pt, pt, r, atoms );
+      if( atoms.size() ) break;
+    }
+
+    double r_min = std::numeric_limits<double>::infinity();
+    for( auto iA : atoms ) {
+      const auto& atom = (*mol_)[iA];
+      const double da_x = pt[0] - atom.x;
+      const double da_y = pt[1] - atom.y;
+      const double da_z = pt[2] - atom.z;
+      r_min = std::min( r_min, std::sqrt(da_x*da_x + da_y*da_y + da_z*da_z) );
+    }
+    return r_min;
+
+  }
+
+};
+
+/**
+ *  Per-batch candidate atoms with coordinates stored SoA
+ */
+struct AtomBatch {
+
+  std::vector<int32_t> idx;
+  std::vector<double>  x, y, z;
+
+  void gather( const Molecule& mol, const AtomCellList& cell_list,
+    const point_type& lo, const point_type& up, double r ) {
+
+    cell_list.query( lo, up, r, idx );
+    const size_t n = idx.size();
+    x.resize(n); y.resize(n); z.resize(n);
+    for( size_t i = 0; i < n; ++i ) {
+      const auto& atom = mol[idx[i]];
+      x[i] = atom.x; y[i] = atom.y; z[i] = atom.z;
+    }
+
+  }
+
+  inline size_t size() const { return idx.size(); }
+
+  /// Distances of a point to each candidate atom
+  void distances( const point_type& pt, double* dist ) const {
+
+    const size_t n = idx.size();
+    const double* x_ = x.data();
+    const double* y_ = y.data();
+    const double* z_ = z.data();
+
+    #pragma omp simd
+    for( size_t i = 0; i < n; ++i ) {
+      const double da_x = pt[0] - x_[i];
+      const double da_y = pt[1] - y_[i];
+      const double da_z = pt[2] - z_[i];
+      dist[i] = std::sqrt(da_x*da_x + da_y*da_y + da_z*da_z);
+    }
+
+  }
+
+};
+
+// Bounding box of a subset of task points
+auto point_bounds( const XCTask& task, const std::vector<int32_t>& pts ) {
+
+  point_type lo, up;
+  lo.fill( std::numeric_limits<double>::infinity() );
+  up.fill( -std::numeric_limits<double>::infinity() );
+  for( auto ipt : pts )
+  for( int d = 0; d < 3; ++d ) {
+    lo[d] = std::min( lo[d], task.points[ipt][d] );
+    up[d] = std::max( up[d], task.points[ipt][d] );
+  }
+  return std::pair( lo, up );
+
+}
+
+}
+
+void screened_ssf_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+) {
+
+  constexpr double magic_ssf = integrator::magic_ssf_factor<>;
+
+  // For any atoms A,B: mu_AB >= (r_A - r_B) / (r_A + r_B), i.e. the SSF cell
+  // function of A vanishes if r_A >= K * r_B. The scaling guards the
+  // candidate lists against roundoff in the distances.
+  constexpr double K = (1. + magic_ssf) / (1. - magic_ssf) * (1. + 1e-10);
+
+  // Clamping mu / a to [-1,1] reproduces the branches in the reference
+  // implementation exactly: g(+-1) = +-1
+  auto gFrisch = [&](double x) {
+    const double s_x  = std::clamp( x / magic_ssf, -1., 1. );
+    const double s_x2 = s_x  * s_x;
+    const double s_x3 = s_x  * s_x2;
+    const double s_x5 = s_x3 * s_x2;
+    const double s_x7 = s_x5 * s_x2;
+
+    return (35.*(s_x - s_x3) + 21.*s_x5 - 5.*s_x7) / 16.;
+  };
+
+  const size_t ntasks = std::distance(task_begin,task_end);
+  const size_t natoms = mol.natoms();
+
+  const auto&  RAB    = meta.rab();
+
+  AtomCellList cell_list( mol );
+
+  #pragma omp parallel
+  {
+
+  AtomBatch            atoms;
+  std::vector<int32_t> active_pts;
+  std::vector<double>  atomDist;
+  std::vector<double>  r_nearest, r_cand;
+  std::vector<int32_t> i_nearest;
+
+  std::vector<int32_t> cand_atoms;
+  std::vector<size_t>  surv_idx;
+  std::vector<char>    cand_surv;
+  std::vector<double>  cand_dist;
+  std::vector<double>  partitionScratch;
+  std::vector<double>  gScratch;
+  std::vector<double>  allDist, allPartition;
+
+  // Unscreened partition function of the parent, identical to the
+  // reference implementation
+  auto eval_all_atoms = [&]( const point_type& pt, int32_t iParent ) {
+
+    allDist.resize( natoms ); allPartition.assign( natoms, 1. );
+    for( size_t iA = 0; iA < natoms; ++iA ) {
+      const double da_x = pt[0] - mol[iA].x;
+      const double da_y = pt[1] - mol[iA].y;
+      const double da_z = pt[2] - mol[iA].z;
+      allDist[iA] = std::sqrt(da_x*da_x + da_y*da_y + da_z*da_z);
+    }
+
+    double* P = allPartition.data();
+    for( size_t iA = 0; iA < natoms; iA++ ) 
+    for( size_t jA = 0; jA < iA;     jA++ )
+    if( P[iA] > integrator::ssf_weight_tol or 
+        P[jA] > integrator::ssf_weight_tol ) {
+      const double mu = (allDist[iA] - allDist[jA]) / RAB[jA + iA*natoms];
+      if( mu <= -magic_ssf )     P[jA] = 0.;
+      else if( mu >= magic_ssf ) P[iA] = 0.;
+      else {
+        const double g = 0.5 * ( 1. - gFrisch(mu) );
+        P[iA] *= g;
+        P[jA] *= 1. - g;
+      }
+    }
+
+    double sum = 0.;
+    for( size_t iA = 0; iA < natoms; iA++ ) sum += P[iA];
+    return P[iParent] / sum;
+
+  };
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    auto& task = *(task_begin+iT);
+    const size_t npts = task.points.size();
+    const auto& parent = mol[task.iParent];
+
+    const auto dist_cutoff = 0.5 * (1-magic_ssf) * task.dist_nearest;
+
+    // Points whose partition weight is not trivially 1
+    active_pts.clear();
+    for( size_t i = 0; i < npts; ++i ) {
+      const auto& point = task.points[i];
+      const double da_x = point[0] - parent.x;
+      const double da_y = point[1] - parent.y;
+      const double da_z = point[2] - parent.z;
+
+      const auto r_parent = std::sqrt(da_x*da_x + da_y*da_y + da_z*da_z);
+      if( not (r_parent < dist_cutoff) ) active_pts.emplace_back(i);
+    }
+    if( active_pts.empty() ) continue;
+
+    const size_t nactive = active_pts.size();
+    r_nearest.resize( nactive );
+    i_nearest.resize( nactive );
+    r_cand.resize( nactive );
+
+    auto [box_lo, box_up] = point_bounds( task, active_pts );
+
+    // The nearest atom of any point in the box lies within the distance
+    // of the box center to its nearest atom plus the box half diagonal
+    double r_search;
+    {
+      point_type center;
+      double half_diag = 0.;
+      for( int d = 0; d < 3; ++d ) {
+        center[d] = 0.5 * (box_lo[d] + box_up[d]);
+        half_diag += (box_up[d] - center[d]) * (box_up[d] - center[d]);
+      }
+      r_search = cell_list.nearest_distance( center ) + std::sqrt(half_diag);
+      r_search *= (1. + 1e-10);
+    }
+
+    // Nearest atom of each point
+    atoms.gather( mol, cell_list, box_lo, box_up, r_search );
+    atomDist.resize( atoms.size() );
+    for( size_t ip = 0; ip < nactive; ++ip ) {
+      atoms.distances( task.points[active_pts[ip]], atomDist.data() );
+      auto it = std::min_element( atomDist.begin(), atomDist.end() );
+      r_nearest[ip] = *it;
+      i_nearest[ip] = atoms.idx[ std::distance( atomDist.begin(), it ) ];
+    }
+
+    // Only atoms within K * r_nearest may have non-vanishing cell functions,
+    // of those, atoms with mu_{A,nearest} >= a vanish as well. Cell functions
+    // of the remaining (surviving) atoms A only depend on atoms within
+    // K * r_A.
+    r_search = K * *std::max_element( r_nearest.begin(), r_nearest.end() );
+    atoms.gather( mol, cell_list, box_lo, box_up, r_search );
+    atomDist.resize( atoms.size() );
+    for( size_t ip = 0; ip < nactive; ++ip ) {
+      atoms.distances( task.points[active_pts[ip]], atomDist.data() );
+      const auto iN = i_nearest[ip];
+      const auto rN = r_nearest[ip];
+      const auto* RAB_N = RAB.data() + iN*natoms;
+
+      // Survivors are determined exactly below, be lenient here
+      double r_surv = rN;
+      for( size_t k = 0; k < atoms.size(); ++k ) {
+        const double mu_bound = magic_ssf * (1. + 1e-10) * RAB_N[atoms.idx[k]];
+        if( atomDist[k] < K * rN and (atomDist[k] - rN) < mu_bound )
+          r_surv = std::max( r_surv, atomDist[k] );
+      }
+      r_cand[ip] = K * r_surv;
+    }
+
+    // Candidate atoms of all points in the batch
+    r_search = *std::max_element( r_cand.begin(), r_cand.end() );
+    atoms.gather( mol, cell_list, box_lo, box_up, r_search );
+    atomDist.resize( atoms.size() );
+
+    for( size_t ip = 0; ip < nactive; ++ip ) {
+
+      auto& weight = task.weights[active_pts[ip]];
+      atoms.distances( task.points[active_pts[ip]], atomDist.data() );
+
+      const auto iN = i_nearest[ip];
+      const auto rN = r_nearest[ip];
+      const auto* RAB_N = RAB.data() + iN*natoms;
+
+      // Candidate atoms of this point (ascending atom index)
+      cand_atoms.clear(); cand_dist.clear(); cand_surv.clear();
+      surv_idx.clear();
+      int64_t parent_idx = -1;
+      for( size_t k = 0; k < atoms.size(); ++k )
+      if( atomDist[k] < r_cand[ip] ) {
+        const auto iA = atoms.idx[k];
+        const auto rA = atomDist[k];
+
+        // Survivor: mu_{A,nearest} < a as computed by the reference
+        bool surv = iA == iN;
+        if( not surv and rA < K * rN ) {
+          const bool a_gt_n = iA > iN;
+          const double mu = a_gt_n ? (rA - rN) / RAB_N[iA] :
+                                     (rN - rA) / RAB_N[iA];
+          surv = a_gt_n ? (mu < magic_ssf) : (mu > -magic_ssf);
+        }
+
+        if( iA == task.iParent ) parent_idx = cand_atoms.size();
+        if( surv ) surv_idx.emplace_back( cand_atoms.size() );
+        cand_atoms.emplace_back( iA );
+        cand_dist.emplace_back( rA );
+        cand_surv.emplace_back( surv );
+      }
+
+      // Every factor of the nearest cell function is >= 1/2, it may only
+      // drop below the tolerance (see below) with many surviving atoms.
+      // Otherwise the parent vanishes once paired with the nearest atom.
+      const bool nearest_above_tol = std::ldexp( 1., 1 - int(surv_idx.size()) ) 
+        > integrator::ssf_weight_tol;
+
+      // Parent cell function vanishes
+      if( parent_idx < 0 and nearest_above_tol ) { weight = 0.; continue; }
+
+      const size_t ncand = cand_atoms.size();
+      partitionScratch.resize( ncand );
+      gScratch.resize( ncand );
+
+      double* P = partitionScratch.data();
+      double* g = gScratch.data();
+      const double* r = cand_dist.data();
+      const int32_t* cand = cand_atoms.data();
+
+      // Evaluate unnormalized partition functions. Pairs are traversed in
+      // the same order as the reference implementation. The pair functions
+      // of surviving atoms are evaluated in bulk. Non-surviving atoms
+      // vanish once paired with the nearest atom, such that pairs of two
+      // non-surviving atoms may be skipped.
+      std::fill_n( P, ncand, 1. );
+      for( size_t i = 0; i < ncand; ++i ) {
+        const auto* RAB_i = RAB.data() + cand[i]*natoms;
+        if( cand_surv[i] ) {
+
+          #pragma omp simd
+          for( size_t j = 0; j < i; ++j ) {
+            const double mu = (r[i] - r[j]) / RAB_i[cand[j]];
+            g[j] = 0.5 * ( 1. - gFrisch(mu) );
+          }
+
+          for( size_t j = 0; j < i; ++j )
+          if( P[i] > integrator::ssf_weight_tol or
+              P[j] > integrator::ssf_weight_tol ) {
+            P[i] *= g[j];
+            P[j] *= 1. - g[j];
+          }
+
+        } else {
+
+          for( auto j : surv_idx ) {
+            if( j >= i ) break;
+            if( P[i] > integrator::ssf_weight_tol or
+                P[j] > integrator::ssf_weight_tol ) {
+              const double mu = (r[i] - r[j]) / RAB_i[cand[j]];
+              const double gj = 0.5 * ( 1. - gFrisch(mu) );
+              P[i] *= gj;
+              P[j] *= 1. - gj;
+            }
+          }
+
+        }
+      }
+
+      // If a surviving cell function takes a value in (0,tol], the
+      // reference skips some of its pairs depending on the cell functions
+      // of the other atoms, including those outside of the candidate list
+      // (e.g. the parent when it is not a candidate, as the nearest cell
+      // function is one of them). Evaluate all atoms to reproduce them.
+      const bool small_surv = std::any_of( surv_idx.begin(), surv_idx.end(),
+        [&]( auto k ) { 
+          return P[k] > 0. and P[k] <= integrator::ssf_weight_tol; 
+        } );
+      if( small_surv ) {
+        weight *= eval_all_atoms( task.points[active_pts[ip]], task.iParent );
+        continue;
+      }
+
+      if( parent_idx < 0 ) { weight = 0.; continue; }
+
+      // Normalization
+      double sum = 0.;
+      for( size_t iA = 0; iA < ncand; iA++ )  sum += P[iA];
+
+      // Update Weights
+      weight *= P[parent_idx] / sum;
+
+    } // Loop over points
+
+  } // Loop over tasks
+
+  } // OMP context
+
+}
+
+
+
+
+void screened_becke_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+) {
+
+  // Becke partition functions
+  auto hBecke = [](double x) {return 1.5 * x - 0.5 * x * x * x;}; // Eq. 19
+  auto gBecke = [&](double x) {return hBecke(hBecke(hBecke(x)));}; // Eq. 20 f_3
+
+  const size_t ntasks = std::distance(task_begin,task_end);
+  const size_t natoms = mol.natoms();
+
+  const auto&  RAB    = meta.rab();
+
+  // Becke cell functions have no compact support, all atoms are candidates
+  AtomBatch atoms;
+  atoms.idx.resize( natoms );
+  atoms.x.resize( natoms ); atoms.y.resize( natoms ); atoms.z.resize( natoms );
+  for( size_t iA = 0; iA < natoms; ++iA ) {
+    atoms.idx[iA] = iA;
+    atoms.x[iA] = mol[iA].x; atoms.y[iA] = mol[iA].y; atoms.z[iA] = mol[iA].z;
+  }
+
+  #pragma omp parallel
+  {
+
+  std::vector<double> partitionScratch( natoms );
+  std::vector<double> atomDist( natoms );
+  std::vector<double> gScratch( natoms );
+
+  #pragma omp for
+  for( size_t iT = 0; iT < ntasks;                  ++iT )
+  for( size_t i  = 0; i  < (task_begin+iT)->points.size(); ++i  ) {
+
+    auto&       task   = *(task_begin+iT);
+    auto&       weight = task.weights[i];
+
+    atoms.distances( task.points[i], atomDist.data() );
+
+    double* P = partitionScratch.data();
+    double* g = gScratch.data();
+    const double* r = atomDist.data();
+
+    // Evaluate unnormalized partition functions, factors are accumulated
+    // in the same order as the reference implementation
+    std::fill(partitionScratch.begin(),partitionScratch.end(),1.);
+    for( size_t iA = 0; iA < natoms; iA++ ) {
+      const auto* RAB_i = RAB.data() + iA*natoms;
+
+      #pragma omp simd
+      for( size_t jA = 0; jA < iA; jA++ ) {
+        g[jA] = gBecke( (r[iA] - r[jA]) / RAB_i[jA] );
+        P[jA] *= 0.5 * (1. + g[jA]);
+      }
+
+      for( size_t jA = 0; jA < iA; jA++ ) P[iA] *= 0.5 * (1. - g[jA]);
+    }
+
+    // Normalization
+    double sum = 0.;
+    for( size_t iA = 0; iA < natoms; iA++ )  sum += partitionScratch[iA];
+
+    // Update Weights
+    weight *= partitionScratch[task.iParent] / sum;
+
+  } // Collapsed loop over tasks and points
+
+  } // OMP context
+
+}
+
+}
@@ -25,6 +25,20 @@ void reference_becke_weights_host(
   task_iterator          task_end
 );
 
+void screened_ssf_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+);
+
+void screened_becke_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+);
+
 void reference_lko_weights_host(
   const Molecule&        mol,
   const MolMeta&         meta,
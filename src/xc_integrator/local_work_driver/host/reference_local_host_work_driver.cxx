@@ -22,6 +22,9 @@
 #include "cpu/chebyshev_boys_computation.hpp"
 #include <gauxc/util/real_solid_harmonics.hpp>
 #include "integrator_util/integral_bounds.hpp"
+#include "integrator_util/shell_block_screening.hpp"
+#include "integrator_util/host_arena.hpp"
+#include <gauxc/util/div_ceil.hpp>
 
 namespace GauXC {
 
@@ -52,6 +55,21 @@ namespace GauXC {
     }
   }
 
+  void ReferenceLocalHostWorkDriver::partition_weights_screened( 
+    XCWeightAlg weight_alg, const Molecule& mol, const MolMeta& meta, 
+    task_iterator task_begin, task_iterator task_end ) {
+    switch( weight_alg ) {
+      case XCWeightAlg::Becke:
+        screened_becke_weights_host( mol, meta, task_begin, task_end );
+        break;
+      case XCWeightAlg::SSF:
+        screened_ssf_weights_host( mol, meta, task_begin, task_end );
+        break;
+      default:
+        partition_weights( weight_alg, mol, meta, task_begin, task_end );
+    }
+  }
+
 
   // Collocation
   void ReferenceLocalHostWorkDriver::eval_collocation( size_t npts, size_t nshells, 
@@ -70,6 +88,24 @@ namespace GauXC {
 				  basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
   }
 
+  // Collocation on atomic quadratures
+  void ReferenceLocalHostWorkDriver::eval_collocation_atomic( size_t npts, 
+    size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+    const int32_t* shell_list, const double* center, double* basis_eval ) {
+    gau2grid_collocation_atomic( npts, nshells, nbe, pts, basis, shell_list, 
+      center, basis_eval );
+  }
+
+  void ReferenceLocalHostWorkDriver::eval_collocation_gradient_atomic( 
+    size_t npts, size_t nshells, size_t nbe, const double* pts, 
+    const BasisSet<double>& basis, const int32_t* shell_list, 
+    const double* center, double* basis_eval, double* dbasis_x_eval, 
+    double* dbasis_y_eval, double* dbasis_z_eval) {
+    gau2grid_collocation_gradient_atomic( npts, nshells, nbe, pts, basis, 
+      shell_list, center, basis_eval, dbasis_x_eval, dbasis_y_eval, 
+      dbasis_z_eval );
+  }
+
   void ReferenceLocalHostWorkDriver::eval_collocation_hessian( size_t npts, 
 							       size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
 							       const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
@@ -82,6 +118,39 @@ namespace GauXC {
 				 d2basis_zz_eval);
   }
 
+  void ReferenceLocalHostWorkDriver::eval_collocation_laplacian( size_t npts, 
+    size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+    const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
+    double* dbasis_y_eval, double* dbasis_z_eval, double* lbasis_eval ) {
+    gau2grid_collocation_laplacian( npts, nshells, nbe, pts, basis, shell_list,
+      basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval );
+  }
+
+  void ReferenceLocalHostWorkDriver::eval_collocation_screened( size_t npts, 
+    const double* pts, const BasisSet<double>& basis, 
+    const PrimitiveScreening& prims, double* basis_eval ) {
+    gau2grid_collocation( npts, prims.nshells(), prims.nbe(), pts, basis, 
+      prims.shell_list().data(), basis_eval, &prims );
+  }
+
+  void ReferenceLocalHostWorkDriver::eval_collocation_gradient_screened( size_t npts, 
+    const double* pts, const BasisSet<double>& basis, 
+    const PrimitiveScreening& prims, double* basis_eval, double* dbasis_x_eval, 
+    double* dbasis_y_eval, double* dbasis_z_eval ) {
+    gau2grid_collocation_gradient( npts, prims.nshells(), prims.nbe(), pts, 
+      basis, prims.shell_list().data(), basis_eval, dbasis_x_eval, 
+      dbasis_y_eval, dbasis_z_eval, &prims );
+  }
+
+  void ReferenceLocalHostWorkDriver::eval_collocation_laplacian_screened( size_t npts, 
+    const double* pts, const BasisSet<double>& basis, 
+    const PrimitiveScreening& prims, double* basis_eval, double* dbasis_x_eval, 
+    double* dbasis_y_eval, double* dbasis_z_eval, double* lbasis_eval ) {
+    gau2grid_collocation_laplacian( npts, prims.nshells(), prims.nbe(), pts, 
+      basis, prims.shell_list().data(), basis_eval, dbasis_x_eval, 
+      dbasis_y_eval, dbasis_z_eval, lbasis_eval, &prims );
+  }
+
   void ReferenceLocalHostWorkDriver::eval_collocation_der3( size_t npts,
 							    size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
 							     const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
@@ -121,6 +190,71 @@ namespace GauXC {
   }
 
 
+  void ReferenceLocalHostWorkDriver::eval_xmat_stacked( size_t npts, 
+    size_t nbf, size_t nbe, const submat_map_t& submat_map, double fac, 
+    size_t ndm, const double* const* P, size_t ldp, const double* basis_eval, 
+    size_t ldb, double* X, size_t ldx, double* scr ) {
+
+    // Gather the compressed P_i into a (ndm*nbe, nbe) stack
+    const size_t ldscr = ndm * nbe;
+    for( size_t i = 0; i < ndm; ++i )
+      detail::submat_set( nbf, nbf, nbe, nbe, P[i], ldp, scr + i*nbe, ldscr,
+        submat_map );
+
+    blas::gemm( 'N', 'N', ldscr, npts, nbe, fac, scr, ldscr, basis_eval, ldb,
+		0., X, ldx );
+
+  }
+
+
+  void ReferenceLocalHostWorkDriver::eval_xmat_screened( size_t npts, 
+    const ShellBlockPattern& pattern, double fac, const double* P, size_t ldp, 
+    const double* basis_eval, size_t ldb, double* X, size_t ldx, double* scr ) {
+
+    const auto& blocks = pattern.blocks();
+    const auto& runs   = pattern.runs();
+
+    // X(I,:) = fac * sum_J P(I,J) * B(J,:), one GEMM per (row group, run)
+    for( const auto& g : pattern.groups() ) {
+      const auto& rows = g.rows;
+      auto* X_I = X + rows.ao_cmp;
+
+      // All blocks of the rows are negligible
+      if( g.run_st == g.run_en ) {
+        for( size_t ipt = 0; ipt < npts; ++ipt )
+          std::fill_n( X_I + ipt*ldx, rows.nbf, 0. );
+        continue;
+      }
+
+      for( auto ir = g.run_st; ir < g.run_en; ++ir ) {
+        const auto& cols = runs[ir];
+
+        // Reference P in place if the panel is a submatrix of P, pack 
+        // the blocks of the panel otherwise
+        const double* P_IJ = P + rows.ao_st + cols.ao_st*ldp;
+        size_t ld_IJ = ldp;
+        if( not (rows.contiguous and cols.contiguous) ) {
+          for( auto iJ = cols.blk_st; iJ <= cols.blk_en; ++iJ )
+          for( auto iI = rows.blk_st; iI <= rows.blk_en; ++iI ) {
+            const auto& bI = blocks[iI];
+            const auto& bJ = blocks[iJ];
+            for( int32_t j = 0; j < bJ.nbf; ++j )
+              std::copy_n( P + bI.ao_st + (bJ.ao_st + j)*ldp, bI.nbf,
+                scr + (bI.ao_cmp - rows.ao_cmp) + 
+                  (bJ.ao_cmp - cols.ao_cmp + j) * rows.nbf );
+          }
+          P_IJ  = scr;
+          ld_IJ = rows.nbf;
+        }
+
+        blas::gemm( 'N', 'N', rows.nbf, npts, cols.nbf, fac, P_IJ, ld_IJ,
+          basis_eval + cols.ao_cmp, ldb, ir == g.run_st ? 0. : 1., X_I, ldx );
+      }
+    }
+
+  }
+
+
   // U/VVar LDA (density)
   void ReferenceLocalHostWorkDriver::eval_uvvar_lda_rks( size_t npts, size_t nbe, 
 						     const double* basis_eval, const double* X, size_t ldx, double* den_eval) {
@@ -128,8 +262,8 @@ namespace GauXC {
 
     for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
-      const size_t ioff = size_t(i) * ldx;
-      const auto*   X_i = X + ioff;
+      const size_t ioff = size_t(i) * nbe; // Collocation (ld = nbe)
+      const auto*   X_i = X + size_t(i) * ldx;
       den_eval[i] = blas::dot( nbe, basis_eval + ioff, 1, X_i, 1 );
 
     }    
@@ -143,14 +277,15 @@ namespace GauXC {
   
     for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
+      const size_t ioff  = size_t(i) * nbe; // Collocation (ld = nbe)
       const size_t ioffs = size_t(i) * ldxs;
       const size_t ioffz = size_t(i) * ldxz;
 
       const auto*   Xs_i = Xs + ioffs;
       const auto*   Xz_i = Xz + ioffz;
 
-      const double rhos = blas::dot( nbe, basis_eval + ioffs, 1, Xs_i, 1 );
-      const double rhoz = blas::dot( nbe, basis_eval + ioffz, 1, Xz_i, 1 );
+      const double rhos = blas::dot( nbe, basis_eval + ioff, 1, Xs_i, 1 );
+      const double rhoz = blas::dot( nbe, basis_eval + ioff, 1, Xz_i, 1 );
       
       den_eval[2*i]   = 0.5*(rhos + rhoz); // rho_+
       den_eval[2*i+1] = 0.5*(rhos - rhoz); // rho_-
@@ -172,6 +307,7 @@ namespace GauXC {
  
     for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
+      const size_t ioff  = size_t(i) * nbe; // Collocation (ld = nbe)
       const size_t ioffs = size_t(i) * ldxs;
       const size_t ioffz = size_t(i) * ldxz;
       const size_t ioffx = size_t(i) * ldxx;
@@ -182,10 +318,10 @@ namespace GauXC {
       const auto*   Xx_i = Xx + ioffx;
       const auto*   Xy_i = Xy + ioffy;
 
-      const double rhos = blas::dot( nbe, basis_eval + ioffs, 1, Xs_i, 1 );
-      const double rhoz = blas::dot( nbe, basis_eval + ioffz, 1, Xz_i, 1 );
-      const double rhox = blas::dot( nbe, basis_eval + ioffx, 1, Xx_i, 1 );
-      const double rhoy = blas::dot( nbe, basis_eval + ioffy, 1, Xy_i, 1 );
+      const double rhos = blas::dot( nbe, basis_eval + ioff, 1, Xs_i, 1 );
+      const double rhoz = blas::dot( nbe, basis_eval + ioff, 1, Xz_i, 1 );
+      const double rhox = blas::dot( nbe, basis_eval + ioff, 1, Xx_i, 1 );
+      const double rhoy = blas::dot( nbe, basis_eval + ioff, 1, Xy_i, 1 );
  
       double mtemp = rhoz * rhoz + rhox * rhox + rhoy * rhoy;
       double mnorm = 0;
@@ -218,8 +354,8 @@ namespace GauXC {
 
     for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
-      const size_t ioff = size_t(i) * ldx;
-      const auto*   X_i = X + ioff;
+      const size_t ioff = size_t(i) * nbe; // Collocation (ld = nbe)
+      const auto*   X_i = X + size_t(i) * ldx;
 
       den_eval[i] = blas::dot( nbe, basis_eval + ioff, 1, X_i, 1 );
 
@@ -245,32 +381,33 @@ void ReferenceLocalHostWorkDriver::eval_uvvar_gga_uks( size_t npts, size_t nbe,
 
    for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
+      const size_t ioff  = size_t(i) * nbe; // Collocation (ld = nbe)
       const size_t ioffs = size_t(i) * ldxs;
       const size_t ioffz = size_t(i) * ldxz;
 
       const auto*   Xs_i = Xs + ioffs;
       const auto*   Xz_i = Xz + ioffz;
 
-      double rhos = blas::dot( nbe, basis_eval + ioffs, 1, Xs_i, 1 ); // S density
-      double rhoz = blas::dot( nbe, basis_eval + ioffz, 1, Xz_i, 1 ); // Z density
+      double rhos = blas::dot( nbe, basis_eval + ioff, 1, Xs_i, 1 ); // S density
+      double rhoz = blas::dot( nbe, basis_eval + ioff, 1, Xz_i, 1 ); // Z density
 
 
       den_eval[2*i]   = 0.5*(rhos + rhoz); // rho_+
       den_eval[2*i+1] = 0.5*(rhos - rhoz); // rho_-
 
       const auto dndx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + ioff, 1, Xs_i, 1 );
       const auto dndy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + ioff, 1, Xs_i, 1 );
       const auto dndz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + ioff, 1, Xs_i, 1 );
 
       const auto dMzdx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + ioff, 1, Xz_i, 1 );
       const auto dMzdy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + ioff, 1, Xz_i, 1 );
       const auto dMzdz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + ioff, 1, Xz_i, 1 );
 
       dden_x_eval[2*i] = dndx; // dn / dx
       dden_y_eval[2*i] = dndy; // dn / dy
@@ -305,8 +442,8 @@ void ReferenceLocalHostWorkDriver::eval_uvvar_mgga_rks( size_t npts, size_t nbe,
 
    for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
-      const size_t ioff = size_t(i) * ldx;
-      const auto*   X_i = X + ioff;
+      const size_t ioff = size_t(i) * nbe; // Collocation (ld = nbe)
+      const auto*   X_i = X + size_t(i) * ldx;
 
       den_eval[i] = blas::dot( nbe, basis_eval + ioff, 1, X_i, 1 );
 
@@ -320,9 +457,9 @@ void ReferenceLocalHostWorkDriver::eval_uvvar_mgga_rks( size_t npts, size_t nbe,
 
       gamma[i] = dx*dx + dy*dy + dz*dz;
 
-      tau[i]  = 0.5*blas::dot( nbe, dbasis_x_eval + ioff, 1, mmat_x + ioff, 1);
-      tau[i] += 0.5*blas::dot( nbe, dbasis_y_eval + ioff, 1, mmat_y + ioff, 1);
-      tau[i] += 0.5*blas::dot( nbe, dbasis_z_eval + ioff, 1, mmat_z + ioff, 1);
+      tau[i]  = 0.5*blas::dot( nbe, dbasis_x_eval + ioff, 1, mmat_x + size_t(i)*ldm, 1);
+      tau[i] += 0.5*blas::dot( nbe, dbasis_y_eval + ioff, 1, mmat_y + size_t(i)*ldm, 1);
+      tau[i] += 0.5*blas::dot( nbe, dbasis_z_eval + ioff, 1, mmat_z + size_t(i)*ldm, 1);
 
       if (lapl != nullptr)
         lapl[i]  = 2. * blas::dot( nbe, lbasis_eval + ioff, 1, X_i, 1) + 4. * tau[i];
@@ -341,32 +478,33 @@ void ReferenceLocalHostWorkDriver::eval_uvvar_mgga_uks( size_t npts, size_t nbe,
 
    for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
+      const size_t ioff  = size_t(i) * nbe; // Collocation (ld = nbe)
       const size_t ioffs = size_t(i) * ldxs;
       const size_t ioffz = size_t(i) * ldxz;
 
       const auto*   Xs_i = Xs + ioffs;
       const auto*   Xz_i = Xz + ioffz;
 
-      double rhos = blas::dot( nbe, basis_eval + ioffs, 1, Xs_i, 1 ); // S density
-      double rhoz = blas::dot( nbe, basis_eval + ioffz, 1, Xz_i, 1 ); // Z density
+      double rhos = blas::dot( nbe, basis_eval + ioff, 1, Xs_i, 1 ); // S density
+      double rhoz = blas::dot( nbe, basis_eval + ioff, 1, Xz_i, 1 ); // Z density
 
 
       den_eval[2*i]   = 0.5*(rhos + rhoz); // rho_+
       den_eval[2*i+1] = 0.5*(rhos - rhoz); // rho_-
 
       const auto dndx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + ioff, 1, Xs_i, 1 );
       const auto dndy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + ioff, 1, Xs_i, 1 );
       const auto dndz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + ioff, 1, Xs_i, 1 );
 
       const auto dMzdx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + ioff, 1, Xz_i, 1 );
       const auto dMzdy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + ioff, 1, Xz_i, 1 );
       const auto dMzdz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + ioff, 1, Xz_i, 1 );
 
       dden_x_eval[2*i] = dndx; // dn / dx
       dden_y_eval[2*i] = dndy; // dn / dy
@@ -387,19 +525,19 @@ void ReferenceLocalHostWorkDriver::eval_uvvar_mgga_uks( size_t npts, size_t nbe,
       gamma[3*i+1] = 0.25*(dn_sq - dMz_sq);
       gamma[3*i+2] = 0.25*(dn_sq + dMz_sq) - 0.5*dn_dMz;
 
-      auto taus  = 0.5*blas::dot( nbe, dbasis_x_eval + ioffs, 1, mmat_xs + ioffs, 1);
-           taus += 0.5*blas::dot( nbe, dbasis_y_eval + ioffs, 1, mmat_ys + ioffs, 1);
-           taus += 0.5*blas::dot( nbe, dbasis_z_eval + ioffs, 1, mmat_zs + ioffs, 1);
-      auto tauz  = 0.5*blas::dot( nbe, dbasis_x_eval + ioffz, 1, mmat_xz + ioffz, 1);
-           tauz += 0.5*blas::dot( nbe, dbasis_y_eval + ioffz, 1, mmat_yz + ioffz, 1);
-           tauz += 0.5*blas::dot( nbe, dbasis_z_eval + ioffz, 1, mmat_zz + ioffz, 1);
+      auto taus  = 0.5*blas::dot( nbe, dbasis_x_eval + ioff, 1, mmat_xs + size_t(i)*ldms, 1);
+           taus += 0.5*blas::dot( nbe, dbasis_y_eval + ioff, 1, mmat_ys + size_t(i)*ldms, 1);
+           taus += 0.5*blas::dot( nbe, dbasis_z_eval + ioff, 1, mmat_zs + size_t(i)*ldms, 1);
+      auto tauz  = 0.5*blas::dot( nbe, dbasis_x_eval + ioff, 1, mmat_xz + size_t(i)*ldmz, 1);
+           tauz += 0.5*blas::dot( nbe, dbasis_y_eval + ioff, 1, mmat_yz + size_t(i)*ldmz, 1);
+           tauz += 0.5*blas::dot( nbe, dbasis_z_eval + ioff, 1, mmat_zz + size_t(i)*ldmz, 1);
 
       tau[2*i]   = 0.5*(taus + tauz);
       tau[2*i+1] = 0.5*(taus - tauz);
 
       if (lapl != nullptr) {
-        auto lapls = 2. * blas::dot( nbe, lbasis_eval + ioffs, 1, Xs_i, 1) + 4. * taus;
-        auto laplz = 2. * blas::dot( nbe, lbasis_eval + ioffz, 1, Xz_i, 1) + 4. * tauz;
+        auto lapls = 2. * blas::dot( nbe, lbasis_eval + ioff, 1, Xs_i, 1) + 4. * taus;
+        auto laplz = 2. * blas::dot( nbe, lbasis_eval + ioff, 1, Xz_i, 1) + 4. * tauz;
 
         lapl[2*i]   = 0.5*(lapls + laplz);
         lapl[2*i+1] = 0.5*(lapls - laplz);
@@ -429,6 +567,7 @@ void ReferenceLocalHostWorkDriver::eval_uvvar_gga_gks( size_t npts, size_t nbe,
 
    for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
+      const size_t ioff  = size_t(i) * nbe; // Collocation (ld = nbe)
       const size_t ioffs = size_t(i) * ldxs;
       const size_t ioffz = size_t(i) * ldxz;
       const size_t ioffx = size_t(i) * ldxx;
@@ -439,38 +578,38 @@ void ReferenceLocalHostWorkDriver::eval_uvvar_gga_gks( size_t npts, size_t nbe,
       const auto*   Xx_i = Xx + ioffx;
       const auto*   Xy_i = Xy + ioffy;
 
-      const double rhos = blas::dot( nbe, basis_eval + ioffs, 1, Xs_i, 1 );
-      const double rhoz = blas::dot( nbe, basis_eval + ioffz, 1, Xz_i, 1 );
-      const double rhox = blas::dot( nbe, basis_eval + ioffx, 1, Xx_i, 1 );
-      const double rhoy = blas::dot( nbe, basis_eval + ioffy, 1, Xy_i, 1 );
+      const double rhos = blas::dot( nbe, basis_eval + ioff, 1, Xs_i, 1 );
+      const double rhoz = blas::dot( nbe, basis_eval + ioff, 1, Xz_i, 1 );
+      const double rhox = blas::dot( nbe, basis_eval + ioff, 1, Xx_i, 1 );
+      const double rhoy = blas::dot( nbe, basis_eval + ioff, 1, Xy_i, 1 );
 
       const auto dndx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + ioff, 1, Xs_i, 1 );
       const auto dndy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + ioff, 1, Xs_i, 1 );
       const auto dndz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + ioff, 1, Xs_i, 1 );
 
       const auto dMzdx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + ioff, 1, Xz_i, 1 );
       const auto dMzdy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + ioff, 1, Xz_i, 1 );
       const auto dMzdz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + ioff, 1, Xz_i, 1 );
 
       const auto dMxdx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffx, 1, Xx_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + ioff, 1, Xx_i, 1 );
       const auto dMxdy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffx, 1, Xx_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + ioff, 1, Xx_i, 1 );
       const auto dMxdz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffx, 1, Xx_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + ioff, 1, Xx_i, 1 );
 
       const auto dMydx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffy, 1, Xy_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + ioff, 1, Xy_i, 1 );
       const auto dMydy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffy, 1, Xy_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + ioff, 1, Xy_i, 1 );
       const auto dMydz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffy, 1, Xy_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + ioff, 1, Xy_i, 1 );
 
 
       dden_x_eval[4 * i] = dndx;
@@ -1039,6 +1178,16 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
 
   }
 
+  void ReferenceLocalHostWorkDriver::inc_vxc_packed( size_t npts, size_t nbf, 
+					      size_t nbe, const double* basis_eval, const submat_map_t& submat_map, 
+					      const double* Z, size_t ldz, double* VXC_packed, double* scr ) {
+
+      blas::syr2k('L', 'N', nbe, npts, 1., basis_eval, nbe, Z, ldz, 0., scr, nbe );
+
+      detail::inc_by_submat_packed_lower( nbf, nbe, VXC_packed, scr, nbe, submat_map );
+
+  }
+
   // Increment K by G
   void ReferenceLocalHostWorkDriver::inc_exx_k( size_t npts, size_t nbf, 
 						size_t nbe_bra, size_t nbe_ket, const double* basis_eval, 
@@ -1053,6 +1202,19 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
 
   }
 
+  void ReferenceLocalHostWorkDriver::inc_exx_k_packed( size_t npts, size_t nbf, 
+						size_t nbe_bra, size_t nbe_ket, const double* basis_eval, 
+						const submat_map_t& submat_map_bra, const submat_map_t& submat_map_ket, 
+						const double* G, size_t ldg, double* K_packed, double* scr ) {
+
+      blas::gemm( 'N', 'T', nbe_bra, nbe_ket, npts, 1., basis_eval, nbe_bra,
+		  G, ldg, 0., scr, nbe_bra );
+
+      detail::inc_by_submat_packed_fold( nbf, nbe_bra, nbe_ket, K_packed, scr, 
+        nbe_bra, submat_map_bra, submat_map_ket );
+
+  }
+
 
   // Construct F = P * B (P non-square, TODO: should merge with XMAT)
   void ReferenceLocalHostWorkDriver::eval_exx_fmat( size_t npts, size_t nbf, 
@@ -1078,194 +1240,399 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
 
   }
 
-  // Construct G(mu,i) = w(i) * A(mu,nu,i) * F(nu, i)
-  void ReferenceLocalHostWorkDriver::eval_exx_gmat( size_t npts, size_t nshells, 
-    size_t nshell_pairs, size_t nbe, const double* points, const double* weights, 
-    const BasisSet<double>& basis, const ShellPairCollection<double>& shpairs, 
-    const BasisSetMap& basis_map, const int32_t* shell_list, 
-    const std::pair<int32_t,int32_t>* shell_pair_list, 
-    const double* X, size_t ldx, double* G, size_t ldg ) {
-
-    util::unused(basis_map);
+  // Spherical <-> Cartesian transformation of the sn-K intermediates
+  static const util::SphericalHarmonicTransform& exx_sph_trans() {
+    static const util::SphericalHarmonicTransform sph_trans(
+      ShellPairIntegralDispatch::max_l_rys );
+    return sph_trans;
+  }
 
-    // Cast points to Rys format (binary compatable)
-    XCPU::point* _points = 
-      reinterpret_cast<XCPU::point*>(const_cast<double*>(points));
-    std::vector<double> _points_transposed(3 * npts);
+  // Whether any shell of a list requires a spherical transformation
+  static bool exx_any_pure( size_t nshells, const int32_t* shell_list,
+    const BasisSet<double>& basis ) {
+    return std::any_of( shell_list, shell_list + nshells, [&](const auto& i){ 
+      return basis.at(i).pure() and basis.at(i).l() > 0; } );
+  }
 
-    for(size_t i = 0; i < npts; ++i) {
-      _points_transposed[i + 0 * npts] = _points[i].x;
-      _points_transposed[i + 1 * npts] = _points[i].y;
-      _points_transposed[i + 2 * npts] = _points[i].z;
-    }
+  // Construct F(mu,i) = P(mu,nu) * B(nu,i) with mu Cartesian, F row major
+  void ReferenceLocalHostWorkDriver::eval_exx_fmat_cart( size_t npts, 
+    size_t nbf, size_t nbe_bra, size_t nbe_ket, size_t nshells_bra, 
+    const int32_t* shell_list_bra, const BasisSet<double>& basis, 
+    const submat_map_t& submat_map_bra, const submat_map_t& submat_map_ket, 
+    const double* P, size_t ldp, const double* basis_eval, size_t ldb, 
+    double* F, size_t ldf ) {
 
-  
-    // Set G to zero
-    for( size_t j = 0; j < npts; ++j )
-    for( size_t i = 0; i < nbe;  ++i ) {
-	    G[i + j*ldg] = 0.;
-    }
+    auto& arena = HostArena::thread_arena();
+    HostArena::scope scratch_scope( arena );
 
+    const auto* P_use = P;
+    size_t ldp_use = ldp;
 
-    // Spherical Harmonic Transformer
-    util::SphericalHarmonicTransform sph_trans(5);
+    if( submat_map_bra.size() > 1 or submat_map_ket.size() > 1 ) {
+      auto* P_scr = arena.allocate<double>( nbe_bra * nbe_ket );
+      detail::submat_set( nbf, nbf, nbe_bra, nbe_ket, P, ldp,
+			  P_scr, nbe_bra, submat_map_bra, submat_map_ket );
+      P_use = P_scr;
+      ldp_use = nbe_bra;
+    } else {
+      P_use = P + submat_map_ket[0][0]*ldp + submat_map_bra[0][0];
+    }
 
-    const bool any_pure = std::any_of( shell_list, shell_list + nshells,
-				       [&](const auto& i){ return basis.at(i).pure(); } );
-    
+    // Transform the rows of P into the Cartesian basis, P_cart = T**T * P
     const size_t nbe_cart = 
-      basis.nbf_cart_subset( shell_list, shell_list + nshells );
-
-    std::vector<double> X_cart, G_cart;
-    if( any_pure ){
-      X_cart.resize( nbe_cart * npts );
-      G_cart.resize( nbe_cart * npts, 0. );
-
-      // Transform X into cartesian
-      int ioff = 0;
-      int ioff_cart = 0;
-      for( auto i = 0ul; i < nshells; ++i ) {
-        const auto ish = shell_list[i];
-        const auto& shell      = basis.at(ish);
-        const int shell_l       = shell.l();
-        const int shell_sz      = shell.size();
-        const int shell_cart_sz = shell.cart_size();
-        
-        if( shell.pure() and shell_l > 0 ) {
-          sph_trans.itform_bra_cm( shell_l, npts, X + ioff, ldx,
-        			   X_cart.data() + ioff_cart, nbe_cart );
+      basis.nbf_cart_subset( shell_list_bra, shell_list_bra + nshells_bra );
+    if( exx_any_pure( nshells_bra, shell_list_bra, basis ) ) {
+      const auto& sph_trans = exx_sph_trans();
+      auto* P_cart = arena.allocate<double>( nbe_cart * nbe_ket );
+
+      size_t ioff = 0, ioff_cart = 0;
+      for( auto i = 0ul; i < nshells_bra; ++i ) {
+        const auto& shell = basis.at(shell_list_bra[i]);
+        if( shell.pure() and shell.l() > 0 ) {
+          sph_trans.itform_bra_cm( shell.l(), nbe_ket, P_use + ioff, ldp_use,
+            P_cart + ioff_cart, nbe_cart );
         } else {
-          blas::lacpy( 'A', shell_sz, npts, X + ioff, ldx,
-        	       X_cart.data() + ioff_cart, nbe_cart );
+          blas::lacpy( 'A', shell.size(), nbe_ket, P_use + ioff, ldp_use,
+            P_cart + ioff_cart, nbe_cart );
         }
-        ioff += shell_sz;
-        ioff_cart += shell_cart_sz;
+        ioff      += shell.size();
+        ioff_cart += shell.cart_size();
       }
-    }
 
-    const auto* X_use = any_pure ? X_cart.data() : X;
-    auto*       G_use = any_pure ? G_cart.data() : G;
-    const auto ldx_use = any_pure ? nbe_cart : ldx;
-    const auto ldg_use = any_pure ? nbe_cart : ldg;
-
-    std::vector<double> X_cart_rm( nbe_cart*npts,0. ), 
-                        G_cart_rm( nbe_cart*npts,0. );
-    for( auto i = 0ul; i < nbe_cart; ++i )
-    for( auto j = 0ul; j < npts;     ++j ) {
-      X_cart_rm[i*npts + j] = X_use[i + j*ldx_use];
+      P_use   = P_cart;
+      ldp_use = nbe_cart;
     }
 
+    // F**T = B**T * P_cart**T, i.e. F in row major
+    blas::gemm( 'T', 'T', npts, nbe_cart, nbe_ket, 1., basis_eval, ldb,
+      P_use, ldp_use, 0., F, ldf );
+
+  }
 
-    std::map<size_t,size_t> cou_offsets_map;
-    std::vector<size_t> cou_cart_sizes(nshells);
-    cou_cart_sizes[0] = 0;
-    cou_offsets_map[shell_list[0]] = 0;
-    for(size_t i = 1; i < nshells; ++i) {
-      cou_cart_sizes[i] = cou_cart_sizes[i-1] +
-        basis.at(shell_list[i-1]).cart_size();
-      cou_offsets_map[shell_list[i]] = cou_cart_sizes[i];
+  // Number of points per block of the point level sn-K screening
+  static constexpr size_t exx_pt_block = 64;
+
+  // Construct G(mu,i) = w(i) * A(mu,nu,i) * F(nu, i), Cartesian row major
+  void ReferenceLocalHostWorkDriver::eval_exx_gmat_cart( size_t npts, 
+    size_t nshells, size_t nshell_pairs, const double* points, 
+    const double* weights, const BasisSet<double>& basis, 
+    const ShellPairCollection<double>& shpairs, const int32_t* shell_list, 
+    const std::pair<int32_t,int32_t>* shell_pair_list, const double* F, 
+    size_t ldf, double* G, size_t ldg, double eps_pt ) {
+
+    // Set up on the first EXX call (see the replicated integrator)
+    const auto* shpair_dispatch = &ShellPairIntegralDispatch::instance();
+
+    auto& arena = HostArena::thread_arena();
+    HostArena::scope scratch_scope( arena );
+
+    // Transposed points for the Obara-Saika kernels
+    auto* points_transposed = arena.allocate<double>( 3 * npts );
+    for( size_t i = 0; i < npts; ++i ) {
+      points_transposed[i + 0 * npts] = points[3*i + 0];
+      points_transposed[i + 1 * npts] = points[3*i + 1];
+      points_transposed[i + 2 * npts] = points[3*i + 2];
     }
 
-    size_t ndo = 0;
-    {
-#if 0
-    //size_t ioff_cart = 0;
+    // Dense Cartesian row offsets / local indices of the task shells
+    auto* cart_offsets = arena.allocate<size_t>( basis.nshells() );
+    auto* shell_index  = arena.allocate<size_t>( basis.nshells() );
+    size_t nbe_cart = 0, ncart_max = 0;
     for( auto i = 0ul; i < nshells; ++i ) {
-      const auto ish        = shell_list[i];
-      const auto& bra       = basis[ish];
-      const int bra_cart_sz = bra.cart_size();
-      const size_t ioff_cart = cou_cart_sizes[i] * npts;
-      XCPU::point bra_origin{bra.O()[0],bra.O()[1],bra.O()[2]};
+      const auto ncart = basis.at(shell_list[i]).cart_size();
+      cart_offsets[shell_list[i]] = nbe_cart;
+      shell_index[shell_list[i]]  = i;
+      nbe_cart += ncart;
+      ncart_max = std::max<size_t>( ncart_max, ncart );
+    }
 
-      //size_t joff_cart = 0;
-      for( auto j = 0ul; j <= i; ++j ) {
-      //for( auto j = i; j < nshells; ++j ) {
-        const auto jsh        = shell_list[j];
-        const auto& ket       = basis[jsh];
-        const int ket_cart_sz = ket.cart_size();
-        const size_t joff_cart = cou_cart_sizes[j] * npts;
-        XCPU::point ket_origin{ket.O()[0],ket.O()[1],ket.O()[2]};
-        if(!need_sp(ish,jsh)) continue;
-        ++ndo;
-
-        auto sh_pair = shpairs.at(ish,jsh);
-        auto prim_pair_data = sh_pair.prim_pairs();
-        auto nprim_pair     = sh_pair.nprim_pairs();
-        
-        XCPU::compute_integral_shell_pair( ish == jsh,
-        				   npts, _points_transposed.data(),
-        				   bra.l(), ket.l(), bra_origin, ket_origin,
-        				   nprim_pair, prim_pair_data,
-        				   X_cart_rm.data()+ioff_cart, X_cart_rm.data()+joff_cart, npts,
-        				   G_cart_rm.data()+ioff_cart, G_cart_rm.data()+joff_cart, npts,
-        				   const_cast<double*>(weights), this->boys_table );
-        
-        //joff_cart += ket_cart_sz * npts;
+    // Set G to zero
+    for( size_t i = 0; i < nbe_cart; ++i )
+      std::fill_n( G + i*ldg, npts, 0. );
+
+    // Point level screening: a shell pair only contributes to the blocks of
+    // points where w(i) * |A(mu,nu,i)| * sum_nu |F(nu,i)| may exceed eps_pt
+    const size_t nblocks = util::div_ceil( npts, exx_pt_block );
+    const bool screen_pts = eps_pt > 0. and nblocks > 1;
+
+    double* block_box   = nullptr; // (lo,hi) corners of each block
+    double* block_w_max = nullptr; // max_i w(i) of each block
+    double* block_F_max = nullptr; // max_i sum_nu |F(nu,i)| per shell/block
+    double* block_A_max = nullptr; // Bound of |A(mu,nu,i)| per block
+    size_t* pt_index    = nullptr; // Points of the significant blocks
+    double *points_scr = nullptr, *points_transposed_scr = nullptr, 
+           *weights_scr = nullptr, *F_scr = nullptr, *G_scr = nullptr;
+    if( screen_pts ) {
+      block_box   = arena.allocate<double>( 6 * nblocks );
+      block_w_max = arena.allocate<double>( nblocks );
+      block_F_max = arena.allocate<double>( nshells * nblocks );
+      for( size_t ib = 0; ib < nblocks; ++ib ) {
+        const auto ipt_st = ib * exx_pt_block;
+        const auto ipt_en = std::min( npts, ipt_st + exx_pt_block );
+
+        double* lo = block_box + 6*ib;
+        double* hi = lo + 3;
+        std::copy_n( points + 3*ipt_st, 3, lo );
+        std::copy_n( points + 3*ipt_st, 3, hi );
+        double w_max = 0.;
+        for( auto ipt = ipt_st; ipt < ipt_en; ++ipt ) {
+          for( int k = 0; k < 3; ++k ) {
+            lo[k] = std::min( lo[k], points[3*ipt + k] );
+            hi[k] = std::max( hi[k], points[3*ipt + k] );
+          }
+          w_max = std::max( w_max, std::abs(weights[ipt]) );
+        }
+        block_w_max[ib] = w_max;
+
+        for( auto i = 0ul; i < nshells; ++i ) {
+          const auto* F_i = F + cart_offsets[shell_list[i]] * ldf;
+          const size_t ncart = basis.at(shell_list[i]).cart_size();
+          double F_max = 0.;
+          for( auto ipt = ipt_st; ipt < ipt_en; ++ipt ) {
+            double tmp = 0.;
+            for( auto mu = 0ul; mu < ncart; ++mu ) 
+              tmp += std::abs( F_i[mu*ldf + ipt] );
+            F_max = std::max( F_max, tmp );
+          }
+          block_F_max[i + ib*nshells] = F_max;
+        }
       }
-	
-      //ioff_cart += bra_cart_sz * npts;
+
+      block_A_max           = arena.allocate<double>( nblocks );
+      pt_index              = arena.allocate<size_t>( npts );
+      points_scr            = arena.allocate<double>( 3 * npts );
+      points_transposed_scr = arena.allocate<double>( 3 * npts );
+      weights_scr           = arena.allocate<double>( npts );
+      F_scr                 = arena.allocate<double>( 2 * ncart_max * npts );
+      G_scr                 = arena.allocate<double>( 2 * ncart_max * npts );
     }
-#else
+
     for( auto ij = 0ul; ij < nshell_pairs; ++ij ) {
       auto [ish,jsh] = shell_pair_list[ij];
-      //std::cout << "SHP " << ij << " " << i << " " << j << " " << nshells << std::endl;
 
-     
       // Bra
       const auto& bra      = basis.at(ish);
-      const auto ioff_cart = cou_offsets_map.at(ish) * npts;
+      const auto  ioff     = cart_offsets[ish];
       XCPU::point bra_origin{bra.O()[0],bra.O()[1],bra.O()[2]};
 
       // Ket
       const auto& ket      = basis.at(jsh);
-      const auto joff_cart = cou_offsets_map.at(jsh) * npts;
+      const auto  joff     = cart_offsets[jsh];
       XCPU::point ket_origin{ket.O()[0],ket.O()[1],ket.O()[2]};
 
-      auto sh_pair = shpairs.at(ish,jsh);
-      auto prim_pair_data = sh_pair.prim_pairs();
-      auto nprim_pair     = sh_pair.nprim_pairs();
-      
-      ndo++;  
-      XCPU::compute_integral_shell_pair( ish == jsh,
-      				   npts, _points_transposed.data(),
-      				   bra.l(), ket.l(), bra_origin, ket_origin,
-      				   nprim_pair, prim_pair_data,
-      				   X_cart_rm.data()+ioff_cart, X_cart_rm.data()+joff_cart, npts,
-      				   G_cart_rm.data()+ioff_cart, G_cart_rm.data()+joff_cart, npts,
-      				   const_cast<double*>(weights), this->boys_table );
+      auto& sh_pair = shpairs.at(ish,jsh);
+      auto* prim_pairs = const_cast<XCPU::prim_pair*>(sh_pair.prim_pairs());
+
+      // Collect the points of the significant blocks
+      size_t npts_sig = npts;
+      if( screen_pts ) {
+        const auto i_loc = shell_index[ish];
+        const auto j_loc = shell_index[jsh];
+        shell_pair_box_bound( bra.l(), ket.l(), sh_pair.nprim_pairs(), 
+          prim_pairs, nblocks, block_box, block_A_max );
+
+        npts_sig = 0;
+        for( size_t ib = 0; ib < nblocks; ++ib ) {
+          const double F_max = std::max( block_F_max[i_loc + ib*nshells],
+            block_F_max[j_loc + ib*nshells] );
+          if( block_w_max[ib] * F_max * block_A_max[ib] < eps_pt ) continue;
+
+          const auto ipt_st = ib * exx_pt_block;
+          const auto ipt_en = std::min( npts, ipt_st + exx_pt_block );
+          for( auto ipt = ipt_st; ipt < ipt_en; ++ipt ) 
+            pt_index[npts_sig++] = ipt;
+        }
+        if( npts_sig == 0 ) continue;
+      }
+
+      if( npts_sig == npts ) {
+        shpair_dispatch->compute_integral_shell_pair( ish == jsh,
+          npts, points, points_transposed, bra.l(), ket.l(), bra_origin, 
+          ket_origin, sh_pair.nprim_pairs(), prim_pairs,
+          const_cast<double*>(F) + ioff*ldf, const_cast<double*>(F) + joff*ldf, 
+          ldf, G + ioff*ldg, G + joff*ldg, ldg,
+          const_cast<double*>(weights), this->boys_table );
+        continue;
+      }
+
+      // Gather the significant points, integrate and scatter into G
+      const size_t ncart_i = bra.cart_size();
+      const size_t ncart_j = (ish == jsh) ? 0 : ket.cart_size();
+      for( size_t p = 0; p < npts_sig; ++p ) {
+        const auto ipt = pt_index[p];
+        for( int k = 0; k < 3; ++k ) {
+          points_scr[3*p + k] = points[3*ipt + k];
+          points_transposed_scr[p + k*npts_sig] = points[3*ipt + k];
+        }
+        weights_scr[p] = weights[ipt];
+      }
+      for( size_t mu = 0; mu < ncart_i + ncart_j; ++mu ) {
+        const auto* F_mu = F + (mu < ncart_i ? ioff + mu : joff + mu - ncart_i)*ldf;
+        for( size_t p = 0; p < npts_sig; ++p ) 
+          F_scr[mu*npts_sig + p] = F_mu[pt_index[p]];
+      }
+      std::fill_n( G_scr, (ncart_i + ncart_j)*npts_sig, 0. );
+
+      auto* F_scr_j = (ish == jsh) ? F_scr : F_scr + ncart_i*npts_sig;
+      auto* G_scr_j = (ish == jsh) ? G_scr : G_scr + ncart_i*npts_sig;
+      shpair_dispatch->compute_integral_shell_pair( ish == jsh,
+        npts_sig, points_scr, points_transposed_scr, bra.l(), ket.l(), 
+        bra_origin, ket_origin, sh_pair.nprim_pairs(), prim_pairs,
+        F_scr, F_scr_j, npts_sig, G_scr, G_scr_j, npts_sig, weights_scr, 
+        this->boys_table );
+
+      for( size_t mu = 0; mu < ncart_i + ncart_j; ++mu ) {
+        auto* G_mu = G + (mu < ncart_i ? ioff + mu : joff + mu - ncart_i)*ldg;
+        for( size_t p = 0; p < npts_sig; ++p ) 
+          G_mu[pt_index[p]] += G_scr[mu*npts_sig + p];
+      }
+    }
+
+  }
+
+  // Construct G(mu,i) = w(i) * A(mu,nu,i) * F(nu, i)
+  void ReferenceLocalHostWorkDriver::eval_exx_gmat( size_t npts, size_t nshells, 
+    size_t nshell_pairs, size_t nbe, const double* points, const double* weights, 
+    const BasisSet<double>& basis, const ShellPairCollection<double>& shpairs, 
+    const BasisSetMap& basis_map, const int32_t* shell_list, 
+    const std::pair<int32_t,int32_t>* shell_pair_list, 
+    const double* X, size_t ldx, double* G, size_t ldg ) {
+
+    util::unused(basis_map);
+
+    auto& arena = HostArena::thread_arena();
+    HostArena::scope scratch_scope( arena );
+
+    const auto& sph_trans = exx_sph_trans();
+    const size_t nbe_cart = 
+      basis.nbf_cart_subset( shell_list, shell_list + nshells );
+
+    // Row major (spherical) X
+    auto* X_rm = arena.allocate<double>( nbe * npts );
+    for( auto j = 0ul; j < npts; ++j )
+    for( auto i = 0ul; i < nbe;  ++i ) {
+      X_rm[i*npts + j] = X[i + j*ldx];
     }
-#endif
+
+    // Transform X into Cartesian
+    auto* X_cart_rm = arena.allocate<double>( nbe_cart * npts );
+    auto* G_cart_rm = arena.allocate<double>( nbe_cart * npts );
+    {
+    size_t ioff = 0, ioff_cart = 0;
+    for( auto i = 0ul; i < nshells; ++i ) {
+      const auto& shell = basis.at(shell_list[i]);
+      if( shell.pure() and shell.l() > 0 ) {
+        sph_trans.itform_bra_rm( shell.l(), npts, X_rm + ioff*npts, npts,
+          X_cart_rm + ioff_cart*npts, npts );
+      } else {
+        std::copy_n( X_rm + ioff*npts, shell.size()*npts, 
+          X_cart_rm + ioff_cart*npts );
+      }
+      ioff      += shell.size();
+      ioff_cart += shell.cart_size();
     }
-    //std::cout << "NDO " << ndo << " " << ndo / double(nshells*(nshells+1)/2) << std::endl;
-   
-    for( auto i = 0ul; i < nbe_cart; ++i )
-    for( auto j = 0ul; j < npts;     ++j ) {
-	    G_use[i + j*ldg_use] = G_cart_rm[i*npts + j];
     }
-  
-    // Transform G back to spherical
-    if( any_pure ) {
-      size_t ioff = 0;
-      size_t ioff_cart = 0;
-      for( auto i = 0ul; i < nshells; ++i ) {
-        const auto ish = shell_list[i];
-        const auto& shell      = basis.at(ish);
-        const int shell_l       = shell.l();
-        const int shell_sz      = shell.size();
-        const int shell_cart_sz = shell.cart_size();
-        
-        if( shell.pure() and shell_l > 0 ) {
-          sph_trans.tform_bra_cm( shell_l, npts, G_cart.data() + ioff_cart, nbe_cart,
-        			  G + ioff, ldg );
-        } else {
-          blas::lacpy( 'A', shell_sz, npts, G_cart.data() + ioff_cart, nbe_cart,
-        	       G + ioff, ldg );
-        }
-        ioff += shell_sz;
-        ioff_cart += shell_cart_sz;
+
+    eval_exx_gmat_cart( npts, nshells, nshell_pairs, points, weights, basis,
+      shpairs, shell_list, shell_pair_list, X_cart_rm, npts, G_cart_rm, npts,
+      0. );
+
+    // Transform G back to spherical (reusing X_rm) and into column major
+    auto* G_rm = X_rm;
+    {
+    size_t ioff = 0, ioff_cart = 0;
+    for( auto i = 0ul; i < nshells; ++i ) {
+      const auto& shell = basis.at(shell_list[i]);
+      if( shell.pure() and shell.l() > 0 ) {
+        sph_trans.tform_bra_rm( shell.l(), npts, G_cart_rm + ioff_cart*npts, 
+          npts, G_rm + ioff*npts, npts );
+      } else {
+        std::copy_n( G_cart_rm + ioff_cart*npts, shell.size()*npts, 
+          G_rm + ioff*npts );
       }
+      ioff      += shell.size();
+      ioff_cart += shell.cart_size();
+    }
+    }
+
+    for( auto j = 0ul; j < npts; ++j )
+    for( auto i = 0ul; i < nbe;  ++i ) {
+      G[i + j*ldg] = G_rm[i*npts + j];
     }
 
   } // GMAT
 
+  // Form Kc(mu,nu) = B(mu,i) * G(nu,i) (nu Cartesian), and transform the
+  // columns of Kc to spherical in place of the ket transformation of G
+  static const double* exx_k_cart_contract( size_t npts, size_t nbe_bra,
+    size_t nbe_ket, size_t nshells_ket, const int32_t* shell_list_ket,
+    const BasisSet<double>& basis, const double* basis_eval, const double* G,
+    size_t ldg, HostArena& arena ) {
+
+    const size_t nbe_cart = 
+      basis.nbf_cart_subset( shell_list_ket, shell_list_ket + nshells_ket );
+
+    // G row major (nbe_cart,npts) == G**T col major
+    auto* K_cart = arena.allocate<double>( nbe_bra * nbe_cart );
+    blas::gemm( 'N', 'N', nbe_bra, nbe_cart, npts, 1., basis_eval, nbe_bra,
+      G, ldg, 0., K_cart, nbe_bra );
+
+    if( not exx_any_pure( nshells_ket, shell_list_ket, basis ) ) return K_cart;
+
+    // K_cart**T is row major (nbe_cart, nbe_bra)
+    const auto& sph_trans = exx_sph_trans();
+    auto* K_sph = arena.allocate<double>( nbe_bra * nbe_ket );
+    size_t ioff = 0, ioff_cart = 0;
+    for( auto i = 0ul; i < nshells_ket; ++i ) {
+      const auto& shell = basis.at(shell_list_ket[i]);
+      if( shell.pure() and shell.l() > 0 ) {
+        sph_trans.tform_bra_rm( shell.l(), nbe_bra, K_cart + ioff_cart*nbe_bra,
+          nbe_bra, K_sph + ioff*nbe_bra, nbe_bra );
+      } else {
+        std::copy_n( K_cart + ioff_cart*nbe_bra, shell.size()*nbe_bra,
+          K_sph + ioff*nbe_bra );
+      }
+      ioff      += shell.size();
+      ioff_cart += shell.cart_size();
+    }
+
+    return K_sph;
+  }
+
+  void ReferenceLocalHostWorkDriver::inc_exx_k_cart( size_t npts, size_t nbf,
+    size_t nbe_bra, size_t nbe_ket, size_t nshells_ket, 
+    const int32_t* shell_list_ket, const BasisSet<double>& basis, 
+    const double* basis_eval, const submat_map_t& submat_map_bra, 
+    const submat_map_t& submat_map_ket, const double* G, size_t ldg, double* K,
+    size_t ldk ) {
+
+    auto& arena = HostArena::thread_arena();
+    HostArena::scope scratch_scope( arena );
+
+    const auto* K_sub = exx_k_cart_contract( npts, nbe_bra, nbe_ket, 
+      nshells_ket, shell_list_ket, basis, basis_eval, G, ldg, arena );
+
+    detail::inc_by_submat_atomic( nbf, nbf, nbe_bra, nbe_ket, K, ldk, 
+      K_sub, nbe_bra, submat_map_bra, submat_map_ket );
+
+  }
+
+  void ReferenceLocalHostWorkDriver::inc_exx_k_cart_packed( size_t npts, 
+    size_t nbf, size_t nbe_bra, size_t nbe_ket, size_t nshells_ket, 
+    const int32_t* shell_list_ket, const BasisSet<double>& basis, 
+    const double* basis_eval, const submat_map_t& submat_map_bra, 
+    const submat_map_t& submat_map_ket, const double* G, size_t ldg, 
+    double* K_packed ) {
+
+    auto& arena = HostArena::thread_arena();
+    HostArena::scope scratch_scope( arena );
+
+    const auto* K_sub = exx_k_cart_contract( npts, nbe_bra, nbe_ket, 
+      nshells_ket, shell_list_ket, basis, basis_eval, G, ldg, arena );
+
+    detail::inc_by_submat_packed_fold( nbf, nbe_bra, nbe_ket, K_packed, 
+      K_sub, nbe_bra, submat_map_bra, submat_map_ket );
+
+  }
+
 }
@@ -15,16 +15,18 @@ typedef struct {
   int m, L;
 } shells;
 
+// Binary compatible with GauXC::PrimitivePair<double>
 typedef struct {
   point P;
   point PA;
   point PB;
 
-  double K;
+  double K_coeff_prod;
   double gamma;
-  double coeff_prod;
+  double gamma_inv;
 } prim_pair;
 
+// rAB = A - B, A is expected to carry the higher angular momentum
 typedef struct {
   int lA;
   int lB;
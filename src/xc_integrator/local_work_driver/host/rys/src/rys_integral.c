@@ -17,7 +17,7 @@
 
 #define R_MAX (Lx + 1)
 
-#define PB 16
+#define PT_BLOCK 16
 
 #define PI 3.14159265358979323846
 
@@ -321,10 +321,10 @@ inline void __attribute__((always_inline)) compute_reduction(int nr_roots, int l
 }
 
 void compute_integral(int n, shells *shell_list, int m, point *points, double *matrix) {
-  double *rts = (double*) malloc(PB * R_MAX * sizeof(double));
-  double *wgh = (double*) malloc(PB * R_MAX * sizeof(double));
+  double *rts = (double*) malloc(PT_BLOCK * R_MAX * sizeof(double));
+  double *wgh = (double*) malloc(PT_BLOCK * R_MAX * sizeof(double));
 
-  double *int_array = (double*) malloc(PB * Vx * Vy * sizeof(double));
+  double *int_array = (double*) malloc(PT_BLOCK * Vx * Vy * sizeof(double));
   double *vrr_array = (double*) malloc(3 * (Lx + Ly + 1) * R_MAX * sizeof(double));
   double *hrr_array = (double*) malloc(3 * (Lx + 1) * (Ly + 1) * R_MAX * sizeof(double));
 
@@ -342,8 +342,8 @@ void compute_integral(int n, shells *shell_list, int m, point *points, double *m
     for(int jj = 0; jj < n; ++jj) {
       shells shell1 = shell_list[jj];
 
-      for(int p = 0; p < m; p += PB) {
-	int pp = MIN(m - p, PB);
+      for(int p = 0; p < m; p += PT_BLOCK) {
+	int pp = MIN(m - p, PT_BLOCK);
 	point *ppoints = (points + p);
       
 	// values
@@ -385,10 +385,10 @@ void compute_integral(int n, shells *shell_list, int m, point *points, double *m
 	    double yPX = (lB < lA) ? (yP - yA) : (yP - yB);
 	    double zPX = (lB < lA) ? (zP - zA) : (zP - zB);
 
-	    double tval[PB];
-	    double xPC[PB];
-	    double yPC[PB];
-	    double zPC[PB];
+	    double tval[PT_BLOCK];
+	    double xPC[PT_BLOCK];
+	    double yPC[PT_BLOCK];
+	    double zPC[PT_BLOCK];
 	    
 	    double eval = exp(-1.0 * (xAB * xAB + yAB * yAB + zAB * zAB) * aA * aB * aP_inv);
 
@@ -492,8 +492,8 @@ void compute_integral_shell_pair( int npts,
 				  shells sh1, 
                                   point *points,
 				  double *matrix ) {
-  double *rts = (double*) malloc(PB * R_MAX * sizeof(double));
-  double *wgh = (double*) malloc(PB * R_MAX * sizeof(double));
+  double *rts = (double*) malloc(PT_BLOCK * R_MAX * sizeof(double));
+  double *wgh = (double*) malloc(PT_BLOCK * R_MAX * sizeof(double));
 
   double *vrr_array = (double*) malloc(3 * (Lx + Ly + 1) * R_MAX * sizeof(double));
   double *hrr_array = (double*) malloc(3 * (Lx + 1) * (Ly + 1) * R_MAX * sizeof(double));
@@ -517,8 +517,8 @@ void compute_integral_shell_pair( int npts,
   double zAB = (lB < lA) ? (zA - zB) : (zB - zA);
 
   const int shpair_sz =  (lA+1)*(lA+2) * (lB+1)*(lB+2) / 4;
-  for(int p = 0; p < npts; p += PB) {
-    int pp = MIN(npts - p, PB);
+  for(int p = 0; p < npts; p += PT_BLOCK) {
+    int pp = MIN(npts - p, PT_BLOCK);
     point *ppoints = (points + p);
     
     double beta = 0.0;
@@ -542,10 +542,10 @@ void compute_integral_shell_pair( int npts,
 	double yPX = (lB < lA) ? (yP - yA) : (yP - yB);
 	double zPX = (lB < lA) ? (zP - zA) : (zP - zB);
 
-	double tval[PB];
-	double xPC[PB];
-	double yPC[PB];
-	double zPC[PB];
+	double tval[PT_BLOCK];
+	double xPC[PT_BLOCK];
+	double yPC[PT_BLOCK];
+	double zPC[PT_BLOCK];
 	    
 	double eval = exp(-1.0 * (xAB * xAB + yAB * yAB + zAB * zAB) * aA * aB * aP_inv);
 
@@ -632,13 +632,12 @@ void compute_integral_shell_pair( int npts,
   free(hrr_array);
 }
 
-#if 0
 void compute_integral_shell_pair_pre( int npts,
 				      shell_pair shpair, 
 				      point *points,
 				      double *matrix ) {
-  double *rts = (double*) malloc(PB * R_MAX * sizeof(double));
-  double *wgh = (double*) malloc(PB * R_MAX * sizeof(double));
+  double *rts = (double*) malloc(PT_BLOCK * R_MAX * sizeof(double));
+  double *wgh = (double*) malloc(PT_BLOCK * R_MAX * sizeof(double));
 
   double *vrr_array = (double*) malloc(3 * (Lx + Ly + 1) * R_MAX * sizeof(double));
   double *hrr_array = (double*) malloc(3 * (Lx + 1) * (Ly + 1) * R_MAX * sizeof(double));
@@ -655,15 +654,15 @@ void compute_integral_shell_pair_pre( int npts,
   double zAB = value * shpair.rAB.z;
   
   const int shpair_sz =  (lA+1)*(lA+2) * (lB+1)*(lB+2) / 4;
-  for(int p = 0; p < npts; p += PB) {
-    int pp = MIN(npts - p, PB);
+  for(int p = 0; p < npts; p += PT_BLOCK) {
+    int pp = MIN(npts - p, PT_BLOCK);
     point *ppoints = (points + p);
 	
     double beta = 0.0;
     prim_pair *prim_pairs = shpair.prim_pairs;
     for(int ij = 0; ij < shpair.nprim_pair; ++ij) { 
       const double aP = prim_pairs[ij].gamma;
-      const double aP_inv = 1.0 / aP;
+      const double aP_inv = prim_pairs[ij].gamma_inv;
 
       const double xP = prim_pairs[ij].P.x;
       const double yP = prim_pairs[ij].P.y;
@@ -673,10 +672,10 @@ void compute_integral_shell_pair_pre( int npts,
       const double yPX = (lB < lA) ? prim_pairs[ij].PA.y : prim_pairs[ij].PB.y;
       const double zPX = (lB < lA) ? prim_pairs[ij].PA.z : prim_pairs[ij].PB.z;
 
-      double tval[PB];
-      double xPC[PB];
-      double yPC[PB];
-      double zPC[PB];
+      double tval[PT_BLOCK];
+      double xPC[PT_BLOCK];
+      double yPC[PT_BLOCK];
+      double zPC[PT_BLOCK];
 	    
       for(int pb = 0; pb < pp; ++pb) {
 	point C = *(ppoints + pb);
@@ -694,7 +693,7 @@ void compute_integral_shell_pair_pre( int npts,
 
       for(int pb = 0; pb < pp * nr_roots; ++pb) {
 	*(rts + pb) = 0.0;
-	*(wgh + pb) = 2 * PI * aP_inv * prim_pairs[ij].K * prim_pairs[ij].coeff_prod;
+	*(wgh + pb) = prim_pairs[ij].K_coeff_prod;
       }
   
       rys_rw(pp, nr_roots, tval, rts, wgh);  
@@ -759,14 +758,3 @@ void compute_integral_shell_pair_pre( int npts,
   free(vrr_array);
   free(hrr_array);
 }
-#endif
-
-
-
-
-
-
-
-
-
-
@@ -0,0 +1,401 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "host/shell_pair_integral_dispatch.hpp"
+#include "cpu/obara_saika_integrals.hpp"
+#include "cpu/chebyshev_boys_computation.hpp"
+#include "rys_integral.h"
+#include "integrator_util/host_arena.hpp"
+
+#include <gauxc/exceptions.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include <unistd.h>
+
+namespace GauXC {
+
+static_assert( sizeof(::prim_pair) == sizeof(XCPU::prim_pair) and
+  offsetof(::prim_pair, K_coeff_prod) == offsetof(XCPU::prim_pair, K_coeff_prod) and
+  offsetof(::prim_pair, gamma_inv)    == offsetof(XCPU::prim_pair, gamma_inv),
+  "Rys and Obara-Saika primitive pairs must be binary compatible" );
+
+static_assert( sizeof(::point) == 3 * sizeof(double),
+  "Rys points must be binary compatible with (x,y,z) interleaved storage" );
+
+namespace {
+
+inline int ncart( int l ) { return (l+1)*(l+2)/2; }
+
+const char* backend_name( ShellPairIntegralBackend backend ) {
+  return backend == ShellPairIntegralBackend::Rys ? "rys" : "os";
+}
+
+}
+
+void rys_integral_shell_pair( int is_diag, size_t npts, const double* points,
+  int lA, int lB, XCPU::point rA, XCPU::point rB, int nprim_pairs,
+  const XCPU::prim_pair* prim_pairs, const double* Xi, const double* Xj,
+  int ldX, double* Gi, double* Gj, int ldG, const double* weights ) {
+
+  if( not nprim_pairs ) return;
+
+  // Primitive pairs are generated w.r.t. the shell of higher L (ShellPair)
+  if( lA < lB ) {
+    std::swap(lA, lB); std::swap(rA, rB);
+    std::swap(Xi, Xj); std::swap(Gi, Gj);
+  }
+
+  ::shell_pair shpair;
+  shpair.lA         = lA;
+  shpair.lB         = lB;
+  shpair.nprim_pair = nprim_pairs;
+  shpair.rAB        = { rA.x - rB.x, rA.y - rB.y, rA.z - rB.z };
+  shpair.prim_pairs =
+    reinterpret_cast<::prim_pair*>(const_cast<XCPU::prim_pair*>(prim_pairs));
+
+  const int ncA = ncart(lA);
+  const int ncB = ncart(lB);
+  const int shpair_sz = ncA * ncB;
+
+  // Integrals are formed in chunks of points, stored (ncA,ncB,npts) row major
+  constexpr size_t npts_chunk = 128;
+  auto& arena = HostArena::thread_arena();
+  HostArena::scope ints_scope( arena );
+  auto* ints = arena.allocate<double>( shpair_sz * std::min(npts, npts_chunk) );
+
+  auto* _points =
+    reinterpret_cast<::point*>(const_cast<double*>(points));
+  for( size_t p_st = 0; p_st < npts; p_st += npts_chunk ) {
+    const size_t np = std::min(npts - p_st, npts_chunk);
+    compute_integral_shell_pair_pre( np, shpair, _points + p_st, ints );
+
+    for( size_t p = 0; p < np; ++p ) {
+      const auto  ip = p_st + p;
+      const auto  w  = weights[ip];
+      const auto* A  = ints + p * shpair_sz;
+
+      // G(a) += w * A(a,b) * X(b)
+      for( int a = 0; a < ncA; ++a ) {
+        double tmp = 0.;
+        for( int b = 0; b < ncB; ++b ) tmp += A[a*ncB + b] * Xj[b*ldX + ip];
+        Gi[a*ldG + ip] += w * tmp;
+      }
+
+      // G(b) += w * A(a,b) * X(a)
+      if( not is_diag )
+      for( int b = 0; b < ncB; ++b ) {
+        double tmp = 0.;
+        for( int a = 0; a < ncA; ++a ) tmp += A[a*ncB + b] * Xi[a*ldX + ip];
+        Gj[b*ldG + ip] += w * tmp;
+      }
+    }
+  }
+
+}
+
+
+
+void shell_pair_box_bound( int lA, int lB, int nprim_pairs,
+  const XCPU::prim_pair* prim_pairs, size_t nboxes, const double* boxes,
+  double* bounds ) {
+
+  // F_0(T) <= min(1, sqrt(pi/T)/2)
+  auto boys_0_bound = []( double T ) {
+    return T < M_PI / 4 ? 1. : 0.5 * std::sqrt( M_PI / T );
+  };
+
+  std::fill_n( bounds, nboxes, 0. );
+
+  const int L = lA + lB;
+  for( int ij = 0; ij < nprim_pairs; ++ij ) {
+    const auto& pp = prim_pairs[ij];
+    const double P[3] = { pp.P.x, pp.P.y, pp.P.z };
+
+    // |r-A|^lA |r-B|^lB exp(-g s^2/2) <= (s + m)^L exp(-g s^2/2) with
+    // s = |r-P| and m = max(|PA|,|PB|), maximized over s
+    double K = std::abs( pp.K_coeff_prod ), g = pp.gamma;
+    if( L > 0 ) {
+      const double PA = std::sqrt( pp.PA.x*pp.PA.x + pp.PA.y*pp.PA.y + 
+        pp.PA.z*pp.PA.z );
+      const double PB = std::sqrt( pp.PB.x*pp.PB.x + pp.PB.y*pp.PB.y + 
+        pp.PB.z*pp.PB.z );
+      const double m = std::max( PA, PB );
+      const double s = 0.5 * ( std::sqrt( m*m + 4. * L * pp.gamma_inv ) - m );
+      K *= 2. * std::pow( s + m, L ) * std::exp( -0.5 * g * s*s );
+      g *= 0.5;
+    }
+
+    for( size_t ib = 0; ib < nboxes; ++ib ) {
+      const double* lo = boxes + 6*ib;
+      const double* hi = lo + 3;
+      double d2 = 0.;
+      for( int k = 0; k < 3; ++k ) {
+        const double dk = std::max( { 0., lo[k] - P[k], P[k] - hi[k] } );
+        d2 += dk * dk;
+      }
+      bounds[ib] += K * boys_0_bound( g * d2 );
+    }
+  }
+
+}
+
+ShellPairIntegralDispatch::ShellPairIntegralDispatch() noexcept {
+  force( ShellPairIntegralBackend::ObaraSaika );
+}
+
+ShellPairIntegralBackend& ShellPairIntegralDispatch::at( int lA, int lB,
+  int bin ) noexcept {
+  return table_[ bin + nprim_bins * (lB + nl * lA) ];
+}
+
+const ShellPairIntegralBackend& ShellPairIntegralDispatch::at( int lA, int lB,
+  int bin ) const noexcept {
+  return table_[ bin + nprim_bins * (lB + nl * lA) ];
+}
+
+int ShellPairIntegralDispatch::nprim_bin( int nprim_pairs ) noexcept {
+  if( nprim_pairs <= 1  ) return 0;
+  if( nprim_pairs <= 4  ) return 1;
+  if( nprim_pairs <= 16 ) return 2;
+  return 3;
+}
+
+ShellPairIntegralBackend ShellPairIntegralDispatch::select( int lA, int lB,
+  int nprim_pairs ) const {
+  if( lA < lB ) std::swap(lA, lB);
+  if( lA > max_l_rys ) 
+    GAUXC_GENERIC_EXCEPTION("sn-K Integrals Not Available for L = " + 
+      std::to_string(lA) + " > " + std::to_string(max_l_rys));
+  return at( lA, lB, nprim_bin(nprim_pairs) );
+}
+
+void ShellPairIntegralDispatch::force( ShellPairIntegralBackend backend )
+  noexcept {
+  for( int lA = 0; lA < nl; ++lA )
+  for( int lB = 0; lB < nl; ++lB )
+  for( int bin = 0; bin < nprim_bins; ++bin ) {
+    at(lA, lB, bin) = std::max(lA,lB) > max_l_os ?
+      ShellPairIntegralBackend::Rys : backend;
+  }
+}
+
+void ShellPairIntegralDispatch::tune() {
+
+  using clock = std::chrono::steady_clock;
+
+  // Representative primitive pair counts for each bin
+  constexpr std::array<int,nprim_bins> nprim_shell = {1, 2, 3, 5};
+  constexpr size_t npts = 64;
+  constexpr int    nrep = 3;
+
+  // Deterministic synthetic grid around the shell pair
+  std::vector<double> points(3*npts), points_transposed(3*npts), weights(npts);
+  uint64_t seed = 88172645463325252ull;
+  auto uniform = [&]() {
+    seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+    return double(seed >> 11) / double(1ull << 53);
+  };
+  for( size_t i = 0; i < npts; ++i ) {
+    for( int k = 0; k < 3; ++k ) {
+      points[3*i + k] = 4. * uniform() - 2.;
+      points_transposed[i + k*npts] = points[3*i + k];
+    }
+    weights[i] = uniform();
+  }
+
+  const int nc_max = ncart(max_l_os);
+  std::vector<double> X(2*nc_max*npts), G(2*nc_max*npts);
+  for( auto& x : X ) x = uniform() - 0.5;
+
+  double* boys_table = XCPU::boys_init();
+
+  XCPU::point rA{0.0,  0.0, 0.0};
+  XCPU::point rB{0.7, -0.5, 1.2};
+  std::vector<XCPU::coefficients> cA, cB;
+  std::vector<XCPU::prim_pair>    prim_pairs;
+
+  for( int bin = 0; bin < nprim_bins; ++bin ) {
+    const int np = nprim_shell[bin];
+    cA.resize(np); cB.resize(np);
+    for( int i = 0; i < np; ++i ) {
+      cA[i] = { 0.4 * std::pow(2., i), 1. };
+      cB[i] = { 0.3 * std::pow(2., i), 1. };
+    }
+
+    XCPU::shells shA{ rA, cA.data(), np, 0 };
+    XCPU::shells shB{ rB, cB.data(), np, 0 };
+    prim_pairs.resize(np*np);
+    XCPU::generate_shell_pair( shA, shB, prim_pairs.data() );
+
+    for( int lA = 0; lA <= max_l_os; ++lA )
+    for( int lB = 0; lB <= lA;       ++lB ) {
+
+      double* Xi = X.data(); double* Xj = Xi + ncart(lA) * npts;
+      double* Gi = G.data(); double* Gj = Gi + ncart(lA) * npts;
+
+      auto time_backend = [&]( auto&& kernel ) {
+        double t_min = std::numeric_limits<double>::infinity();
+        for( int irep = 0; irep < nrep; ++irep ) {
+          auto st = clock::now();
+          kernel();
+          auto en = clock::now();
+          t_min = std::min( t_min,
+            std::chrono::duration<double>(en - st).count() );
+        }
+        return t_min;
+      };
+
+      const double t_os = time_backend( [&]() {
+        XCPU::compute_integral_shell_pair( 0, npts, points_transposed.data(),
+          lA, lB, rA, rB, np*np, prim_pairs.data(), Xi, Xj, npts, Gi, Gj,
+          npts, weights.data(), boys_table );
+      });
+      const double t_rys = time_backend( [&]() {
+        rys_integral_shell_pair( 0, npts, points.data(), lA, lB, rA, rB,
+          np*np, prim_pairs.data(), Xi, Xj, npts, Gi, Gj, npts,
+          weights.data() );
+      });
+
+      // Require a clear win to avoid flip-flopping on timer noise
+      const auto backend = (t_rys < 0.95 * t_os) ?
+        ShellPairIntegralBackend::Rys : ShellPairIntegralBackend::ObaraSaika;
+      at(lA, lB, bin) = backend;
+      at(lB, lA, bin) = backend;
+    }
+  }
+
+  XCPU::boys_finalize(boys_table);
+
+}
+
+bool ShellPairIntegralDispatch::read( const std::string& fname ) {
+
+  std::ifstream infile(fname);
+  if( not infile.good() ) return false;
+
+  std::string line;
+  while( std::getline(infile, line) ) {
+    if( line.empty() or line[0] == '#' ) continue;
+
+    std::istringstream ss(line);
+    int lA, lB, bin;
+    std::string name;
+    if( not (ss >> lA >> lB >> bin >> name) or
+        lA < 0 or lA > max_l_os or lB < 0 or lB > max_l_os or
+        bin < 0 or bin >= nprim_bins or (name != "os" and name != "rys") )
+      GAUXC_GENERIC_EXCEPTION("Malformed sn-K Integral Tuning File " + fname +
+        ": " + line);
+
+    const auto backend = name == "rys" ?
+      ShellPairIntegralBackend::Rys : ShellPairIntegralBackend::ObaraSaika;
+    at(lA, lB, bin) = backend;
+    at(lB, lA, bin) = backend;
+  }
+
+  return true;
+}
+
+void ShellPairIntegralDispatch::write( const std::string& fname ) const {
+
+  // Concurrent readers must never observe a partially written file
+  const std::string tmp_fname = fname + ".tmp." + std::to_string(getpid());
+  std::ofstream outfile(tmp_fname);
+  if( not outfile.good() )
+    GAUXC_GENERIC_EXCEPTION("Could Not Open sn-K Integral Tuning File " + 
+      tmp_fname);
+
+  outfile << "# GauXC sn-K shell pair integral dispatch\n";
+  outfile << "# lA lB nprim_bin backend\n";
+  for( int lA = 0; lA <= max_l_os; ++lA )
+  for( int lB = 0; lB <= lA;       ++lB )
+  for( int bin = 0; bin < nprim_bins; ++bin ) {
+    outfile << lA << " " << lB << " " << bin << " "
+            << backend_name(at(lA, lB, bin)) << "\n";
+  }
+
+  outfile.close();
+  if( outfile.fail() or std::rename( tmp_fname.c_str(), fname.c_str() ) ) {
+    std::remove( tmp_fname.c_str() );
+    GAUXC_GENERIC_EXCEPTION("Could Not Write sn-K Integral Tuning File " + 
+      fname);
+  }
+
+}
+
+const ShellPairIntegralDispatch& ShellPairIntegralDispatch::instance(
+  GAUXC_MPI_CODE(MPI_Comm comm) ) {
+
+  static const ShellPairIntegralDispatch dispatch = [&]() {
+    ShellPairIntegralDispatch d;
+
+    const char* backend_env = getenv("GAUXC_EXX_INTEGRAL_BACKEND");
+    const std::string backend = backend_env ? backend_env : "";
+    if( backend.empty() or backend == "os" ) {
+      d.force( ShellPairIntegralBackend::ObaraSaika );
+    } else if( backend == "rys" ) {
+      d.force( ShellPairIntegralBackend::Rys );
+    } else if( backend == "auto" ) {
+      // Timings differ between ranks, only tune on the root
+      int world_rank = 0;
+      GAUXC_MPI_CODE(
+        int mpi_initialized = 0;
+        MPI_Initialized( &mpi_initialized );
+        if( mpi_initialized ) MPI_Comm_rank( comm, &world_rank );
+      )
+
+      if( not world_rank ) {
+        const char* fname_env = getenv("GAUXC_EXX_INTEGRAL_TUNING_FILE");
+        const std::string fname = fname_env ? fname_env : "";
+        if( fname.empty() or not d.read(fname) ) {
+          d.tune();
+          if( not fname.empty() ) d.write(fname);
+        }
+      }
+
+      GAUXC_MPI_CODE(
+        if( mpi_initialized ) 
+          MPI_Bcast( d.table_.data(), sizeof(d.table_), MPI_BYTE, 0, comm );
+      )
+    } else {
+      GAUXC_GENERIC_EXCEPTION("Unknown sn-K Integral Backend " + backend);
+    }
+
+    return d;
+  }();
+
+  return dispatch;
+}
+
+void ShellPairIntegralDispatch::compute_integral_shell_pair( int is_diag,
+  size_t npts, const double* points, double* points_transposed, int lA,
+  int lB, XCPU::point rA, XCPU::point rB, int nprim_pairs,
+  XCPU::prim_pair* prim_pairs, double* Xi, double* Xj, int ldX,
+  double* Gi, double* Gj, int ldG, double* weights,
+  double* boys_table ) const {
+
+  if( select(lA, lB, nprim_pairs) == ShellPairIntegralBackend::Rys ) {
+    rys_integral_shell_pair( is_diag, npts, points, lA, lB, rA, rB,
+      nprim_pairs, prim_pairs, Xi, Xj, ldX, Gi, Gj, ldG, weights );
+  } else {
+    XCPU::compute_integral_shell_pair( is_diag, npts, points_transposed,
+      lA, lB, rA, rB, nprim_pairs, prim_pairs, Xi, Xj, ldX, Gi, Gj, ldG,
+      weights, boys_table );
+  }
+
+}
+
+}
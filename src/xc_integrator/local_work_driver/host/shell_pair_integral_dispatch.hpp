@@ -0,0 +1,146 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include "cpu/integral_data_types.hpp"
+#include <gauxc/util/mpi.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace GauXC {
+
+/// Integral backends available to form sn-K G contributions on the host
+enum class ShellPairIntegralBackend : uint8_t {
+  ObaraSaika = 0, ///< Generated Obara-Saika kernels (lA,lB <= 4)
+  Rys        = 1  ///< Rys quadrature (lA,lB <= 8)
+};
+
+/**
+ *  Selection of the integral backend per shell pair class
+ *
+ *  Shell pairs are classified by their angular momenta and (binned) number
+ *  of significant primitive pairs. By default, Obara-Saika is selected
+ *  wherever it is available and Rys otherwise, such that K is reproducible
+ *  between runs. Optionally, the table is filled by a short microbenchmark
+ *  of both backends on synthetic shell pairs, or read from a tuning file
+ *  previously written by the same.
+ *
+ *  instance() honors the following environment variables
+ *    GAUXC_EXX_INTEGRAL_BACKEND     "os" (default) or "rys" forces a single
+ *                                   backend wherever it is available,
+ *                                   "auto" selects the backends by tuning
+ *    GAUXC_EXX_INTEGRAL_TUNING_FILE tuning file to read the table from
+ *                                   ("auto" only). If it does not exist,
+ *                                   the table is tuned and written to it.
+ */
+class ShellPairIntegralDispatch {
+
+public:
+
+  static constexpr int max_l_os   = 4; ///< Max L of the Obara-Saika kernels
+  static constexpr int max_l_rys  = 8; ///< Max L of the Rys kernels
+  static constexpr int nprim_bins = 4; ///< nprim_pairs: 1, 2-4, 5-16, > 16
+
+  /// Construct a table which selects Obara-Saika wherever it is available
+  ShellPairIntegralDispatch() noexcept;
+
+  /**
+   *  Process-wide table, set up on first use
+   *
+   *  When tuning is requested, rank 0 of comm tunes (or reads) the table
+   *  and broadcasts it, such that all ranks select the same backends. In
+   *  that case the first call must be collective over comm.
+   *
+   *  @param[in] comm Communicator over which the table is shared
+   */
+  static const ShellPairIntegralDispatch& instance(
+    GAUXC_MPI_CODE(MPI_Comm comm = MPI_COMM_SELF) );
+
+  /// Bin of a shell pair with a particular number of primitive pairs
+  static int nprim_bin( int nprim_pairs ) noexcept;
+
+  /// Backend selected for a shell pair class, throws if lA or lB > max_l_rys
+  ShellPairIntegralBackend select( int lA, int lB, int nprim_pairs ) const;
+
+  /// Fill the table by timing both backends on synthetic shell pairs
+  void tune();
+
+  /// Force a single backend wherever it is available
+  void force( ShellPairIntegralBackend backend ) noexcept;
+
+  /**
+   *  Read the table from a tuning file
+   *
+   *  @param[in] fname Name of the tuning file
+   *  @returns   true if the file was read, false if it could not be opened
+   *
+   *  Throws if the file is malformed
+   */
+  bool read( const std::string& fname );
+
+  /// Write the table to a tuning file (through a temporary file which is
+  /// renamed into place)
+  void write( const std::string& fname ) const;
+
+  /**
+   *  Increment the G contributions of a shell pair with the selected
+   *  backend. Arguments follow XCPU::compute_integral_shell_pair, with
+   *  the grid points provided both in (x,y,z) interleaved (points) and
+   *  transposed (points_transposed) storage.
+   */
+  void compute_integral_shell_pair( int is_diag, size_t npts,
+    const double* points, double* points_transposed, int lA, int lB,
+    XCPU::point rA, XCPU::point rB, int nprim_pairs,
+    XCPU::prim_pair* prim_pairs, double* Xi, double* Xj, int ldX,
+    double* Gi, double* Gj, int ldG, double* weights,
+    double* boys_table ) const;
+
+private:
+
+  static constexpr int nl = max_l_rys + 1;
+  std::array<ShellPairIntegralBackend, nl*nl*nprim_bins> table_;
+
+  ShellPairIntegralBackend& at( int lA, int lB, int bin ) noexcept;
+  const ShellPairIntegralBackend& at( int lA, int lB, int bin ) const noexcept;
+
+};
+
+/**
+ *  Increment the G contributions of a shell pair using Rys quadrature
+ *
+ *  Same semantics as XCPU::compute_integral_shell_pair, with points
+ *  stored (x,y,z) interleaved.
+ */
+void rys_integral_shell_pair( int is_diag, size_t npts, const double* points,
+  int lA, int lB, XCPU::point rA, XCPU::point rB, int nprim_pairs,
+  const XCPU::prim_pair* prim_pairs, const double* Xi, const double* Xj,
+  int ldX, double* Gi, double* Gj, int ldG, const double* weights );
+
+/**
+ *  Upper bounds of |A(mu,nu,r)| over the Cartesian functions of a shell pair
+ *  and all points r within each of a set of axis aligned boxes
+ *
+ *  The angular factors of each primitive pair are absorbed into half of its
+ *  exponent, such that its contribution is bounded by
+ *    2 |K| C_L(gamma,|PA|,|PB|) F_0(gamma d^2 / 2)
+ *  where d is the distance of P to the box (|K| F_0(gamma d^2) for L = 0).
+ *
+ *  @param[in]  lA, lB      Angular momenta of the shell pair
+ *  @param[in]  nprim_pairs Number of primitive pairs
+ *  @param[in]  prim_pairs  Primitive pairs of the shell pair
+ *  @param[in]  nboxes      Number of boxes
+ *  @param[in]  boxes       Lower and upper corners (x,y,z) of each box 
+ *                          ((6,nboxes) col major)
+ *  @param[out] bounds      Bound for each box (nboxes)
+ */
+void shell_pair_box_bound( int lA, int lB, int nprim_pairs,
+  const XCPU::prim_pair* prim_pairs, size_t nboxes, const double* boxes,
+  double* bounds );
+
+}
@@ -0,0 +1,238 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "collocation.hpp"
+#include "collocation_kernels.hpp"
+#include "integrator_util/host_arena.hpp"
+#include <gauxc/gauxc_config.hpp>
+#include <gauxc/exceptions.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace GauXC {
+
+namespace simd_kernels {
+
+collocation_kernel_type* select_collocation_kernel() {
+
+  const std::string isa = getenv("GAUXC_COLLOCATION_ISA") ? 
+    getenv("GAUXC_COLLOCATION_ISA") : "";
+  if( isa == "reference" ) return reference::collocation_kernel;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+  #ifdef GAUXC_SIMD_COLLOCATION_HAS_AVX512
+  if( (isa.empty() or isa == "avx512") and __builtin_cpu_supports("avx512f") )
+    return avx512::collocation_kernel;
+  #endif
+  #ifdef GAUXC_SIMD_COLLOCATION_HAS_AVX2
+  if( __builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma") )
+    return avx2::collocation_kernel;
+  #endif
+#endif
+
+  return reference::collocation_kernel;
+
+}
+
+}
+
+namespace {
+
+using simd_kernels::collocation_kernel_type;
+using simd_kernels::collocation_shell;
+using simd_kernels::spherical_term;
+using simd_kernels::spherical_transform;
+using simd_kernels::deriv_laplacian;
+using simd_kernels::select_collocation_kernel;
+
+/**
+ *  Cartesian to (unnormalized) real solid harmonic transformation in CCA
+ *  order, Helgaker, Jorgensen and Olsen Eq. (6.4.47). Matches the spherical
+ *  collocation of gau2grid.
+ */
+std::vector<spherical_term> gen_spherical_transform( int l ) {
+
+  auto fact = []( int n ) {
+    double f = 1.; for( int i = 2; i <= n; ++i ) f *= i; return f;
+  };
+  auto binom = [&]( int n, int k ) {
+    return (k < 0 or k > n) ? 0. : fact(n) / (fact(k) * fact(n-k));
+  };
+  auto cart_index = [&]( int a, int b ) {
+    const int i = l - a; return i*(i+1)/2 + (i - b);
+  };
+
+  std::vector<spherical_term> terms;
+  std::vector<double> coef( (l+1)*(l+2)/2 );
+  for( int m = -l; m <= l; ++m ) {
+
+    const int am = std::abs(m);
+    const double N = std::sqrt( 2. * fact(l+am) * fact(l-am) /
+      (m == 0 ? 2. : 1.) ) / (std::pow(2.,am) * fact(l));
+
+    std::fill( coef.begin(), coef.end(), 0. );
+    for( int t = 0; t <= (l - am)/2; ++t )
+    for( int u = 0; u <= t; ++u )
+    // vv = 2v, v is half integral for m < 0
+    for( int vv = (m < 0); vv <= am; vv += 2 ) {
+      const int    v_shift = (vv - (m < 0)) / 2;
+      const double sign    = ((t + v_shift) % 2) ? -1. : 1.;
+      const int py = 2*u + vv;
+      const int px = 2*t + am - py;
+      coef[cart_index(px,py)] += N * sign * std::pow(0.25,t) * binom(l,t) *
+        binom(l-t, am+t) * binom(t,u) * binom(am,vv);
+    }
+
+    for( size_t k = 0; k < coef.size(); ++k )
+    if( coef[k] != 0. ) terms.push_back( spherical_term{ m + l, int(k), coef[k] } );
+
+  }
+
+  return terms;
+
+}
+
+/// Spherical transformations of all supported angular momenta, indexed by l
+const spherical_transform* spherical_transforms() {
+  static const auto tables = [](){
+    std::array< std::vector<spherical_term>, GAUXC_CPU_XC_MAX_AM+1 > t;
+    for( int i = 0; i <= GAUXC_CPU_XC_MAX_AM; ++i )
+      t[i] = gen_spherical_transform(i);
+    return t;
+  }();
+  static const auto views = [](){
+    std::array< spherical_transform, GAUXC_CPU_XC_MAX_AM+1 > v;
+    for( int i = 0; i <= GAUXC_CPU_XC_MAX_AM; ++i )
+      v[i] = spherical_transform{ tables[i].data(), tables[i].size() };
+    return v;
+  }();
+  return views.data();
+}
+
+/// simd_collocation* for the build of the kernels selected for this CPU
+void simd_collocation_impl( int deriv, size_t npts, size_t nshells,
+  size_t nbe, const double* points, const BasisSet<double>& basis,
+  const int32_t* shell_mask, const PrimitiveScreening* prims,
+  double* const* eval ) {
+
+  static collocation_kernel_type* kernel = select_collocation_kernel();
+  simd_kernels::simd_collocation_isa( kernel, deriv, npts, nshells, nbe,
+    points, basis, shell_mask, prims, eval );
+
+}
+
+}
+
+void simd_kernels::simd_collocation_isa( collocation_kernel_type* kernel,
+  int deriv, size_t npts, size_t nshells, size_t nbe, const double* points,
+  const BasisSet<double>& basis, const int32_t* shell_mask,
+  const PrimitiveScreening* prims, double* const* eval ) {
+
+  auto& arena = HostArena::thread_arena();
+  HostArena::scope arena_scope( arena );
+  auto* shells = arena.allocate<collocation_shell>( nshells );
+
+  size_t ioff = 0;
+  for( size_t i = 0; i < nshells; ++i ) {
+    const auto& sh = basis.at(shell_mask[i]);
+    if( sh.l() > GAUXC_CPU_XC_MAX_AM )
+      GAUXC_GENERIC_EXCEPTION("SIMD Collocation: L > GAUXC_CPU_XC_MAX_AM");
+    const auto prim = task_primitives( sh, prims, i );
+    shells[i] = collocation_shell{ sh.l(), sh.pure(), prim.nprim, sh.O_data(),
+      prim.alpha, prim.coeff, ioff };
+    ioff += sh.size();
+  }
+
+  kernel( deriv, npts, nshells, nbe, points, shells, spherical_transforms(),
+    eval );
+
+}
+
+void simd_collocation( size_t                  npts,
+                       size_t                  nshells,
+                       size_t                  nbe,
+                       const double*           points,
+                       const BasisSet<double>& basis,
+                       const int32_t*          shell_mask,
+                       double*                 basis_eval,
+                       const PrimitiveScreening* prims ) {
+
+  double* eval[] = { basis_eval };
+  simd_collocation_impl( 0, npts, nshells, nbe, points, basis, shell_mask,
+    prims, eval );
+
+}
+
+void simd_collocation_gradient( size_t                  npts,
+                                size_t                  nshells,
+                                size_t                  nbe,
+                                const double*           points,
+                                const BasisSet<double>& basis,
+                                const int32_t*          shell_mask,
+                                double*                 basis_eval,
+                                double*                 dbasis_x_eval,
+                                double*                 dbasis_y_eval,
+                                double*                 dbasis_z_eval,
+                                const PrimitiveScreening* prims ) {
+
+  double* eval[] = { basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval };
+  simd_collocation_impl( 1, npts, nshells, nbe, points, basis, shell_mask,
+    prims, eval );
+
+}
+
+void simd_collocation_hessian( size_t                  npts,
+                               size_t                  nshells,
+                               size_t                  nbe,
+                               const double*           points,
+                               const BasisSet<double>& basis,
+                               const int32_t*          shell_mask,
+                               double*                 basis_eval,
+                               double*                 dbasis_x_eval,
+                               double*                 dbasis_y_eval,
+                               double*                 dbasis_z_eval,
+                               double*                 d2basis_xx_eval,
+                               double*                 d2basis_xy_eval,
+                               double*                 d2basis_xz_eval,
+                               double*                 d2basis_yy_eval,
+                               double*                 d2basis_yz_eval,
+                               double*                 d2basis_zz_eval ) {
+
+  double* eval[] = { basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
+    d2basis_xx_eval, d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval,
+    d2basis_yz_eval, d2basis_zz_eval };
+  simd_collocation_impl( 2, npts, nshells, nbe, points, basis, shell_mask,
+    nullptr, eval );
+
+}
+
+void simd_collocation_laplacian( size_t                  npts,
+                                 size_t                  nshells,
+                                 size_t                  nbe,
+                                 const double*           points,
+                                 const BasisSet<double>& basis,
+                                 const int32_t*          shell_mask,
+                                 double*                 basis_eval,
+                                 double*                 dbasis_x_eval,
+                                 double*                 dbasis_y_eval,
+                                 double*                 dbasis_z_eval,
+                                 double*                 lbasis_eval,
+                                 const PrimitiveScreening* prims ) {
+
+  double* eval[] = { basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
+    lbasis_eval };
+  simd_collocation_impl( deriv_laplacian, npts, nshells, nbe, points, basis, 
+    shell_mask, prims, eval );
+
+}
+
+}
@@ -0,0 +1,99 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/basisset.hpp>
+#include "integrator_util/primitive_screening.hpp"
+#include "collocation_kernels.hpp"
+
+namespace GauXC {
+
+/**
+ *  Native host collocation kernels
+ *
+ *  Same semantics (and CCA ordering) as the gau2grid_collocation* kernels.
+ *  Shells are evaluated by kernels specialized on angular momentum and
+ *  derivative order over fixed width blocks of points, such that all point
+ *  loops (including the exponentials) vectorize for the target ISA. Results
+ *  are written directly in the (nbe,npts) layout. The kernels are built for
+ *  several ISAs, selected at runtime (see collocation_kernels.hpp).
+ */
+void simd_collocation( size_t                  npts,
+                       size_t                  nshells,
+                       size_t                  nbe,
+                       const double*           points,
+                       const BasisSet<double>& basis,
+                       const int32_t*          shell_mask,
+                       double*                 basis_eval,
+                       const PrimitiveScreening* prims = nullptr );
+
+void simd_collocation_gradient( size_t                  npts,
+                                size_t                  nshells,
+                                size_t                  nbe,
+                                const double*           points,
+                                const BasisSet<double>& basis,
+                                const int32_t*          shell_mask,
+                                double*                 basis_eval,
+                                double*                 dbasis_x_eval,
+                                double*                 dbasis_y_eval,
+                                double*                 dbasis_z_eval,
+                                const PrimitiveScreening* prims = nullptr );
+
+void simd_collocation_hessian( size_t                  npts,
+                               size_t                  nshells,
+                               size_t                  nbe,
+                               const double*           points,
+                               const BasisSet<double>& basis,
+                               const int32_t*          shell_mask,
+                               double*                 basis_eval,
+                               double*                 dbasis_x_eval,
+                               double*                 dbasis_y_eval,
+                               double*                 dbasis_z_eval,
+                               double*                 d2basis_xx_eval,
+                               double*                 d2basis_xy_eval,
+                               double*                 d2basis_xz_eval,
+                               double*                 d2basis_yy_eval,
+                               double*                 d2basis_yz_eval,
+                               double*                 d2basis_zz_eval );
+
+void simd_collocation_laplacian( size_t                  npts,
+                                 size_t                  nshells,
+                                 size_t                  nbe,
+                                 const double*           points,
+                                 const BasisSet<double>& basis,
+                                 const int32_t*          shell_mask,
+                                 double*                 basis_eval,
+                                 double*                 dbasis_x_eval,
+                                 double*                 dbasis_y_eval,
+                                 double*                 dbasis_z_eval,
+                                 double*                 lbasis_eval,
+                                 const PrimitiveScreening* prims = nullptr );
+
+namespace simd_kernels {
+
+/**
+ *  simd_collocation* for an explicit ISA build of the kernels
+ *
+ *  @param[in]  kernel Build of the kernels, e.g. select_collocation_kernel()
+ *  @param[in]  deriv  Derivative order: 0, 1, 2 or deriv_laplacian
+ *  @param[out] eval   Outputs, in the argument order of simd_collocation*
+ */
+void simd_collocation_isa( collocation_kernel_type*  kernel,
+                           int                       deriv,
+                           size_t                    npts,
+                           size_t                    nshells,
+                           size_t                    nbe,
+                           const double*             points,
+                           const BasisSet<double>&   basis,
+                           const int32_t*            shell_mask,
+                           const PrimitiveScreening* prims,
+                           double* const*            eval );
+
+}
+
+}
@@ -0,0 +1,300 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "collocation_kernels.hpp"
+#include <gauxc/gauxc_config.hpp>
+#include <cstring>
+
+namespace GauXC::simd_kernels::GAUXC_SIMD_COLLOCATION_ISA {
+
+namespace {
+
+/// Number of points evaluated together, a multiple of the double precision
+/// SIMD width of SSE2, AVX2 and AVX-512
+constexpr int simd_block = 8;
+
+/// Number of outputs for a given derivative order
+template <int D>
+constexpr int collocation_ncomp = D == 0 ? 1 : D == 1 ? 4 :
+                                  D == deriv_laplacian ? 5 : 10;
+
+/**
+ *  Branch free exp which vectorizes without vector math libraries
+ *
+ *  Cody-Waite reduction x = n ln2 + r, |r| <= ln2/2, followed by a degree
+ *  13 Taylor expansion of exp(r) and scaling by 2^n through the exponent
+ *  bits. Arguments are clamped to the range of normal results.
+ */
+inline double simd_exp( double x ) {
+
+  constexpr double log2e  = 1.4426950408889634074;
+  constexpr double ln2_hi = 6.93147180369123816490e-01;
+  constexpr double ln2_lo = 1.90821492927058770002e-10;
+  constexpr double shift  = 6755399441055744.0; // 1.5 * 2^52
+
+  x = x < -708. ? -708. : x;
+  x = x >  709. ?  709. : x;
+
+  // Round x / ln2 to nearest, n is stored in the low mantissa bits of t
+  const double t = x * log2e + shift;
+  const double n = t - shift;
+  const double r = (x - n * ln2_hi) - n * ln2_lo;
+
+  double p = 1. / 6227020800.;
+  p = p * r + 1. / 479001600.;
+  p = p * r + 1. / 39916800.;
+  p = p * r + 1. / 3628800.;
+  p = p * r + 1. / 362880.;
+  p = p * r + 1. / 40320.;
+  p = p * r + 1. / 5040.;
+  p = p * r + 1. / 720.;
+  p = p * r + 1. / 120.;
+  p = p * r + 1. / 24.;
+  p = p * r + 1. / 6.;
+  p = p * r + 0.5;
+  p = p * r + 1.;
+  p = p * r + 1.;
+
+  uint64_t ti; memcpy( &ti, &t, sizeof(ti) );
+  const uint64_t si = (ti + 1023) << 52;
+  double s; memcpy( &s, &si, sizeof(s) );
+
+  return p * s;
+
+}
+
+/// Cartesian exponents of a shell in CCA order
+template <int L>
+struct cartesian_powers {
+  static constexpr int size = (L+1)*(L+2)/2;
+  int x[size], y[size], z[size];
+  constexpr cartesian_powers() : x(), y(), z() {
+    int k = 0;
+    for( int i = 0; i <= L; ++i )
+    for( int j = 0; j <= i; ++j, ++k ) {
+      x[k] = L - i; y[k] = i - j; z[k] = j;
+    }
+  }
+};
+
+/**
+ *  Evaluate a shell of angular momentum L (and derivatives through order D,
+ *  or the gradient and Laplacian for deriv_laplacian) on a block of points
+ *
+ *  @param[in]  sh       Shell to evaluate
+ *  @param[in]  sph      Spherical transformation of L
+ *  @param[in]  xb,yb,zb Block of points (SoA, simd_block, padded)
+ *  @param[in]  nb       Number of valid points in the block
+ *  @param[in]  nbe      Leading dimension of the outputs
+ *  @param[out] eval     Outputs (collocation_ncomp<D>), offset to the block
+ */
+template <int L, int D>
+void collocation_shell_block( const collocation_shell& sh,
+  const spherical_transform& sph, const double* xb, const double* yb,
+  const double* zb, size_t nb, size_t nbe, double* const* eval ) {
+
+  constexpr int W     = simd_block;
+  constexpr auto cart = cartesian_powers<L>();
+  constexpr int ncart = cart.size;
+  constexpr int nsph  = 2*L + 1;
+  constexpr int ncomp = collocation_ncomp<D>;
+
+  const double* O = sh.O;
+  alignas(64) double x[W], y[W], z[W], r2[W];
+  #pragma omp simd
+  for( int i = 0; i < W; ++i ) {
+    x[i] = xb[i] - O[0];
+    y[i] = yb[i] - O[1];
+    z[i] = zb[i] - O[2];
+    r2[i] = x[i]*x[i] + y[i]*y[i] + z[i]*z[i];
+  }
+
+  // Radial factor R and its derivatives wrt r^2 (R1 = 2 dR/dr^2, ...)
+  alignas(64) double R[W] = {}, R1[W] = {}, R2[W] = {};
+  for( int p = 0; p < sh.nprim; ++p ) {
+    const double a = sh.alpha[p], c = sh.coeff[p];
+    #pragma omp simd
+    for( int i = 0; i < W; ++i ) {
+      const double e = c * simd_exp( -a * r2[i] );
+      R[i] += e;
+      if constexpr (D > 0) R1[i] -= 2. * a * e;
+      if constexpr (D > 1) R2[i] += 4. * a * a * e;
+    }
+  }
+
+  // Powers of the coordinates
+  alignas(64) double px[L+1][W], py[L+1][W], pz[L+1][W];
+  for( int i = 0; i < W; ++i ) { px[0][i] = py[0][i] = pz[0][i] = 1.; }
+  for( int k = 1; k <= L; ++k ) {
+    #pragma omp simd
+    for( int i = 0; i < W; ++i ) {
+      px[k][i] = px[k-1][i] * x[i];
+      py[k][i] = py[k-1][i] * y[i];
+      pz[k][i] = pz[k-1][i] * z[i];
+    }
+  }
+
+  // Cartesian functions: phi = R(r) x^a y^b z^c
+  alignas(64) double cbuf[ncomp][ncart][W];
+  for( int k = 0; k < ncart; ++k ) {
+
+    const int a = cart.x[k], b = cart.y[k], c = cart.z[k];
+    const int a1 = a > 0 ? a-1 : 0, b1 = b > 0 ? b-1 : 0, c1 = c > 0 ? c-1 : 0;
+    const int a2 = a > 1 ? a-2 : 0, b2 = b > 1 ? b-2 : 0, c2 = c > 1 ? c-2 : 0;
+
+    #pragma omp simd
+    for( int i = 0; i < W; ++i ) {
+
+      const double m = px[a][i] * py[b][i] * pz[c][i];
+      cbuf[0][k][i] = R[i] * m;
+
+      if constexpr (D > 0) {
+        const double m_x = a * px[a1][i] * py[b][i]  * pz[c][i];
+        const double m_y = b * px[a][i]  * py[b1][i] * pz[c][i];
+        const double m_z = c * px[a][i]  * py[b][i]  * pz[c1][i];
+
+        const double rx = x[i] * R1[i], ry = y[i] * R1[i], rz = z[i] * R1[i];
+        cbuf[1][k][i] = R[i] * m_x + rx * m;
+        cbuf[2][k][i] = R[i] * m_y + ry * m;
+        cbuf[3][k][i] = R[i] * m_z + rz * m;
+
+        if constexpr (D == 2) {
+          const double m_xx = a * (a-1) * px[a2][i] * py[b][i]  * pz[c][i];
+          const double m_yy = b * (b-1) * px[a][i]  * py[b2][i] * pz[c][i];
+          const double m_zz = c * (c-1) * px[a][i]  * py[b][i]  * pz[c2][i];
+          const double m_xy = a * b * px[a1][i] * py[b1][i] * pz[c][i];
+          const double m_xz = a * c * px[a1][i] * py[b][i]  * pz[c1][i];
+          const double m_yz = b * c * px[a][i]  * py[b1][i] * pz[c1][i];
+
+          cbuf[4][k][i] = R[i] * m_xx + 2. * rx * m_x +
+                          (R1[i] + x[i] * x[i] * R2[i]) * m;
+          cbuf[5][k][i] = R[i] * m_xy + rx * m_y + ry * m_x +
+                          x[i] * y[i] * R2[i] * m;
+          cbuf[6][k][i] = R[i] * m_xz + rx * m_z + rz * m_x +
+                          x[i] * z[i] * R2[i] * m;
+          cbuf[7][k][i] = R[i] * m_yy + 2. * ry * m_y +
+                          (R1[i] + y[i] * y[i] * R2[i]) * m;
+          cbuf[8][k][i] = R[i] * m_yz + ry * m_z + rz * m_y +
+                          y[i] * z[i] * R2[i] * m;
+          cbuf[9][k][i] = R[i] * m_zz + 2. * rz * m_z +
+                          (R1[i] + z[i] * z[i] * R2[i]) * m;
+        }
+
+        if constexpr (D == deriv_laplacian) {
+          const double m_lapl =
+            a * (a-1) * px[a2][i] * py[b][i]  * pz[c][i] +
+            b * (b-1) * px[a][i]  * py[b2][i] * pz[c][i] +
+            c * (c-1) * px[a][i]  * py[b][i]  * pz[c2][i];
+          cbuf[4][k][i] = R[i] * m_lapl +
+            2. * (rx * m_x + ry * m_y + rz * m_z) +
+            (3. * R1[i] + r2[i] * R2[i]) * m;
+        }
+      }
+
+    }
+
+  }
+
+  // Store (nfunc,npts) block in the (nbe,npts) outputs
+  auto store = [&]( const auto& buf, int nfunc ) {
+    for( int d = 0; d < ncomp; ++d ) {
+      double* out = eval[d] + sh.ioff;
+      for( size_t i = 0; i < nb; ++i )
+      for( int f = 0; f < nfunc; ++f )
+        out[i*nbe + f] = buf[d][f][i];
+    }
+  };
+
+  if( sh.pure ) {
+    alignas(64) double sbuf[ncomp][nsph][W] = {};
+    for( size_t t = 0; t < sph.nterms; ++t ) {
+      const auto& term = sph.terms[t];
+      for( int d = 0; d < ncomp; ++d ) {
+        #pragma omp simd
+        for( int i = 0; i < W; ++i )
+          sbuf[d][term.m][i] += term.coef * cbuf[d][term.k][i];
+      }
+    }
+    store( sbuf, nsph );
+  } else {
+    store( cbuf, ncart );
+  }
+
+}
+
+/// Dispatch on l, the caller guarantees l <= GAUXC_CPU_XC_MAX_AM
+template <int D, int L = 0>
+void collocation_shell_block_dispatch( const collocation_shell& sh,
+  const spherical_transform* sph, const double* xb, const double* yb,
+  const double* zb, size_t nb, size_t nbe, double* const* eval ) {
+
+  if constexpr ( L <= GAUXC_CPU_XC_MAX_AM ) {
+    if( sh.l == L )
+      collocation_shell_block<L,D>( sh, sph[L], xb, yb, zb, nb, nbe, eval );
+    else
+      collocation_shell_block_dispatch<D,L+1>( sh, sph, xb, yb, zb, nb, nbe,
+        eval );
+  }
+
+}
+
+template <int D>
+void collocation_impl( size_t npts, size_t nshells, size_t nbe,
+  const double* points, const collocation_shell* shells,
+  const spherical_transform* sph, double* const* eval ) {
+
+  constexpr int W     = simd_block;
+  constexpr int ncomp = collocation_ncomp<D>;
+
+  for( size_t p0 = 0; p0 < npts; p0 += W ) {
+
+    // SoA block of points, tail is padded with the last point
+    const size_t nb = npts - p0 < W ? npts - p0 : W;
+    alignas(64) double xb[W], yb[W], zb[W];
+    for( int i = 0; i < W; ++i ) {
+      const size_t ip = p0 + (size_t(i) < nb ? i : nb-1);
+      xb[i] = points[3*ip + 0];
+      yb[i] = points[3*ip + 1];
+      zb[i] = points[3*ip + 2];
+    }
+
+    double* eval_block[ncomp];
+    for( int d = 0; d < ncomp; ++d ) eval_block[d] = eval[d] + p0*nbe;
+
+    for( size_t i = 0; i < nshells; ++i )
+      collocation_shell_block_dispatch<D>( shells[i], sph, xb, yb, zb, nb,
+        nbe, eval_block );
+
+  }
+
+}
+
+}
+
+void collocation_kernel( int deriv, size_t npts, size_t nshells, size_t nbe,
+  const double* points, const collocation_shell* shells,
+  const spherical_transform* sph, double* const* eval ) {
+
+  switch( deriv ) {
+    case 0:
+      collocation_impl<0>( npts, nshells, nbe, points, shells, sph, eval );
+      break;
+    case 1:
+      collocation_impl<1>( npts, nshells, nbe, points, shells, sph, eval );
+      break;
+    case 2:
+      collocation_impl<2>( npts, nshells, nbe, points, shells, sph, eval );
+      break;
+    case deriv_laplacian:
+      collocation_impl<deriv_laplacian>( npts, nshells, nbe, points, shells,
+        sph, eval );
+      break;
+  }
+
+}
+
+}
@@ -0,0 +1,93 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ *  The SIMD collocation kernels (collocation_kernels.cxx) are compiled once
+ *  with the flags of the library ("reference") and once per additional
+ *  target ISA (see ../CMakeLists.txt). Each build is placed in its own
+ *  namespace, GauXC::simd_kernels::GAUXC_SIMD_COLLOCATION_ISA, and only
+ *  operates on the plain data below: the kernels must not call inline
+ *  functions shared with the rest of the library (BasisSet, std::vector,
+ *  ...), as the linker keeps a single out-of-line copy of those, which could
+ *  then be the one compiled for a wider ISA. simd_collocation* (collocation.cxx)
+ *  prepares the data and selects the build at runtime.
+ */
+#ifndef GAUXC_SIMD_COLLOCATION_ISA
+  #define GAUXC_SIMD_COLLOCATION_ISA reference
+#endif
+
+namespace GauXC::simd_kernels {
+
+/// Derivative "order" of the basis + gradient + Laplacian kernels
+constexpr int deriv_laplacian = 3;
+
+/// Shell to evaluate, with its offset in the outputs
+struct collocation_shell {
+  int           l;
+  int           pure;
+  int32_t       nprim;
+  const double* O;
+  const double* alpha;
+  const double* coeff;
+  size_t        ioff;
+};
+
+/// Nonzero element of the cartesian to spherical transformation
+struct spherical_term {
+  int    m;    ///< Spherical index (m + l)
+  int    k;    ///< Cartesian index (CCA)
+  double coef;
+};
+
+/// Cartesian to spherical transformation of a given angular momentum
+struct spherical_transform {
+  const spherical_term* terms;
+  size_t                nterms;
+};
+
+/**
+ *  Evaluate shells (and derivatives) on points in the (nbe,npts) layout
+ *
+ *  @param[in]  deriv   Derivative order: 0, 1, 2 or deriv_laplacian
+ *  @param[in]  npts    Number of points
+ *  @param[in]  nshells Number of shells
+ *  @param[in]  nbe     Leading dimension of the outputs
+ *  @param[in]  points  Points (AoS)
+ *  @param[in]  shells  Shells to evaluate, l <= GAUXC_CPU_XC_MAX_AM
+ *  @param[in]  sph     Spherical transformations, indexed by l
+ *  @param[out] eval    Outputs, as in simd_collocation*
+ */
+using collocation_kernel_type = void( int                        deriv,
+                                      size_t                     npts,
+                                      size_t                     nshells,
+                                      size_t                     nbe,
+                                      const double*              points,
+                                      const collocation_shell*   shells,
+                                      const spherical_transform* sph,
+                                      double* const*             eval );
+
+// ISA builds of the kernels
+namespace reference { collocation_kernel_type collocation_kernel; }
+namespace avx2      { collocation_kernel_type collocation_kernel; }
+namespace avx512    { collocation_kernel_type collocation_kernel; }
+
+/**
+ *  Select the ISA build of the collocation kernels
+ *
+ *  The widest build supported by both the library and the executing CPU
+ *  is chosen. The selection may be capped by setting GAUXC_COLLOCATION_ISA
+ *  to one of "reference", "avx2" or "avx512" in the environment.
+ *  simd_collocation* make this selection once per process.
+ */
+collocation_kernel_type* select_collocation_kernel();
+
+}
@@ -0,0 +1,91 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "host/simd_local_host_work_driver.hpp"
+#include "host/simd/collocation.hpp"
+
+namespace GauXC {
+
+SIMDLocalHostWorkDriver::SIMDLocalHostWorkDriver() : 
+  ReferenceLocalHostWorkDriver() { }
+
+SIMDLocalHostWorkDriver::~SIMDLocalHostWorkDriver() noexcept = default;
+
+void SIMDLocalHostWorkDriver::eval_collocation( size_t npts, size_t nshells, 
+  size_t nbe, const double* pts, const BasisSet<double>& basis, 
+  const int32_t* shell_list, double* basis_eval ) {
+  simd_collocation( npts, nshells, nbe, pts, basis, shell_list, basis_eval );
+}
+
+void SIMDLocalHostWorkDriver::eval_collocation_gradient( size_t npts, 
+  size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+  const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
+  double* dbasis_y_eval, double* dbasis_z_eval) {
+  simd_collocation_gradient( npts, nshells, nbe, pts, basis, shell_list,
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+}
+
+void SIMDLocalHostWorkDriver::eval_collocation_hessian( size_t npts, 
+  size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+  const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
+  double* dbasis_y_eval, double* dbasis_z_eval, double* d2basis_xx_eval, 
+  double* d2basis_xy_eval, double* d2basis_xz_eval, double* d2basis_yy_eval, 
+  double* d2basis_yz_eval, double* d2basis_zz_eval ) {
+  simd_collocation_hessian( npts, nshells, nbe, pts, basis, shell_list,
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
+    d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
+    d2basis_zz_eval );
+}
+
+void SIMDLocalHostWorkDriver::eval_collocation_laplacian( size_t npts, 
+  size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+  const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
+  double* dbasis_y_eval, double* dbasis_z_eval, double* lbasis_eval ) {
+  simd_collocation_laplacian( npts, nshells, nbe, pts, basis, shell_list,
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval );
+}
+
+void SIMDLocalHostWorkDriver::eval_collocation_screened( size_t npts, 
+  const double* pts, const BasisSet<double>& basis, 
+  const PrimitiveScreening& prims, double* basis_eval ) {
+  simd_collocation( npts, prims.nshells(), prims.nbe(), pts, basis, 
+    prims.shell_list().data(), basis_eval, &prims );
+}
+
+void SIMDLocalHostWorkDriver::eval_collocation_gradient_screened( size_t npts, 
+  const double* pts, const BasisSet<double>& basis, 
+  const PrimitiveScreening& prims, double* basis_eval, double* dbasis_x_eval, 
+  double* dbasis_y_eval, double* dbasis_z_eval ) {
+  simd_collocation_gradient( npts, prims.nshells(), prims.nbe(), pts, 
+    basis, prims.shell_list().data(), basis_eval, dbasis_x_eval, 
+    dbasis_y_eval, dbasis_z_eval, &prims );
+}
+
+void SIMDLocalHostWorkDriver::eval_collocation_laplacian_screened( size_t npts, 
+  const double* pts, const BasisSet<double>& basis, 
+  const PrimitiveScreening& prims, double* basis_eval, double* dbasis_x_eval, 
+  double* dbasis_y_eval, double* dbasis_z_eval, double* lbasis_eval ) {
+  simd_collocation_laplacian( npts, prims.nshells(), prims.nbe(), pts, 
+    basis, prims.shell_list().data(), basis_eval, dbasis_x_eval, 
+    dbasis_y_eval, dbasis_z_eval, lbasis_eval, &prims );
+}
+
+void SIMDLocalHostWorkDriver::eval_collocation_atomic( size_t npts, 
+  size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+  const int32_t* shell_list, const double* /*center*/, double* basis_eval ) {
+  eval_collocation( npts, nshells, nbe, pts, basis, shell_list, basis_eval );
+}
+
+void SIMDLocalHostWorkDriver::eval_collocation_gradient_atomic( size_t npts, 
+  size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+  const int32_t* shell_list, const double* /*center*/, double* basis_eval, 
+  double* dbasis_x_eval, double* dbasis_y_eval, double* dbasis_z_eval) {
+  eval_collocation_gradient( npts, nshells, nbe, pts, basis, shell_list,
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+}
+
+}
@@ -0,0 +1,69 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include "reference_local_host_work_driver.hpp"
+
+namespace GauXC {
+
+/**
+ *  Host LWD which evaluates collocation with the native SIMD kernels
+ *  (see simd/collocation.hpp). All other kernels are those of the 
+ *  reference LWD, which remains the basis for validation.
+ */
+struct SIMDLocalHostWorkDriver : public ReferenceLocalHostWorkDriver {
+
+  SIMDLocalHostWorkDriver();
+  virtual ~SIMDLocalHostWorkDriver() noexcept;
+
+  SIMDLocalHostWorkDriver( const SIMDLocalHostWorkDriver& )     = delete;
+  SIMDLocalHostWorkDriver( SIMDLocalHostWorkDriver&& ) noexcept = delete;
+
+  // Public APIs
+
+  void eval_collocation( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval ) override;
+  void eval_collocation_gradient( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval) override;
+  void eval_collocation_hessian( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* d2basis_xx_eval, double* d2basis_xy_eval,
+    double* d2basis_xz_eval, double* d2basis_yy_eval, double* d2basis_yz_eval,
+    double* d2basis_zz_eval ) override;
+  void eval_collocation_laplacian( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* lbasis_eval ) override;
+  void eval_collocation_screened( size_t npts, const double* pts, 
+    const BasisSet<double>& basis, const PrimitiveScreening& prims, 
+    double* basis_eval ) override;
+  void eval_collocation_gradient_screened( size_t npts, const double* pts, 
+    const BasisSet<double>& basis, const PrimitiveScreening& prims, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval ) override;
+  void eval_collocation_laplacian_screened( size_t npts, const double* pts, 
+    const BasisSet<double>& basis, const PrimitiveScreening& prims, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* lbasis_eval ) override;
+
+  // The SIMD kernels evaluate exponentials at a fraction of the cost of 
+  // the gau2grid path, the atomic variants map onto the generic kernels
+  void eval_collocation_atomic( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    const double* center, double* basis_eval ) override;
+  void eval_collocation_gradient_atomic( size_t npts, size_t nshells, 
+    size_t nbe, const double* pts, const BasisSet<double>& basis, 
+    const int32_t* shell_list, const double* center, double* basis_eval, 
+    double* dbasis_x_eval, double* dbasis_y_eval, double* dbasis_z_eval) override;
+
+};
+
+}
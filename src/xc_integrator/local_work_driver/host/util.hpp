@@ -8,6 +8,7 @@
 #pragma once
 #include "host/blas.hpp"
 #include <vector>
+#include <algorithm>
 #include <tuple>
 #include <cstdint>
 
@@ -186,5 +187,118 @@ void inc_by_submat_atomic(int32_t M, int32_t N, int32_t MSub,
 
 }
 
+
+// Packed lower triangle (column major) index of (i,j), i >= j, of a 
+// matrix of order N (the layout of XCHostAccumulator)
+inline constexpr size_t packed_lower_index( size_t i, size_t j, size_t N ) {
+  return i + j*(2*N - j - 1) / 2;
+}
+
+/**
+ *  Increment a packed lower triangular matrix by the lower triangle
+ *  of a compressed symmetric submatrix.
+ *
+ *  Only the lower triangle of ASmall is referenced. As submat_map
+ *  is monotone, the lower triangle of ASmall maps onto the lower
+ *  triangle of ABig.
+ */
+template <typename _F1, typename _F2>
+void inc_by_submat_packed_lower(int32_t N, int32_t NSub, _F1 *ABig,
+  _F2 *ASmall, int32_t LDAS,
+  const std::vector<std::array<int32_t,3>> &submat_map ) {
+
+  (void)(NSub);
+
+  int32_t j(0);
+  for( auto jCut = submat_map.begin(); jCut != submat_map.end(); ++jCut ) {
+    const int32_t deltaJ = (*jCut)[1];
+    int32_t i(j);
+  for( auto iCut = jCut; iCut != submat_map.end(); ++iCut ) {
+    const int32_t deltaI = (*iCut)[1];
+    const bool is_diag = iCut == jCut;
+
+    auto* ASmall_use = ASmall + i + j * LDAS;
+    for( int32_t jj = 0; jj < deltaJ; ++jj ) {
+      const int32_t ii_st = is_diag ? jj : 0;
+      auto* ABig_use = ABig +
+        packed_lower_index( (*iCut)[0] + ii_st, (*jCut)[0] + jj, N );
+      for( int32_t ii = ii_st; ii < deltaI; ++ii ) {
+        ABig_use[ii - ii_st] += ASmall_use[ ii + jj * LDAS ];
+      }
+    }
+
+    i += deltaI;
+  }
+    j += deltaJ;
+  }
+
+}
+
+/**
+ *  Increment a packed lower triangular matrix by a general compressed
+ *  submatrix, folding the strict upper triangle onto the lower triangle,
+ *  i.e. ABig(i,j) += ASmall(i,j) + ASmall(j,i) for i > j.
+ */
+template <typename _F1, typename _F2>
+void inc_by_submat_packed_fold(int32_t N, int32_t MSub, int32_t NSub,
+  _F1 *ABig, _F2 *ASmall, int32_t LDAS,
+  const std::vector<std::array<int32_t,3>> &submat_map_row,
+  const std::vector<std::array<int32_t,3>> &submat_map_col) {
+
+  (void)(MSub);
+  (void)(NSub);
+
+  int32_t j(0);
+  for( auto& jCut : submat_map_col ) {
+    const int32_t deltaJ = jCut[1];
+    int32_t i(0);
+  for( auto& iCut : submat_map_row ) {
+    const int32_t deltaI = iCut[1];
+
+    // Rows [0,ii_diag) of column jj lie above the diagonal and are folded
+    // onto row J, the remaining rows are contiguous in the packed column J
+    auto* ASmall_use = ASmall + i + j * LDAS;
+    for( int32_t jj = 0; jj < deltaJ; ++jj ) {
+      const int32_t J = jCut[0] + jj;
+      const int32_t ii_diag = std::clamp( J - iCut[0], 0, deltaI );
+      const auto* A_col = ASmall_use + jj * LDAS;
+
+      for( int32_t ii = 0; ii < ii_diag; ++ii )
+        ABig[ packed_lower_index(J, iCut[0] + ii, N) ] += A_col[ii];
+
+      if( ii_diag == deltaI ) continue;
+      auto* ABig_use = ABig + packed_lower_index(iCut[0] + ii_diag, J, N);
+      for( int32_t ii = ii_diag; ii < deltaI; ++ii )
+        ABig_use[ii - ii_diag] += A_col[ii];
+    }
+
+    i += deltaI;
+  }
+    j += deltaJ;
+  }
+
+}
+
+/**
+ *  In-place gather of a subset of the columns of a sequence of matrices
+ *
+ *  A holds nblk consecutive (ld,n) column-major blocks, on exit it holds
+ *  nblk consecutive (ld,m) blocks containing columns idx[0..m) of each
+ *  block. idx must be strictly increasing, such that every column moves
+ *  towards the front of A and no column is overwritten before it is read.
+ */
+template <typename _F>
+void compact_columns( int32_t ld, int32_t n, int32_t nblk, 
+  const int32_t* idx, int32_t m, _F* A ) {
+
+  for( int32_t b = 0; b < nblk; ++b )
+  for( int32_t j = 0; j < m;    ++j ) {
+    const _F* src = A + (size_t(b) * n + idx[j]) * ld;
+    _F*       dst = A + (size_t(b) * m + j     ) * ld;
+    if( src != dst ) std::copy_n( src, ld, dst );
+  }
+
+}
+
 }
 }
@@ -126,7 +126,6 @@ void IncoreReplicatedXCDeviceIntegrator<ValueType>::
   const auto& mol   = this->load_balancer_->molecule();
 
   const auto nbf     = basis.nbf();
-  const auto nshells = basis.nshells();
 
 
   // Get basis map and shell pairs
@@ -155,27 +154,15 @@ void IncoreReplicatedXCDeviceIntegrator<ValueType>::
   std::vector<double> P_abs(nb2);
   for( auto i = 0ul; i < nb2; ++i ) P_abs[i] = std::abs(P[i]);
 
-  // Loop over sparse shell pairs
-  const size_t ns2 = nshells * nshells;
-  std::vector<double> V_max(ns2, 0.0);
+  // Coulomb bounds on the sparse shell pairs
+  std::vector<double> V_max;
   this->timer_.time_op("XCIntegrator.VM_EXX", [&](){
-  const auto sp_row_ptr = shell_pairs.row_ptr();
-  const auto sp_col_ind = shell_pairs.col_ind();
-  for( auto i = 0; i < nshells; ++i ) {
-    const auto j_st = sp_row_ptr[i];
-    const auto j_en = sp_row_ptr[i+1];
-    for( auto _j = j_st; _j < j_en; ++_j ) {
-      const auto j = sp_col_ind[_j];
-      const auto mv = util::max_coulomb( basis.at(i), basis.at(j) );
-      V_max[i + j*nshells] = mv;
-      if( i != j ) V_max[j + i*nshells] = mv;
-    }
-  }
+    V_max = exx_shell_pair_v_max( basis, shell_pairs );
   });
 
 #if 1
   exx_ek_screening( basis, basis_map, shell_pairs, P_abs.data(), basis.nbf(),
-    V_max.data(), nshells, sn_link_settings.energy_tol, 
+    V_max.data(), sn_link_settings.energy_tol, 
     sn_link_settings.k_tol, device_data, lwd, task_begin, task_end );
 #else
   for( auto it = task_begin; it != task_end; ++it) {
@@ -185,9 +172,10 @@ void IncoreReplicatedXCDeviceIntegrator<ValueType>::
   LocalHostWorkDriver host_lwd(
     std::make_unique<ReferenceLocalHostWorkDriver>()
   );
-  exx_ek_screening( basis, basis_map, P_abs.data(), basis.nbf(),
-    V_max.data(), nshells, sn_link_settings.energy_tol, 
-    sn_link_settings.k_tol, &host_lwd, task_begin, task_end );
+  exx_ek_screening( basis, basis_map, shell_pairs, P, ldp,
+    V_max.data(), sn_link_settings.energy_tol, 
+    sn_link_settings.k_tol, sn_link_settings.approx_f_p_tol, &host_lwd, 
+    task_begin, task_end );
 #endif
 
   //this->load_balancer_->rebalance_exx();
@@ -8,6 +8,12 @@
 #pragma once
 #include <gauxc/xc_integrator/replicated/replicated_xc_host_integrator.hpp>
 #include "xc_host_data.hpp"
+#include "integrator_util/collocation_cache.hpp"
+
+namespace GauXC {
+template <typename F> struct XCHostIntegrand;
+template <typename F> class XCHostIntegrands;
+}
 
 namespace GauXC::detail {
 
@@ -70,11 +76,30 @@ protected:
                       value_type* VXCx, int64_t ldvxcx,
                       value_type* EXC, const IntegratorSettingsXC& ks_settings ) override;
 
+  /// Batched RKS EXC/VXC (shared collocation)
+  void eval_exc_vxc_batch_( int64_t m, int64_t n, int64_t ndm,
+                            const value_type* const* P, int64_t ldp,
+                            value_type* const* VXC, int64_t ldvxc,
+                            value_type* EXC, const IntegratorSettingsXC& ks_settings ) override;
+
+  /// RKS EXC/VXC for several functionals (shared density variables)
+  void eval_exc_vxc_multi_( int64_t m, int64_t n, const value_type* P,
+                            int64_t ldp, int64_t nfunc,
+                            const functional_type* funcs,
+                            value_type* const* VXC, int64_t ldvxc,
+                            value_type* EXC, const IntegratorSettingsXC& ks_settings ) override;
 
   /// RKS EXC Gradient
   void eval_exc_grad_( int64_t m, int64_t n, const value_type* P,
                        int64_t ldp, value_type* EXC_GRAD ) override;
 
+  /// RKS fxc contraction with trial densities
+  void eval_fxc_contraction_( int64_t m, int64_t n, const value_type* P,
+                              int64_t ldp, int64_t ntrial,
+                              const value_type* const* tP, int64_t ldtp,
+                              value_type* const* FXC, int64_t ldfxc,
+                              const IntegratorSettingsXC& ks_settings ) override;
+
   /// sn-LinK
   void eval_exx_( int64_t m, int64_t n, const value_type* P,
                   int64_t ldp, value_type* K, int64_t ldk,
@@ -82,6 +107,15 @@ protected:
 
 
 
+  // Task loop shared by the EXC/VXC type integrands: task order, screening,
+  // collocation and accumulation of the integrands
+  template <typename KernelTraits, typename ThreadFunc>
+  void host_task_loop_( const basis_type& basis, const IntegratorSettingsKS& ks_settings,
+                        task_iterator task_begin, task_iterator task_end,
+                        bool eval_collocation, size_t arena_bytes,
+                        XCHostIntegrands<value_type>& integrands,
+                        ThreadFunc&& thread_func );
+
   // Implementation details of integrate_den
   void integrate_den_local_work_( const value_type* P, int64_t ldp, 
                                    value_type *N_EL );
@@ -97,14 +131,65 @@ protected:
                             value_type* VXCx, int64_t ldvxcx,
                             value_type* EXC, value_type *N_EL, const IntegratorSettingsXC& ks_settings,
                             task_iterator task_begin, task_iterator task_end );
+
+  // exc_vxc task kernel for a fixed spin / functional family (XCHostKernelTraits),
+  // shared by one or several functionals
+  template <typename KernelTraits>
+  void exc_vxc_local_work_kernel_( const basis_type& basis, const value_type* Ps, int64_t ldps,
+                                   const value_type* Pz, int64_t ldpz,
+                                   const value_type* Py, int64_t ldpy,
+                                   const value_type* Px, int64_t ldpx,
+                                   int64_t nfunc, const functional_type* funcs,
+                                   std::vector<XCHostIntegrand<value_type>> VXC,
+                                   value_type* EXC, value_type *N_EL, const IntegratorSettingsXC& ks_settings,
+                                   task_iterator task_begin, task_iterator task_end );
+
+  // Implementation details of batched exc_vxc
+  void exc_vxc_batch_local_work_( int64_t ndm, const value_type* const* P, int64_t ldp,
+                                  value_type* const* VXC, int64_t ldvxc,
+                                  value_type* EXC, value_type* N_EL,
+                                  const IntegratorSettingsXC& ks_settings );
+
+  // Batched exc_vxc task kernel for a fixed functional family (XCHostKernelTraits)
+  template <typename KernelTraits>
+  void exc_vxc_batch_local_work_kernel_( int64_t ndm, const value_type* const* P, int64_t ldp,
+                                         value_type* const* VXC, int64_t ldvxc,
+                                         value_type* EXC, value_type* N_EL,
+                                         const IntegratorSettingsXC& ks_settings );
+
+  // fxc contraction task kernel for a fixed functional family (XCHostKernelTraits)
+  template <typename KernelTraits>
+  void fxc_contraction_local_work_kernel_( const value_type* P, int64_t ldp,
+                                           int64_t ntrial,
+                                           const value_type* const* tP, int64_t ldtp,
+                                           value_type* const* FXC, int64_t ldfxc,
+                                           const IntegratorSettingsXC& ks_settings );
                             
   // Implemetation details of exc_grad
   void exc_grad_local_work_( const value_type* P, int64_t ldp, value_type* EXC_GRAD );
 
+  // exc_grad task kernel for a fixed functional family (XCHostKernelTraits)
+  template <typename KernelTraits>
+  void exc_grad_local_work_kernel_( const value_type* P, int64_t ldp, value_type* EXC_GRAD );
+
   // Implementation details of sn-LinK
   void exx_local_work_( const value_type* P, int64_t ldp, value_type* K, int64_t ldk,
     const IntegratorSettingsEXX& settings );
 
+  /// Cross-call collocation cache (opt-in through IntegratorSettingsKS)
+  std::unique_ptr<CollocationCache> collocation_cache_;
+
+  /// State of incremental sn-K builds (IntegratorSettingsSNLinK::incremental)
+  struct exx_incremental_state {
+    std::vector<value_type> P; ///< Density of the previous build (ld = nbf)
+    std::vector<value_type> K; ///< Exchange of the previous build (ld = nbf)
+    double V_max = 0.; ///< Max V bound over all shell pairs
+    /// Sum of max|dP| * V_max over the delta builds since the last full build
+    double accumulated_error = 0.;
+  };
+
+  exx_incremental_state exx_state_;
+
 public:
 
   template <typename... Args>
@@ -11,6 +11,9 @@
 #include "integrator_util/integrator_common.hpp"
 #include "host/local_host_work_driver.hpp"
 #include "host/blas.hpp"
+#include "xc_host_accumulator.hpp"
+#include "xc_host_kernel_traits.hpp"
+#include "integrator_util/host_arena.hpp"
 #include <stdexcept>
 
 namespace GauXC::detail {
@@ -58,6 +61,23 @@ template <typename ValueType>
 void ReferenceReplicatedXCHostIntegrator<ValueType>::
   exc_grad_local_work_( const value_type* P, int64_t ldp, value_type* EXC_GRAD ) {
 
+  // Dispatch to the task kernel specialized for the functional family
+  dispatch_xc_host_kernel( XCSpin::RKS, *this->func_, [&]( auto traits ) {
+    this->template exc_grad_local_work_kernel_<decltype(traits)>( P, ldp, 
+      EXC_GRAD );
+  });
+
+}
+
+template <typename ValueType>
+template <typename KernelTraits>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  exc_grad_local_work_kernel_( const value_type* P, int64_t ldp, 
+    value_type* EXC_GRAD ) {
+
+  constexpr bool is_gga  = KernelTraits::is_gga;
+  constexpr bool is_mgga = KernelTraits::is_mgga;
+
   // Cast LWD to LocalHostWorkDriver
   auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
 
@@ -67,8 +87,8 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   const auto& mol   = this->load_balancer_->molecule();
 
   // MGGA constants
-  const size_t mmga_dim_scal = func.is_mgga() ? 4 : 1;
-  const bool needs_laplacian = func.is_mgga() ? true : false; // TODO: Check for Laplacian dependence
+  const size_t mmga_dim_scal = is_mgga ? 4 : 1;
+  const bool needs_laplacian = is_mgga ? true : false; // TODO: Check for Laplacian dependence
 							      //
   // Get basis map
   BasisSetMap basis_map(basis,mol);
@@ -98,10 +118,30 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
   // Loop over tasks
   const size_t ntasks = tasks.size();
+  // Thread-private gradient contributions
+  XCHostAccumulator<value_type> grad_acc( 1, 3*natoms );
+  const bool use_grad_acc = grad_acc.enabled();
+
+  // Collocation (+ derivative) and Z blocks of the functional family
+  constexpr size_t colloc_nblocks = is_gga ? 10 : 4;
+  constexpr size_t zmat_nblocks   = is_gga ? 4  : 1;
+
+  // Per-thread scratch, sized for the largest task: collocation (+ gau2grid
+  // transpose scratch), X/Z and per point quantities
+  const size_t lb_max_npts = this->load_balancer_->max_npts();
+  const size_t lb_max_nbe  = this->load_balancer_->max_nbe();
+  const size_t scratch_len = 
+    (2 * colloc_nblocks + zmat_nblocks) * this->load_balancer_->max_npts_x_nbe() +
+    lb_max_nbe * lb_max_nbe + 8 * lb_max_npts;
+  const size_t scratch_bytes = sizeof(value_type) * scratch_len +
+    16 * HostArena::alignment;
+
   #pragma omp parallel
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
+  auto& arena = HostArena::thread_arena(); // Thread local scratch
+  arena.reserve( scratch_bytes );
+  if( use_grad_acc ) grad_acc.zero_local();
 
   #pragma omp for schedule(dynamic)
   for( size_t iT = 0; iT < ntasks; ++iT ) {
@@ -118,28 +158,29 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     const auto* weights     = task.weights.data();
     const int32_t* shell_list = task.bfn_screening.shell_list.data();
 
+    // Task scratch is released at the end of each iteration
+    HostArena::scope task_scope( arena );
+
     // Allocate enough memory for batch
 
     // Things that every calc needs
-    host_data.nbe_scr .resize( nbe * nbe  );
-    host_data.eps     .resize( npts );
-    host_data.vrho    .resize( npts );
-    host_data.den_scr .resize( 4 * npts );
-
-    if( func.is_lda() ) {
-      host_data.basis_eval .resize( 4 * npts * nbe );
-      host_data.zmat       .resize( npts * nbe );
-    }
-
-    if( func.is_gga() ){
-      host_data.basis_eval .resize( 10 * npts * nbe );
-      host_data.zmat       .resize( 4  * npts * nbe );
-      host_data.gamma      .resize( npts );
-      host_data.vgamma     .resize( npts );
+    auto* nbe_scr  = arena.allocate<value_type>( nbe * nbe );
+    auto* eps      = arena.allocate<value_type>( npts );
+    auto* vrho     = arena.allocate<value_type>( npts );
+    auto* den_eval = arena.allocate<value_type>( 4 * npts );
+
+    auto* basis_eval = arena.allocate<value_type>( colloc_nblocks * npts * nbe );
+    auto* zmat       = arena.allocate<value_type>( zmat_nblocks   * npts * nbe );
+
+    value_type* gamma  = nullptr;
+    value_type* vgamma = nullptr;
+    if( is_gga ){
+      gamma  = arena.allocate<value_type>( npts );
+      vgamma = arena.allocate<value_type>( npts );
     }
 
 #if 0
-    if( func.is_mgga() ) {
+    if( is_mgga ) {
       host_data.basis_eval .resize( 11 * npts * nbe ); // basis + grad(3) + hess(6) + lapl
       host_data.zmat       .resize(  7 * npts * nbe ); // basis + grad(3) + grad(3)
       host_data.mmat       .resize( npts * nbe );
@@ -155,21 +196,11 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     }
 #endif
 
-    // Alias/Partition out scratch memory
-    auto* basis_eval = host_data.basis_eval.data();
-    auto* den_eval   = host_data.den_scr.data();
-    auto* nbe_scr    = host_data.nbe_scr.data();
-    auto* zmat       = host_data.zmat.data();
-
+    // Partition out scratch memory
     auto* zmat_x = zmat   + npts*nbe;
     auto* zmat_y = zmat_x + npts*nbe;
     auto* zmat_z = zmat_y + npts*nbe;
 
-    auto* eps        = host_data.eps.data();
-    auto* gamma      = host_data.gamma.data();
-    auto* vrho       = host_data.vrho.data();
-    auto* vgamma     = host_data.vgamma.data();
-
 #if 0
     auto* tau        = host_data.tau.data();
     auto* lapl       = host_data.lapl.data();
@@ -210,7 +241,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     value_type* dlbasis_z_eval = nullptr;
 #endif
 
-    if( func.is_gga() ) {
+    if( is_gga ) {
       d2basis_xx_eval = dbasis_z_eval   + npts * nbe;
       d2basis_xy_eval = d2basis_xx_eval + npts * nbe;
       d2basis_xz_eval = d2basis_xy_eval + npts * nbe;
@@ -220,7 +251,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     }
 
 #if 0
-    if( func.is_mgga() ) {
+    if( is_mgga ) {
       d2basis_xx_eval = dbasis_z_eval   + npts * nbe;
       d2basis_xy_eval = d2basis_xx_eval + npts * nbe;
       d2basis_xz_eval = d2basis_xy_eval + npts * nbe;
@@ -253,7 +284,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
     // Evaluate Collocation Gradient (+ Hessian)
 #if 0
-    if( func.is_mgga() ) {
+    if( is_mgga ) {
       lwd->eval_collocation_der3( npts, nshells, nbe, points, basis, shell_list, 
         basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
         d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
@@ -262,9 +293,9 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 	d3basis_yyz_eval, d3basis_yzz_eval, d3basis_zzz_eval);
 
     }
-    else if( func.is_gga() )
+    else if( is_gga )
 #endif
-    if( func.is_gga() )
+    if( is_gga )
       lwd->eval_collocation_hessian( npts, nshells, nbe, points, basis, shell_list, 
         basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
         d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
@@ -276,7 +307,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
     // Evaluate X matrix (2 * P * B/Bx/By/Bz) -> store in Z
     // XXX: This assumes that bfn + gradients are contiguous in memory
-    if( func.is_gga() or func.is_mgga() ) {
+    if( is_gga or is_mgga ) {
       lwd->eval_xmat( 4*npts, nbf, nbe, submat_map, 2.0, P, ldp, basis_eval, nbe,
         zmat, nbe, nbe_scr );
     } else {
@@ -286,7 +317,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
     // Evaluate U and V variables
 #if 0
-    if( func.is_mgga() ) {
+    if( is_mgga ) {
       if ( needs_laplacian ) {
         blas::lacpy( 'A', nbe, npts, d2basis_xx_eval, nbe, lbasis_eval, nbe );
         blas::axpy( nbe * npts, 1., d2basis_yy_eval, 1, lbasis_eval, 1);
@@ -309,9 +340,9 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 	den_eval, dden_x_eval, dden_y_eval, dden_z_eval,
         gamma, tau, lapl );
     }
-    else if( func.is_gga() )
+    else if( is_gga )
 #endif
-    if( func.is_gga() )
+    if( is_gga )
       lwd->eval_uvvar_gga_rks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
         dbasis_z_eval, zmat, nbe, den_eval, dden_x_eval, dden_y_eval, dden_z_eval,
         gamma );
@@ -321,11 +352,11 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
     // Evaluate XC functional
 #if 0
-    if( func.is_mgga() )
+    if( is_mgga )
       func.eval_exc_vxc( npts, den_eval, gamma, lapl, tau, eps, vrho, vgamma, vlapl, vtau );
-    else if(func.is_gga() )
+    else if(is_gga )
 #endif
-    if( func.is_gga() )
+    if( is_gga )
       func.eval_exc_vxc( npts, den_eval, gamma, eps, vrho, vgamma );
     else
       func.eval_exc_vxc( npts, den_eval, eps, vrho );
@@ -357,7 +388,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 	      g_acc_y += vrho_ipt * z * dby;
 	      g_acc_z += vrho_ipt * z * dbz;
 
-	      if( func.is_gga() or func.is_mgga() ) {
+	      if constexpr ( is_gga or is_mgga ) {
       	  // GGA Contributions
           const double vgamma_ipt = weights[ipt] * vgamma[ipt];
 
@@ -389,7 +420,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 	        g_acc_z += 2 * vgamma_ipt * ( z * d2_term_z + dbz * d11_zmat_term );
 	      }
 #if 0
-	      if( func.is_mgga() ) {
+	      if( is_mgga ) {
 
                 const double vtau_ipt = 0.5 * weights[ipt] * vtau[ipt];
 	        const double zx = zmat_x[mu_i]; // Z_x = N * B_x
@@ -430,12 +461,19 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
       } // loop over bfns + grid points
 
-      #pragma omp atomic
-      EXC_GRAD[3*iAt + 0] += -2 * g_acc_x;
-      #pragma omp atomic
-      EXC_GRAD[3*iAt + 1] += -2 * g_acc_y;
-      #pragma omp atomic
-      EXC_GRAD[3*iAt + 2] += -2 * g_acc_z;
+      if( use_grad_acc ) {
+        auto* grad_local = grad_acc.local(0);
+        grad_local[3*iAt + 0] += -2 * g_acc_x;
+        grad_local[3*iAt + 1] += -2 * g_acc_y;
+        grad_local[3*iAt + 2] += -2 * g_acc_z;
+      } else {
+        #pragma omp atomic
+        EXC_GRAD[3*iAt + 0] += -2 * g_acc_x;
+        #pragma omp atomic
+        EXC_GRAD[3*iAt + 1] += -2 * g_acc_y;
+        #pragma omp atomic
+        EXC_GRAD[3*iAt + 2] += -2 * g_acc_z;
+      }
 
       bf_off += sh_sz; // Increment basis offset
 
@@ -443,6 +481,12 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
         
   } // End loop over tasks
 
+  // Reduce thread-private gradients
+  if( use_grad_acc ) grad_acc.reduce( 0, EXC_GRAD );
+
+  // Return the task scratch to the system
+  arena.shrink();
+
   } // OpenMP Region
 
   
@@ -11,6 +11,13 @@
 #include "integrator_util/integrator_common.hpp"
 #include "host/local_host_work_driver.hpp"
 #include "host/blas.hpp"
+#include "host/util.hpp"
+#include "xc_host_integrands.hpp"
+#include "xc_host_kernel_traits.hpp"
+#include "reference_replicated_xc_host_integrator_task_loop.hpp"
+#include "integrator_util/host_arena.hpp"
+#include "integrator_util/shell_block_screening.hpp"
+#include <optional>
 #include <stdexcept>
 
 namespace GauXC::detail {
@@ -98,7 +105,8 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
 
 /// Generic implementation details of EXC/VXC local work - deduces RKS/UKS/GKS
-/// based on null-y / zero parameters
+/// based on null-y / zero parameters and dispatches to the task kernel
+/// specialized for the spin treatment and functional family
 template <typename ValueType>
 void ReferenceReplicatedXCHostIntegrator<ValueType>::
   exc_vxc_local_work_( const basis_type& basis, const value_type* Ps, int64_t ldps,
@@ -120,9 +128,78 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     GAUXC_GENERIC_EXCEPTION("Must Be Either RKS, UKS, or GKS!");
   }
 
-  const bool is_exc_only = (!VXCs) and (!VXCz) and (!VXCy) and (!VXCx);
-  //if(is_exc_only) std::cout << "EXC ONLY" << std::endl;
+  // VXC integrands (s, z, y, x), none for EXC only
+  std::vector<XCHostIntegrand<value_type>> VXC;
+  if( VXCs or VXCz or VXCy or VXCx ) {
+    VXC.push_back( {VXCs, ldvxcs} );
+    if( not is_rks ) VXC.push_back( {VXCz, ldvxcz} );
+    if( is_gks ) {
+      VXC.push_back( {VXCy, ldvxcy} );
+      VXC.push_back( {VXCx, ldvxcx} );
+    }
+  }
+
+  const auto spin = is_rks ? XCSpin::RKS : is_uks ? XCSpin::UKS : XCSpin::GKS;
+  dispatch_xc_host_kernel( spin, *this->func_, [&]( auto traits ) {
+    this->template exc_vxc_local_work_kernel_<decltype(traits)>( basis, 
+      Ps, ldps, Pz, ldpz, Py, ldpy, Px, ldpx, 1, this->func_.get(), 
+      std::move(VXC), EXC, N_EL, settings, task_begin, task_end );
+  });
 
+}
+
+/**
+ *  EXC/VXC local work for a fixed spin treatment and functional family
+ *
+ *  Several functionals may be evaluated on the same density, the kernel
+ *  family must then be the widest family of the functionals. Collocation, 
+ *  X matrices and density variables are evaluated once, only the functional
+ *  evaluation, Z matrices and VXC increments are repeated per functional.
+ *
+ *  @param[in]  nfunc Number of functionals
+ *  @param[in]  funcs Functionals (nfunc)
+ *  @param[out] VXC   VXC integrands, functional major (the s, z, y, x 
+ *                    components of functional k are consecutive). Empty
+ *                    for EXC only
+ *  @param[out] EXC   EXC of each functional (nfunc)
+ */
+template <typename ValueType>
+template <typename KernelTraits>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  exc_vxc_local_work_kernel_( const basis_type& basis, const value_type* Ps, int64_t ldps,
+                              const value_type* Pz, int64_t ldpz,
+                              const value_type* Py, int64_t ldpy,
+                              const value_type* Px, int64_t ldpx,
+                              int64_t nfunc, const functional_type* funcs,
+                              std::vector<XCHostIntegrand<value_type>> VXC,
+                              value_type* EXC, value_type *N_EL, 
+                              const IntegratorSettingsXC& settings,
+                              task_iterator task_begin, task_iterator task_end) {
+
+  constexpr bool is_rks = KernelTraits::is_rks;
+  constexpr bool is_uks = KernelTraits::is_uks;
+  constexpr bool is_gks = KernelTraits::is_gks;
+
+  constexpr bool is_gga  = KernelTraits::is_gga;
+  constexpr bool is_mgga = KernelTraits::is_mgga;
+  constexpr bool needs_laplacian = KernelTraits::needs_laplacian;
+
+  constexpr size_t spin_dim_scal = KernelTraits::spin_dim_scal;
+  constexpr size_t sds           = KernelTraits::sds;
+  constexpr size_t mgga_dim_scal = KernelTraits::mgga_dim_scal; // basis + d1basis
+  constexpr size_t gga_dim_scal  = KernelTraits::gga_dim_scal;
+  constexpr size_t den_dim_scal  = KernelTraits::den_dim_scal;  // den + grad (3)
+
+  constexpr bool has_gamma = is_gga or is_mgga;
+  constexpr bool has_lapl  = needs_laplacian;
+
+  // Collocation blocks (see host_task_loop_)
+  constexpr int colloc_nblocks = KernelTraits::colloc_nblocks;
+
+  const bool is_exc_only = VXC.empty();
+
+  // VXC integrands per functional
+  constexpr size_t nvxc = is_rks ? 1 : is_uks ? 2 : 4;
 
   // Misc KS settings
   IntegratorSettingsKS ks_settings;
@@ -136,138 +213,336 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
 
   // Setup Aliases
-  const auto& func  = *this->func_;
   const auto& mol   = this->load_balancer_->molecule();
 
-  const bool needs_laplacian = func.needs_laplacian(); 
-  
-  if (func.is_mgga() and is_gks) {
-    GAUXC_GENERIC_EXCEPTION("GKS Not Yet Implemented With MGGA Functionals!");
-  }
-
   // Get basis map
   BasisSetMap basis_map(basis,mol);
 
   const int32_t nbf = basis.nbf();
 
-  // Sort tasks on size (XXX: maybe doesnt matter?)
-  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
-    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
-  };
+  if( not is_exc_only and VXC.size() != size_t(nfunc) * nvxc )
+    GAUXC_GENERIC_EXCEPTION("Invalid Number of VXC Integrands");
+  XCHostIntegrands<value_type> vxc( nbf, std::move(VXC) );
 
-  auto& tasks = this->load_balancer_->get_tasks();
-  std::sort( task_begin, task_end, task_comparator );
+  std::vector<double> EXC_WORK( nfunc, 0.0 );
+  double NEL_WORK = 0.0;
 
+  // Fused (cache blocked) task kernel, if provided by the LWD. The
+  // collocation cache and primitive screening, the batched functional
+  // evaluation and the density screening of the points are only 
+  // implemented by the unfused pipeline
+  const bool use_fused = lwd->supports_fused_exc_vxc() and nfunc == 1 and not is_gks and
+    not is_mgga and not ks_settings.collocation_cache_bytes and 
+    ks_settings.xmat_screen_tol <= 0. and ks_settings.prim_screen_tol <= 0. and
+    not ks_settings.func_batch_npts and ks_settings.den_screen_tol <= 0.;
+
+  // Shell block screening of the density matrices for the X matrix GEMMs,
+  // a single (union) pattern serves all density components of a task
+  const bool use_xmat_screen = ks_settings.xmat_screen_tol > 0.;
+  std::unique_ptr<ShellBlockScreening> xmat_screen;
+  if( use_xmat_screen ) {
+    const double* Pk[]  = { Ps, Pz, Py, Px };
+    const size_t  ldk[] = { size_t(ldps), size_t(ldpz), size_t(ldpy), 
+      size_t(ldpx) };
+    xmat_screen = std::make_unique<ShellBlockScreening>( basis_map, nvxc, Pk,
+      ldk, ks_settings.xmat_screen_tol );
+  }
 
-  // Check that Partition Weights have been calculated
-  auto& lb_state = this->load_balancer_->state();
-  if( not lb_state.modified_weights_are_stored ) {
-    GAUXC_GENERIC_EXCEPTION("Weights Have Not Been Modified");
+  // Per-thread scratch, sized for the largest task: collocation (+ gau2grid
+  // transpose scratch), Z/X, compressed P/VXC and per point quantities
+  const size_t lb_max_npts  = this->load_balancer_->max_npts();
+  const size_t lb_max_nbe   = this->load_balancer_->max_nbe();
+  const size_t scratch_len = 
+    (2 * colloc_nblocks + spin_dim_scal * mgga_dim_scal) * 
+      this->load_balancer_->max_npts_x_nbe() +
+    2 * nvxc * lb_max_nbe * lb_max_nbe + 
+    32 * lb_max_npts;
+  const size_t scratch_bytes = sizeof(value_type) * scratch_len +
+    32 * HostArena::alignment;
+
+  // Batched functional evaluation: the density variables of consecutive 
+  // tasks of a thread are staged contiguously and the functional is 
+  // evaluated once per func_batch_npts points. The scratch of staged tasks
+  // is kept until their batch is evaluated, a batch is also closed once 
+  // the arena can no longer hold a maximal task
+  const bool use_func_batch = ks_settings.func_batch_npts > 0 and not is_gks;
+  const size_t func_batch_npts = use_func_batch ? ks_settings.func_batch_npts : 0;
+  const size_t arena_bytes = use_func_batch ? 4 * scratch_bytes : scratch_bytes;
+  const size_t stage_npts  = func_batch_npts + lb_max_npts;
+
+  // Density screening of the points of each task (not for GKS, whose K/H 
+  // intermediates are not compacted)
+  const bool use_den_screen = ks_settings.den_screen_tol > 0. and not is_gks;
+  const double den_screen_tol = ks_settings.den_screen_tol;
+
+  this->template host_task_loop_<KernelTraits>( basis, ks_settings, task_begin,
+    task_end, not use_fused, arena_bytes, vxc, 
+    [&]( HostArena& arena, auto&& for_each_task ) {
+
+  // Shell block pattern of the X matrix GEMMs, rebuilt for each task
+  ShellBlockPattern xmat_pattern;
+
+  // Staged functional inputs / outputs
+  std::vector<value_type> stage_weights( stage_npts ), 
+    stage_den( spin_dim_scal * stage_npts ), stage_eps( stage_npts ), 
+    stage_vrho( spin_dim_scal * stage_npts );
+  std::vector<value_type> stage_gamma, stage_vgamma, stage_tau, stage_vtau,
+    stage_lapl, stage_vlapl;
+  if( has_gamma ) {
+    stage_gamma.resize( gga_dim_scal * stage_npts );
+    stage_vgamma.resize( gga_dim_scal * stage_npts );
+  }
+  if( is_mgga ) {
+    stage_tau.resize( spin_dim_scal * stage_npts );
+    stage_vtau.resize( spin_dim_scal * stage_npts );
+  }
+  if( has_lapl ) {
+    stage_lapl.resize( spin_dim_scal * stage_npts );
+    stage_vlapl.resize( spin_dim_scal * stage_npts );
   }
 
-  // Zero out integrands
-  
-  if(VXCs)
-  for( auto j = 0; j < nbf; ++j ) {
-    for( auto i = 0; i < nbf; ++i ) {
-      VXCs[i + j*ldvxcs] = 0.;
+  // Tasks whose density variables have been staged (the functional 
+  // quantities of a task start at point offset off in the staging buffers)
+  struct staged_task {
+    int32_t npts, nbe;
+    size_t  off;
+    std::vector< std::array<int32_t, 3> > submat_map;
+    value_type *basis_eval, *dbasis_x_eval, *dbasis_y_eval, *dbasis_z_eval,
+      *lbasis_eval, *dden_x_eval, *dden_y_eval, *dden_z_eval, *nbe_scr,
+      *zmat, *zmat_z, *zmat_x, *zmat_y, *mmat_x, *mmat_y, *mmat_z, 
+      *mmat_x_z, *mmat_y_z, *mmat_z_z, *K, *H;
+  };
+  std::vector<staged_task> staged;
+  size_t staged_npts = 0;
+
+  // Arena state before the scratch of the first task of the batch
+  std::optional<HostArena::marker> batch_mark;
+
+  auto stage_ptr = []( std::vector<value_type>& v, size_t ld, size_t off ) {
+    return v.size() ? v.data() + ld * off : nullptr;
+  };
+
+  // Evaluate the functional over the staged points and finish the staged 
+  // tasks (Z matrix + VXC increment)
+  auto flush_batch = [&]() {
+
+    if( staged.empty() ) { 
+      if( batch_mark ) arena.release( *batch_mark );
+      batch_mark.reset(); 
+      return; 
     }
-  }
 
-  if(VXCz) {
-    for( auto j = 0; j < nbf; ++j ) {
-      for( auto i = 0; i < nbf; ++i ) {
-        VXCz[i + j*ldvxcz] = 0.;
-      }
+    const int32_t npts = staged_npts;
+    const auto* weights = stage_weights.data();
+    auto* den_eval = stage_den.data();
+    auto* eps      = stage_eps.data();
+    auto* vrho     = stage_vrho.data();
+    auto* gamma    = stage_ptr( stage_gamma,  gga_dim_scal,  0 );
+    auto* vgamma   = stage_ptr( stage_vgamma, gga_dim_scal,  0 );
+    auto* tau      = stage_ptr( stage_tau,    spin_dim_scal, 0 );
+    auto* vtau     = stage_ptr( stage_vtau,   spin_dim_scal, 0 );
+    auto* lapl     = stage_ptr( stage_lapl,   spin_dim_scal, 0 );
+    auto* vlapl    = stage_ptr( stage_vlapl,  spin_dim_scal, 0 );
+
+    // Electron count of the staged points
+    double NEL_local = 0.0;
+    for( int32_t i = 0; i < npts; ++i ) {
+      const auto den = is_rks ? den_eval[i] : (den_eval[2*i] + den_eval[2*i+1]);
+      NEL_local += weights[i] * den;
     }
-  }
+    #pragma omp atomic
+    NEL_WORK += NEL_local;
+
+    for( int64_t ifunc = 0; ifunc < nfunc; ++ifunc ) {
+
+    // Character of the current functional (bounded by the kernel family)
+    const auto& func   = funcs[ifunc];
+    const bool  f_mgga = is_mgga and func.is_mgga();
+    const bool  f_gga  = has_gamma and func.is_gga();
+    const bool  f_lapl = has_lapl and func.needs_laplacian();
+    auto* f_lapl_eval  = f_lapl ? lapl  : nullptr;
+    auto* f_vlapl      = f_lapl ? vlapl : nullptr;
+
+    // Evaluate XC functional on the staged density variables
+    if( f_mgga )
+      func.eval_exc_vxc( npts, den_eval, gamma, f_lapl_eval, tau, eps, vrho, 
+        vgamma, f_vlapl, vtau );
+    else if( f_gga )
+      func.eval_exc_vxc( npts, den_eval, gamma, eps, vrho, vgamma );
+    else
+      func.eval_exc_vxc( npts, den_eval, eps, vrho );
 
-  if(VXCx and VXCy) {
-    for( auto j = 0; j < nbf; ++j ) {
-      for( auto i = 0; i < nbf; ++i ) {
-        VXCy[i + j*ldvxcy] = 0.;
-        VXCx[i + j*ldvxcx] = 0.;
+    // Factor weights into XC results (strides are fixed per kernel)
+    for( int32_t i = 0; i < npts; ++i ) {
+      const auto w = weights[i];
+      eps[i] *= w;
+      for( size_t s = 0; s < sds; ++s ) vrho[sds*i + s] *= w;
+      if( f_mgga or f_gga )
+        for( size_t s = 0; s < gga_dim_scal; ++s ) vgamma[gga_dim_scal*i + s] *= w;
+      if( f_mgga )
+        for( size_t s = 0; s < sds; ++s ) vtau[spin_dim_scal*i + s] *= w;
+      if( f_lapl )
+        for( size_t s = 0; s < sds; ++s ) vlapl[spin_dim_scal*i + s] *= w;
+    }
+
+    // Scalar integrations
+    double EXC_local = 0.0;
+    for( int32_t i = 0; i < npts; ++i ) {
+      const auto den = is_rks ? den_eval[i] : (den_eval[2*i] + den_eval[2*i+1]);
+      EXC_local += eps[i] * den;
+    }
+    #pragma omp atomic
+    EXC_WORK[ifunc] += EXC_local;
+
+    if( not is_exc_only ) for( auto& st : staged ) {
+
+      const int32_t npts = st.npts;
+      const int32_t nbe  = st.nbe;
+      const auto& submat_map = st.submat_map;
+      auto* vrho   = stage_ptr( stage_vrho,   spin_dim_scal, st.off );
+      auto* vgamma = stage_ptr( stage_vgamma, gga_dim_scal,  st.off );
+      auto* vtau   = stage_ptr( stage_vtau,   spin_dim_scal, st.off );
+      auto* vlapl  = f_lapl ? stage_ptr( stage_vlapl, spin_dim_scal, st.off ) :
+        nullptr;
+      auto* basis_eval    = st.basis_eval;
+      auto* dbasis_x_eval = st.dbasis_x_eval;
+      auto* dbasis_y_eval = st.dbasis_y_eval;
+      auto* dbasis_z_eval = st.dbasis_z_eval;
+      auto* lbasis_eval   = f_lapl ? st.lbasis_eval : nullptr;
+      auto* dden_x_eval   = st.dden_x_eval;
+      auto* dden_y_eval   = st.dden_y_eval;
+      auto* dden_z_eval   = st.dden_z_eval;
+      auto* nbe_scr  = st.nbe_scr;
+      auto* zmat     = st.zmat;
+      auto* zmat_z   = st.zmat_z;
+      auto* zmat_x   = st.zmat_x;
+      auto* zmat_y   = st.zmat_y;
+      auto* mmat_x   = st.mmat_x;
+      auto* mmat_y   = st.mmat_y;
+      auto* mmat_z   = st.mmat_z;
+      auto* mmat_x_z = st.mmat_x_z;
+      auto* mmat_y_z = st.mmat_y_z;
+      auto* mmat_z_z = st.mmat_z_z;
+      auto* K = st.K;
+      auto* H = st.H;
+
+      // Evaluate Z matrix for VXC
+      if( f_mgga ) {
+        if(is_rks) {
+          lwd->eval_zmat_mgga_vxc_rks( npts, nbe, vrho, vgamma, vlapl, basis_eval, dbasis_x_eval,
+                                       dbasis_y_eval, dbasis_z_eval, lbasis_eval,
+                                       dden_x_eval, dden_y_eval, dden_z_eval, zmat, nbe);
+          lwd->eval_mmat_mgga_vxc_rks( npts, nbe, vtau, vlapl, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
+                                       mmat_x, mmat_y, mmat_z, nbe);
+        } else if (is_uks) {
+          lwd->eval_zmat_mgga_vxc_uks( npts, nbe, vrho, vgamma, vlapl, basis_eval, dbasis_x_eval,
+                                       dbasis_y_eval, dbasis_z_eval, lbasis_eval,
+                                       dden_x_eval, dden_y_eval, dden_z_eval, zmat, nbe, zmat_z, nbe);
+          lwd->eval_mmat_mgga_vxc_uks( npts, nbe, vtau, vlapl, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
+                                       mmat_x, mmat_y, mmat_z, nbe, mmat_x_z, mmat_y_z, mmat_z_z, nbe);
+        }
+      }
+      else if( f_gga ) {
+        if(is_rks) {
+          lwd->eval_zmat_gga_vxc_rks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
+                                  dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
+                                  dden_z_eval, zmat, nbe);
+        } else if(is_uks) {
+          lwd->eval_zmat_gga_vxc_uks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
+                                  dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
+                                  dden_z_eval, zmat, nbe, zmat_z, nbe);
+        } else if(is_gks) {
+          lwd->eval_zmat_gga_vxc_gks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
+                                  dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
+                                  dden_z_eval, zmat, nbe, zmat_z, nbe, zmat_x, nbe, zmat_y, nbe,
+                                  K, H);
+        }
+     
+      } else {
+        if(is_rks) {
+          lwd->eval_zmat_lda_vxc_rks( npts, nbe, vrho, basis_eval, zmat, nbe );
+        } else if(is_uks) {
+          lwd->eval_zmat_lda_vxc_uks( npts, nbe, vrho, basis_eval, zmat, nbe, zmat_z, nbe );
+        } else if(is_gks) {
+          lwd->eval_zmat_lda_vxc_gks( npts, nbe, vrho, basis_eval, zmat, nbe, zmat_z, nbe, 
+                                      zmat_x, nbe, zmat_y, nbe, K);
+        }
       }
+
+      // Increment LT of VXC (the M blocks only contribute for MGGAs)
+      const size_t  ivxc = ifunc * nvxc;
+      const int32_t nz   = f_mgga ? mgga_dim_scal * npts : npts;
+      vxc.inc_vxc( lwd, ivxc, nz, nbe, basis_eval, submat_map, zmat, nbe, 
+        nbe_scr );
+      if(not is_rks) {
+        vxc.inc_vxc( lwd, ivxc+1, nz, nbe, basis_eval, submat_map, zmat_z, 
+          nbe, nbe_scr );
+      }
+      if(is_gks) {
+        vxc.inc_vxc( lwd, ivxc+2, npts, nbe, basis_eval, submat_map, zmat_x, 
+          nbe, nbe_scr );
+        vxc.inc_vxc( lwd, ivxc+3, npts, nbe, basis_eval, submat_map, zmat_y, 
+          nbe, nbe_scr );
+      }
+
     }
-  }
- 
-  double EXC_WORK = 0.0;
-  double NEL_WORK = 0.0;
-    
-  // Loop over tasks
-  const size_t ntasks = std::distance(task_begin, task_end);
 
-  #pragma omp parallel
-  {
+    } // Loop over functionals
 
-  XCHostData<value_type> host_data; // Thread local host data
+    staged.clear();
+    staged_npts = 0;
+    arena.release( *batch_mark );
+    batch_mark.reset();
 
-  #pragma omp for schedule(dynamic)
-  for( size_t iT = 0; iT < ntasks; ++iT ) {
-     
-    //std::cout << iT << "/" << ntasks << std::endl;
-    //if(is_exc_only) printf("%lu / %lu\n", iT, ntasks);
-    // Alias current task
-    const auto& task = *(task_begin + iT);
+  };
 
-    // Get tasks constants
-    const int32_t  npts    = task.points.size();
-    const int32_t  nbe     = task.bfn_screening.nbe;
-    const int32_t  nshells = task.bfn_screening.shell_list.size();
+  for_each_task( [&]( XCHostTaskData<value_type>& td ) {
 
-    const auto* points      = task.points.data()->data();
-    const auto* weights     = task.weights.data();
-    const int32_t* shell_list = task.bfn_screening.shell_list.data();
+    const int32_t  npts       = td.npts;
+    const int32_t  nbe        = td.nbe;
+    const int32_t  nshells    = td.nshells;
+    const int32_t* shell_list = td.shells.data();
+    const auto*    weights    = td.weights;
+    auto& submat_map = td.submat_map;
 
-    // Allocate enough memory for batch
-   
-    const size_t spin_dim_scal = is_rks ? 1 : is_uks ? 2 : 4; // last case is_gks
-    const size_t sds          = is_rks ? 1 : 2;
-    const size_t gks_mod_KH = is_gks ? 6*npts : 0; // used to store H and H
-    const size_t mgga_dim_scal = func.is_mgga() ? 4 : 1; // basis + d1basis
-
-    // Things that every calc needs
-    host_data.nbe_scr .resize(nbe  * nbe);
-    host_data.zmat    .resize(npts * nbe * spin_dim_scal * mgga_dim_scal + gks_mod_KH); 
-    host_data.eps     .resize(npts);
-    host_data.vrho    .resize(npts * spin_dim_scal);
-
-    // LDA data requirements
-    if( func.is_lda() ){
-      host_data.basis_eval .resize( npts * nbe );
-      host_data.den_scr    .resize( npts * spin_dim_scal);
-    }
-     
-    // GGA data requirements
-    const size_t gga_dim_scal = is_rks ? 1 : 3;
-    if( func.is_gga() ){
-      host_data.basis_eval .resize( 4 * npts * nbe );
-      host_data.den_scr    .resize( spin_dim_scal * 4 * npts );
-      host_data.gamma      .resize( gga_dim_scal * npts );
-      host_data.vgamma     .resize( gga_dim_scal * npts );
-    }
+    if( use_fused ) {
 
-    if( func.is_mgga() ){
-      if ( needs_laplacian ) {
-        host_data.basis_eval .resize( 11 * npts * nbe ); // basis + grad (3) + hess (6) + lapl 
-        host_data.lapl       .resize( spin_dim_scal * npts );
-        host_data.vlapl      .resize( spin_dim_scal * npts );
-      } else {
-        host_data.basis_eval .resize( 4 * npts * nbe ); // basis + grad (3)
+      // Compressed VXC integrands
+      auto* vxcs_sub = is_exc_only ? nullptr : 
+        arena.allocate<value_type>( nvxc * nbe * nbe );
+      auto* vxcz_sub = is_uks and vxcs_sub ? vxcs_sub + nbe * nbe : nullptr;
+
+      double EXC_local, NEL_local;
+      lwd->eval_exc_vxc_fused( funcs[0], npts, nbf, nbe, nshells, td.points, 
+        weights, basis, shell_list, submat_map, Ps, ldps, Pz, ldpz, vxcs_sub, 
+        vxcz_sub, &EXC_local, &NEL_local );
+
+      #pragma omp atomic
+      EXC_WORK[0] += EXC_local;
+      #pragma omp atomic
+      NEL_WORK += NEL_local;
+
+      if( not is_exc_only ) {
+        vxc.inc_submat( 0, nbe, vxcs_sub, nbe, submat_map );
+        if(is_uks) vxc.inc_submat( 1, nbe, vxcz_sub, nbe, submat_map );
       }
 
-      host_data.den_scr    .resize( spin_dim_scal * 4 * npts );
-      host_data.gamma      .resize( gga_dim_scal * npts );
-      host_data.vgamma     .resize( gga_dim_scal * npts );
-      host_data.tau        .resize( npts * spin_dim_scal );
-      host_data.vtau       .resize( npts * spin_dim_scal );
+      return false;
     }
 
-    // Alias/Partition out scratch memory
-    auto* basis_eval = host_data.basis_eval.data();
-    auto* den_eval   = host_data.den_scr.data();
-    auto* nbe_scr    = host_data.nbe_scr.data();
-    auto* zmat       = host_data.zmat.data();
+    // Scratch of staged tasks is released once their batch is evaluated
+    if( not batch_mark ) batch_mark = td.mark;
+
+    const size_t gks_mod_KH = is_gks ? 6*npts : 0; // used to store K and H
+
+    // Partition out scratch memory, functional quantities are staged
+    const size_t off = staged_npts;
+    auto* den_eval   = stage_ptr( stage_den, spin_dim_scal, off );
+    auto* dden_eval  = den_dim_scal > 1 ? 
+      arena.allocate<value_type>( spin_dim_scal * (den_dim_scal-1) * npts ) : nullptr;
+    auto* nbe_scr    = arena.allocate<value_type>( nbe * nbe );
+    auto* zmat       = arena.allocate<value_type>( 
+      npts * nbe * spin_dim_scal * mgga_dim_scal + gks_mod_KH );
 
     decltype(zmat) zmat_z = nullptr;
     decltype(zmat) zmat_x = nullptr;
@@ -279,27 +554,18 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
       zmat_x = zmat_z + nbe * npts;
       zmat_y = zmat_x + nbe * npts;
     }
-     
-    auto* eps        = host_data.eps.data();
-    auto* gamma      = host_data.gamma.data();
-    auto* tau        = host_data.tau.data();
-    auto* lapl       = host_data.lapl.data();
-    auto* vrho       = host_data.vrho.data();
-    auto* vgamma     = host_data.vgamma.data();
-    auto* vtau       = host_data.vtau.data();
-    auto* vlapl      = host_data.vlapl.data();
-
-
-    value_type* dbasis_x_eval = nullptr;
-    value_type* dbasis_y_eval = nullptr;
-    value_type* dbasis_z_eval = nullptr;
-    value_type* d2basis_xx_eval = nullptr;
-    value_type* d2basis_xy_eval = nullptr;
-    value_type* d2basis_xz_eval = nullptr;
-    value_type* d2basis_yy_eval = nullptr;
-    value_type* d2basis_yz_eval = nullptr;
-    value_type* d2basis_zz_eval = nullptr;
-    value_type* lbasis_eval = nullptr;
+
+    std::copy_n( weights, npts, stage_weights.data() + off );
+    auto* gamma  = stage_ptr( stage_gamma, gga_dim_scal,  off );
+    auto* tau    = stage_ptr( stage_tau,   spin_dim_scal, off );
+    auto* lapl   = stage_ptr( stage_lapl,  spin_dim_scal, off );
+
+    auto* basis_eval    = td.basis_eval;
+    auto* dbasis_x_eval = td.dbasis_x_eval;
+    auto* dbasis_y_eval = td.dbasis_y_eval;
+    auto* dbasis_z_eval = td.dbasis_z_eval;
+    auto* lbasis_eval   = td.lbasis_eval;
+
     value_type* dden_x_eval = nullptr;
     value_type* dden_y_eval = nullptr;
     value_type* dden_z_eval = nullptr;
@@ -313,35 +579,17 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     value_type* mmat_y_z    = nullptr;
     value_type* mmat_z_z    = nullptr;
 
-    if( func.is_gga() ) {
-      dbasis_x_eval = basis_eval    + npts * nbe;
-      dbasis_y_eval = dbasis_x_eval + npts * nbe;
-      dbasis_z_eval = dbasis_y_eval + npts * nbe;
-      dden_x_eval   = den_eval    + spin_dim_scal * npts;
+    if( has_gamma ) {
+      dden_x_eval   = dden_eval;
       dden_y_eval   = dden_x_eval + spin_dim_scal * npts;
       dden_z_eval   = dden_y_eval + spin_dim_scal * npts;
       if (is_gks) { H = K + 3*npts;}
     }
 
-    if ( func.is_mgga() ) {
-      dbasis_x_eval = basis_eval    + npts * nbe;
-      dbasis_y_eval = dbasis_x_eval + npts * nbe;
-      dbasis_z_eval = dbasis_y_eval + npts * nbe;
-      dden_x_eval   = den_eval    + spin_dim_scal * npts;
-      dden_y_eval   = dden_x_eval + spin_dim_scal * npts;
-      dden_z_eval   = dden_y_eval + spin_dim_scal * npts;
+    if ( is_mgga ) {
       mmat_x        = zmat + npts * nbe;
       mmat_y        = mmat_x + npts * nbe;
       mmat_z        = mmat_y + npts * nbe;
-      if ( needs_laplacian ) {
-        d2basis_xx_eval = dbasis_z_eval + npts * nbe;
-        d2basis_xy_eval = d2basis_xx_eval + npts * nbe;
-        d2basis_xz_eval = d2basis_xy_eval + npts * nbe;
-        d2basis_yy_eval = d2basis_xz_eval + npts * nbe;
-        d2basis_yz_eval = d2basis_yy_eval + npts * nbe;
-        d2basis_zz_eval = d2basis_yz_eval + npts * nbe;
-        lbasis_eval     = d2basis_zz_eval + npts * nbe;
-      }
       if(is_uks) {
         mmat_x_z = zmat_z + npts * nbe;
         mmat_y_z = mmat_x_z + npts * nbe;
@@ -349,39 +597,29 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
       }
     }
 
+    // Evaluate X matrix (fac * P * B) -> store in Z
+    const auto xmat_fac = is_rks ? 2.0 : 1.0; // TODO Fix for spinor RKS input
+    if( use_xmat_screen ) {
 
-    // Get the submatrix map for batch
-    std::vector< std::array<int32_t, 3> > submat_map;
-    std::tie(submat_map, std::ignore) =
-          gen_compressed_submat_map(basis_map, task.bfn_screening.shell_list, nbf, nbf);
-
-    // Evaluate Collocation (+ Grad and Hessian)
-    if( func.is_mgga() ) {
-      if ( needs_laplacian ) {
-        // TODO: Modify gau2grid to compute Laplacian instead of full hessian
-        lwd->eval_collocation_hessian( npts, nshells, nbe, points, basis, shell_list,
-          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
-          d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
-          d2basis_zz_eval);
-        blas::lacpy( 'A', nbe, npts, d2basis_xx_eval, nbe, lbasis_eval, nbe );
-        blas::axpy( nbe * npts, 1., d2basis_yy_eval, 1, lbasis_eval, 1);
-        blas::axpy( nbe * npts, 1., d2basis_zz_eval, 1, lbasis_eval, 1);
-      } else {
-        lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
-          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
-      }
+    xmat_pattern.build( basis_map, nshells, shell_list, *xmat_screen );
+
+    lwd->eval_xmat_screened( mgga_dim_scal * npts, xmat_pattern, xmat_fac, 
+      Ps, ldps, basis_eval, nbe, zmat, nbe, nbe_scr );
+
+    if(not is_rks) {
+      lwd->eval_xmat_screened( mgga_dim_scal * npts, xmat_pattern, 1.0, 
+        Pz, ldpz, basis_eval, nbe, zmat_z, nbe, nbe_scr );
     }
-    // Evaluate Collocation (+ Grad)
-    else if( func.is_gga() )
-      lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
-        basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
-    else
-      lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list,
-        basis_eval );
 
-     
-    // Evaluate X matrix (fac * P * B) -> store in Z
-    const auto xmat_fac = is_rks ? 2.0 : 1.0; // TODO Fix for spinor RKS input
+    if(is_gks) {
+      lwd->eval_xmat_screened( npts, xmat_pattern, 1.0, Py, ldpy, basis_eval, 
+        nbe, zmat_x, nbe, nbe_scr );
+      lwd->eval_xmat_screened( npts, xmat_pattern, 1.0, Px, ldpx, basis_eval, 
+        nbe, zmat_y, nbe, nbe_scr );
+    }
+
+    } else {
+
     lwd->eval_xmat( mgga_dim_scal * npts, nbf, nbe, submat_map, xmat_fac, Ps, ldps, basis_eval, nbe,
       zmat, nbe, nbe_scr );
 		
@@ -398,9 +636,11 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
       lwd->eval_xmat( npts, nbf, nbe, submat_map, 1.0, Px, ldpx, basis_eval, nbe,
         zmat_y, nbe, nbe_scr);
     }
+
+    } // X matrix
      
     // Evaluate U and V variables
-    if( func.is_mgga() ) {
+    if( is_mgga ) {
       if (is_rks) {
         lwd->eval_uvvar_mgga_rks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
           dbasis_z_eval, lbasis_eval, zmat, nbe, mmat_x, mmat_y, mmat_z, 
@@ -411,7 +651,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
           mmat_x, mmat_y, mmat_z, nbe, mmat_x_z, mmat_y_z, mmat_z_z, nbe, 
           den_eval, dden_x_eval, dden_y_eval, dden_z_eval, gamma, tau, lapl);
       }
-    } else if ( func.is_gga() ) {
+    } else if ( is_gga ) {
       if(is_rks) {
         lwd->eval_uvvar_gga_rks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
           dbasis_z_eval, zmat, nbe, den_eval, dden_x_eval, dden_y_eval, dden_z_eval,
@@ -438,163 +678,91 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
       }
      }
     
-    // Evaluate XC functional
-    if( func.is_mgga() )
-      func.eval_exc_vxc( npts, den_eval, gamma, lapl, tau, eps, vrho, vgamma, vlapl, vtau);
-    else if( func.is_gga() )
-      func.eval_exc_vxc( npts, den_eval, gamma, eps, vrho, vgamma );
-    else
-      func.eval_exc_vxc( npts, den_eval, eps, vrho );
 
-    // Factor weights into XC results
-    for( int32_t i = 0; i < npts; ++i ) {
-      eps[i]  *= weights[i];
-      vrho[sds*i] *= weights[i];
-      if(not is_rks) vrho[sds*i+1] *= weights[i];
-    }
-    if( func.is_gga() ){
+    // Remove points with negligible density, the remainder of the task
+    // (functional, Z matrix and VXC increment) is evaluated on the 
+    // surviving points only. Tasks without surviving points are not staged,
+    // their scratch is released with the batch
+    int32_t npts_eval = npts;
+    if( use_den_screen ) {
+
+      auto* pt_idx = arena.allocate<int32_t>( npts );
+      int32_t npts_keep = 0;
       for( int32_t i = 0; i < npts; ++i ) {
-         vgamma[gga_dim_scal*i] *= weights[i];
-         if(not is_rks) {
-           vgamma[gga_dim_scal*i+1] *= weights[i];
-           vgamma[gga_dim_scal*i+2] *= weights[i];
-         }
+        const auto rho = is_rks ? den_eval[i] : 
+          den_eval[2*i] + den_eval[2*i+1];
+        if( rho > den_screen_tol ) pt_idx[npts_keep++] = i;
       }
-    }
+      npts_eval = npts_keep;
 
-    if( func.is_mgga() ){
-      for( int32_t i = 0; i < npts; ++i) {
-        vtau[spin_dim_scal*i]  *= weights[i];
-        vgamma[gga_dim_scal*i] *= weights[i];
-        if(not is_rks) {
-          vgamma[gga_dim_scal*i+1] *= weights[i];
-          vgamma[gga_dim_scal*i+2] *= weights[i];
-          vtau[spin_dim_scal*i+1]  *= weights[i];
-        }
+      if( npts_eval and npts_eval < npts ) {
 
-        // TODO: Add checks for Lapacian-dependent functionals
-        if( needs_laplacian ) {
-          vlapl[spin_dim_scal*i] *= weights[i];
-          if(not is_rks) {
-            vlapl[spin_dim_scal*i+1] *= weights[i];
-          }
+        // Gather surviving columns of collocation and density variables
+        detail::compact_columns( nbe, npts, colloc_nblocks, pt_idx, npts_keep,
+          basis_eval );
+        detail::compact_columns( spin_dim_scal, npts, 1, pt_idx, npts_keep,
+          den_eval );
+        detail::compact_columns( 1, npts, 1, pt_idx, npts_keep, 
+          stage_weights.data() + off );
+        if( dden_eval ) detail::compact_columns( spin_dim_scal, npts, 3, 
+          pt_idx, npts_keep, dden_eval );
+        if( gamma ) detail::compact_columns( gga_dim_scal, npts, 1, pt_idx,
+          npts_keep, gamma );
+        if( tau ) detail::compact_columns( spin_dim_scal, npts, 1, pt_idx,
+          npts_keep, tau );
+        if( lapl ) detail::compact_columns( spin_dim_scal, npts, 1, pt_idx,
+          npts_keep, lapl );
+
+        // Repartition the task scratch for the reduced number of points
+        if( dbasis_x_eval ) {
+          dbasis_x_eval = basis_eval    + npts_eval * nbe;
+          dbasis_y_eval = dbasis_x_eval + npts_eval * nbe;
+          dbasis_z_eval = dbasis_y_eval + npts_eval * nbe;
+          dden_y_eval   = dden_x_eval + spin_dim_scal * npts_eval;
+          dden_z_eval   = dden_y_eval + spin_dim_scal * npts_eval;
+        }
+        if( lbasis_eval ) lbasis_eval = dbasis_z_eval + npts_eval * nbe;
+        if( zmat_z ) zmat_z = zmat + mgga_dim_scal * nbe * npts_eval;
+        if( mmat_x ) {
+          mmat_x = zmat   + npts_eval * nbe;
+          mmat_y = mmat_x + npts_eval * nbe;
+          mmat_z = mmat_y + npts_eval * nbe;
+        }
+        if( mmat_x_z ) {
+          mmat_x_z = zmat_z   + npts_eval * nbe;
+          mmat_y_z = mmat_x_z + npts_eval * nbe;
+          mmat_z_z = mmat_y_z + npts_eval * nbe;
         }
-      }
-    }
 
+      }
 
-    // Scalar integrations
-    double NEL_local = 0.0;
-    double EXC_local  = 0.0;
-    for( int32_t i = 0; i < npts; ++i ) {
-      const auto den = is_rks ? den_eval[i] : (den_eval[2*i] + den_eval[2*i+1]);
-      NEL_local += weights[i] * den;
-      EXC_local += eps[i]     * den;
     }
 
-    // Atomic updates
-    #pragma omp atomic
-    EXC_WORK += EXC_local;
-    #pragma omp atomic
-    NEL_WORK += NEL_local;
-
-    if(is_exc_only) continue;
-
-    // Evaluate Z matrix for VXC
-    if( func.is_mgga() ) {
-      if(is_rks) {
-        lwd->eval_zmat_mgga_vxc_rks( npts, nbe, vrho, vgamma, vlapl, basis_eval, dbasis_x_eval,
-                                     dbasis_y_eval, dbasis_z_eval, lbasis_eval,
-                                     dden_x_eval, dden_y_eval, dden_z_eval, zmat, nbe);
-        lwd->eval_mmat_mgga_vxc_rks( npts, nbe, vtau, vlapl, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
-                                     mmat_x, mmat_y, mmat_z, nbe);
-      } else if (is_uks) {
-        lwd->eval_zmat_mgga_vxc_uks( npts, nbe, vrho, vgamma, vlapl, basis_eval, dbasis_x_eval,
-                                     dbasis_y_eval, dbasis_z_eval, lbasis_eval,
-                                     dden_x_eval, dden_y_eval, dden_z_eval, zmat, nbe, zmat_z, nbe);
-        lwd->eval_mmat_mgga_vxc_uks( npts, nbe, vtau, vlapl, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
-                                     mmat_x, mmat_y, mmat_z, nbe, mmat_x_z, mmat_y_z, mmat_z_z, nbe);
-      }
-    }
-    else if( func.is_gga() ) {
-      if(is_rks) {
-        lwd->eval_zmat_gga_vxc_rks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
-                                dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
-                                dden_z_eval, zmat, nbe);
-      } else if(is_uks) {
-        lwd->eval_zmat_gga_vxc_uks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
-                                dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
-                                dden_z_eval, zmat, nbe, zmat_z, nbe);
-      } else if(is_gks) {
-        lwd->eval_zmat_gga_vxc_gks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
-                                dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
-                                dden_z_eval, zmat, nbe, zmat_z, nbe, zmat_x, nbe, zmat_y, nbe,
-                                K, H);
-      }
-       
-    } else {
-      if(is_rks) {
-        lwd->eval_zmat_lda_vxc_rks( npts, nbe, vrho, basis_eval, zmat, nbe );
-      } else if(is_uks) {
-        lwd->eval_zmat_lda_vxc_uks( npts, nbe, vrho, basis_eval, zmat, nbe, zmat_z, nbe );
-      } else if(is_gks) {
-        lwd->eval_zmat_lda_vxc_gks( npts, nbe, vrho, basis_eval, zmat, nbe, zmat_z, nbe, 
-                                    zmat_x, nbe, zmat_y, nbe, K);
-      }
+    // Stage the task, the functional is evaluated once the batch is full
+    if( npts_eval ) {
+      staged.push_back( staged_task{ npts_eval, nbe, off, std::move(submat_map), 
+        basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval,
+        dden_x_eval, dden_y_eval, dden_z_eval, nbe_scr, zmat, zmat_z, zmat_x, 
+        zmat_y, mmat_x, mmat_y, mmat_z, mmat_x_z, mmat_y_z, mmat_z_z, K, H } );
+      staged_npts += npts_eval;
     }
-    
-
-     
-    // Incremeta LT of VXC
-    {
+    if( staged_npts >= func_batch_npts or 
+        arena.used() + scratch_bytes > arena.capacity() ) flush_batch();
 
-      // Increment VXC
-      lwd->inc_vxc( mgga_dim_scal * npts, nbf, nbe, basis_eval, submat_map, zmat, nbe, VXCs, ldvxcs, nbe_scr );
-      if(not is_rks) {
-        lwd->inc_vxc( mgga_dim_scal * npts, nbf, nbe, basis_eval, submat_map, zmat_z, nbe,VXCz, ldvxcz, nbe_scr);
-      }
-      if(is_gks) {
-        lwd->inc_vxc( npts, nbf, nbe, basis_eval, submat_map, zmat_x, nbe, VXCy, ldvxcy,
-          nbe_scr);
-        lwd->inc_vxc( npts, nbf, nbe, basis_eval, submat_map, zmat_y, nbe, VXCx, ldvxcx,
-          nbe_scr);
-      }
-       
-    }
+    // The scratch of the task is released with its batch
+    return true;
 
-  } // Loop over tasks
+  }); // Loop over tasks
 
-  } // End OpenMP region
+  // Evaluate the remaining staged tasks
+  flush_batch();
 
+  }); // Task loop
 
   // Set scalar return values
-  *EXC  = EXC_WORK;
+  for( int64_t k = 0; k < nfunc; ++k ) EXC[k] = EXC_WORK[k];
   *N_EL = NEL_WORK;
 
-  if(not is_exc_only) {
-    // Symmetrize VXC
-    for( int32_t j = 0;   j < nbf; ++j ) {
-      for( int32_t i = j+1; i < nbf; ++i ) {
-        VXCs[ j + i*ldvxcs ] = VXCs[ i + j*ldvxcs ];
-      }
-    }
-    if(not is_rks) {
-      for( int32_t j = 0;   j < nbf; ++j ) {
-        for( int32_t i = j+1; i < nbf; ++i ) {
-          VXCz[ j + i*ldvxcz ] = VXCz[ i + j*ldvxcz ];
-        }
-      }
-    }
-    if( is_gks) {
-      for( int32_t j = 0;   j < nbf; ++j ) {
-        for( int32_t i = j+1; i < nbf; ++i ) {
-          VXCy[ j + i*ldvxcy ] = VXCy[ i + j*ldvxcy ];
-          VXCx[ j + i*ldvxcx ] = VXCx[ i + j*ldvxcx ];
-        }
-      }
-    }
-  }
-
 } 
 
 
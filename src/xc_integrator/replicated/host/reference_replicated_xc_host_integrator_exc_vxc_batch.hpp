@@ -0,0 +1,299 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include "reference_replicated_xc_host_integrator.hpp"
+#include "integrator_util/integrator_common.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "host/blas.hpp"
+#include "host/util.hpp"
+#include "xc_host_integrands.hpp"
+#include "xc_host_kernel_traits.hpp"
+#include "reference_replicated_xc_host_integrator_task_loop.hpp"
+#include "integrator_util/host_arena.hpp"
+#include <stdexcept>
+
+namespace GauXC::detail {
+
+/// Batched RKS EXC/VXC: all density matrices share a single pass over tasks
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  eval_exc_vxc_batch_( int64_t m, int64_t n, int64_t ndm,
+                       const value_type* const* P, int64_t ldp,
+                       value_type* const* VXC, int64_t ldvxc,
+                       value_type* EXC, const IntegratorSettingsXC& ks_settings ) {
+
+  const auto& basis = this->load_balancer_->basis();
+
+  // Check that P / VXC are sane
+  const int64_t nbf = basis.nbf();
+  if( m != n )
+    GAUXC_GENERIC_EXCEPTION("P/VXC Must Be Square");
+  if( m != nbf )
+    GAUXC_GENERIC_EXCEPTION("P/VXC Must Have Same Dimension as Basis");
+  if( ldp < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDP");
+  if( ldvxc < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDVXC");
+
+  if( ndm <= 0 ) return;
+
+  // Get Tasks
+  this->load_balancer_->get_tasks();
+
+  // Temporary electron counts to judge integrator accuracy
+  std::vector<value_type> N_EL( ndm );
+
+  // Compute Local contributions to EXC / VXC
+  this->timer_.time_op("XCIntegrator.LocalWork", [&](){
+    exc_vxc_batch_local_work_( ndm, P, ldp, VXC, ldvxc, EXC, N_EL.data(),
+      ks_settings );
+  });
+
+  // Reduce Results
+  this->timer_.time_op("XCIntegrator.Allreduce", [&](){
+
+    if( not this->reduction_driver_->takes_host_memory() )
+      GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
+
+    for( int64_t i = 0; i < ndm; ++i )
+      this->reduction_driver_->allreduce_inplace( VXC[i], nbf*nbf, ReductionOp::Sum );
+
+    this->reduction_driver_->allreduce_inplace( EXC,         ndm, ReductionOp::Sum );
+    this->reduction_driver_->allreduce_inplace( N_EL.data(), ndm, ReductionOp::Sum );
+
+  });
+
+}
+
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  exc_vxc_batch_local_work_( int64_t ndm, const value_type* const* P,
+                             int64_t ldp, value_type* const* VXC,
+                             int64_t ldvxc, value_type* EXC, value_type* N_EL,
+                             const IntegratorSettingsXC& settings ) {
+
+  dispatch_xc_host_kernel( XCSpin::RKS, *this->func_, [&]( auto traits ) {
+    this->template exc_vxc_batch_local_work_kernel_<decltype(traits)>( ndm,
+      P, ldp, VXC, ldvxc, EXC, N_EL, settings );
+  });
+
+}
+
+/**
+ *  Batched EXC/VXC local work for a fixed functional family
+ *
+ *  Collocation is evaluated once per task. The X matrices of all densities
+ *  are obtained from a single GEMM against the vertically stacked compressed
+ *  density matrices. The remainder of the pipeline (U/V variables, functional,
+ *  Z matrix, VXC increment) runs per density on the shared collocation.
+ */
+template <typename ValueType>
+template <typename KernelTraits>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  exc_vxc_batch_local_work_kernel_( int64_t ndm, const value_type* const* P,
+                                    int64_t ldp, value_type* const* VXC,
+                                    int64_t ldvxc, value_type* EXC,
+                                    value_type* N_EL,
+                                    const IntegratorSettingsXC& settings ) {
+
+  constexpr bool is_gga  = KernelTraits::is_gga;
+  constexpr bool is_mgga = KernelTraits::is_mgga;
+  constexpr bool needs_laplacian = KernelTraits::needs_laplacian;
+  constexpr size_t mgga_dim_scal  = KernelTraits::mgga_dim_scal;
+  constexpr int    colloc_nblocks = KernelTraits::colloc_nblocks;
+
+  // Misc KS settings
+  IntegratorSettingsKS ks_settings;
+  if( auto* tmp = dynamic_cast<const IntegratorSettingsKS*>(&settings) ) {
+    ks_settings = *tmp;
+  }
+
+  // Cast LWD to LocalHostWorkDriver
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
+
+  // Setup Aliases
+  const auto& func  = *this->func_;
+  const auto& basis = this->load_balancer_->basis();
+
+  const int32_t nbf = basis.nbf();
+
+  // VXC integrands
+  std::vector<XCHostIntegrand<value_type>> vxc_list;
+  for( int64_t k = 0; k < ndm; ++k ) vxc_list.push_back( {VXC[k], ldvxc} );
+  XCHostIntegrands<value_type> vxc( nbf, std::move(vxc_list) );
+
+  std::vector<double> EXC_WORK( ndm, 0. ), NEL_WORK( ndm, 0. );
+
+  // Per-thread scratch, sized for the largest task: collocation (+ gau2grid
+  // transpose scratch), stacked X + Z, stacked compressed P and per point
+  // quantities (one density at a time)
+  const size_t lb_max_npts = this->load_balancer_->max_npts();
+  const size_t lb_max_nbe  = this->load_balancer_->max_nbe();
+  const size_t scratch_len =
+    (2 * colloc_nblocks + (ndm+1) * mgga_dim_scal) *
+      this->load_balancer_->max_npts_x_nbe() +
+    (ndm+1) * lb_max_nbe * lb_max_nbe + 32 * lb_max_npts;
+  const size_t scratch_bytes = sizeof(value_type) * scratch_len +
+    32 * HostArena::alignment;
+
+  auto& tasks = this->load_balancer_->get_tasks();
+  this->template host_task_loop_<KernelTraits>( basis, ks_settings,
+    tasks.begin(), tasks.end(), true, scratch_bytes, vxc,
+    [&]( HostArena& arena, auto&& for_each_task ) {
+
+  std::vector<double> EXC_LOCAL( ndm, 0. ), NEL_LOCAL( ndm, 0. );
+
+  for_each_task( [&]( XCHostTaskData<value_type>& td ) {
+
+    const int32_t npts    = td.npts;
+    const int32_t nbe     = td.nbe;
+    const auto*   weights = td.weights;
+    const auto&   submat_map = td.submat_map;
+
+    // Stacked X matrices: rows [k*nbe, (k+1)*nbe) belong to P[k]
+    const size_t ldx = ndm * nbe;
+    auto* xmat       = arena.allocate<value_type>( mgga_dim_scal * npts * ldx );
+    auto* zmat       = arena.allocate<value_type>( mgga_dim_scal * npts * nbe );
+    auto* pstack_scr = arena.allocate<value_type>( ldx * nbe );
+    auto* nbe_scr    = arena.allocate<value_type>( nbe * nbe );
+
+    auto* den_eval = arena.allocate<value_type>( npts );
+    auto* eps      = arena.allocate<value_type>( npts );
+    auto* vrho     = arena.allocate<value_type>( npts );
+
+    const auto* basis_eval    = td.basis_eval;
+    const auto* dbasis_x_eval = td.dbasis_x_eval;
+    const auto* dbasis_y_eval = td.dbasis_y_eval;
+    const auto* dbasis_z_eval = td.dbasis_z_eval;
+    const auto* lbasis_eval   = td.lbasis_eval;
+    value_type* dden_x_eval   = nullptr;
+    value_type* dden_y_eval   = nullptr;
+    value_type* dden_z_eval   = nullptr;
+    value_type* gamma  = nullptr;
+    value_type* vgamma = nullptr;
+    value_type* tau    = nullptr;
+    value_type* vtau   = nullptr;
+    value_type* lapl   = nullptr;
+    value_type* vlapl  = nullptr;
+    value_type* mmat_x = nullptr;
+    value_type* mmat_y = nullptr;
+    value_type* mmat_z = nullptr;
+
+    if( is_gga or is_mgga ) {
+      dden_x_eval   = arena.allocate<value_type>( 3 * npts );
+      dden_y_eval   = dden_x_eval + npts;
+      dden_z_eval   = dden_y_eval + npts;
+      gamma         = arena.allocate<value_type>( npts );
+      vgamma        = arena.allocate<value_type>( npts );
+    }
+
+    if( is_mgga ) {
+      tau    = arena.allocate<value_type>( npts );
+      vtau   = arena.allocate<value_type>( npts );
+      mmat_x = zmat   + npts * nbe;
+      mmat_y = mmat_x + npts * nbe;
+      mmat_z = mmat_y + npts * nbe;
+      if( needs_laplacian ) {
+        lapl        = arena.allocate<value_type>( npts );
+        vlapl       = arena.allocate<value_type>( npts );
+      }
+    }
+
+    // Evaluate all X matrices (2 * P[k] * B) with a single GEMM
+    lwd->eval_xmat_stacked( mgga_dim_scal * npts, nbf, nbe, submat_map, 2.0,
+      ndm, P, ldp, basis_eval, nbe, xmat, ldx, pstack_scr );
+
+    for( int64_t k = 0; k < ndm; ++k ) {
+
+      const auto* xmat_k = xmat + k * nbe;
+
+      // Evaluate U and V variables
+      if( is_mgga ) {
+        const auto* xmat_k_x = xmat_k   + npts * ldx;
+        const auto* xmat_k_y = xmat_k_x + npts * ldx;
+        const auto* xmat_k_z = xmat_k_y + npts * ldx;
+        lwd->eval_uvvar_mgga_rks( npts, nbe, basis_eval, dbasis_x_eval,
+          dbasis_y_eval, dbasis_z_eval, lbasis_eval, xmat_k, ldx, xmat_k_x,
+          xmat_k_y, xmat_k_z, ldx, den_eval, dden_x_eval, dden_y_eval,
+          dden_z_eval, gamma, tau, lapl );
+      } else if( is_gga ) {
+        lwd->eval_uvvar_gga_rks( npts, nbe, basis_eval, dbasis_x_eval,
+          dbasis_y_eval, dbasis_z_eval, xmat_k, ldx, den_eval, dden_x_eval,
+          dden_y_eval, dden_z_eval, gamma );
+      } else {
+        lwd->eval_uvvar_lda_rks( npts, nbe, basis_eval, xmat_k, ldx, den_eval );
+      }
+
+      // Evaluate XC functional
+      if( is_mgga )
+        func.eval_exc_vxc( npts, den_eval, gamma, lapl, tau, eps, vrho, vgamma, vlapl, vtau );
+      else if( is_gga )
+        func.eval_exc_vxc( npts, den_eval, gamma, eps, vrho, vgamma );
+      else
+        func.eval_exc_vxc( npts, den_eval, eps, vrho );
+
+      // Factor weights into XC results
+      for( int32_t i = 0; i < npts; ++i ) {
+        const auto w = weights[i];
+        eps[i]  *= w;
+        vrho[i] *= w;
+        if constexpr ( is_gga or is_mgga ) vgamma[i] *= w;
+        if constexpr ( is_mgga ) vtau[i] *= w;
+        if constexpr ( needs_laplacian ) vlapl[i] *= w;
+      }
+
+      // Scalar integrations
+      for( int32_t i = 0; i < npts; ++i ) {
+        NEL_LOCAL[k] += weights[i] * den_eval[i];
+        EXC_LOCAL[k] += eps[i]     * den_eval[i];
+      }
+
+      // Evaluate Z matrix for VXC
+      if( is_mgga ) {
+        lwd->eval_zmat_mgga_vxc_rks( npts, nbe, vrho, vgamma, vlapl, basis_eval,
+          dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval,
+          dden_x_eval, dden_y_eval, dden_z_eval, zmat, nbe );
+        lwd->eval_mmat_mgga_vxc_rks( npts, nbe, vtau, vlapl, dbasis_x_eval,
+          dbasis_y_eval, dbasis_z_eval, mmat_x, mmat_y, mmat_z, nbe );
+      } else if( is_gga ) {
+        lwd->eval_zmat_gga_vxc_rks( npts, nbe, vrho, vgamma, basis_eval,
+          dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, dden_x_eval,
+          dden_y_eval, dden_z_eval, zmat, nbe );
+      } else {
+        lwd->eval_zmat_lda_vxc_rks( npts, nbe, vrho, basis_eval, zmat, nbe );
+      }
+
+      // Increment LT of VXC
+      vxc.inc_vxc( lwd, k, mgga_dim_scal * npts, nbe, basis_eval, submat_map,
+        zmat, nbe, nbe_scr );
+
+    } // Loop over densities
+
+    return false;
+
+  }); // Loop over tasks
+
+  for( int64_t k = 0; k < ndm; ++k ) {
+    #pragma omp atomic
+    EXC_WORK[k] += EXC_LOCAL[k];
+    #pragma omp atomic
+    NEL_WORK[k] += NEL_LOCAL[k];
+  }
+
+  }); // Task loop
+
+  // Set scalar return values
+  for( int64_t k = 0; k < ndm; ++k ) {
+    EXC[k]  = EXC_WORK[k];
+    N_EL[k] = NEL_WORK[k];
+  }
+
+}
+
+} // namespace GauXC::detail
@@ -0,0 +1,107 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include "reference_replicated_xc_host_integrator.hpp"
+#include "integrator_util/integrator_common.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "host/blas.hpp"
+#include "host/util.hpp"
+#include "xc_host_integrands.hpp"
+#include "xc_host_kernel_traits.hpp"
+#include "reference_replicated_xc_host_integrator_exc_vxc.hpp"
+#include <stdexcept>
+
+namespace GauXC::detail {
+
+/// Union of the density variable requirements of a set of functionals
+struct MultiFunctionalFamily {
+  bool mgga = false;
+  bool gga  = false;
+  bool lapl = false;
+
+  inline bool is_mgga() const { return mgga; }
+  inline bool is_gga()  const { return gga;  }
+  inline bool needs_laplacian() const { return lapl; }
+};
+
+/// RKS EXC(/VXC) for several functionals on a single density
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  eval_exc_vxc_multi_( int64_t m, int64_t n, const value_type* P,
+                       int64_t ldp, int64_t nfunc,
+                       const functional_type* funcs,
+                       value_type* const* VXC, int64_t ldvxc,
+                       value_type* EXC, const IntegratorSettingsXC& ks_settings ) {
+
+  const auto& basis = this->load_balancer_->basis();
+
+  // Check that P / VXC are sane
+  const int64_t nbf = basis.nbf();
+  if( m != n )
+    GAUXC_GENERIC_EXCEPTION("P/VXC Must Be Square");
+  if( m != nbf )
+    GAUXC_GENERIC_EXCEPTION("P/VXC Must Have Same Dimension as Basis");
+  if( ldp < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDP");
+  if( VXC and ldvxc < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDVXC");
+
+  if( nfunc <= 0 ) return;
+
+  for( int64_t k = 0; k < nfunc; ++k )
+  if( funcs[k].is_polarized() )
+    GAUXC_GENERIC_EXCEPTION("Multi-Functional EXC/VXC Requires Unpolarized Functionals");
+
+  // Get Tasks
+  auto& tasks = this->load_balancer_->get_tasks();
+
+  // Temporary electron count to judge integrator accuracy
+  value_type N_EL;
+
+  // VXC integrands, none for EXC only
+  std::vector<XCHostIntegrand<value_type>> VXC_list;
+  if( VXC )
+  for( int64_t k = 0; k < nfunc; ++k ) VXC_list.push_back( {VXC[k], ldvxc} );
+
+  // Density variables are evaluated for the most demanding functional
+  MultiFunctionalFamily family;
+  for( int64_t k = 0; k < nfunc; ++k ) {
+    family.mgga = family.mgga or funcs[k].is_mgga();
+    family.gga  = family.gga  or funcs[k].is_gga();
+    family.lapl = family.lapl or funcs[k].needs_laplacian();
+  }
+
+  // Compute Local contributions to EXC / VXC
+  this->timer_.time_op("XCIntegrator.LocalWork", [&](){
+    dispatch_xc_host_kernel( XCSpin::RKS, family, [&]( auto traits ) {
+      this->template exc_vxc_local_work_kernel_<decltype(traits)>( basis,
+        P, ldp, nullptr, 0, nullptr, 0, nullptr, 0, nfunc, funcs,
+        std::move(VXC_list), EXC, &N_EL, ks_settings, tasks.begin(), 
+        tasks.end() );
+    });
+  });
+
+  // Reduce Results
+  this->timer_.time_op("XCIntegrator.Allreduce", [&](){
+
+    if( not this->reduction_driver_->takes_host_memory() )
+      GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
+
+    if( VXC )
+    for( int64_t i = 0; i < nfunc; ++i )
+      this->reduction_driver_->allreduce_inplace( VXC[i], nbf*nbf, ReductionOp::Sum );
+
+    this->reduction_driver_->allreduce_inplace( EXC,   nfunc, ReductionOp::Sum );
+    this->reduction_driver_->allreduce_inplace( &N_EL, 1,     ReductionOp::Sum );
+
+  });
+
+}
+
+} // namespace GauXC::detail
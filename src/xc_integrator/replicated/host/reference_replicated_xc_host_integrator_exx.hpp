@@ -12,7 +12,10 @@
 #include "integrator_util/integral_bounds.hpp"
 #include "integrator_util/exx_screening.hpp"
 #include "host/local_host_work_driver.hpp"
+#include "host/shell_pair_integral_dispatch.hpp"
 #include "host/blas.hpp"
+#include "xc_host_accumulator.hpp"
+#include "integrator_util/host_arena.hpp"
 #include <stdexcept>
 #include <set>
 
@@ -52,9 +55,45 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   // Get Tasks
   this->load_balancer_->get_tasks();
 
+  IntegratorSettingsSNLinK sn_link_settings;
+  if( auto* tmp = dynamic_cast<const IntegratorSettingsSNLinK*>(&settings) ) {
+    sn_link_settings = *tmp;
+  }
+
+  // Incremental builds: K(P) = K(P_prev) + K(P - P_prev). As sn-K screening
+  // is performed against |P|, the delta build prunes far more shell pairs
+  // as the density converges. The error of a delta build scales with the
+  // magnitude of its contribution, bounded by max|P - P_prev| * max V, fall
+  // back to a full build once the accumulated bound exceeds the threshold.
+  const bool incremental = sn_link_settings.incremental;
+  bool delta_build = incremental and not sn_link_settings.incremental_reset and
+    exx_state_.K.size() == size_t(nbf*nbf);
+
+  std::vector<value_type> delta_P;
+  double delta_bound = 0.;
+  if( delta_build ) {
+    delta_P.resize( nbf*nbf );
+    double delta_P_max = 0.;
+    for( auto j = 0; j < nbf; ++j )
+    for( auto i = 0; i < nbf; ++i ) {
+      delta_P[i + j*nbf] = P[i + j*ldp] - exx_state_.P[i + j*nbf];
+      delta_P_max = std::max( delta_P_max, std::abs(delta_P[i + j*nbf]) );
+    }
+
+    delta_bound = delta_P_max * exx_state_.V_max;
+    delta_build = exx_state_.accumulated_error + delta_bound <=
+      sn_link_settings.incremental_rebuild_tol;
+  }
+
+  // Set up the (possibly tuned) integral backend table collectively, such
+  // that all ranks select the same backends
+  ShellPairIntegralDispatch::instance( 
+    GAUXC_MPI_CODE(this->load_balancer_->runtime().comm()) );
+
   // Compute Local contributions to EXC / VXC
   this->timer_.time_op("XCIntegrator.LocalWork", [&](){
-    exx_local_work_( P, ldp, K, ldk, settings );
+    if( delta_build ) exx_local_work_( delta_P.data(), nbf, K, ldk, settings );
+    else              exx_local_work_( P, ldp, K, ldk, settings );
   });
 
   #ifdef GAUXC_HAS_MPI
@@ -73,6 +112,37 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
   });
 
+  // Update incremental state
+  if( incremental ) {
+    if( delta_build ) {
+      for( auto j = 0; j < nbf; ++j )
+      for( auto i = 0; i < nbf; ++i ) 
+        K[i + j*ldk] += exx_state_.K[i + j*nbf];
+      exx_state_.accumulated_error += delta_bound;
+    } else {
+      exx_state_.P.resize( nbf*nbf );
+      exx_state_.K.resize( nbf*nbf );
+      exx_state_.accumulated_error = 0.;
+
+      // The shell pairs are fixed by the load balancer, the bound is only
+      // evaluated once
+      if( exx_state_.V_max == 0. ) {
+        const auto V_max = exx_shell_pair_v_max( basis,
+          this->load_balancer_->shell_pairs() );
+        exx_state_.V_max = V_max.size() ?
+          *std::max_element( V_max.begin(), V_max.end() ) : 0.;
+      }
+    }
+
+    for( auto j = 0; j < nbf; ++j )
+    for( auto i = 0; i < nbf; ++i ) {
+      exx_state_.P[i + j*nbf] = P[i + j*ldp];
+      exx_state_.K[i + j*nbf] = K[i + j*ldk];
+    }
+  } else {
+    exx_state_ = exx_incremental_state();
+  }
+
 }
 
 
@@ -305,26 +375,8 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     K[i + j*ldk] = 0.;
 
    
-  // Compute V upper bounds per shell pair
-  const size_t nshells_bf = basis.size();
-  std::vector<double> V_max( nshells_bf * nshells_bf );
-  // Loop over sparse shell pairs
-  const auto sp_row_ptr = shpairs.row_ptr();
-  const auto sp_col_ind = shpairs.col_ind();
-  for( auto i = 0; i < nshells_bf; ++i ) {
-    const auto j_st = sp_row_ptr[i];
-    const auto j_en = sp_row_ptr[i+1];
-    for( auto _j = j_st; _j < j_en; ++_j ) {
-      const auto j = sp_col_ind[_j];
-      const auto mv = util::max_coulomb( basis.at(i), basis.at(j) );
-      V_max[i + j*nshells_bf] = mv;
-      if( i != j ) V_max[j + i*nshells_bf] = mv;
-    }
-  }
-
-  // Absolute value of P
-  std::vector<double> P_abs(nbf*nbf);
-  for( auto i = 0; i < nbf*nbf; ++i ) P_abs[i] = std::abs(P[i]);
+  // Compute V upper bounds per shell pair (on the shell pair CSR pattern)
+  const auto V_max = exx_shell_pair_v_max( basis, shpairs );
 
   // Full shell list
   std::vector<int32_t> full_shell_list_( basis.nshells() );
@@ -340,6 +392,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   const bool screen_ek = sn_link_settings.screen_ek;
   const double eps_K   = sn_link_settings.k_tol;
   const double eps_E   = sn_link_settings.energy_tol;
+  const double eps_pt  = sn_link_settings.pt_tol;
 
   int world_rank = 0;
   #ifdef GAUXC_HAS_MPI
@@ -358,8 +411,9 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   for(auto& task : tasks) task.cou_screening = XCTask::screening_data();
 
   // Precompute EK shell screening
-  exx_ek_screening( basis, basis_map, shpairs, P_abs.data(), nbf, V_max.data(), 
-    nshells_bf, eps_E, eps_K, lwd, tasks.begin(), tasks.end() );
+  exx_ek_screening( basis, basis_map, shpairs, P, ldp, V_max.data(), 
+    eps_E, eps_K, sn_link_settings.approx_f_p_tol, lwd, tasks.begin(), 
+    tasks.end() );
 
   // Allow for merging of tasks with different iParent
   for(auto& task : tasks) task.iParent = 0;
@@ -433,27 +487,52 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   const size_t ntasks = tasks.size();
   //std::cout << "NTASKS = " << ntasks << std::endl;
   //std::cout << "NTASKS NNZ = " << std::count_if(tasks.begin(),tasks.end(),[](const auto& t){ return t.cou_screening.shell_pair_list.size(); }) << std::endl;
+  // Thread-private packed K (K + K**T folded onto the lower triangle)
+  XCHostAccumulator<value_type> k_acc( 1, 
+    XCHostAccumulator<value_type>::packed_size(nbf) );
+  const bool use_k_acc = k_acc.enabled();
+
+  // Per-thread scratch, sized for the largest task: collocation and the
+  // Cartesian F / G matrices
+  size_t scratch_len = 0;
+  for( const auto& task : tasks ) {
+    const auto& bfn_shells = task.bfn_screening.shell_list;
+    const auto& ek_shells  = task.cou_screening.shell_list;
+    const size_t nbe_bfn = 
+      basis.nbf_subset( bfn_shells.begin(), bfn_shells.end() );
+    const size_t nbe_ek_cart = 
+      basis.nbf_cart_subset( ek_shells.begin(), ek_shells.end() );
+    scratch_len = std::max( scratch_len, 
+      task.points.size() * (nbe_bfn + 2 * nbe_ek_cart) );
+  }
+  const size_t scratch_bytes = sizeof(value_type) * scratch_len + 
+    3 * HostArena::alignment;
+
   #pragma omp parallel
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
-  std::vector<double> K_local(nbf*nbf,0.0);
+  auto& arena = HostArena::thread_arena(); // Thread local scratch
+  arena.reserve( scratch_bytes );
+  if( use_k_acc ) k_acc.zero_local();
+
+  // Submatrix maps, storage is reused by the tasks of the thread
+  LocalHostWorkDriver::submat_map_t ek_submat_map, submat_map_bfn;
 
   #pragma omp for schedule(dynamic)
   for( size_t iT = 0; iT < ntasks; ++iT ) {
 
-    //std::cout << iT << "/" << ntasks << std::endl;
     // Alias current task
     const auto& task = tasks[iT];
 
     // Early exit
-    auto ek_shell_list = task.cou_screening.shell_list;
+    const auto& ek_shell_list = task.cou_screening.shell_list;
     if( ek_shell_list.size() == 0 ) {
       continue;
     }
-    std::vector< std::array<int32_t,3> > ek_submat_map;
-    std::tie( ek_submat_map, std::ignore ) =
-      gen_compressed_submat_map( basis_map, ek_shell_list, nbf, nbf );
+    gen_compressed_submat_map( basis_map, ek_shell_list, ek_submat_map );
+
+    // Task scratch is released at the end of each iteration
+    HostArena::scope task_scope( arena );
 
     // Get tasks constants
     const int32_t  npts    = task.points.size();
@@ -462,75 +541,75 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     const auto* weights     = task.weights.data();
 
     // Basis function shell list
-    auto shell_list_bfn_ = task.bfn_screening.shell_list;
-    int32_t* shell_list_bfn = shell_list_bfn_.data();
-    size_t nshells_bfn = shell_list_bfn_.size();
-    size_t nbe_bfn     = 
-      basis.nbf_subset( shell_list_bfn_.begin(), shell_list_bfn_.end() );
-
-    std::vector< std::array<int32_t, 3> > submat_map_bfn;
-    std::tie(submat_map_bfn, std::ignore) =
-      gen_compressed_submat_map( basis_map, shell_list_bfn_, nbf, nbf );
-    
+    const auto& shell_list_bfn = task.bfn_screening.shell_list;
+    const size_t nshells_bfn = shell_list_bfn.size();
+    const size_t nbe_bfn     = 
+      basis.nbf_subset( shell_list_bfn.begin(), shell_list_bfn.end() );
 
+    gen_compressed_submat_map( basis_map, shell_list_bfn, submat_map_bfn );
 
     // Allocate data screening independent data
-    host_data.basis_eval.resize( npts * nbe_bfn );
-    host_data.nbe_scr   .resize( nbe_bfn * nbf );
-    auto* basis_eval = host_data.basis_eval.data();
-    auto* nbe_scr    = host_data.nbe_scr.data();
-
-
+    auto* basis_eval = arena.allocate<value_type>( npts * nbe_bfn );
 
     // Evaluate collocation B(mu,i)
     // mu ranges over the bfn shell list and i runs over all points
     lwd->eval_collocation( npts, nshells_bfn, nbe_bfn, points, basis, 
-      shell_list_bfn, basis_eval );
+      shell_list_bfn.data(), basis_eval );
 
     const auto nbe_ek = basis.nbf_subset( ek_shell_list.begin(), ek_shell_list.end() );
     const auto nshells_ek = ek_shell_list.size();
+    const auto nbe_ek_cart = 
+      basis.nbf_cart_subset( ek_shell_list.begin(), ek_shell_list.end() );
 
 
     // Allocate Screening Dependent Data
-    host_data.zmat.resize( npts * nbe_ek );
-    host_data.gmat.resize( npts * nbe_ek );
-    auto* zmat = host_data.zmat.data();
-    auto* gmat = host_data.gmat.data();
+    // F and G are kept in the Cartesian, row major layout of the integrals
+    auto* zmat = arena.allocate<value_type>( npts * nbe_ek_cart );
+    auto* gmat = arena.allocate<value_type>( npts * nbe_ek_cart );
 
     // Evaluate F(mu,i) = P(mu,nu) * B(nu,i)
-    // mu runs over significant ek shells
+    // mu runs over (Cartesian) significant ek shells
     // nu runs over the bfn shell list
     // i runs over all points
-    lwd->eval_exx_fmat( npts, nbf, nbe_ek, nbe_bfn, ek_submat_map,
-      submat_map_bfn, P, ldp, basis_eval, nbe_bfn, zmat, nbe_ek, nbe_scr );
-
-    // Get True Max F for shell pairs
-    //auto max_F = compute_true_f_max( npts, nshells_ek, nbe_ek, basis_map,
-    //  ek_shell_list, weights, zmat, nbe_ek );
-
+    lwd->eval_exx_fmat_cart( npts, nbf, nbe_ek, nbe_bfn, nshells_ek,
+      ek_shell_list.data(), basis, ek_submat_map, submat_map_bfn, P, ldp, 
+      basis_eval, nbe_bfn, zmat, npts );
 
     // Compute G(mu,i) = w(i) * A(mu,nu,i) * F(nu,i)
-    // mu/nu run over significant ek shells
+    // mu/nu run over (Cartesian) significant ek shells
     // i runs over all points
     const size_t nshell_pairs = task.cou_screening.shell_pair_list.size();
     const auto*  shell_pair_list = task.cou_screening.shell_pair_list.data();
-    lwd->eval_exx_gmat( npts, nshells_ek, nshell_pairs, nbe_ek, points, weights, 
-      basis, shpairs,basis_map, ek_shell_list.data(), shell_pair_list, zmat, 
-      nbe_ek, gmat, nbe_ek );
+    lwd->eval_exx_gmat_cart( npts, nshells_ek, nshell_pairs, points, weights, 
+      basis, shpairs, ek_shell_list.data(), shell_pair_list, zmat, npts, 
+      gmat, npts, eps_pt );
 
     // Increment K(mu,nu) += B(mu,i) * G(nu,i)
     // mu runs over bfn shell list
-    // nu runs over ek shells
+    // nu runs over ek shells, G is transformed from Cartesian after the
+    //    contraction over i
     // i runs over all points
-    lwd->inc_exx_k( npts, nbf, nbe_bfn, nbe_ek, basis_eval, submat_map_bfn,
-      ek_submat_map, gmat, nbe_ek, K, ldk, nbe_scr );
+    if( use_k_acc )
+      lwd->inc_exx_k_cart_packed( npts, nbf, nbe_bfn, nbe_ek, nshells_ek, 
+        ek_shell_list.data(), basis, basis_eval, submat_map_bfn, ek_submat_map,
+        gmat, npts, k_acc.local(0) );
+    else
+      lwd->inc_exx_k_cart( npts, nbf, nbe_bfn, nbe_ek, nshells_ek, 
+        ek_shell_list.data(), basis, basis_eval, submat_map_bfn, ek_submat_map,
+        gmat, npts, K, ldk );
 
   } // Loop over tasks 
 
+  // Reduce and symmetrize thread-private K
+  if( use_k_acc ) k_acc.reduce_packed( 0, nbf, K, ldk, 0.5 );
+
+  // Return the task scratch to the system
+  arena.shrink();
 
   } // End OpenMP region
 
   // Symmetrize K
+  if( not use_k_acc )
   for( auto j = 0; j < nbf; ++j ) 
   for( auto i = 0; i < j;   ++i ) {
     const auto K_ij = K[i + j*ldk];
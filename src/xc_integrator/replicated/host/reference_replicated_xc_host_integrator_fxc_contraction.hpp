@@ -0,0 +1,275 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include "reference_replicated_xc_host_integrator.hpp"
+#include "integrator_util/integrator_common.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "host/blas.hpp"
+#include "host/util.hpp"
+#include "xc_host_integrands.hpp"
+#include "xc_host_kernel_traits.hpp"
+#include "reference_replicated_xc_host_integrator_task_loop.hpp"
+#include "integrator_util/host_arena.hpp"
+#include <stdexcept>
+
+namespace GauXC::detail {
+
+/// RKS fxc contraction with a set of trial densities
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  eval_fxc_contraction_( int64_t m, int64_t n, const value_type* P,
+                         int64_t ldp, int64_t ntrial,
+                         const value_type* const* tP, int64_t ldtp,
+                         value_type* const* FXC, int64_t ldfxc,
+                         const IntegratorSettingsXC& ks_settings ) {
+
+  const auto& basis = this->load_balancer_->basis();
+
+  // Check that P / FXC are sane
+  const int64_t nbf = basis.nbf();
+  if( m != n )
+    GAUXC_GENERIC_EXCEPTION("P/FXC Must Be Square");
+  if( m != nbf )
+    GAUXC_GENERIC_EXCEPTION("P/FXC Must Have Same Dimension as Basis");
+  if( ldp < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDP");
+  if( ldtp < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDTP");
+  if( ldfxc < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDFXC");
+
+  if( this->func_->is_mgga() )
+    GAUXC_GENERIC_EXCEPTION("FXC Contraction Not Yet Implemented With MGGA Functionals!");
+
+  if( ntrial <= 0 ) return;
+
+  // Get Tasks
+  this->load_balancer_->get_tasks();
+
+  // Compute Local contributions to FXC
+  this->timer_.time_op("XCIntegrator.LocalWork", [&](){
+    dispatch_xc_host_kernel( XCSpin::RKS, *this->func_, [&]( auto traits ) {
+      using traits_type = decltype(traits);
+      if constexpr ( not traits_type::is_mgga )
+        this->template fxc_contraction_local_work_kernel_<traits_type>( P,
+          ldp, ntrial, tP, ldtp, FXC, ldfxc, ks_settings );
+    });
+  });
+
+  // Reduce Results
+  this->timer_.time_op("XCIntegrator.Allreduce", [&](){
+
+    if( not this->reduction_driver_->takes_host_memory() )
+      GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
+
+    for( int64_t i = 0; i < ntrial; ++i )
+      this->reduction_driver_->allreduce_inplace( FXC[i], nbf*nbf, ReductionOp::Sum );
+
+  });
+
+}
+
+/**
+ *  fxc contraction local work for a fixed functional family
+ *
+ *  The second derivatives of the functional are evaluated once per task
+ *  at the ground state density. The X matrices of all trial densities are
+ *  obtained from a single GEMM against the stacked compressed trial
+ *  densities, and each contracted kernel is accumulated with one syr2k
+ *  against the shared collocation.
+ */
+template <typename ValueType>
+template <typename KernelTraits>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  fxc_contraction_local_work_kernel_( const value_type* P, int64_t ldp,
+                                      int64_t ntrial,
+                                      const value_type* const* tP, int64_t ldtp,
+                                      value_type* const* FXC, int64_t ldfxc,
+                                      const IntegratorSettingsXC& settings ) {
+
+  constexpr int colloc_nblocks = KernelTraits::colloc_nblocks;
+  constexpr bool is_gga = KernelTraits::is_gga;
+
+  // Misc KS settings
+  IntegratorSettingsKS ks_settings;
+  if( auto* tmp = dynamic_cast<const IntegratorSettingsKS*>(&settings) ) {
+    ks_settings = *tmp;
+  }
+
+  // Cast LWD to LocalHostWorkDriver
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
+
+  // Setup Aliases
+  const auto& func  = *this->func_;
+  const auto& basis = this->load_balancer_->basis();
+
+  const int32_t nbf = basis.nbf();
+
+  // FXC integrands
+  std::vector<XCHostIntegrand<value_type>> fxc_list;
+  for( int64_t k = 0; k < ntrial; ++k ) fxc_list.push_back( {FXC[k], ldfxc} );
+  XCHostIntegrands<value_type> fxc( nbf, std::move(fxc_list) );
+
+  // Per-thread scratch, sized for the largest task: collocation (+ gau2grid
+  // transpose scratch), ground state / stacked trial X, Z, stacked
+  // compressed trial densities and per point quantities
+  const size_t lb_max_npts = this->load_balancer_->max_npts();
+  const size_t lb_max_nbe  = this->load_balancer_->max_nbe();
+  const size_t scratch_len =
+    (2 * colloc_nblocks + ntrial + 2) * this->load_balancer_->max_npts_x_nbe() +
+    (ntrial+1) * lb_max_nbe * lb_max_nbe + 32 * lb_max_npts;
+  const size_t scratch_bytes = sizeof(value_type) * scratch_len +
+    32 * HostArena::alignment;
+
+  auto& tasks = this->load_balancer_->get_tasks();
+  this->template host_task_loop_<KernelTraits>( basis, ks_settings,
+    tasks.begin(), tasks.end(), true, scratch_bytes, fxc,
+    [&]( HostArena& arena, auto&& for_each_task ) {
+
+  for_each_task( [&]( XCHostTaskData<value_type>& td ) {
+
+    const int32_t npts    = td.npts;
+    const int32_t nbe     = td.nbe;
+    const auto*   weights = td.weights;
+    const auto&   submat_map = td.submat_map;
+
+    // Stacked trial X matrices: rows [k*nbe, (k+1)*nbe) belong to tP[k]
+    const size_t ldx = ntrial * nbe;
+    auto* xmat       = arena.allocate<value_type>( npts * nbe );
+    auto* txmat      = arena.allocate<value_type>( npts * ldx );
+    auto* zmat       = arena.allocate<value_type>( npts * nbe );
+    auto* pstack_scr = arena.allocate<value_type>( ldx * nbe );
+    auto* nbe_scr    = arena.allocate<value_type>( nbe * nbe );
+
+    // Ground state density and functional derivatives
+    auto* den_eval = arena.allocate<value_type>( npts );
+    auto* v2rho2   = arena.allocate<value_type>( npts );
+
+    // Trial density and effective (contracted) potentials
+    auto* tden_eval = arena.allocate<value_type>( npts );
+    auto* veff_rho  = arena.allocate<value_type>( npts );
+
+    const auto* basis_eval    = td.basis_eval;
+    const auto* dbasis_x_eval = td.dbasis_x_eval;
+    const auto* dbasis_y_eval = td.dbasis_y_eval;
+    const auto* dbasis_z_eval = td.dbasis_z_eval;
+    value_type* dden_x_eval = nullptr;
+    value_type* dden_y_eval = nullptr;
+    value_type* dden_z_eval = nullptr;
+    value_type* gamma      = nullptr;
+    value_type* vrho       = nullptr;
+    value_type* vgamma     = nullptr;
+    value_type* v2rhosigma = nullptr;
+    value_type* v2sigma2   = nullptr;
+    value_type* tdden_x_eval = nullptr;
+    value_type* tdden_y_eval = nullptr;
+    value_type* tdden_z_eval = nullptr;
+    value_type* tgamma       = nullptr;
+    value_type* veff_x       = nullptr;
+    value_type* veff_y       = nullptr;
+    value_type* veff_z       = nullptr;
+    value_type* unit         = nullptr;
+
+    if( is_gga ) {
+      dden_x_eval   = arena.allocate<value_type>( 3 * npts );
+      dden_y_eval   = dden_x_eval + npts;
+      dden_z_eval   = dden_y_eval + npts;
+      gamma         = arena.allocate<value_type>( npts );
+      vrho          = arena.allocate<value_type>( npts );
+      vgamma        = arena.allocate<value_type>( npts );
+      v2rhosigma    = arena.allocate<value_type>( npts );
+      v2sigma2      = arena.allocate<value_type>( npts );
+      tdden_x_eval  = arena.allocate<value_type>( 3 * npts );
+      tdden_y_eval  = tdden_x_eval + npts;
+      tdden_z_eval  = tdden_y_eval + npts;
+      tgamma        = arena.allocate<value_type>( npts );
+      veff_x        = arena.allocate<value_type>( 3 * npts );
+      veff_y        = veff_x + npts;
+      veff_z        = veff_y + npts;
+
+      // The GGA Z matrix kernel forms 2 * vgamma * (veff . grad B), the
+      // effective gradient term is folded into veff such that vgamma = 1
+      unit = arena.allocate<value_type>( npts );
+      std::fill_n( unit, npts, 1. );
+    }
+
+    // Ground state X matrix (2 * P * B) and all trial X matrices
+    // (2 * tP[k] * B) with a single GEMM
+    lwd->eval_xmat( npts, nbf, nbe, submat_map, 2.0, P, ldp, basis_eval, nbe,
+      xmat, nbe, nbe_scr );
+    lwd->eval_xmat_stacked( npts, nbf, nbe, submat_map, 2.0, ntrial, tP, ldtp,
+      basis_eval, nbe, txmat, ldx, pstack_scr );
+
+    // Ground state density variables and second functional derivatives
+    if( is_gga ) {
+      lwd->eval_uvvar_gga_rks( npts, nbe, basis_eval, dbasis_x_eval,
+        dbasis_y_eval, dbasis_z_eval, xmat, nbe, den_eval, dden_x_eval,
+        dden_y_eval, dden_z_eval, gamma );
+      func.eval_vxc_fxc( npts, den_eval, gamma, vrho, vgamma, v2rho2,
+        v2rhosigma, v2sigma2 );
+    } else {
+      lwd->eval_uvvar_lda_rks( npts, nbe, basis_eval, xmat, nbe, den_eval );
+      func.eval_fxc( npts, den_eval, v2rho2 );
+    }
+
+    for( int64_t k = 0; k < ntrial; ++k ) {
+
+      const auto* txmat_k = txmat + k * nbe;
+
+      // Contract the kernel with the trial density variables
+      if( is_gga ) {
+
+        lwd->eval_uvvar_gga_rks( npts, nbe, basis_eval, dbasis_x_eval,
+          dbasis_y_eval, dbasis_z_eval, txmat_k, ldx, tden_eval, tdden_x_eval,
+          tdden_y_eval, tdden_z_eval, tgamma );
+
+        for( int32_t i = 0; i < npts; ++i ) {
+          const auto w = weights[i];
+          const auto tsigma = 2. * ( dden_x_eval[i] * tdden_x_eval[i] +
+                                     dden_y_eval[i] * tdden_y_eval[i] +
+                                     dden_z_eval[i] * tdden_z_eval[i] );
+          const auto vg = w * ( v2rhosigma[i] * tden_eval[i] +
+                                v2sigma2[i]   * tsigma );
+          const auto wvgamma = w * vgamma[i];
+          veff_rho[i] = w * ( v2rho2[i] * tden_eval[i] + v2rhosigma[i] * tsigma );
+          veff_x[i]   = vg * dden_x_eval[i] + wvgamma * tdden_x_eval[i];
+          veff_y[i]   = vg * dden_y_eval[i] + wvgamma * tdden_y_eval[i];
+          veff_z[i]   = vg * dden_z_eval[i] + wvgamma * tdden_z_eval[i];
+        }
+
+        lwd->eval_zmat_gga_vxc_rks( npts, nbe, veff_rho, unit, basis_eval,
+          dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, veff_x, veff_y, veff_z,
+          zmat, nbe );
+
+      } else {
+
+        lwd->eval_uvvar_lda_rks( npts, nbe, basis_eval, txmat_k, ldx,
+          tden_eval );
+        for( int32_t i = 0; i < npts; ++i )
+          veff_rho[i] = weights[i] * v2rho2[i] * tden_eval[i];
+
+        lwd->eval_zmat_lda_vxc_rks( npts, nbe, veff_rho, basis_eval, zmat, nbe );
+
+      }
+
+      // Increment LT of FXC
+      fxc.inc_vxc( lwd, k, npts, nbe, basis_eval, submat_map, zmat, nbe,
+        nbe_scr );
+
+    } // Loop over trial densities
+
+    return false;
+
+  }); // Loop over tasks
+
+  }); // Task loop
+
+}
+
+} // namespace GauXC::detail
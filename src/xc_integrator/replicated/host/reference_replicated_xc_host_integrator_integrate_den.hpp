@@ -10,6 +10,7 @@
 #include "reference_replicated_xc_host_integrator.hpp"
 #include "integrator_util/integrator_common.hpp"
 #include "host/local_host_work_driver.hpp"
+#include "integrator_util/host_arena.hpp"
 #include <stdexcept>
 
 namespace GauXC::detail {
@@ -86,6 +87,15 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   }
 
 
+  // Per-thread scratch, sized for the largest task: collocation (+ gau2grid
+  // transpose scratch), X and per point quantities
+  const size_t lb_max_npts = this->load_balancer_->max_npts();
+  const size_t lb_max_nbe  = this->load_balancer_->max_nbe();
+  const size_t scratch_len = 3 * this->load_balancer_->max_npts_x_nbe() +
+    lb_max_nbe * lb_max_nbe + lb_max_npts;
+  const size_t scratch_bytes = sizeof(value_type) * scratch_len +
+    8 * HostArena::alignment;
+
   // Loop over tasks
   const size_t ntasks = tasks.size();
   double N_EL_WORK = 0.0;
@@ -93,7 +103,8 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   #pragma omp parallel
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
+  auto& arena = HostArena::thread_arena(); // Thread local scratch
+  arena.reserve( scratch_bytes );
   double N_EL_LOCAL = 0.;
 
   #pragma omp for schedule(dynamic)
@@ -112,20 +123,14 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     const auto* weights     = task.weights.data();
     const int32_t* shell_list = task.bfn_screening.shell_list.data();
 
-    // Allocate enough memory for batch
-
-    host_data.nbe_scr .resize( nbe * nbe  );
-    host_data.zmat    .resize( npts * nbe );
-
-    host_data.basis_eval .resize( npts * nbe );
-    host_data.den_scr    .resize( npts );
+    // Task scratch is released at the end of each iteration
+    HostArena::scope task_scope( arena );
 
-
-    // Alias/Partition out scratch memory
-    auto* basis_eval = host_data.basis_eval.data();
-    auto* den_eval   = host_data.den_scr.data();
-    auto* nbe_scr    = host_data.nbe_scr.data();
-    auto* zmat       = host_data.zmat.data();
+    // Partition out scratch memory
+    auto* basis_eval = arena.allocate<value_type>( npts * nbe );
+    auto* den_eval   = arena.allocate<value_type>( npts );
+    auto* nbe_scr    = arena.allocate<value_type>( nbe * nbe );
+    auto* zmat       = arena.allocate<value_type>( npts * nbe );
 
 
     // Get the submatrix map for batch
@@ -156,6 +161,9 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   #pragma omp atomic 
   N_EL_WORK += N_EL_LOCAL;
 
+  // Return the task scratch to the system
+  arena.shrink();
+
   } // End OpenMP region
 
   // Commit return value
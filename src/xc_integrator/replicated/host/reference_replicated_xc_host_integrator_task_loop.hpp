@@ -0,0 +1,289 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include "reference_replicated_xc_host_integrator.hpp"
+#include "integrator_util/integrator_common.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "xc_host_integrands.hpp"
+#include "xc_host_kernel_traits.hpp"
+#include "integrator_util/host_arena.hpp"
+#include "integrator_util/primitive_screening.hpp"
+#include <optional>
+#include <stdexcept>
+
+namespace GauXC::detail {
+
+/// Task of the host task loop as seen by the stage callback
+template <typename F>
+struct XCHostTaskData {
+  const XCTask&     task;
+  HostArena::marker mark;    ///< Arena state before any scratch of the task
+  int32_t npts, nbe, nshells;
+  const double* points;
+  const double* weights;
+  const std::vector<int32_t>& shells; ///< Shells of the (screened) task
+  LocalHostWorkDriver::submat_map_t submat_map;
+  F* basis_eval;    ///< Collocation (null if not evaluated)
+  F* dbasis_x_eval;
+  F* dbasis_y_eval;
+  F* dbasis_z_eval;
+  F* lbasis_eval;
+};
+
+/**
+ *  Generic host task loop shared by the EXC/VXC type integrands
+ *
+ *  Owns everything that does not depend on the quantity being integrated:
+ *  task ordering, the per-thread HostArena, primitive screening, the
+ *  compressed submatrix maps, collocation (and the collocation cache) and
+ *  the thread-private accumulation / reduction of the symmetric integrands.
+ *
+ *  thread_func( arena, for_each_task ) is invoked once by every thread of
+ *  the parallel region, thread-local state (scalar integrals, staging
+ *  buffers) lives in its scope. It must call for_each_task( stage ) exactly
+ *  once, stage( XCHostTaskData& ) is then invoked for each task assigned to
+ *  the thread. The task scratch (including collocation) is released after
+ *  stage returns unless it returns true, in which case it is kept until the
+ *  stage releases it (e.g. to evaluate the functional over several tasks).
+ *
+ *  @param[in] basis            Basis set of the tasks
+ *  @param[in] ks_settings      Screening / collocation cache settings
+ *  @param[in] task_begin       Start of the task range
+ *  @param[in] task_end         End of the task range
+ *  @param[in] eval_collocation Whether to evaluate the collocation
+ *                              (colloc_nderiv of KernelTraits)
+ *  @param[in] arena_bytes      Per-thread scratch to reserve
+ *  @param[in/out] integrands   Integrands (zeroed, reduced and symmetrized)
+ *  @param[in] thread_func      Per-thread callback
+ */
+template <typename ValueType>
+template <typename KernelTraits, typename ThreadFunc>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  host_task_loop_( const basis_type& basis,
+                   const IntegratorSettingsKS& ks_settings,
+                   task_iterator task_begin, task_iterator task_end,
+                   bool eval_collocation, size_t arena_bytes,
+                   XCHostIntegrands<value_type>& integrands,
+                   ThreadFunc&& thread_func ) {
+
+  constexpr bool is_gga  = KernelTraits::is_gga;
+  constexpr bool is_mgga = KernelTraits::is_mgga;
+  constexpr bool needs_laplacian = KernelTraits::needs_laplacian;
+
+  // Collocation derivative order (and number of stored blocks)
+  constexpr int colloc_nderiv  = KernelTraits::colloc_nderiv;
+  constexpr int colloc_nblocks = KernelTraits::colloc_nblocks;
+
+  // Cast LWD to LocalHostWorkDriver
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
+
+  // Setup Aliases
+  const auto& mol = this->load_balancer_->molecule();
+
+  // Get basis map
+  BasisSetMap basis_map(basis,mol);
+
+  const int32_t nbf = basis.nbf();
+
+  // Primitive screening of the collocation, shells without significant
+  // primitives are removed from the packed basis functions of a task
+  const bool use_prim_screen = ks_settings.prim_screen_tol > 0.;
+
+  // Collocation cache, only valid for the basis of the load balancer (and
+  // the shell lists produced by its screening)
+  CollocationCache* colloc_cache = nullptr;
+  if( eval_collocation and ks_settings.collocation_cache_bytes and
+      not use_prim_screen and &basis == &this->load_balancer_->basis() ) {
+    if( not collocation_cache_ or not collocation_cache_->has_config(
+          ks_settings.collocation_cache_bytes,
+          ks_settings.collocation_cache_spill_file,
+          ks_settings.collocation_cache_spill_bytes ) ) {
+      // Release the previous cache (and its spill file) first
+      collocation_cache_.reset();
+      collocation_cache_ = std::make_unique<CollocationCache>(
+        ks_settings.collocation_cache_bytes,
+        ks_settings.collocation_cache_spill_file,
+        ks_settings.collocation_cache_spill_bytes );
+    }
+    colloc_cache = collocation_cache_.get();
+  }
+
+  // Sort tasks on size, the dynamic schedule then ends on the small tasks
+  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
+    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
+  };
+  std::sort( task_begin, task_end, task_comparator );
+
+  // Check that Partition Weights have been calculated
+  auto& lb_state = this->load_balancer_->state();
+  if( not lb_state.modified_weights_are_stored ) {
+    GAUXC_GENERIC_EXCEPTION("Weights Have Not Been Modified");
+  }
+
+  // Zero out integrands
+  integrands.zero();
+
+  const size_t ntasks = std::distance(task_begin, task_end);
+
+  #pragma omp parallel
+  {
+
+  auto& arena = HostArena::thread_arena(); // Thread local scratch
+  arena.reserve( arena_bytes );
+  integrands.zero_local();
+
+  auto for_each_task = [&]( auto&& stage ) {
+
+    #pragma omp for schedule(dynamic) nowait
+    for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+      // Alias current task
+      const auto& task = *(task_begin + iT);
+
+      const int32_t npts   = task.points.size();
+      const auto*   points = task.points.data()->data();
+
+      // Screen primitives over the task
+      std::optional<PrimitiveScreening> prim_screen;
+      if( use_prim_screen ) {
+        prim_screen.emplace( basis, task.bfn_screening.shell_list, npts,
+          points, ks_settings.prim_screen_tol, colloc_nderiv );
+        if( not prim_screen->nshells() ) continue;
+      }
+
+      // Get tasks constants
+      const auto& task_shells = prim_screen ? prim_screen->shell_list() :
+        task.bfn_screening.shell_list;
+      const int32_t nbe = prim_screen ? prim_screen->nbe() :
+        task.bfn_screening.nbe;
+      const int32_t  nshells    = task_shells.size();
+      const int32_t* shell_list = task_shells.data();
+
+      XCHostTaskData<value_type> td{ task, arena.mark(), npts, nbe, nshells,
+        points, task.weights.data(), task_shells, {},
+        nullptr, nullptr, nullptr, nullptr, nullptr };
+
+      // Get the submatrix map for batch
+      std::tie(td.submat_map, std::ignore) =
+            gen_compressed_submat_map(basis_map, task_shells, nbf, nbf);
+
+      if( eval_collocation ) {
+
+      auto* basis_eval = arena.allocate<value_type>( colloc_nblocks * npts * nbe );
+      value_type* dbasis_x_eval = nullptr;
+      value_type* dbasis_y_eval = nullptr;
+      value_type* dbasis_z_eval = nullptr;
+      value_type* lbasis_eval   = nullptr;
+      if( is_gga or is_mgga ) {
+        dbasis_x_eval = basis_eval    + npts * nbe;
+        dbasis_y_eval = dbasis_x_eval + npts * nbe;
+        dbasis_z_eval = dbasis_y_eval + npts * nbe;
+      }
+      if( needs_laplacian ) lbasis_eval = dbasis_z_eval + npts * nbe;
+
+      td.basis_eval    = basis_eval;
+      td.dbasis_x_eval = dbasis_x_eval;
+      td.dbasis_y_eval = dbasis_y_eval;
+      td.dbasis_z_eval = dbasis_z_eval;
+      td.lbasis_eval   = lbasis_eval;
+
+      // Lookup cached collocation
+      const size_t colloc_len = size_t(colloc_nblocks) * npts * nbe;
+      CollocationCache::data_ptr cached_colloc;
+      if( colloc_cache ) cached_colloc = colloc_cache->lookup( task, colloc_nderiv );
+
+      if( cached_colloc ) {
+        std::copy_n( cached_colloc.get(), colloc_len, basis_eval );
+        cached_colloc.reset();
+      } else {
+
+      // Evaluate Collocation (+ Grad and Laplacian) of the retained primitives
+      if( prim_screen ) {
+        if( needs_laplacian )
+          lwd->eval_collocation_laplacian_screened( npts, points, basis,
+            *prim_screen, basis_eval, dbasis_x_eval, dbasis_y_eval,
+            dbasis_z_eval, lbasis_eval );
+        else if( is_gga or is_mgga )
+          lwd->eval_collocation_gradient_screened( npts, points, basis,
+            *prim_screen, basis_eval, dbasis_x_eval, dbasis_y_eval,
+            dbasis_z_eval );
+        else
+          lwd->eval_collocation_screened( npts, points, basis, *prim_screen,
+            basis_eval );
+      }
+      // Evaluate Collocation (+ Grad and Laplacian)
+      else if( is_mgga ) {
+        if ( needs_laplacian ) {
+          lwd->eval_collocation_laplacian( npts, nshells, nbe, points, basis, shell_list,
+            basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval );
+        } else {
+          lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
+            basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+        }
+      }
+      // Evaluate Collocation (+ Grad), reusing radial factors of shells
+      // centered on the parent atom when the task stems from an atomic grid
+      else if( task.iParent >= 0 ) {
+        const auto& parent = mol[task.iParent];
+        const double center[3] = { parent.x, parent.y, parent.z };
+        if( is_gga )
+          lwd->eval_collocation_gradient_atomic( npts, nshells, nbe, points, basis,
+            shell_list, center, basis_eval, dbasis_x_eval, dbasis_y_eval,
+            dbasis_z_eval );
+        else
+          lwd->eval_collocation_atomic( npts, nshells, nbe, points, basis,
+            shell_list, center, basis_eval );
+      }
+      else if( is_gga )
+        lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
+          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+      else
+        lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list,
+          basis_eval );
+
+      // Offer collocation to the cache, the benefit is estimated by the
+      // number of primitive + angular evaluations it replaces
+      if( colloc_cache ) {
+        double benefit = 0.;
+        for( auto ish : task_shells ) {
+          benefit += basis.at(ish).nprim() + basis.at(ish).size();
+        }
+        benefit *= double(npts) * colloc_nblocks;
+        if( colloc_cache->admits( colloc_len, benefit ) )
+          colloc_cache->insert( task, colloc_nderiv, colloc_len, basis_eval, benefit );
+      }
+
+      } // Collocation
+
+      } // eval_collocation
+
+      if( not stage( td ) ) arena.release( td.mark );
+
+    } // Loop over tasks
+
+  };
+
+  thread_func( arena, for_each_task );
+
+  // All increments have to be complete before the reduction
+  #pragma omp barrier
+
+  // Reduce thread-private integrands (also symmetrizes)
+  integrands.reduce();
+
+  // Return the task scratch to the system
+  arena.shrink();
+
+  } // End OpenMP region
+
+  integrands.symmetrize();
+
+}
+
+} // namespace GauXC::detail
@@ -0,0 +1,187 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+
+#include <gauxc/gauxc_config.hpp>
+#include "host/util.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace GauXC {
+
+/**
+ *  Thread-private accumulation buffers for host integrands
+ *
+ *  Each OpenMP thread owns a private copy of every accumulated quantity
+ *  which it may increment without synchronization. The private copies are
+ *  merged with a pairwise (tree) reduction which is itself distributed
+ *  over the threads of the enclosing parallel region.
+ *
+ *  Symmetric matrices (VXC, K) are stored in packed lower triangular
+ *  format (column major, diagonal included) to halve the per-thread
+ *  footprint. If the total footprint exceeds the memory budget, the
+ *  accumulator is disabled and callers are expected to fall back to
+ *  atomic updates of the shared result.
+ */
+template <typename F>
+class XCHostAccumulator {
+
+  size_t nthreads_ = 1; ///< Number of thread-private copies
+  size_t nmat_     = 0; ///< Number of accumulated quantities
+  size_t len_      = 0; ///< Length of each accumulated quantity
+  std::unique_ptr<F[]> data_; ///< Storage (nthreads_ x nmat_ x len_)
+
+  inline static size_t max_threads() {
+    #ifdef _OPENMP
+    return omp_get_max_threads();
+    #else
+    return 1;
+    #endif
+  }
+
+  inline static size_t thread_id() {
+    #ifdef _OPENMP
+    return omp_get_thread_num();
+    #else
+    return 0;
+    #endif
+  }
+
+  inline static size_t num_active_threads() {
+    #ifdef _OPENMP
+    return omp_get_num_threads();
+    #else
+    return 1;
+    #endif
+  }
+
+  inline F* thread_buffer( size_t ithread, size_t imat ) {
+    return data_.get() + (ithread * nmat_ + imat) * len_;
+  }
+
+  /// Sum [st,en) of the thread-private copies of imat into the first copy
+  void tree_reduce( size_t imat, size_t st, size_t en ) {
+    for( size_t stride = 1; stride < nthreads_; stride *= 2 )
+    for( size_t t = 0; t + stride < nthreads_; t += 2*stride ) {
+      auto* dst = thread_buffer(t,        imat);
+      auto* src = thread_buffer(t+stride, imat);
+      for( size_t i = st; i < en; ++i ) dst[i] += src[i];
+    }
+  }
+
+public:
+
+  /// Default memory budget (bytes) for all thread-private copies
+  static constexpr size_t default_max_bytes = size_t(4) << 30;
+
+  /// Number of elements in a packed lower triangle of order n
+  inline static constexpr size_t packed_size( size_t n ) {
+    return n * (n+1) / 2;
+  }
+
+  /**
+   *  Construct an accumulator for nmat quantities of length len
+   *
+   *  Must be called outside of an OpenMP parallel region.
+   *
+   *  @param[in] nmat      Number of quantities to accumulate
+   *  @param[in] len       Length of each quantity
+   *  @param[in] max_bytes Memory budget for all thread-private copies
+   */
+  XCHostAccumulator( size_t nmat, size_t len,
+    size_t max_bytes = default_max_bytes ) :
+    nthreads_(max_threads()), nmat_(nmat), len_(len) {
+
+    const size_t nbytes = nthreads_ * nmat_ * len_ * sizeof(F);
+    // Storage is left uninitialized so that each thread may first-touch
+    // its own copy in zero_local
+    if( nbytes and nbytes <= max_bytes )
+      data_ = std::unique_ptr<F[]>( new F[nthreads_ * nmat_ * len_] );
+
+  }
+
+  /// Whether thread-private accumulation is available
+  inline bool enabled() const { return data_ != nullptr; }
+
+  /// Zero the calling thread's copies (call once per thread in the region)
+  void zero_local() {
+    const size_t tid = thread_id();
+    // Threads which do not participate in the region must still be zeroed
+    if( tid == 0 )
+    for( size_t t = std::max<size_t>(1, num_active_threads()); t < nthreads_; ++t )
+      std::fill_n( thread_buffer(t,0), nmat_ * len_, F(0.) );
+    std::fill_n( thread_buffer(tid,0), nmat_ * len_, F(0.) );
+  }
+
+  /// Calling thread's private copy of quantity imat
+  inline F* local( size_t imat ) { return thread_buffer(thread_id(), imat); }
+
+  /**
+   *  Reduce quantity imat and write the result to A
+   *
+   *  Must be encountered by all threads of the enclosing parallel region
+   *  (orphaned worksharing construct). An implicit barrier separates the
+   *  reduction from any following work.
+   */
+  void reduce( size_t imat, F* A ) {
+    constexpr size_t block = 4096;
+    const size_t nblocks = (len_ + block - 1) / block;
+    #ifdef _OPENMP
+    #pragma omp for schedule(static)
+    #endif
+    for( size_t ib = 0; ib < nblocks; ++ib ) {
+      const size_t st = ib * block;
+      const size_t en = std::min( len_, st + block );
+      tree_reduce( imat, st, en );
+      const auto* R = thread_buffer(0, imat);
+      for( size_t i = st; i < en; ++i ) A[i] = R[i];
+    }
+  }
+
+  /**
+   *  Reduce packed lower triangular quantity imat into a full matrix
+   *
+   *  A(i,j) = A(j,i) = scal * R(i,j) for i > j, A(i,i) = R(i,i).
+   *
+   *  scal = 1 unpacks a symmetric matrix (VXC), scal = 0.5 symmetrizes
+   *  a matrix whose transpose has been folded into the lower triangle (K).
+   *
+   *  Same calling requirements as reduce.
+   *
+   *  @param[in]  imat Index of the quantity to reduce
+   *  @param[in]  n    Order of the matrix (len = packed_size(n))
+   *  @param[out] A    Full (n,n) matrix, col major
+   *  @param[in]  lda  Leading dimension of A
+   *  @param[in]  scal Scaling factor for off-diagonal elements
+   */
+  void reduce_packed( size_t imat, size_t n, F* A, size_t lda, F scal = 1. ) {
+    #ifdef _OPENMP
+    #pragma omp for schedule(dynamic)
+    #endif
+    for( size_t j = 0; j < n; ++j ) {
+      const size_t st = detail::packed_lower_index(j, j, n);
+      tree_reduce( imat, st, st + n - j );
+      const auto* R = thread_buffer(0, imat) + st;
+      A[j + j*lda] = R[0];
+      for( size_t i = j+1; i < n; ++i ) {
+        const auto r = scal * R[i-j];
+        A[i + j*lda] = r;
+        A[j + i*lda] = r;
+      }
+    }
+  }
+
+};
+
+}
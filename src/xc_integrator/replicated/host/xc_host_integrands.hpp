@@ -0,0 +1,117 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include "xc_host_accumulator.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "host/util.hpp"
+
+namespace GauXC {
+
+/// Full (nbf,nbf) integrand matrix (col major)
+template <typename F>
+struct XCHostIntegrand {
+  F*      A;   ///< Integrand
+  int64_t lda; ///< Leading dimension of A
+};
+
+/**
+ *  Symmetric integrands (VXC, FXC) of a host task loop
+ *
+ *  Task increments go to thread-private packed lower triangles if the
+ *  XCHostAccumulator fits its memory budget, and are otherwise added
+ *  atomically to the lower triangle of the shared integrands. Either way
+ *  the full, symmetric integrands are obtained after reduce / symmetrize.
+ */
+template <typename F>
+class XCHostIntegrands {
+
+  using submat_map_t = LocalHostWorkDriver::submat_map_t;
+
+  size_t nbf_;
+  std::vector<XCHostIntegrand<F>> A_;
+  XCHostAccumulator<F> acc_;
+
+public:
+
+  /**
+   *  Construct the integrand set, must be called outside of an OpenMP
+   *  parallel region.
+   *
+   *  @param[in] nbf       Order of the integrands
+   *  @param[in] A         Integrands, may be empty (e.g. EXC only)
+   *  @param[in] max_bytes Memory budget for all thread-private copies
+   */
+  XCHostIntegrands( size_t nbf, std::vector<XCHostIntegrand<F>> A,
+    size_t max_bytes = XCHostAccumulator<F>::default_max_bytes ) :
+    nbf_(nbf), A_(std::move(A)),
+    acc_( A_.size(), XCHostAccumulator<F>::packed_size(nbf), max_bytes ) { }
+
+  /// Number of integrands
+  inline size_t size() const { return A_.size(); }
+
+  /// Whether increments are accumulated in thread-private storage
+  inline bool packed() const { return acc_.enabled(); }
+
+  /// Zero the shared integrands (outside of the parallel region)
+  void zero() {
+    for( auto& a : A_ )
+    for( size_t j = 0; j < nbf_; ++j )
+    for( size_t i = 0; i < nbf_; ++i ) a.A[i + j*a.lda] = 0.;
+  }
+
+  /// Zero the calling thread's copies (once per thread in the region)
+  void zero_local() { if( packed() ) acc_.zero_local(); }
+
+  /// Increment integrand imat by the (nbe,nbe) task contribution B**H * Z
+  /// + Z**H * B (see LocalHostWorkDriver::inc_vxc)
+  void inc_vxc( LocalHostWorkDriver* lwd, size_t imat, size_t npts,
+    size_t nbe, const F* basis_eval, const submat_map_t& submat_map,
+    const F* Z, size_t ldz, F* nbe_scr ) {
+    if( packed() )
+      lwd->inc_vxc_packed( npts, nbf_, nbe, basis_eval, submat_map, Z, ldz,
+        acc_.local(imat), nbe_scr );
+    else
+      lwd->inc_vxc( npts, nbf_, nbe, basis_eval, submat_map, Z, ldz,
+        A_[imat].A, A_[imat].lda, nbe_scr );
+  }
+
+  /// Increment integrand imat by a compressed, symmetric (nbe,nbe) matrix
+  void inc_submat( size_t imat, size_t nbe, const F* B, size_t ldb,
+    const submat_map_t& submat_map ) {
+    if( packed() )
+      detail::inc_by_submat_packed_lower( nbf_, nbe, acc_.local(imat), B, ldb,
+        submat_map );
+    else
+      detail::inc_by_submat_atomic( nbf_, nbf_, nbe, nbe, A_[imat].A,
+        A_[imat].lda, B, ldb, submat_map );
+  }
+
+  /**
+   *  Reduce the thread-private copies into the (full) integrands
+   *
+   *  Must be encountered by all threads of the enclosing parallel region
+   *  once all increments are done, see XCHostAccumulator::reduce_packed.
+   */
+  void reduce() {
+    if( packed() )
+    for( size_t imat = 0; imat < A_.size(); ++imat )
+      acc_.reduce_packed( imat, nbf_, A_[imat].A, A_[imat].lda );
+  }
+
+  /// Fill the upper triangles of atomically accumulated integrands
+  /// (outside of the parallel region)
+  void symmetrize() {
+    if( not packed() )
+    for( auto& a : A_ )
+    for( size_t j = 0;   j < nbf_; ++j )
+    for( size_t i = j+1; i < nbf_; ++i ) a.A[j + i*a.lda] = a.A[i + j*a.lda];
+  }
+
+};
+
+}
@@ -0,0 +1,101 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <gauxc/exceptions.hpp>
+#include <cstddef>
+#include <type_traits>
+
+namespace GauXC::detail {
+
+/// Spin treatment of a host task kernel
+enum class XCSpin { RKS, UKS, GKS };
+
+/// Functional family of a host task kernel
+enum class XCFamily { LDA, GGA, MGGA };
+
+/**
+ *  Compile time description of a host task kernel
+ *
+ *  Host integrator task bodies are instantiated once per (spin, family)
+ *  such that the branches on the character of the calculation and the
+ *  strides of the per point quantities are resolved at compile time.
+ */
+template <XCSpin Spin, XCFamily Family, bool Laplacian = false>
+struct XCHostKernelTraits {
+
+  static constexpr XCSpin   spin   = Spin;
+  static constexpr XCFamily family = Family;
+
+  static constexpr bool is_rks = Spin == XCSpin::RKS;
+  static constexpr bool is_uks = Spin == XCSpin::UKS;
+  static constexpr bool is_gks = Spin == XCSpin::GKS;
+
+  static constexpr bool is_lda  = Family == XCFamily::LDA;
+  static constexpr bool is_gga  = Family == XCFamily::GGA;
+  static constexpr bool is_mgga = Family == XCFamily::MGGA;
+  static constexpr bool needs_laplacian = is_mgga and Laplacian;
+
+  static_assert( not (is_gks and is_mgga), "GKS MGGA Kernels Not Supported" );
+
+  /// Number of density matrices (and Z matrices)
+  static constexpr size_t spin_dim_scal = is_rks ? 1 : is_uks ? 2 : 4;
+  /// Number of spin densities seen by the functional
+  static constexpr size_t sds           = is_rks ? 1 : 2;
+  /// Number of Z matrix blocks per density matrix
+  static constexpr size_t mgga_dim_scal = is_mgga ? 4 : 1;
+  /// Number of gamma components per point
+  static constexpr size_t gga_dim_scal  = is_rks ? 1 : 3;
+  /// Density + gradient blocks per spin
+  static constexpr size_t den_dim_scal  = is_lda ? 1 : 4;
+
+  /// Collocation derivative order (and number of stored blocks)
+  ///   0: basis, 1: basis + gradient, 2: basis + gradient + laplacian
+  static constexpr int colloc_nderiv  = needs_laplacian ? 2 : is_lda ? 0 : 1;
+  static constexpr int colloc_nblocks = colloc_nderiv == 2 ? 5 :
+                                        colloc_nderiv == 1 ? 4 : 1;
+
+};
+
+/**
+ *  Invoke a generic callable with the kernel traits matching the runtime
+ *  character of a calculation, i.e. f( XCHostKernelTraits<...>{} ).
+ *
+ *  @param[in] spin Spin treatment of the calculation
+ *  @param[in] func Functional (is_gga/is_mgga/needs_laplacian)
+ *  @param[in] f    Callable to invoke
+ */
+template <typename FunctionalType, typename Functor>
+void dispatch_xc_host_kernel( XCSpin spin, const FunctionalType& func,
+  Functor&& f ) {
+
+  auto dispatch_family = [&]( auto spin_tag ) {
+    constexpr XCSpin S = decltype(spin_tag)::value;
+    if( func.is_mgga() ) {
+      if constexpr ( S == XCSpin::GKS )
+        GAUXC_GENERIC_EXCEPTION("GKS Not Yet Implemented With MGGA Functionals!");
+      else if( func.needs_laplacian() )
+        f( XCHostKernelTraits<S, XCFamily::MGGA, true>{} );
+      else
+        f( XCHostKernelTraits<S, XCFamily::MGGA, false>{} );
+    }
+    else if( func.is_gga() ) f( XCHostKernelTraits<S, XCFamily::GGA>{} );
+    else                     f( XCHostKernelTraits<S, XCFamily::LDA>{} );
+  };
+
+  switch( spin ) {
+    case XCSpin::RKS:
+      dispatch_family( std::integral_constant<XCSpin, XCSpin::RKS>{} ); break;
+    case XCSpin::UKS:
+      dispatch_family( std::integral_constant<XCSpin, XCSpin::UKS>{} ); break;
+    case XCSpin::GKS:
+      dispatch_family( std::integral_constant<XCSpin, XCSpin::GKS>{} ); break;
+  }
+
+}
+
+}
@@ -6,6 +6,7 @@
  * See LICENSE.txt for details
  */
 #include <gauxc/xc_integrator/replicated/replicated_xc_integrator_impl.hpp>
+#include <gauxc/exceptions.hpp>
 
 namespace GauXC  {
 namespace detail {
@@ -117,6 +118,52 @@ void ReplicatedXCIntegratorImpl<ValueType>::
 
 }
 
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_exc_vxc_batch( int64_t m, int64_t n, int64_t ndm, 
+                      const value_type* const* P, int64_t ldp, 
+                      value_type* const* VXC, int64_t ldvxc,
+                      value_type* EXC, const IntegratorSettingsXC& ks_settings ) {
+
+    eval_exc_vxc_batch_(m,n,ndm,P,ldp,VXC,ldvxc,EXC,ks_settings);
+
+}
+
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_exc_vxc_batch_( int64_t m, int64_t n, int64_t ndm, 
+                       const value_type* const* P, int64_t ldp, 
+                       value_type* const* VXC, int64_t ldvxc,
+                       value_type* EXC, const IntegratorSettingsXC& ks_settings ) {
+
+    for( int64_t i = 0; i < ndm; ++i )
+      eval_exc_vxc_(m,n,P[i],ldp,VXC[i],ldvxc,EXC+i,ks_settings);
+
+}
+
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_exc_vxc_multi( int64_t m, int64_t n, const value_type* P,
+                      int64_t ldp, int64_t nfunc,
+                      const functional_type* funcs,
+                      value_type* const* VXC, int64_t ldvxc,
+                      value_type* EXC, const IntegratorSettingsXC& ks_settings ) {
+
+    eval_exc_vxc_multi_(m,n,P,ldp,nfunc,funcs,VXC,ldvxc,EXC,ks_settings);
+
+}
+
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_exc_vxc_multi_( int64_t, int64_t, const value_type*, int64_t, 
+                       int64_t, const functional_type*,
+                       value_type* const*, int64_t,
+                       value_type*, const IntegratorSettingsXC& ) {
+
+    GAUXC_GENERIC_EXCEPTION("Multi-Functional EXC/VXC Not Implemented For This Integrator");
+
+}
+
 template <typename ValueType>
 void ReplicatedXCIntegratorImpl<ValueType>::
   eval_exc_grad( int64_t m, int64_t n, const value_type* P,
@@ -126,6 +173,29 @@ void ReplicatedXCIntegratorImpl<ValueType>::
 
 }
 
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_fxc_contraction( int64_t m, int64_t n, const value_type* P,
+                        int64_t ldp, int64_t ntrial,
+                        const value_type* const* tP, int64_t ldtp,
+                        value_type* const* FXC, int64_t ldfxc,
+                        const IntegratorSettingsXC& ks_settings ) {
+
+    eval_fxc_contraction_(m,n,P,ldp,ntrial,tP,ldtp,FXC,ldfxc,ks_settings);
+
+}
+
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_fxc_contraction_( int64_t, int64_t, const value_type*, int64_t, 
+                         int64_t, const value_type* const*, int64_t,
+                         value_type* const*, int64_t,
+                         const IntegratorSettingsXC& ) {
+
+    GAUXC_GENERIC_EXCEPTION("FXC Contraction Not Implemented For This Integrator");
+
+}
+
 template <typename ValueType>
 void ReplicatedXCIntegratorImpl<ValueType>::
   eval_exx( int64_t m, int64_t n, const value_type* P,
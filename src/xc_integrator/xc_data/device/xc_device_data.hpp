@@ -440,7 +440,7 @@ struct XCDeviceData {
   virtual void send_static_data_weights( const Molecule& mol, const MolMeta& meta ) = 0;
   virtual void send_static_data_density_basis( const double* Ps, int32_t ldps, const double* Pz, int32_t ldpz, const double* Py, int32_t ldpy, const double* Px, int32_t ldpx, const BasisSet<double>& basis ) = 0;
   virtual void send_static_data_shell_pairs( const BasisSet<double>&, const ShellPairCollection<double>& ) = 0;
-  virtual void send_static_data_exx_ek_screening( const double* V_max, int32_t ldv, const BasisSetMap&, const ShellPairCollection<double>& ) = 0;
+  virtual void send_static_data_exx_ek_screening( const double* V_max, const BasisSetMap&, const ShellPairCollection<double>& ) = 0;
 
   /// Zero out the density integrands in device memory
   virtual void zero_den_integrands() = 0;
@@ -385,7 +385,7 @@ void XCDeviceStackData::send_static_data_shell_pairs(
 }
 
 void XCDeviceStackData::send_static_data_exx_ek_screening( const double* V_max, 
-  int32_t ldv, const BasisSetMap& basis_map, 
+  const BasisSetMap& basis_map, 
   const ShellPairCollection<double>& shpairs ) {
 
   if( not allocated_terms.exx_ek_screening ) 
@@ -393,30 +393,18 @@ void XCDeviceStackData::send_static_data_exx_ek_screening( const double* V_max,
 
   const auto nshells      = global_dims.nshells;
   const auto nshell_pairs = global_dims.nshell_pairs;
-  if( ldv != (int)nshells ) GAUXC_GENERIC_EXCEPTION("LDV must bf NSHELLS");
   if( shpairs.npairs() != nshell_pairs ) 
     GAUXC_GENERIC_EXCEPTION("Inconsistent ShellPairs"); 
   if( not device_backend_ ) GAUXC_GENERIC_EXCEPTION("Invalid Device Backend");
 
 
-  // Pack VMAX
-  std::vector<double> V_pack(nshell_pairs);
-  const auto sp_row_ptr = shpairs.row_ptr();
-  const auto sp_col_ind = shpairs.col_ind();
-  for( auto i = 0ul; i < nshells; ++i ) {
-    const auto j_st = sp_row_ptr[i];
-    const auto j_en = sp_row_ptr[i+1];
-    for( auto _j = j_st; _j < j_en; ++_j ) {
-      const auto j = sp_col_ind[_j];
-      V_pack[_j] = V_max[i + j*ldv];
-    }
-  }
-
-  // Copy VMAX
-  device_backend_->copy_async( nshell_pairs, V_pack.data(), 
+  // Copy VMAX (already stored on the shell pair CSR pattern)
+  device_backend_->copy_async( nshell_pairs, V_max, 
     static_stack.vshell_max_sparse_device, "VMAX Sparse H2D");
 
   // Create sparse triplet for device
+  const auto sp_row_ptr = shpairs.row_ptr();
+  const auto sp_col_ind = shpairs.col_ind();
   std::vector<size_t> rowind(nshell_pairs);
   for( auto i = 0ul; i < nshells; ++i ) {
     const auto j_st = sp_row_ptr[i];
@@ -171,7 +171,7 @@ struct XCDeviceStackData : public XCDeviceData {
     const BasisSet<double>& basis ) override final;
   void send_static_data_shell_pairs( const BasisSet<double>&, const ShellPairCollection<double>& ) 
     override final;
-  void send_static_data_exx_ek_screening( const double* V_max, int32_t ldv, const BasisSetMap&, const ShellPairCollection<double>& ) override final;
+  void send_static_data_exx_ek_screening( const double* V_max, const BasisSetMap&, const ShellPairCollection<double>& ) override final;
   void zero_den_integrands() override final;
   void zero_exc_vxc_integrands(integrator_term_tracker t) override final;
   void zero_exc_grad_integrands() override final;
@@ -9,6 +9,7 @@
 #include "catch2/catch.hpp"
 #include <gauxc/basisset.hpp>
 #include <gauxc/basisset_map.hpp>
+#include <gauxc/shell_spatial_index.hpp>
 #include <gauxc/molecule.hpp>
 #include <gauxc/external/hdf5.hpp>
 
@@ -218,6 +219,56 @@ TEST_CASE("BasisSet", "[basisset]") {
 
 
 
+TEST_CASE("ShellSpatialIndex", "[basisset]") {
+
+  Molecule mol = make_taxol();
+
+  // Default and diffuse (most shells placed on coarse levels) cutoffs
+  for( bool diffuse : {false, true} ) {
+    BasisSet<double> basis = make_631Gd(mol, SphericalType(false));
+    if( diffuse ) 
+      for( auto& sh : basis ) 
+        sh.set_shell_tolerance( std::numeric_limits<double>::epsilon() );
+
+    ShellSpatialIndex shell_index( basis );
+    CHECK( shell_index.nshells() == basis.nshells() );
+
+    // Bounding box of the molecule
+    std::array<double,3> mol_lo, mol_up;
+    mol_lo.fill( std::numeric_limits<double>::infinity() );
+    mol_up.fill( -std::numeric_limits<double>::infinity() );
+    for( const auto& atom : mol ) {
+      std::array<double,3> r = { atom.x, atom.y, atom.z };
+      for( int d = 0; d < 3; ++d ) {
+        mol_lo[d] = std::min( mol_lo[d], r[d] );
+        mol_up[d] = std::max( mol_up[d], r[d] );
+      }
+    }
+
+    std::default_random_engine gen;
+    std::uniform_real_distribution<double> frac( -0.2, 1.2 );
+    std::uniform_real_distribution<double> width( 0.01, 5.0 );
+    for( int i = 0; i < 500; ++i ) {
+      std::array<double,3> lo, up;
+      const auto w = width(gen);
+      for( int d = 0; d < 3; ++d ) {
+        lo[d] = mol_lo[d] + frac(gen) * (mol_up[d] - mol_lo[d]);
+        up[d] = lo[d] + w;
+      }
+
+      std::vector<int32_t> ref_list;
+      for( int32_t ish = 0; ish < basis.nshells(); ++ish ) {
+        if( geometry::cube_sphere_intersect( lo, up, basis[ish].O(), 
+          basis[ish].cutoff_radius() ) ) ref_list.emplace_back(ish);
+      }
+
+      CHECK( shell_index.intersecting_shells( lo, up ) == ref_list );
+    }
+
+  }
+
+}
+
 TEST_CASE("HDF5-BASISSET", "[basisset]") {
 
 #ifdef GAUXC_HAS_MPI
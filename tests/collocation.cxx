@@ -53,6 +53,26 @@ TEST_CASE( "Water / cc-pVDZ", "[collocation]" ) {
   SECTION( "Host Eval Hessian" ) {
     test_host_collocation_deriv2( basis, ref_data );
   }
+
+  SECTION( "Host Eval Laplacian" ) {
+    test_host_collocation_laplacian( basis, ref_data );
+  }
+
+  SECTION( "Host Eval Atomic" ) {
+    test_host_collocation_atomic( mol, basis, ref_data );
+  }
+
+  SECTION( "Host Eval Atomic Grid" ) {
+    test_host_collocation_atomic_grid( mol, basis );
+  }
+
+  SECTION( "Host SIMD Eval" ) {
+    test_host_simd_collocation( basis, ref_data );
+  }
+
+  SECTION( "Host SIMD Eval ISA Builds" ) {
+    test_host_simd_collocation_isa( basis, ref_data );
+  }
 #endif
 
 #ifdef GAUXC_HAS_CUDA
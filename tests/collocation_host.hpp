@@ -8,6 +8,8 @@
 #ifdef GAUXC_HAS_HOST
 #include "collocation_common.hpp"
 #include "host/reference/collocation.hpp"
+#include "host/simd/collocation.hpp"
+#include <numeric>
 
 void generate_collocation_data( const Molecule& mol, const BasisSet<double>& basis,
                                 std::ofstream& out_file, size_t ntask_save = 10 ) {
@@ -153,6 +155,164 @@ void test_host_collocation_deriv1( const BasisSet<double>& basis, std::ifstream&
 
 }
 
+void test_host_collocation_laplacian( const BasisSet<double>& basis, std::ifstream& in_file) {
+
+
+
+  std::vector<ref_collocation_data> ref_data;
+
+  {
+    cereal::BinaryInputArchive ar( in_file );
+    ar( ref_data );
+  }
+
+  for( auto& d : ref_data ) {
+
+    const auto npts = d.pts.size();
+    const auto nbf  = d.eval.size() / npts;
+
+    const auto& mask = d.mask;
+    const auto& pts  = d.pts;
+
+    std::vector<double> eval   ( nbf * npts ),
+                        deval_x( nbf * npts ),
+                        deval_y( nbf * npts ),
+                        deval_z( nbf * npts ),
+                        leval  ( nbf * npts );
+
+
+    gau2grid_collocation_laplacian( npts, mask.size(), nbf,
+      pts.data()->data(), basis, mask.data(), eval.data(), 
+      deval_x.data(), deval_y.data(), deval_z.data(), leval.data() );
+
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( eval[i] == Approx( d.eval[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_x[i] == Approx( d.deval_x[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_y[i] == Approx( d.deval_y[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_z[i] == Approx( d.deval_z[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( leval[i] == 
+        Approx( d.d2eval_xx[i] + d.d2eval_yy[i] + d.d2eval_zz[i] ) );
+  }
+
+}
+
+void test_host_collocation_atomic( const Molecule& mol, 
+  const BasisSet<double>& basis, std::ifstream& in_file) {
+
+
+
+  std::vector<ref_collocation_data> ref_data;
+
+  {
+    cereal::BinaryInputArchive ar( in_file );
+    ar( ref_data );
+  }
+
+  // Radial reuse must be exact for any center, on-center shells are only
+  // those of the atom taken as center
+  for( const auto& atom : mol ) 
+  for( auto& d : ref_data ) {
+
+    const auto npts = d.pts.size();
+    const auto nbf  = d.eval.size() / npts;
+
+    const auto& mask = d.mask;
+    const auto& pts  = d.pts;
+    const double center[3] = { atom.x, atom.y, atom.z };
+
+    std::vector<double> eval   ( nbf * npts ),
+                        deval_x( nbf * npts ),
+                        deval_y( nbf * npts ),
+                        deval_z( nbf * npts );
+
+    gau2grid_collocation_atomic( npts, mask.size(), nbf,
+                                 pts.data()->data(), basis,
+                                 mask.data(), center,
+                                 eval.data() );
+
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( eval[i] == Approx( d.eval[i] ) );
+
+    gau2grid_collocation_gradient_atomic( npts, mask.size(), nbf,
+                                          pts.data()->data(), basis,
+                                          mask.data(), center,
+                                          eval.data(), deval_x.data(),
+                                          deval_y.data(), deval_z.data() );
+
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( eval[i] == Approx( d.eval[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_x[i] == Approx( d.deval_x[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_y[i] == Approx( d.deval_y[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_z[i] == Approx( d.deval_z[i] ) );
+  }
+
+}
+
+void test_host_collocation_atomic_grid( const Molecule& mol, 
+  const BasisSet<double>& basis ) {
+
+  // Points of an atomic quadrature: few radii times a set of directions,
+  // such that the radial factors of the on-center shells are reused
+  const std::vector<double> radii = { 0.05, 0.3, 1., 2.5, 5. };
+  std::vector<std::array<double,3>> dirs = {
+    {1,0,0}, {-1,0,0}, {0,1,0}, {0,-1,0}, {0,0,1}, {0,0,-1} };
+  const double c = 1. / std::sqrt(3.);
+  for( auto sx : {-c, c} ) for( auto sy : {-c, c} ) for( auto sz : {-c, c} )
+    dirs.push_back( {sx, sy, sz} );
+
+  const size_t nbf = basis.nbf();
+  std::vector<int32_t> mask( basis.nshells() );
+  std::iota( mask.begin(), mask.end(), 0 );
+
+  for( const auto& atom : mol ) {
+
+    // Centers which differ from the shell origins in their last bits are
+    // still taken as on-center
+    const double center[3] = { atom.x + 1e-14, atom.y, atom.z };
+
+    std::vector<std::array<double,3>> pts;
+    for( auto r : radii ) for( const auto& d : dirs )
+      pts.push_back( { center[0] + r*d[0], center[1] + r*d[1], 
+        center[2] + r*d[2] } );
+    const size_t npts = pts.size();
+
+    std::vector<double> eval( nbf * npts ), deval_x( nbf * npts ),
+      deval_y( nbf * npts ), deval_z( nbf * npts );
+    std::vector<double> ref( nbf * npts ), dref_x( nbf * npts ),
+      dref_y( nbf * npts ), dref_z( nbf * npts );
+
+    gau2grid_collocation( npts, mask.size(), nbf, pts.data()->data(), basis,
+      mask.data(), ref.data() );
+    gau2grid_collocation_atomic( npts, mask.size(), nbf, pts.data()->data(), 
+      basis, mask.data(), center, eval.data() );
+
+    for( size_t i = 0; i < npts * nbf; ++i )
+      CHECK( eval[i] == Approx( ref[i] ).margin(1e-12) );
+
+    gau2grid_collocation_gradient( npts, mask.size(), nbf, pts.data()->data(),
+      basis, mask.data(), ref.data(), dref_x.data(), dref_y.data(), 
+      dref_z.data() );
+    gau2grid_collocation_gradient_atomic( npts, mask.size(), nbf, 
+      pts.data()->data(), basis, mask.data(), center, eval.data(), 
+      deval_x.data(), deval_y.data(), deval_z.data() );
+
+    for( size_t i = 0; i < npts * nbf; ++i ) {
+      CHECK( eval[i]    == Approx( ref[i]    ).margin(1e-12) );
+      CHECK( deval_x[i] == Approx( dref_x[i] ).margin(1e-10) );
+      CHECK( deval_y[i] == Approx( dref_y[i] ).margin(1e-10) );
+      CHECK( deval_z[i] == Approx( dref_z[i] ).margin(1e-10) );
+    }
+  }
+
+}
+
 void test_host_collocation_deriv2( const BasisSet<double>& basis, std::ifstream& in_file) {
 
 
@@ -213,5 +373,148 @@ void test_host_collocation_deriv2( const BasisSet<double>& basis, std::ifstream&
       CHECK( d2eval_zz[i] == Approx( d.d2eval_zz[i] ) );
   }
 
+}
+
+void test_host_simd_collocation( const BasisSet<double>& basis, std::ifstream& in_file) {
+
+
+
+  std::vector<ref_collocation_data> ref_data;
+
+  {
+    cereal::BinaryInputArchive ar( in_file );
+    ar( ref_data );
+  }
+
+  auto check = []( const auto& eval, const auto& ref ) {
+    for( size_t i = 0; i < ref.size(); ++i )
+      CHECK( eval[i] == Approx( ref[i] ) );
+  };
+
+  for( auto& d : ref_data ) {
+
+    const auto npts = d.pts.size();
+    const auto nbf  = d.eval.size() / npts;
+
+    const auto& mask = d.mask;
+    const auto& pts  = d.pts;
+
+    std::vector<double> eval   ( nbf * npts ),
+                        deval_x( nbf * npts ),
+                        deval_y( nbf * npts ),
+                        deval_z( nbf * npts ),
+                        d2eval_xx( nbf * npts ),
+                        d2eval_xy( nbf * npts ),
+                        d2eval_xz( nbf * npts ),
+                        d2eval_yy( nbf * npts ),
+                        d2eval_yz( nbf * npts ),
+                        d2eval_zz( nbf * npts );
+
+    simd_collocation( npts, mask.size(), nbf, pts.data()->data(), basis, 
+      mask.data(), eval.data() );
+    check( eval, d.eval );
+
+    simd_collocation_gradient( npts, mask.size(), nbf, pts.data()->data(), 
+      basis, mask.data(), eval.data(), deval_x.data(), deval_y.data(), 
+      deval_z.data() );
+    check( eval,    d.eval    );
+    check( deval_x, d.deval_x );
+    check( deval_y, d.deval_y );
+    check( deval_z, d.deval_z );
+
+    simd_collocation_hessian( npts, mask.size(), nbf,
+      pts.data()->data(), basis, mask.data(), eval.data(), 
+      deval_x.data(), deval_y.data(), deval_z.data(),
+      d2eval_xx.data(), d2eval_xy.data(), d2eval_xz.data(),
+      d2eval_yy.data(), d2eval_yz.data(), d2eval_zz.data() );
+    check( eval,      d.eval      );
+    check( deval_x,   d.deval_x   );
+    check( deval_y,   d.deval_y   );
+    check( deval_z,   d.deval_z   );
+    check( d2eval_xx, d.d2eval_xx );
+    check( d2eval_xy, d.d2eval_xy );
+    check( d2eval_xz, d.d2eval_xz );
+    check( d2eval_yy, d.d2eval_yy );
+    check( d2eval_yz, d.d2eval_yz );
+    check( d2eval_zz, d.d2eval_zz );
+
+    std::vector<double> leval( nbf * npts ), leval_ref( nbf * npts );
+    for( size_t i = 0; i < leval_ref.size(); ++i )
+      leval_ref[i] = d.d2eval_xx[i] + d.d2eval_yy[i] + d.d2eval_zz[i];
+    simd_collocation_laplacian( npts, mask.size(), nbf, pts.data()->data(), 
+      basis, mask.data(), eval.data(), deval_x.data(), deval_y.data(), 
+      deval_z.data(), leval.data() );
+    check( eval,    d.eval    );
+    check( deval_x, d.deval_x );
+    check( deval_y, d.deval_y );
+    check( deval_z, d.deval_z );
+    check( leval,   leval_ref );
+  }
+
+}
+
+void test_host_simd_collocation_isa( const BasisSet<double>& basis, 
+  std::ifstream& in_file) {
+
+  std::vector<ref_collocation_data> ref_data;
+
+  {
+    cereal::BinaryInputArchive ar( in_file );
+    ar( ref_data );
+  }
+
+  auto check = []( const auto& eval, const auto& ref ) {
+    for( size_t i = 0; i < ref.size(); ++i )
+      CHECK( eval[i] == Approx( ref[i] ) );
+  };
+
+  const char* env_isa = getenv("GAUXC_COLLOCATION_ISA");
+  const std::string prev_isa = env_isa ? env_isa : "";
+
+  // Builds not supported by the library or the CPU fall back to a
+  // narrower one, which is then (harmlessly) checked again
+  for( std::string isa : {"reference", "avx2", "avx512"} ) {
+    setenv( "GAUXC_COLLOCATION_ISA", isa.c_str(), 1 );
+    auto* kernel = simd_kernels::select_collocation_kernel();
+
+    for( auto& d : ref_data ) {
+
+      const auto npts = d.pts.size();
+      const auto nbf  = d.eval.size() / npts;
+
+      std::vector<std::vector<double>> eval( 10, 
+        std::vector<double>( nbf * npts ) );
+      std::vector<double*> eval_ptr;
+      for( auto& e : eval ) eval_ptr.emplace_back( e.data() );
+
+      simd_kernels::simd_collocation_isa( kernel, 2, npts, d.mask.size(), 
+        nbf, d.pts.data()->data(), basis, d.mask.data(), nullptr, 
+        eval_ptr.data() );
+      check( eval[0], d.eval      );
+      check( eval[1], d.deval_x   );
+      check( eval[2], d.deval_y   );
+      check( eval[3], d.deval_z   );
+      check( eval[4], d.d2eval_xx );
+      check( eval[5], d.d2eval_xy );
+      check( eval[6], d.d2eval_xz );
+      check( eval[7], d.d2eval_yy );
+      check( eval[8], d.d2eval_yz );
+      check( eval[9], d.d2eval_zz );
+
+      std::vector<double> leval_ref( nbf * npts );
+      for( size_t i = 0; i < leval_ref.size(); ++i )
+        leval_ref[i] = d.d2eval_xx[i] + d.d2eval_yy[i] + d.d2eval_zz[i];
+      simd_kernels::simd_collocation_isa( kernel, 
+        simd_kernels::deriv_laplacian, npts, d.mask.size(), nbf, 
+        d.pts.data()->data(), basis, d.mask.data(), nullptr, 
+        eval_ptr.data() );
+      check( eval[0], d.eval    );
+      check( eval[4], leval_ref );
+    }
+  }
+
+  if( prev_isa.empty() ) unsetenv( "GAUXC_COLLOCATION_ISA" );
+  else setenv( "GAUXC_COLLOCATION_ISA", prev_isa.c_str(), 1 );
+
 }
 #endif
@@ -0,0 +1,567 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "ut_common.hpp"
+
+#ifdef GAUXC_HAS_HOST
+#include "host/util.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "replicated/host/xc_host_accumulator.hpp"
+#include "integrator_util/host_arena.hpp"
+#include "integrator_util/collocation_cache.hpp"
+#include "integrator_util/shell_block_screening.hpp"
+#include "standards.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+using namespace GauXC;
+
+TEST_CASE( "Packed Host Accumulation", "[host]" ) {
+
+  const int32_t N = 16;
+  const size_t  len = XCHostAccumulator<double>::packed_size(N);
+
+  // Compressed rows / columns, {start, size, compressed start}. The column
+  // blocks straddle the diagonal of the row blocks
+  const std::vector<std::array<int32_t,3>> map_row =
+    { {0,3,0}, {5,4,3}, {12,2,7} };
+  const std::vector<std::array<int32_t,3>> map_col =
+    { {2,5,0}, {10,4,5} };
+  const int32_t nrow = 9, ncol = 9;
+
+  auto expand = []( const auto& map ) {
+    std::vector<int32_t> idx;
+    for( auto& c : map ) for( int32_t i = 0; i < c[1]; ++i )
+      idx.emplace_back( c[0] + i );
+    return idx;
+  };
+  const auto rows = expand(map_row);
+  const auto cols = expand(map_col);
+
+  // Symmetric (nrow,nrow) and general (nrow,ncol) increments of task k
+  auto A_sym = [&]( int k, int32_t i, int32_t j ) {
+    return std::sin( k + 0.3 * (i + j) ) + std::cos( 0.1 * i * j );
+  };
+  auto B_gen = [&]( int k, int32_t i, int32_t j ) {
+    return std::sin( 0.5 * k + 0.3 * i - 0.7 * j );
+  };
+  const int ntasks = 37;
+
+  // Dense references, K is symmetrized
+  std::vector<double> V_ref( N*N, 0. ), K_dense( N*N, 0. ), K_ref( N*N );
+  for( int k = 0; k < ntasks; ++k ) {
+    for( int32_t j = 0; j < nrow; ++j )
+    for( int32_t i = 0; i < nrow; ++i )
+      V_ref[ rows[i] + rows[j]*N ] += A_sym(k,i,j);
+    for( int32_t j = 0; j < ncol; ++j )
+    for( int32_t i = 0; i < nrow; ++i )
+      K_dense[ rows[i] + cols[j]*N ] += B_gen(k,i,j);
+  }
+  for( int32_t j = 0; j < N; ++j )
+  for( int32_t i = 0; i < N; ++i )
+    K_ref[i + j*N] = 0.5 * ( K_dense[i + j*N] + K_dense[j + i*N] );
+
+  XCHostAccumulator<double> acc( 2, len );
+  REQUIRE( acc.enabled() );
+
+  std::vector<double> V( N*N ), K( N*N );
+  #pragma omp parallel
+  {
+    acc.zero_local();
+    std::vector<double> A( nrow*nrow ), B( nrow*ncol );
+
+    #pragma omp for schedule(dynamic)
+    for( int k = 0; k < ntasks; ++k ) {
+      for( int32_t j = 0; j < nrow; ++j )
+      for( int32_t i = 0; i < nrow; ++i ) A[i + j*nrow] = A_sym(k,i,j);
+      for( int32_t j = 0; j < ncol; ++j )
+      for( int32_t i = 0; i < nrow; ++i ) B[i + j*nrow] = B_gen(k,i,j);
+
+      detail::inc_by_submat_packed_lower( N, nrow, acc.local(0), A.data(),
+        nrow, map_row );
+      detail::inc_by_submat_packed_fold( N, nrow, ncol, acc.local(1),
+        B.data(), nrow, map_row, map_col );
+    }
+
+    acc.reduce_packed( 0, N, V.data(), N );
+    acc.reduce_packed( 1, N, K.data(), N, 0.5 );
+  }
+
+  for( int32_t i = 0; i < N*N; ++i ) {
+    CHECK( V[i] == Approx( V_ref[i] ).margin(1e-12) );
+    CHECK( K[i] == Approx( K_ref[i] ).margin(1e-12) );
+  }
+
+  // Accumulation is disabled beyond the memory budget
+  XCHostAccumulator<double> acc_small( 2, len, sizeof(double) );
+  CHECK_FALSE( acc_small.enabled() );
+
+}
+
+TEST_CASE( "Host Arena", "[host]" ) {
+
+  const size_t cap = 4096;
+  HostArena arena( cap );
+  REQUIRE( arena.capacity() >= cap );
+  CHECK( arena.used() == 0 );
+
+  auto is_aligned = []( const void* p ) {
+    return reinterpret_cast<std::uintptr_t>(p) % HostArena::alignment == 0;
+  };
+
+  SECTION("Mark / Release") {
+    auto* a = arena.allocate<double>( 3 );
+    CHECK( is_aligned(a) );
+    CHECK( arena.used() == HostArena::aligned_size<double>(3) );
+
+    const auto m = arena.mark();
+    auto* b = arena.allocate<double>( 17 );
+    CHECK( is_aligned(b) );
+    CHECK( b == a + HostArena::aligned_size<double>(3) / sizeof(double) );
+    {
+      HostArena::scope s( arena );
+      arena.allocate<int32_t>( 5 );
+      CHECK( arena.used() > m.offset + HostArena::aligned_size<double>(17) );
+    }
+    CHECK( arena.used() == m.offset + HostArena::aligned_size<double>(17) );
+
+    // Released storage is handed out again
+    arena.release( m );
+    CHECK( arena.used() == m.offset );
+    CHECK( arena.allocate<double>( 17 ) == b );
+
+    arena.release_all();
+    CHECK( arena.used() == 0 );
+    CHECK( arena.allocate<double>( 1 ) == a );
+    arena.release_all();
+  }
+
+  SECTION("Overflow") {
+    const size_t n = arena.capacity() / sizeof(double);
+    auto* a = arena.allocate<double>( n );
+    CHECK( arena.overflow_count() == 0 );
+
+    // Requests beyond the capacity are served from the heap
+    const auto m = arena.mark();
+    auto* b = arena.allocate<double>( 8 );
+    auto* c = arena.allocate<double>( 8 );
+    CHECK( is_aligned(b) );
+    CHECK( is_aligned(c) );
+    CHECK( arena.overflow_count() == 2 );
+    CHECK( arena.used() == n * sizeof(double) );
+    std::fill_n( b, 8, 1. ); std::fill_n( c, 8, 2. );
+    std::fill_n( a, n, 0. );
+
+    // The count is cumulative across releases
+    arena.release( m );
+    arena.allocate<double>( 8 );
+    CHECK( arena.overflow_count() == 3 );
+    arena.release_all();
+    CHECK( arena.overflow_count() == 3 );
+    CHECK( arena.used() == 0 );
+  }
+
+  SECTION("Reserve / Shrink") {
+    // Growing / dropping the mapping requires all storage to be released
+    arena.allocate<double>( 1 );
+    CHECK_THROWS( arena.reserve( 2 * arena.capacity() ) );
+    CHECK_THROWS( arena.shrink() );
+    arena.release_all();
+    arena.allocate<double>( 2 * arena.capacity() ); // Overflow
+    CHECK_THROWS( arena.reserve( 4 * arena.capacity() ) );
+    arena.release_all();
+
+    // Reserving less than the capacity is a no-op
+    const auto cap_old = arena.capacity();
+    arena.reserve( cap_old / 2 );
+    CHECK( arena.capacity() == cap_old );
+
+    arena.reserve( 2 * cap_old );
+    CHECK( arena.capacity() >= 2 * cap_old );
+    CHECK( is_aligned( arena.allocate<char>(1) ) );
+    arena.release_all();
+
+    // Mappings within the retained size are kept
+    const auto cap_new = arena.capacity();
+    arena.shrink( cap_new );
+    CHECK( arena.capacity() == cap_new );
+    arena.shrink();
+    CHECK( arena.capacity() == 0 );
+
+    // Allocations of an empty arena are served from the heap
+    const auto noverflow = arena.overflow_count();
+    CHECK( is_aligned( arena.allocate<double>(4) ) );
+    CHECK( arena.overflow_count() == noverflow + 1 );
+    arena.release_all();
+  }
+
+}
+
+TEST_CASE( "Collocation Cache", "[host]" ) {
+
+  // Tasks only differ in their points, entries all have the same length
+  constexpr size_t len = 64;
+  constexpr size_t nbytes = len * sizeof(double);
+  auto make_task = []( int i ) {
+    XCTask task;
+    task.iParent = 0;
+    task.points  = { {double(i), 0., 1.}, {0., double(i), 2.} };
+    task.weights = { 1., 1. };
+    task.npts    = task.points.size();
+    task.bfn_screening.shell_list = { 0, 2, 3 };
+    task.bfn_screening.nbe = 8;
+    return task;
+  };
+  auto make_data = []( size_t n, int i ) {
+    std::vector<double> d(n);
+    for( size_t j = 0; j < n; ++j ) d[j] = i + 1e-3 * j;
+    return d;
+  };
+  auto holds = [&]( CollocationCache& cache, int i, size_t n ) {
+    auto ptr = cache.lookup( make_task(i), 0 );
+    if( not ptr ) return false;
+    const auto ref = make_data( n, i );
+    return std::equal( ref.begin(), ref.end(), ptr.get() );
+  };
+
+  // Benefit of entry i (score increases with i)
+  auto benefit = []( int i ) { return double(i + 1); };
+
+  SECTION("Eviction") {
+    CollocationCache cache( 3 * nbytes );
+    for( int i = 0; i < 3; ++i )
+      cache.insert( make_task(i), 1, len, make_data(len,i).data(), benefit(i) );
+    CHECK( cache.bytes() == 3 * nbytes );
+    for( int i = 0; i < 3; ++i ) CHECK( holds(cache, i, len) );
+
+    // Lower derivative orders are served by the prefix of an entry, higher
+    // ones are not served at all
+    CHECK( cache.lookup( make_task(0), 0 ) );
+    CHECK_FALSE( cache.lookup( make_task(0), 2 ) );
+
+    // The entry of the smallest score makes room
+    cache.insert( make_task(3), 1, len, make_data(len,3).data(), benefit(3) );
+    CHECK( cache.bytes() == 3 * nbytes );
+    CHECK_FALSE( holds(cache, 0, len) );
+    for( int i = 1; i < 4; ++i ) CHECK( holds(cache, i, len) );
+
+    // Outstanding handles keep evicted data alive
+    auto ptr = cache.lookup( make_task(1), 1 );
+    cache.insert( make_task(4), 1, len, make_data(len,4).data(), benefit(4) );
+    CHECK_FALSE( holds(cache, 1, len) );
+    const auto ref = make_data(len, 1);
+    CHECK( std::equal( ref.begin(), ref.end(), ptr.get() ) );
+
+    cache.clear();
+    CHECK( cache.bytes() == 0 );
+    CHECK_FALSE( holds(cache, 4, len) );
+  }
+
+  SECTION("Admission") {
+    CollocationCache cache( 2 * nbytes );
+    CHECK( cache.admits( len, benefit(0) ) );
+    CHECK_FALSE( cache.admits( 3 * len, benefit(10) ) );
+    for( int i = 1; i < 3; ++i )
+      cache.insert( make_task(i), 0, len, make_data(len,i).data(), benefit(i) );
+
+    // Entries may only displace entries of a smaller score
+    CHECK_FALSE( cache.admits( len, benefit(0) ) );
+    CHECK( cache.admits( len, benefit(3) ) );
+    CHECK( cache.admits( 2 * len, 2 * benefit(3) ) );
+    CHECK_FALSE( cache.admits( 2 * len, 2 * benefit(1) ) );
+
+    // Rejected entries leave the cache untouched
+    cache.insert( make_task(0), 0, len, make_data(len,0).data(), benefit(0) );
+    CHECK_FALSE( holds(cache, 0, len) );
+    CHECK( holds(cache, 1, len) );
+    CHECK( holds(cache, 2, len) );
+    CHECK( cache.bytes() == 2 * nbytes );
+  }
+
+  SECTION("Spill") {
+    CollocationCache cache( nbytes, "gauxc_colloc_cache_ut.spill", 2 * nbytes );
+    for( int i = 0; i < 3; ++i )
+      cache.insert( make_task(i), 0, len, make_data(len,i).data(), benefit(i) );
+
+    // Evicted entries are served from the spill file, which is not part
+    // of the in-core budget
+    CHECK( cache.bytes() == nbytes );
+    for( int i = 0; i < 3; ++i ) CHECK( holds(cache, i, len) );
+
+    // Entries are admitted as long as the spill file has space
+    CHECK_FALSE( cache.admits( len, benefit(0) ) );
+
+    // Evicted entries which do not fit into the spill file are dropped
+    cache.insert( make_task(3), 0, len, make_data(len,3).data(), benefit(3) );
+    CHECK( holds(cache, 3, len) );
+    CHECK( holds(cache, 1, len) );
+    CHECK( holds(cache, 0, len) );
+    CHECK_FALSE( holds(cache, 2, len) );
+  }
+
+  SECTION("Spill Reuse") {
+    CollocationCache cache( 2 * nbytes, "gauxc_colloc_cache_ut.spill",
+      2 * nbytes );
+
+    // Fill the spill file with single length entries
+    for( int i = 0; i < 4; ++i )
+      cache.insert( make_task(i), 0, len, make_data(len,i).data(), benefit(i) );
+    for( int i = 0; i < 4; ++i ) CHECK( holds(cache, i, len) );
+    CHECK_FALSE( cache.admits( len, benefit(0) ) );
+
+    // Replacing a spilled entry returns its space once no handle is held
+    {
+      auto ptr = cache.lookup( make_task(0), 0 );
+      cache.insert( make_task(0), 1, len, make_data(len,0).data(), benefit(0) );
+      CHECK_FALSE( holds(cache, 0, len) );
+      CHECK_FALSE( cache.admits( len, benefit(0) ) );
+    }
+    CHECK( cache.admits( len, benefit(0) ) );
+
+    // Released ranges are coalesced, a double length entry may be spilled
+    // after all single length entries are gone
+    cache.clear();
+    for( int i = 0; i < 2; ++i )
+      cache.insert( make_task(i), 0, 2*len, make_data(2*len,i).data(),
+        2 * benefit(i) );
+    CHECK( cache.bytes() == 2 * nbytes );
+    CHECK( holds(cache, 0, 2*len) );
+    CHECK( holds(cache, 1, 2*len) );
+  }
+
+}
+
+TEST_CASE( "Screened X Matrix", "[host]" ) {
+
+  auto lwd_base = LocalWorkDriverFactory::make_local_work_driver(
+    ExecutionSpace::Host, "Reference" );
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>( lwd_base.get() );
+  REQUIRE( lwd );
+
+  Molecule mol           = make_water();
+  BasisSet<double> basis = make_ccpvdz( mol, SphericalType(true) );
+  BasisSetMap basis_map( basis, mol );
+
+  const int32_t nbf     = basis.nbf();
+  const int32_t nshells = basis.nshells();
+
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> dist(-1., 1.);
+
+  // Random P with shell blocks dropped across the hydrogens, such that
+  // the pattern has gaps
+  std::vector<double> P( nbf * nbf );
+  for( int32_t j = 0; j < nshells; ++j )
+  for( int32_t i = 0; i < nshells; ++i ) {
+    const auto ci = basis_map.shell_to_center(i);
+    const auto cj = basis_map.shell_to_center(j);
+    const bool drop = ci != cj and ci > 0 and cj > 0;
+    for( int32_t jj = 0; jj < basis_map.shell_size(j); ++jj )
+    for( int32_t ii = 0; ii < basis_map.shell_size(i); ++ii ) {
+      const auto mu = basis_map.shell_to_first_ao(i) + ii;
+      const auto nu = basis_map.shell_to_first_ao(j) + jj;
+      P[mu + nu*nbf] = drop ? 0. : dist(gen);
+    }
+  }
+  ShellBlockScreening screen( basis_map, P.data(), nbf, 1e-12 );
+
+  // Every other shell of the task is dropped, the blocks of P are then
+  // not contiguous in the full basis
+  std::vector<int32_t> shell_list;
+  for( int32_t i = 0; i < nshells; ++i ) 
+    if( i % 3 != 1 ) shell_list.emplace_back(i);
+  std::vector<int32_t> bfn_list;
+  for( auto ish : shell_list )
+  for( int32_t i = 0; i < basis_map.shell_size(ish); ++i )
+    bfn_list.emplace_back( basis_map.shell_to_first_ao(ish) + i );
+  const size_t nbe = bfn_list.size(), npts = 17;
+
+  ShellBlockPattern pattern;
+  pattern.build( basis_map, shell_list.size(), shell_list.data(), screen );
+
+  // The row groups tile the compressed basis
+  int32_t ao_cmp = 0;
+  for( const auto& g : pattern.groups() ) {
+    CHECK( g.rows.ao_cmp == ao_cmp );
+    ao_cmp += g.rows.nbf;
+  }
+  CHECK( size_t(ao_cmp) == nbe );
+  REQUIRE( pattern.max_panel() <= nbe * nbe );
+
+  // Gaps in the pattern split the runs, panels of P are packed
+  CHECK( pattern.runs().size() > pattern.groups().size() );
+  CHECK( std::any_of( pattern.runs().begin(), pattern.runs().end(),
+    []( const auto& r ) { return not r.contiguous; } ) );
+
+  std::vector<double> B( nbe * npts );
+  for( auto& x : B ) x = dist(gen);
+
+  const double fac = 2.;
+  std::vector<double> X( nbe * npts ), scr( nbe * nbe );
+  lwd->eval_xmat_screened( npts, pattern, fac, P.data(), nbf, B.data(), nbe,
+    X.data(), nbe, scr.data() );
+
+  // Only exactly zero blocks are skipped
+  for( size_t ipt = 0; ipt < npts; ++ipt )
+  for( size_t i = 0; i < nbe; ++i ) {
+    double ref = 0.;
+    for( size_t j = 0; j < nbe; ++j ) 
+      ref += fac * P[bfn_list[i] + bfn_list[j]*nbf] * B[j + ipt*nbe];
+    CHECK( X[i + ipt*nbe] == Approx(ref) );
+  }
+
+  // Rebuilding the pattern of a different task reuses the instance
+  shell_list.resize( shell_list.size() / 2 );
+  pattern.build( basis_map, shell_list.size(), shell_list.data(), screen );
+  int32_t nbe_half = 0;
+  for( auto ish : shell_list ) nbe_half += basis_map.shell_size(ish);
+  CHECK( pattern.groups().back().rows.ao_cmp + 
+    pattern.groups().back().rows.nbf == nbe_half );
+
+}
+
+TEST_CASE( "Strided Host U/V Variables", "[host]" ) {
+
+  auto lwd_base = LocalWorkDriverFactory::make_local_work_driver(
+    ExecutionSpace::Host, "Reference" );
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>( lwd_base.get() );
+  REQUIRE( lwd );
+
+  const size_t npts = 13, nbe = 7;
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> dist(-1., 1.);
+  auto rand_vec = [&]( size_t n ) {
+    std::vector<double> v(n);
+    for( auto& x : v ) x = dist(gen);
+    return v;
+  };
+
+  // Collocation (+ derivatives), ld = nbe
+  const auto B  = rand_vec( nbe * npts );
+  const auto Bx = rand_vec( nbe * npts );
+  const auto By = rand_vec( nbe * npts );
+  const auto Bz = rand_vec( nbe * npts );
+  const auto BL = rand_vec( nbe * npts );
+
+  // The X (and M) matrices of density k are the k-th block of a vertically
+  // stacked matrix, the results must match those of the compact matrices
+  const size_t nstack = 3, ldx = nstack * nbe;
+  auto stack = [&]( const std::vector<double>& X, size_t k ) {
+    auto XS = rand_vec( ldx * npts );
+    for( size_t i = 0; i < npts; ++i )
+      std::copy_n( X.data() + i*nbe, nbe, XS.data() + i*ldx + k*nbe );
+    return XS;
+  };
+
+  std::vector< std::vector<double> > X, XS;
+  for( int k = 0; k < 8; ++k ) {
+    X.emplace_back( rand_vec( nbe * npts ) );
+    XS.emplace_back( stack( X.back(), k % nstack ) );
+  }
+  auto x  = [&]( int k ) { return X[k].data(); };
+  auto xs = [&]( int k ) { return XS[k].data() + (k % nstack) * nbe; };
+
+  std::vector<double> den(2*npts), dx(4*npts), dy(4*npts), dz(4*npts),
+    gamma(3*npts), tau(2*npts), lapl(2*npts), K(3*npts), H(3*npts);
+  auto ref_den = den, ref_dx = dx, ref_dy = dy, ref_dz = dz, 
+    ref_gamma = gamma, ref_tau = tau, ref_lapl = lapl, ref_K = K, ref_H = H;
+
+  auto save_ref = [&]() {
+    ref_den = den; ref_dx = dx; ref_dy = dy; ref_dz = dz; ref_gamma = gamma;
+    ref_tau = tau; ref_lapl = lapl; ref_K = K; ref_H = H;
+  };
+  auto check_ref = [&]() {
+    CHECK( den   == ref_den   ); 
+    CHECK( dx    == ref_dx    );
+    CHECK( dy    == ref_dy    );
+    CHECK( dz    == ref_dz    );
+    CHECK( gamma == ref_gamma );
+    CHECK( tau   == ref_tau   );
+    CHECK( lapl  == ref_lapl  );
+    CHECK( K     == ref_K     );
+    CHECK( H     == ref_H     );
+  };
+
+  SECTION("RKS") {
+    lwd->eval_uvvar_lda_rks( npts, nbe, B.data(), x(0), nbe, den.data() );
+    save_ref();
+    lwd->eval_uvvar_lda_rks( npts, nbe, B.data(), xs(0), ldx, den.data() );
+    check_ref();
+
+    lwd->eval_uvvar_gga_rks( npts, nbe, B.data(), Bx.data(), By.data(), 
+      Bz.data(), x(1), nbe, den.data(), dx.data(), dy.data(), dz.data(), 
+      gamma.data() );
+    save_ref();
+    lwd->eval_uvvar_gga_rks( npts, nbe, B.data(), Bx.data(), By.data(), 
+      Bz.data(), xs(1), ldx, den.data(), dx.data(), dy.data(), dz.data(), 
+      gamma.data() );
+    check_ref();
+
+    lwd->eval_uvvar_mgga_rks( npts, nbe, B.data(), Bx.data(), By.data(), 
+      Bz.data(), BL.data(), x(2), nbe, x(3), x(4), x(5), nbe, den.data(), 
+      dx.data(), dy.data(), dz.data(), gamma.data(), tau.data(), lapl.data() );
+    save_ref();
+    lwd->eval_uvvar_mgga_rks( npts, nbe, B.data(), Bx.data(), By.data(), 
+      Bz.data(), BL.data(), xs(2), ldx, xs(3), xs(4), xs(5), ldx, den.data(), 
+      dx.data(), dy.data(), dz.data(), gamma.data(), tau.data(), lapl.data() );
+    check_ref();
+  }
+
+  SECTION("UKS") {
+    lwd->eval_uvvar_lda_uks( npts, nbe, B.data(), x(0), nbe, x(1), nbe, 
+      den.data() );
+    save_ref();
+    lwd->eval_uvvar_lda_uks( npts, nbe, B.data(), xs(0), ldx, xs(1), ldx, 
+      den.data() );
+    check_ref();
+
+    lwd->eval_uvvar_gga_uks( npts, nbe, B.data(), Bx.data(), By.data(), 
+      Bz.data(), x(0), nbe, x(1), nbe, den.data(), dx.data(), dy.data(), 
+      dz.data(), gamma.data() );
+    save_ref();
+    lwd->eval_uvvar_gga_uks( npts, nbe, B.data(), Bx.data(), By.data(), 
+      Bz.data(), xs(0), ldx, xs(1), ldx, den.data(), dx.data(), dy.data(), 
+      dz.data(), gamma.data() );
+    check_ref();
+
+    lwd->eval_uvvar_mgga_uks( npts, nbe, B.data(), Bx.data(), By.data(), 
+      Bz.data(), BL.data(), x(0), nbe, x(1), nbe, x(2), x(3), x(4), nbe, 
+      x(5), x(6), x(7), nbe, den.data(), dx.data(), dy.data(), dz.data(), 
+      gamma.data(), tau.data(), lapl.data() );
+    save_ref();
+    lwd->eval_uvvar_mgga_uks( npts, nbe, B.data(), Bx.data(), By.data(), 
+      Bz.data(), BL.data(), xs(0), ldx, xs(1), ldx, xs(2), xs(3), xs(4), ldx, 
+      xs(5), xs(6), xs(7), ldx, den.data(), dx.data(), dy.data(), dz.data(), 
+      gamma.data(), tau.data(), lapl.data() );
+    check_ref();
+  }
+
+  SECTION("GKS") {
+    lwd->eval_uvvar_lda_gks( npts, nbe, B.data(), x(0), nbe, x(1), nbe, 
+      x(2), nbe, x(3), nbe, den.data(), K.data(), 1e-12 );
+    save_ref();
+    lwd->eval_uvvar_lda_gks( npts, nbe, B.data(), xs(0), ldx, xs(1), ldx, 
+      xs(2), ldx, xs(3), ldx, den.data(), K.data(), 1e-12 );
+    check_ref();
+
+    lwd->eval_uvvar_gga_gks( npts, nbe, B.data(), Bx.data(), By.data(), 
+      Bz.data(), x(0), nbe, x(1), nbe, x(2), nbe, x(3), nbe, den.data(), 
+      dx.data(), dy.data(), dz.data(), gamma.data(), K.data(), H.data(), 
+      1e-12 );
+    save_ref();
+    lwd->eval_uvvar_gga_gks( npts, nbe, B.data(), Bx.data(), By.data(), 
+      Bz.data(), xs(0), ldx, xs(1), ldx, xs(2), ldx, xs(3), ldx, den.data(), 
+      dx.data(), dy.data(), dz.data(), gamma.data(), K.data(), H.data(), 
+      1e-12 );
+    check_ref();
+  }
+
+}
+#endif
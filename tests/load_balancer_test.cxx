@@ -8,6 +8,7 @@
 #include "ut_common.hpp"
 #include <gauxc/load_balancer.hpp>
 #include <gauxc/molgrid/defaults.hpp>
+#include <gauxc/molecular_weights.hpp>
 
 using namespace GauXC;
 
@@ -156,3 +157,70 @@ TEST_CASE( "DefaultLoadBalancer", "[load_balancer]" ) {
 
 
 }
+
+
+TEST_CASE( "Compact Tasks", "[load_balancer]" ) {
+
+  auto world = RuntimeEnvironment(GAUXC_MPI_CODE(MPI_COMM_WORLD));
+
+  Molecule mol           = make_benzene();
+  BasisSet<double> basis = make_ccpvdz( mol, SphericalType(true) );
+
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  LoadBalancerFactory lb_factory( ExecutionSpace::Host, "Default" );
+  auto lb     = lb_factory.get_instance( world, mol, mg, basis);
+  auto lb_cmp = lb_factory.get_instance( world, mol, mg, basis);
+
+  MolecularWeightsSettings mw_settings;
+  MolecularWeightsFactory mw_factory( ExecutionSpace::Host, "Default", 
+    mw_settings );
+  mw_factory.get_instance().modify_weights(lb);
+
+  mw_settings.compact_tasks = true;
+  MolecularWeightsFactory mw_cmp_factory( ExecutionSpace::Host, "Default", 
+    mw_settings );
+  mw_cmp_factory.get_instance().modify_weights(lb_cmp);
+
+  const auto& tasks     = lb.get_tasks();
+  const auto& tasks_cmp = lb_cmp.get_tasks();
+
+  size_t npts = 0, npts_cmp = 0, nbe_npts = 0, nbe_npts_cmp = 0;
+  double wsum = 0., wsum_cmp = 0.;
+  for( const auto& t : tasks ) {
+    npts     += t.points.size();
+    nbe_npts += t.points.size() * t.bfn_screening.nbe;
+    for( auto w : t.weights ) wsum += w;
+  }
+
+  for( const auto& t : tasks_cmp ) {
+    REQUIRE( t.npts == (int32_t)t.points.size() );
+    REQUIRE( t.weights.size() == t.points.size() );
+    REQUIRE( t.bfn_screening.shell_list.size() );
+
+    size_t nbe = 0;
+    for( auto sh : t.bfn_screening.shell_list ) nbe += basis[sh].size();
+    CHECK( t.bfn_screening.nbe == (int32_t)nbe );
+
+    npts_cmp     += t.points.size();
+    nbe_npts_cmp += t.points.size() * t.bfn_screening.nbe;
+    for( auto w : t.weights ) {
+      CHECK( std::abs(w) > mw_settings.compact_weight_tol );
+      wsum_cmp += w;
+    }
+  }
+
+  CHECK( npts_cmp < npts );
+  CHECK( nbe_npts_cmp < nbe_npts );
+  CHECK( wsum_cmp == Approx(wsum) );
+
+  // A rank whose tasks are all removed must keep an empty task list
+  // rather than regenerating the uncompacted tasks
+  auto lb_empty = lb_factory.get_instance( world, mol, mg, basis);
+  mw_factory.get_instance().modify_weights(lb_empty);
+  lb_empty.compact_tasks( std::numeric_limits<double>::infinity() );
+  CHECK( lb_empty.get_tasks().empty() );
+  CHECK( lb_empty.max_npts() == 0 );
+
+}
@@ -0,0 +1,226 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "ut_common.hpp"
+
+#ifdef GAUXC_HAS_HOST
+#include "host/shell_pair_integral_dispatch.hpp"
+#include "cpu/obara_saika_integrals.hpp"
+#include "cpu/chebyshev_boys_computation.hpp"
+#include "host/obara_saika/src/integral_shell_pair.hpp"
+
+#include <cstdio>
+#include <random>
+
+using namespace GauXC;
+
+TEST_CASE( "Shell Pair Integral Backends", "[exx]" ) {
+
+  const size_t npts = 100;
+  std::default_random_engine gen(1234);
+  std::uniform_real_distribution<double> dist(-1.5, 1.5);
+
+  std::vector<double> points(3*npts), points_transposed(3*npts), weights(npts);
+  for( size_t i = 0; i < npts; ++i ) {
+    for( int k = 0; k < 3; ++k ) {
+      points[3*i + k] = dist(gen);
+      points_transposed[i + k*npts] = points[3*i + k];
+    }
+    weights[i] = std::abs(dist(gen));
+  }
+
+  double* boys_table = XCPU::boys_init();
+
+  SECTION("Rys == Obara-Saika") {
+    std::vector<XCPU::coefficients> cA = {{0.5,0.7},{2.1,0.4},{7.0,0.2}};
+    std::vector<XCPU::coefficients> cB = {{0.3,0.9},{1.7,0.3}};
+
+    for( int is_diag = 0; is_diag < 2; ++is_diag )
+    for( int lA = 0; lA <= ShellPairIntegralDispatch::max_l_os; ++lA )
+    for( int lB = 0; lB <= ShellPairIntegralDispatch::max_l_os; ++lB ) {
+      if( is_diag and lA != lB ) continue;
+
+      XCPU::point rA{0.1, 0.2, -0.3};
+      XCPU::point rB = is_diag ? rA : XCPU::point{0.8, -0.4, 0.9};
+      auto& cket = is_diag ? cA : cB;
+
+      // Primitive pairs are generated w.r.t. the shell of higher L
+      XCPU::shells shA{ rA, cA.data(),   int(cA.size()),   lA };
+      XCPU::shells shB{ rB, cket.data(), int(cket.size()), lB };
+      std::vector<XCPU::prim_pair> prim_pairs( cA.size() * cket.size() );
+      if( lA >= lB ) XCPU::generate_shell_pair( shA, shB, prim_pairs.data() );
+      else           XCPU::generate_shell_pair( shB, shA, prim_pairs.data() );
+
+      const int ncA = (lA+1)*(lA+2)/2;
+      const int ncB = (lB+1)*(lB+2)/2;
+      std::vector<double> X((ncA+ncB)*npts);
+      for( auto& x : X ) x = dist(gen);
+      double* Xi = X.data();
+      double* Xj = is_diag ? Xi : Xi + ncA*npts;
+
+      std::vector<double> G_os((ncA+ncB)*npts, 0.), G_rys((ncA+ncB)*npts, 0.);
+      auto Gj_off = is_diag ? 0 : ncA*npts;
+
+      XCPU::compute_integral_shell_pair( is_diag, npts,
+        points_transposed.data(), lA, lB, rA, rB, prim_pairs.size(),
+        prim_pairs.data(), Xi, Xj, npts, G_os.data(), G_os.data() + Gj_off,
+        npts, weights.data(), boys_table );
+      rys_integral_shell_pair( is_diag, npts, points.data(), lA, lB, rA, rB,
+        prim_pairs.size(), prim_pairs.data(), Xi, Xj, npts, G_rys.data(),
+        G_rys.data() + Gj_off, npts, weights.data() );
+
+      for( size_t i = 0; i < G_os.size(); ++i )
+        CHECK( G_rys[i] == Approx(G_os[i]).margin(1e-12) );
+    }
+  }
+
+  SECTION("Obara-Saika ISA Builds") {
+    std::vector<XCPU::coefficients> cA = {{0.5,0.7},{2.1,0.4},{7.0,0.2}};
+    std::vector<XCPU::coefficients> cB = {{0.3,0.9},{1.7,0.3}};
+    XCPU::point rA{0.1, 0.2, -0.3};
+    XCPU::point rB{0.8, -0.4, 0.9};
+
+    const char* env_isa = getenv("GAUXC_OS_ISA");
+    const std::string prev_isa = env_isa ? env_isa : "";
+
+    // Builds not supported by the library or the CPU fall back to a
+    // narrower one, which is then (harmlessly) checked again
+    for( std::string isa : {"reference", "avx2", "avx512"} ) {
+      setenv( "GAUXC_OS_ISA", isa.c_str(), 1 );
+      auto* kernel = XCPU::select_integral_shell_pair();
+
+      for( int is_diag = 0; is_diag < 2; ++is_diag )
+      for( int lA = 0; lA <= ShellPairIntegralDispatch::max_l_os; ++lA )
+      for( int lB = 0; lB <= lA; ++lB ) {
+        if( is_diag and lA != lB ) continue;
+        auto rB_ = is_diag ? rA : rB;
+        auto& cket = is_diag ? cA : cB;
+
+        XCPU::shells shA{ rA,  cA.data(),   int(cA.size()),   lA };
+        XCPU::shells shB{ rB_, cket.data(), int(cket.size()), lB };
+        std::vector<XCPU::prim_pair> prim_pairs( cA.size() * cket.size() );
+        XCPU::generate_shell_pair( shA, shB, prim_pairs.data() );
+
+        const int ncA = (lA+1)*(lA+2)/2;
+        const int ncB = (lB+1)*(lB+2)/2;
+        std::vector<double> X((ncA+ncB)*npts);
+        for( auto& x : X ) x = dist(gen);
+        double* Xi = X.data();
+        double* Xj = is_diag ? Xi : Xi + ncA*npts;
+
+        std::vector<double> G_ref((ncA+ncB)*npts, 0.), G_isa((ncA+ncB)*npts, 0.);
+        auto Gj_off = is_diag ? 0 : ncA*npts;
+
+        XCPU::reference::compute_integral_shell_pair( is_diag, npts,
+          points_transposed.data(), lA, lB, rA, rB_, prim_pairs.size(),
+          prim_pairs.data(), Xi, Xj, npts, G_ref.data(),
+          G_ref.data() + Gj_off, npts, weights.data(), boys_table );
+        kernel( is_diag, npts, points_transposed.data(), lA, lB, rA, rB_,
+          prim_pairs.size(), prim_pairs.data(), Xi, Xj, npts, G_isa.data(),
+          G_isa.data() + Gj_off, npts, weights.data(), boys_table );
+
+        for( size_t i = 0; i < G_ref.size(); ++i )
+          CHECK( G_isa[i] == Approx(G_ref[i]).margin(1e-12) );
+      }
+    }
+
+    if( prev_isa.empty() ) unsetenv( "GAUXC_OS_ISA" );
+    else setenv( "GAUXC_OS_ISA", prev_isa.c_str(), 1 );
+  }
+
+  SECTION("Point Screening Bound") {
+    std::vector<XCPU::coefficients> cA = {{0.5,0.7},{2.1,0.4},{7.0,0.2}};
+    std::vector<XCPU::coefficients> cB = {{0.3,0.9},{1.7,0.3}};
+    XCPU::point rA{0.1, 0.2, -0.3};
+    XCPU::point rB{0.8, -0.4, 0.9};
+
+    // Grid points overlapping / far away from the shell pair
+    for( double shift : {0., 4., 10.} ) {
+      std::vector<double> pts(points), pts_t(points_transposed);
+      std::vector<double> w(npts, 1.);
+      for( size_t i = 0; i < npts; ++i ) {
+        pts[3*i] += shift; pts_t[i] += shift;
+      }
+
+      double box[6];
+      for( int k = 0; k < 3; ++k ) {
+        box[k] = box[k+3] = pts[k];
+        for( size_t i = 0; i < npts; ++i ) {
+          box[k]   = std::min( box[k],   pts[3*i + k] );
+          box[k+3] = std::max( box[k+3], pts[3*i + k] );
+        }
+      }
+
+      for( int lA = 0; lA <= ShellPairIntegralDispatch::max_l_os; ++lA )
+      for( int lB = 0; lB <= lA; ++lB ) {
+        XCPU::shells shA{ rA, cA.data(), int(cA.size()), lA };
+        XCPU::shells shB{ rB, cB.data(), int(cB.size()), lB };
+        std::vector<XCPU::prim_pair> prim_pairs( cA.size() * cB.size() );
+        XCPU::generate_shell_pair( shA, shB, prim_pairs.data() );
+
+        double bound;
+        shell_pair_box_bound( lA, lB, prim_pairs.size(), prim_pairs.data(),
+          1, box, &bound );
+
+        // G(a,i) = A(a,b,i) for X(nu,i) = delta(nu,b)
+        const int ncA = (lA+1)*(lA+2)/2;
+        const int ncB = (lB+1)*(lB+2)/2;
+        double A_max = 0.;
+        for( int b = 0; b < ncB; ++b ) {
+          std::vector<double> X((ncA+ncB)*npts, 0.), G((ncA+ncB)*npts, 0.);
+          std::fill_n( X.data() + (ncA + b)*npts, npts, 1. );
+          XCPU::compute_integral_shell_pair( 0, npts, pts_t.data(), lA, lB, 
+            rA, rB, prim_pairs.size(), prim_pairs.data(), X.data(), 
+            X.data() + ncA*npts, npts, G.data(), G.data() + ncA*npts, npts,
+            w.data(), boys_table );
+          for( size_t i = 0; i < ncA*npts; ++i ) 
+            A_max = std::max( A_max, std::abs(G[i]) );
+        }
+
+        CHECK( A_max <= bound );
+      }
+    }
+  }
+
+  SECTION("Dispatch Table") {
+    ShellPairIntegralDispatch dispatch;
+    dispatch.force( ShellPairIntegralBackend::Rys );
+    CHECK( dispatch.select(2,1,5) == ShellPairIntegralBackend::Rys );
+
+    // Obara-Saika kernels are not available for L > 4
+    dispatch.force( ShellPairIntegralBackend::ObaraSaika );
+    CHECK( dispatch.select(2,1,5) == ShellPairIntegralBackend::ObaraSaika );
+    CHECK( dispatch.select(5,0,1) == ShellPairIntegralBackend::Rys );
+
+    // Neither backend is available beyond max_l_rys
+    CHECK_THROWS( dispatch.select(ShellPairIntegralDispatch::max_l_rys+1,0,1) );
+    CHECK_THROWS( dispatch.select(0,ShellPairIntegralDispatch::max_l_rys+1,1) );
+
+    // Round trip through a tuning file
+    dispatch.tune();
+    const std::string fname = "gauxc_shell_pair_tuning.txt";
+    dispatch.write( fname );
+
+    ShellPairIntegralDispatch read_dispatch;
+    read_dispatch.force( ShellPairIntegralBackend::Rys );
+    REQUIRE( read_dispatch.read( fname ) );
+    std::remove( fname.c_str() );
+
+    for( int lA = 0; lA <= ShellPairIntegralDispatch::max_l_rys; ++lA )
+    for( int lB = 0; lB <= ShellPairIntegralDispatch::max_l_rys; ++lB )
+    for( int nprim : {1, 3, 10, 40} ) {
+      CHECK( read_dispatch.select(lA,lB,nprim) ==
+             dispatch.select(lA,lB,nprim) );
+    }
+
+    CHECK_FALSE( read_dispatch.read( fname ) );
+  }
+
+  XCPU::boys_finalize( boys_table );
+
+}
+#endif
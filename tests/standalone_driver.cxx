@@ -104,6 +104,8 @@ int main(int argc, char** argv) {
     IntegratorSettingsSNLinK sn_link_settings;
     OPTIONAL_KEYWORD( "EXX.TOL_E", sn_link_settings.energy_tol, double );
     OPTIONAL_KEYWORD( "EXX.TOL_K", sn_link_settings.k_tol,      double );
+    OPTIONAL_KEYWORD( "EXX.TOL_PT", sn_link_settings.pt_tol,    double );
+    OPTIONAL_KEYWORD( "EXX.TOL_APPROX_F", sn_link_settings.approx_f_p_tol, double );
 
 
     #ifdef GAUXC_HAS_DEVICE
@@ -141,7 +143,11 @@ int main(int argc, char** argv) {
                   std::cout << "  EXX.TOL_E         = " 
                             << sn_link_settings.energy_tol << std::endl
                             << "  EXX.TOL_K         = " 
-                            << sn_link_settings.k_tol << std::endl;
+                            << sn_link_settings.k_tol << std::endl
+                            << "  EXX.TOL_PT        = " 
+                            << sn_link_settings.pt_tol << std::endl
+                            << "  EXX.TOL_APPROX_F  = " 
+                            << sn_link_settings.approx_f_p_tol << std::endl;
                 }
                 std::cout << std::endl;
     }
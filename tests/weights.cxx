@@ -54,6 +54,11 @@ TEST_CASE( "Partition Weights", "[weights]" ) {
                           std::ios::binary );
   test_host_weights( ref_data, XCWeightAlg::Becke );
   }
+  SECTION("Becke Screened") {
+  std::ifstream ref_data( GAUXC_REF_DATA_PATH "/benzene_weights_becke.bin", 
+                          std::ios::binary );
+  test_host_screened_weights( ref_data, XCWeightAlg::Becke );
+  }
   SECTION("LKO") {
   std::ifstream ref_data( GAUXC_REF_DATA_PATH "/benzene_weights_lko.bin", 
                           std::ios::binary );
@@ -71,6 +76,12 @@ TEST_CASE( "Partition Weights", "[weights]" ) {
   SECTION( "Host Weights" ) {
     test_host_weights( ref_data, XCWeightAlg::SSF );
   }
+  SECTION( "Host Screened Weights" ) {
+    test_host_screened_weights( ref_data, XCWeightAlg::SSF );
+  }
+  SECTION( "Host Screened Weights (Taxol)" ) {
+    test_host_screened_weights( make_taxol(), 10 );
+  }
 #endif
 
 #ifdef GAUXC_HAS_DEVICE
@@ -53,5 +53,79 @@ void test_host_weights( std::ifstream& in_file, XCWeightAlg weight_alg ) {
     }
   }
 
+}
+
+void test_host_screened_weights( std::ifstream& in_file, 
+  XCWeightAlg weight_alg ) {
+
+  ref_weights_data ref_data;
+  {
+    cereal::BinaryInputArchive ar( in_file );
+    ar( ref_data );
+  }
+
+  auto tasks_ref = ref_data.tasks_unm;
+  auto& tasks    = ref_data.tasks_unm;
+  switch(weight_alg) {
+    case XCWeightAlg::Becke:
+      reference_becke_weights_host( 
+        ref_data.mol, *ref_data.meta, tasks_ref.begin(), tasks_ref.end() );
+      screened_becke_weights_host( 
+        ref_data.mol, *ref_data.meta, tasks.begin(), tasks.end() );
+      break;
+    case XCWeightAlg::SSF:
+      reference_ssf_weights_host( 
+        ref_data.mol, *ref_data.meta, tasks_ref.begin(), tasks_ref.end() );
+      screened_ssf_weights_host( 
+        ref_data.mol, *ref_data.meta, tasks.begin(), tasks.end() );
+      break;
+    default:
+      GAUXC_GENERIC_EXCEPTION("Weight Alg Not Screened");
+  }
+
+  size_t ntasks = tasks.size();
+  for( size_t itask = 0; itask < ntasks; ++itask ) {
+    auto& task     = tasks.at(itask);
+    auto& ref_task = tasks_ref.at(itask);
+
+    size_t npts = task.weights.size();
+    for( size_t i = 0; i < npts; ++i ) {
+      CHECK( task.weights.at(i) ==
+             Approx(ref_task.weights.at(i)).epsilon(1e-14) );
+    }
+  }
+
+}
+
+void test_host_screened_weights( const Molecule& mol, size_t task_stride ) {
+
+  auto rt = RuntimeEnvironment(GAUXC_MPI_CODE(MPI_COMM_WORLD));
+  auto basis = make_631Gd( mol, SphericalType(true) );
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Robust,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  LoadBalancerFactory lb_factory(ExecutionSpace::Host, "Default");
+  auto lb = lb_factory.get_instance(rt, mol, mg, basis);
+
+  // Subsample the tasks to keep the reference tractable
+  std::vector<XCTask> tasks;
+  const auto& lb_tasks = lb.get_tasks();
+  for( size_t i = 0; i < lb_tasks.size(); i += task_stride )
+    tasks.emplace_back( lb_tasks[i] );
+
+  MolMeta meta( mol );
+  auto tasks_ref = tasks;
+  reference_ssf_weights_host( mol, meta, tasks_ref.begin(), tasks_ref.end() );
+  screened_ssf_weights_host( mol, meta, tasks.begin(), tasks.end() );
+
+  for( size_t itask = 0; itask < tasks.size(); ++itask ) {
+    const auto& task     = tasks.at(itask);
+    const auto& ref_task = tasks_ref.at(itask);
+    for( size_t i = 0; i < task.weights.size(); ++i ) {
+      CHECK( task.weights.at(i) ==
+             Approx(ref_task.weights.at(i)).epsilon(1e-14) );
+    }
+  }
+
 }
 #endif
@@ -170,12 +170,158 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     auto VXC_diff_nrm = ( VXC - VXC_ref ).norm();
     CHECK( EXC == Approx( EXC_ref ) );
     CHECK( VXC_diff_nrm / basis.nbf() < 1e-10 ); 
+
+    // Check EXC/VXC evaluated with the given (host) settings against 
+    // EXC_cmp and VXC_cmp (to within vxc_tol per basis function)
+    auto check_settings = [&]( const IntegratorSettingsKS& ks_settings,
+      const Approx& EXC_cmp, const matrix_type& VXC_cmp, double vxc_tol ) {
+      auto [ EXC1, VXC1 ] = integrator.eval_exc_vxc( P, ks_settings );
+      CHECK( EXC1 == EXC_cmp );
+      auto VXC1_diff_nrm = ( VXC1 - VXC_cmp ).norm();
+      CHECK( VXC1_diff_nrm / basis.nbf() < vxc_tol );
+    };
+
     // Check if the integrator propagates state correctly
     {
       auto [ EXC1, VXC1 ] = integrator.eval_exc_vxc( P );
       CHECK( EXC1 == Approx( EXC_ref ) );
       auto VXC1_diff_nrm = ( VXC1 - VXC_ref ).norm();
-      CHECK( VXC1_diff_nrm / basis.nbf() < 1e-10 ); 
+      CHECK( VXC1_diff_nrm / basis.nbf() < 1e-10 );
+    }
+
+    // Check the collocation cache (populate + reuse)
+    if( ex == ExecutionSpace::Host ) {
+      IntegratorSettingsKS ks_settings;
+      ks_settings.collocation_cache_bytes = 1ul << 30;
+      for( int i = 0; i < 2; ++i ) 
+        check_settings( ks_settings, Approx( EXC_ref ), VXC_ref, 1e-10 );
+
+      // Budgets which only hold a few tasks (eviction), no task at all
+      // (rejected admission) and a few tasks backed by a spill file
+      ks_settings.collocation_cache_bytes = 1ul << 20;
+      for( int i = 0; i < 2; ++i ) 
+        check_settings( ks_settings, Approx( EXC_ref ), VXC_ref, 1e-10 );
+
+      ks_settings.collocation_cache_bytes = 1ul << 10;
+      for( int i = 0; i < 2; ++i ) 
+        check_settings( ks_settings, Approx( EXC_ref ), VXC_ref, 1e-10 );
+
+      ks_settings.collocation_cache_bytes       = 1ul << 20;
+      ks_settings.collocation_cache_spill_file  = "gauxc_collocation_cache.spill";
+      ks_settings.collocation_cache_spill_bytes = 1ul << 23;
+      for( int i = 0; i < 2; ++i ) 
+        check_settings( ks_settings, Approx( EXC_ref ), VXC_ref, 1e-10 );
+    }
+
+    // Check shell block screening of the X matrix
+    if( ex == ExecutionSpace::Host ) {
+      IntegratorSettingsKS ks_settings;
+      ks_settings.xmat_screen_tol = 1e-14;
+      check_settings( ks_settings, Approx( EXC_ref ), VXC_ref, 1e-10 );
+
+      // Blocks below the (looser) threshold are dropped from the density,
+      // the error w.r.t. the unscreened evaluation must remain bounded
+      ks_settings.xmat_screen_tol = 1e-8;
+      check_settings( ks_settings, Approx( EXC ).epsilon(0.).margin(1e-6),
+        VXC, 1e-6 );
+    }
+
+    // Check primitive screening of the collocation
+    if( ex == ExecutionSpace::Host ) {
+      IntegratorSettingsKS ks_settings;
+      ks_settings.prim_screen_tol = 1e-14;
+      check_settings( ks_settings, Approx( EXC_ref ), VXC_ref, 1e-10 );
+
+      // Primitives (and derivatives) bounded below the (looser) threshold 
+      // are dropped, the error w.r.t. the unscreened evaluation must remain
+      // bounded
+      ks_settings.prim_screen_tol = 1e-8;
+      check_settings( ks_settings, Approx( EXC ).epsilon(0.).margin(1e-6),
+        VXC, 1e-6 );
+    }
+
+    // Check batched evaluation of the functional across tasks
+    if( ex == ExecutionSpace::Host ) {
+      IntegratorSettingsKS ks_settings;
+      ks_settings.func_batch_npts = 4096;
+      check_settings( ks_settings, Approx( EXC_ref ), VXC_ref, 1e-10 );
+    }
+
+    // Check batched evaluation over several densities against single
+    // density evaluations (the X matrices of the batch are strided)
+    if( ex == ExecutionSpace::Host ) {
+      std::vector<matrix_type> Ps = { P, 0.5 * P, 
+        matrix_type(0.75 * P + 0.25 * matrix_type(P.diagonal().asDiagonal())) };
+      auto EXC_VXC = integrator.eval_exc_vxc_batch( Ps );
+      REQUIRE( EXC_VXC.size() == Ps.size() );
+      for( size_t k = 0; k < Ps.size(); ++k ) {
+        auto [ EXCk_ref, VXCk_ref ] = integrator.eval_exc_vxc( Ps[k] );
+        CHECK( std::get<0>(EXC_VXC[k]) == Approx( EXCk_ref ) );
+        auto VXCk_diff_nrm = ( std::get<1>(EXC_VXC[k]) - VXCk_ref ).norm();
+        CHECK( VXCk_diff_nrm / basis.nbf() < 1e-10 );
+      }
+    }
+
+    // Check multi-functional evaluation against individual integrators
+    // (not implemented by the ShellBatched integrator)
+    if( ex == ExecutionSpace::Host and integrator_kernel != "ShellBatched" ) {
+      functional_type lda( ExchCXX::Backend::builtin, ExchCXX::Functional::SVWN5,
+        ExchCXX::Spin::Unpolarized );
+      auto lda_integrator = integrator_factory.get_instance( lda, lb );
+      auto [ EXC_lda, VXC_lda ] = lda_integrator.eval_exc_vxc( P );
+
+      auto EXC_VXC = integrator.eval_exc_vxc_multi( P, { func, lda } );
+      REQUIRE( EXC_VXC.size() == 2 );
+      CHECK( std::get<0>(EXC_VXC[0]) == Approx( EXC_ref ) );
+      CHECK( std::get<0>(EXC_VXC[1]) == Approx( EXC_lda ) );
+      auto VXC1_diff_nrm = ( std::get<1>(EXC_VXC[0]) - VXC_ref ).norm();
+      auto VXC2_diff_nrm = ( std::get<1>(EXC_VXC[1]) - VXC_lda ).norm();
+      CHECK( VXC1_diff_nrm / basis.nbf() < 1e-10 );
+      CHECK( VXC2_diff_nrm / basis.nbf() < 1e-10 );
+
+      auto EXC_multi = integrator.eval_exc_multi( P, { lda, func } );
+      REQUIRE( EXC_multi.size() == 2 );
+      CHECK( EXC_multi[0] == Approx( EXC_lda ) );
+      CHECK( EXC_multi[1] == Approx( EXC_ref ) );
+    }
+
+    // Check fxc contraction against a central difference of VXC
+    // (not implemented by the ShellBatched integrator)
+    if( ex == ExecutionSpace::Host and integrator_kernel != "ShellBatched" and
+        not func.is_mgga() ) {
+      const double h = 1e-4;
+      matrix_type Pp = (1. + h) * P;
+      matrix_type Pm = (1. - h) * P;
+      auto VXCp = std::get<1>( integrator.eval_exc_vxc( Pp ) );
+      auto VXCm = std::get<1>( integrator.eval_exc_vxc( Pm ) );
+      matrix_type FXC_fd = (VXCp - VXCm) / (2. * h);
+
+      std::vector<matrix_type> tPs = { P, 0.5 * P,
+        matrix_type(P.diagonal().asDiagonal()) };
+      auto FXC = integrator.eval_fxc_contraction( P, tPs );
+      REQUIRE( FXC.size() == tPs.size() );
+      CHECK( ( FXC[0] - FXC_fd ).norm() / FXC_fd.norm() < 1e-5 );
+      CHECK( ( FXC[1] - 0.5 * FXC_fd ).norm() / FXC_fd.norm() < 1e-5 );
+
+      // Each trial of the (strided) batch must match a one-trial contraction
+      for( size_t k = 0; k < tPs.size(); ++k ) {
+        auto FXCk_ref = integrator.eval_fxc_contraction( P, { tPs[k] } );
+        REQUIRE( FXCk_ref.size() == 1 );
+        CHECK( ( FXC[k] - FXCk_ref[0] ).norm() / basis.nbf() < 1e-10 );
+      }
+    }
+
+    // Check density screening of the points
+    if( ex == ExecutionSpace::Host ) {
+      IntegratorSettingsKS ks_settings;
+      ks_settings.den_screen_tol = 1e-14;
+      check_settings( ks_settings, Approx( EXC_ref ), VXC_ref, 1e-10 );
+
+      // Points of (looser) negligible density are removed, the error w.r.t.
+      // the unscreened evaluation must remain bounded
+      ks_settings.den_screen_tol = 1e-8;
+      check_settings( ks_settings, Approx( EXC ).epsilon(0.).margin(1e-6),
+        VXC, 1e-6 );
     }
 
     // Check EXC-only path
@@ -191,6 +337,20 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     CHECK( EXC == Approx( EXC_ref ) );
     CHECK( VXC_diff_nrm / basis.nbf() < 1e-10 );
     CHECK( VXCz_diff_nrm / basis.nbf() < 1e-10 );
+
+    // Check EXC/VXC evaluated with the given (host) settings against 
+    // EXC_cmp and VXC(z)_cmp (to within vxc_tol per basis function)
+    auto check_settings = [&]( const IntegratorSettingsKS& ks_settings,
+      const Approx& EXC_cmp, const matrix_type& VXC_cmp, 
+      const matrix_type& VXCz_cmp, double vxc_tol ) {
+      auto [ EXC1, VXC1, VXCz1 ] = integrator.eval_exc_vxc( P, Pz, ks_settings );
+      CHECK( EXC1 == EXC_cmp );
+      auto VXC1_diff_nrm = ( VXC1 - VXC_cmp ).norm();
+      auto VXCz1_diff_nrm = ( VXCz1 - VXCz_cmp ).norm();
+      CHECK( VXC1_diff_nrm / basis.nbf() < vxc_tol );
+      CHECK( VXCz1_diff_nrm / basis.nbf() < vxc_tol );
+    };
+
     // Check if the integrator propagates state correctly
     {
       auto [ EXC1, VXC1, VXCz1 ] = integrator.eval_exc_vxc( P, Pz );
@@ -201,6 +361,27 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
       CHECK( VXCz1_diff_nrm / basis.nbf() < 1e-10 );
     }
 
+    // Check batched evaluation of the functional across tasks
+    if( ex == ExecutionSpace::Host ) {
+      IntegratorSettingsKS ks_settings;
+      ks_settings.func_batch_npts = 4096;
+      check_settings( ks_settings, Approx( EXC_ref ), VXC_ref, VXCz_ref, 
+        1e-10 );
+    }
+
+    // Check density screening of the points within batched evaluation
+    if( ex == ExecutionSpace::Host ) {
+      IntegratorSettingsKS ks_settings;
+      ks_settings.func_batch_npts = 4096;
+      ks_settings.den_screen_tol  = 1e-14;
+      check_settings( ks_settings, Approx( EXC_ref ), VXC_ref, VXCz_ref, 
+        1e-10 );
+
+      ks_settings.den_screen_tol  = 1e-8;
+      check_settings( ks_settings, Approx( EXC ).epsilon(0.).margin(1e-6),
+        VXC, VXCz, 1e-6 );
+    }
+
     // Check EXC-only path
     auto EXC2 = integrator.eval_exc( P, Pz );
     CHECK(EXC2 == Approx(EXC));
@@ -259,6 +440,38 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     auto K = integrator.eval_exx( P );
     CHECK((K - K.transpose()).norm() < std::numeric_limits<double>::epsilon()); // Symmetric
     CHECK( (K - K_ref).norm() / basis.nbf() < 1e-7 );
+
+    // Incremental builds (full + delta)
+    IntegratorSettingsSNLinK sn_link_settings;
+    sn_link_settings.incremental = true;
+    auto K1 = integrator.eval_exx( P, sn_link_settings );
+    CHECK( (K1 - K_ref).norm() / basis.nbf() < 1e-7 );
+    matrix_type P2 = 0.5 * P;
+    auto K2 = integrator.eval_exx( P2, sn_link_settings );
+    CHECK( (K2 - 0.5 * K_ref).norm() / basis.nbf() < 1e-7 );
+
+    // Small changes of the density are built as deltas, large ones (as
+    // P -> P2 above) trigger a full build
+    matrix_type P3 = P2 + 1e-7 * matrix_type(P.diagonal().asDiagonal());
+    auto K3 = integrator.eval_exx( P3, sn_link_settings );
+    auto K3_full = integrator.eval_exx( P3 );
+    CHECK( (K3 - K3_full).norm() / basis.nbf() < 1e-8 );
+
+    // Point block screening: the tasks (BatchSize(512)) span several point
+    // blocks, every skipped (shell pair, block) bounds |G| below pt_tol
+    if( ex == ExecutionSpace::Host ) {
+      IntegratorSettingsSNLinK pt_settings;
+      pt_settings.pt_tol = 1e-12;
+      auto K_pt = integrator.eval_exx( P, pt_settings );
+      CHECK( (K_pt - K).norm() / basis.nbf() < 1e-8 );
+      CHECK( (K_pt - K_ref).norm() / basis.nbf() < 1e-7 );
+
+      // Approximate F bounds of the EK screening (opt-in)
+      IntegratorSettingsSNLinK f_settings;
+      f_settings.approx_f_p_tol = 1e-14;
+      auto K_f = integrator.eval_exx( P, f_settings );
+      CHECK( (K_f - K_ref).norm() / basis.nbf() < 1e-7 );
+    }
   }
 
 }
@@ -277,6 +490,14 @@ void test_integrator(std::string reference_file, functional_type& func, PruningS
         test_xc_integrator( ExecutionSpace::Host, rt, reference_file, func,
           pruning_scheme, true, true, true );
       }
+      SECTION("Fused") {
+        test_xc_integrator( ExecutionSpace::Host, rt, reference_file, func,
+          pruning_scheme, false, false, false, "Default", "Default", "Fused" );
+      }
+      SECTION("SIMD") {
+        test_xc_integrator( ExecutionSpace::Host, rt, reference_file, func,
+          pruning_scheme, false, false, false, "Default", "Default", "SIMD" );
+      }
       SECTION("ShellBatched") {
         test_xc_integrator( ExecutionSpace::Host, rt, reference_file, func,
           pruning_scheme, false, false, false, "ShellBatched" );